@@ -0,0 +1,210 @@
+#include "ara/crypto/cryp/algorithm_registry.h"
+
+#include <array>
+#include <utility>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                struct AlgorithmName
+                {
+                    CryptoAlgId mAlgId;
+                    const char *mName;
+                };
+
+                // Ordered by the algorithm ID: the entry of an ID is located at index (ID - 1).
+                constexpr AlgorithmName kAlgorithms[] =
+                {
+                    {kAlgIdAes128Ecb, "AES-128/ECB"},
+                    {kAlgIdAes256Ecb, "AES-256/ECB"},
+                    {kAlgIdAes128Cbc, "AES-128/CBC"},
+                    {kAlgIdAes256Cbc, "AES-256/CBC"},
+                    {kAlgIdAes128Ctr, "AES-128/CTR"},
+                    {kAlgIdAes256Ctr, "AES-256/CTR"},
+                    {kAlgIdAes128Xts, "AES-128/XTS"},
+                    {kAlgIdAes256Xts, "AES-256/XTS"},
+                    {kAlgIdChaCha20, "ChaCha20"},
+                    {kAlgIdAes128Kw, "AES-128/KW"},
+                    {kAlgIdAes256Kw, "AES-256/KW"},
+                    {kAlgIdAes128Kwp, "AES-128/KWP"},
+                    {kAlgIdAes256Kwp, "AES-256/KWP"},
+                    {kAlgIdSha1, "SHA-1"},
+                    {kAlgIdSha2_256, "SHA2-256"},
+                    {kAlgIdSha2_512, "SHA2-512"},
+                    {kAlgIdHmacSha2_256, "HMAC/SHA2-256"},
+                    {kAlgIdHmacSha2_512, "HMAC/SHA2-512"},
+                    {kAlgIdCmacAes128, "CMAC/AES-128"},
+                    {kAlgIdCmacAes256, "CMAC/AES-256"},
+                    {kAlgIdGmacAes128, "GMAC/AES-128"},
+                    {kAlgIdGmacAes256, "GMAC/AES-256"},
+                    {kAlgIdPoly1305, "Poly1305"},
+                    {kAlgIdHkdfSha2_256, "HKDF/SHA2-256"},
+                    {kAlgIdPbkdf2HmacSha2_256, "PBKDF2/HMAC/SHA2-256"},
+                    {kAlgIdKdfCtrHmacSha2_256, "KDF-CTR/HMAC/SHA2-256"},
+                    {kAlgIdCtrDrbgAes256, "CTR-DRBG/AES-256"},
+                    {kAlgIdHmacDrbgSha2_256, "HMAC-DRBG/SHA2-256"},
+                    {kAlgIdChaCha20Rng, "ChaCha20-RNG"},
+                    {kAlgIdX25519, "X25519"},
+                    {kAlgIdEcdhP256, "ECDH/P-256"},
+                    {kAlgIdEd25519, "Ed25519"},
+                    {kAlgIdEcdsaP256Sha2_256, "ECDSA/P-256/SHA2-256"},
+                    {kAlgIdRsa2048OaepSha2_256, "RSA-2048/OAEP/SHA2-256"},
+                    {kAlgIdRsa3072OaepSha2_256, "RSA-3072/OAEP/SHA2-256"},
+                    {kAlgIdRsa2048Kem, "RSA-2048/KEM/HKDF/SHA2-256"},
+                    {kAlgIdRsa3072Kem, "RSA-3072/KEM/HKDF/SHA2-256"},
+                    {kAlgIdRsaPkcs1Sha2_256, "RSA/PKCS1-v1_5/SHA2-256"}
+                };
+
+                constexpr std::size_t kTableSize = sizeof(kAlgorithms) / sizeof(kAlgorithms[0]);
+                static_assert(kTableSize == AlgorithmRegistry::kAlgorithmCount, "AlgorithmRegistry::kAlgorithmCount is out of date");
+
+                constexpr bool IsDense ()
+                {
+                    for (std::size_t i = 0; i < kTableSize; ++i)
+                    {
+                        if (kAlgorithms[i].mAlgId != (i + 1u))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                static_assert(IsDense(), "Algorithm IDs must be dense and ordered");
+
+                // Number of the hash table slots: a power of two that keeps the load factor below 1/4, so a
+                // collision-free seed is found after a few dozens of attempts.
+                constexpr std::size_t kSlotCount = 256u;
+                static_assert(kSlotCount >= 4u * kTableSize, "The perfect hash table is too dense");
+
+                constexpr std::size_t Length (const char *str)
+                {
+                    std::size_t length = 0u;
+                    while (str[length] != '\0')
+                    {
+                        ++length;
+                    }
+                    return length;
+                }
+
+                // FNV-1a, seeded by the initial value.
+                constexpr std::uint32_t Hash (const char *str, std::size_t length, std::uint32_t seed)
+                {
+                    std::uint32_t hash = 2166136261u ^ seed;
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        hash ^= static_cast<std::uint8_t>(str[i]);
+                        hash *= 16777619u;
+                    }
+                    return hash ^ (hash >> 15);
+                }
+
+                struct PerfectHashTable
+                {
+                    std::uint32_t mSeed = 0u;
+                    std::uint8_t mSlots[kSlotCount] = {};   // (index + 1) of the entry occupying the slot, or 0
+                };
+
+                constexpr PerfectHashTable BuildPerfectHashTable ()
+                {
+                    for (std::uint32_t seed = 1u; seed < 100000u; ++seed)
+                    {
+                        PerfectHashTable table;
+                        table.mSeed = seed;
+                        bool collision = false;
+                        for (std::size_t i = 0; (i < kTableSize) && !collision; ++i)
+                        {
+                            const std::size_t slot = Hash(kAlgorithms[i].mName, Length(kAlgorithms[i].mName), seed) % kSlotCount;
+                            collision = (table.mSlots[slot] != 0u);
+                            table.mSlots[slot] = static_cast<std::uint8_t>(i + 1u);
+                        }
+                        if (!collision)
+                        {
+                            return table;
+                        }
+                    }
+                    return PerfectHashTable();
+                }
+
+                constexpr PerfectHashTable kPerfectHashTable = BuildPerfectHashTable();
+                static_assert(kPerfectHashTable.mSeed != 0u, "No perfect hash seed was found for the algorithm names");
+
+                /**
+                 * @brief Crypto Primitive ID of a registered algorithm.
+                 */
+                class RegisteredPrimitiveId final : public CryptoPrimitiveId
+                {
+                public:
+                    RegisteredPrimitiveId (AlgId algId, const char *name) noexcept
+                    : CryptoPrimitiveId(ara::core::StringView(name)),
+                      mAlgId(algId)
+                    {
+                    }
+
+                    AlgId GetPrimitiveId () const noexcept override
+                    {
+                        return mAlgId;
+                    }
+
+                private:
+                    AlgId mAlgId;
+                };
+
+                template <std::size_t... Index>
+                std::array<RegisteredPrimitiveId, sizeof...(Index)> MakePrimitiveIds (std::index_sequence<Index...>) noexcept
+                {
+                    return {{RegisteredPrimitiveId(kAlgorithms[Index].mAlgId, kAlgorithms[Index].mName)...}};
+                }
+
+                const std::array<RegisteredPrimitiveId, kTableSize> kPrimitiveIds = MakePrimitiveIds(std::make_index_sequence<kTableSize>());
+            }
+
+            CryptoAlgId AlgorithmRegistry::ToAlgId (ara::core::StringView primitiveName) noexcept
+            {
+                const std::size_t slot = Hash(primitiveName.data(), primitiveName.size(), kPerfectHashTable.mSeed) % kSlotCount;
+                const std::uint8_t entry = kPerfectHashTable.mSlots[slot];
+                if (entry == 0u)
+                {
+                    return kAlgIdUndefined;
+                }
+
+                const AlgorithmName &candidate = kAlgorithms[entry - 1u];
+                const std::size_t length = Length(candidate.mName);
+                if (length != primitiveName.size())
+                {
+                    return kAlgIdUndefined;
+                }
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (candidate.mName[i] != primitiveName[i])
+                    {
+                        return kAlgIdUndefined;
+                    }
+                }
+                return candidate.mAlgId;
+            }
+
+            ara::core::StringView AlgorithmRegistry::ToAlgName (CryptoAlgId algId) noexcept
+            {
+                if ((algId == kAlgIdUndefined) || (algId > kTableSize))
+                {
+                    return ara::core::StringView();
+                }
+                return ara::core::StringView(kAlgorithms[algId - 1u].mName);
+            }
+
+            const CryptoPrimitiveId* AlgorithmRegistry::GetPrimitiveId (CryptoAlgId algId) noexcept
+            {
+                if ((algId == kAlgIdUndefined) || (algId > kTableSize))
+                {
+                    return nullptr;
+                }
+                return &kPrimitiveIds[algId - 1u];
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef ARA_CRYPTO_CRYP_ALGORITHM_REGISTRY_H
+#define ARA_CRYPTO_CRYP_ALGORITHM_REGISTRY_H
+
+#include <cinttypes>
+
+#include "ara/core/string_view.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/cryobj/crypto_primitive_id.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Vendor specific binary IDs of the crypto primitives implemented by the Crypto Stack (the
+             * kernels and engines of the cryp directory). The IDs are dense (from 1 up to
+             * AlgorithmRegistry::kAlgorithmCount), so an ID is an index of the primitive.
+             */
+            const CryptoAlgId kAlgIdAes128Ecb = 1u;             // "AES-128/ECB"
+            const CryptoAlgId kAlgIdAes256Ecb = 2u;             // "AES-256/ECB"
+            const CryptoAlgId kAlgIdAes128Cbc = 3u;             // "AES-128/CBC"
+            const CryptoAlgId kAlgIdAes256Cbc = 4u;             // "AES-256/CBC"
+            const CryptoAlgId kAlgIdAes128Ctr = 5u;             // "AES-128/CTR"
+            const CryptoAlgId kAlgIdAes256Ctr = 6u;             // "AES-256/CTR"
+            const CryptoAlgId kAlgIdAes128Xts = 7u;             // "AES-128/XTS"
+            const CryptoAlgId kAlgIdAes256Xts = 8u;             // "AES-256/XTS"
+            const CryptoAlgId kAlgIdChaCha20 = 9u;              // "ChaCha20"
+            const CryptoAlgId kAlgIdAes128Kw = 10u;             // "AES-128/KW"
+            const CryptoAlgId kAlgIdAes256Kw = 11u;             // "AES-256/KW"
+            const CryptoAlgId kAlgIdAes128Kwp = 12u;            // "AES-128/KWP"
+            const CryptoAlgId kAlgIdAes256Kwp = 13u;            // "AES-256/KWP"
+            const CryptoAlgId kAlgIdSha1 = 14u;                 // "SHA-1"
+            const CryptoAlgId kAlgIdSha2_256 = 15u;             // "SHA2-256"
+            const CryptoAlgId kAlgIdSha2_512 = 16u;             // "SHA2-512"
+            const CryptoAlgId kAlgIdHmacSha2_256 = 17u;         // "HMAC/SHA2-256"
+            const CryptoAlgId kAlgIdHmacSha2_512 = 18u;         // "HMAC/SHA2-512"
+            const CryptoAlgId kAlgIdCmacAes128 = 19u;           // "CMAC/AES-128"
+            const CryptoAlgId kAlgIdCmacAes256 = 20u;           // "CMAC/AES-256"
+            const CryptoAlgId kAlgIdGmacAes128 = 21u;           // "GMAC/AES-128"
+            const CryptoAlgId kAlgIdGmacAes256 = 22u;           // "GMAC/AES-256"
+            const CryptoAlgId kAlgIdPoly1305 = 23u;             // "Poly1305"
+            const CryptoAlgId kAlgIdHkdfSha2_256 = 24u;         // "HKDF/SHA2-256"
+            const CryptoAlgId kAlgIdPbkdf2HmacSha2_256 = 25u;   // "PBKDF2/HMAC/SHA2-256"
+            const CryptoAlgId kAlgIdKdfCtrHmacSha2_256 = 26u;   // "KDF-CTR/HMAC/SHA2-256" (NIST SP 800-108 counter mode)
+            const CryptoAlgId kAlgIdCtrDrbgAes256 = 27u;        // "CTR-DRBG/AES-256"
+            const CryptoAlgId kAlgIdHmacDrbgSha2_256 = 28u;     // "HMAC-DRBG/SHA2-256"
+            const CryptoAlgId kAlgIdChaCha20Rng = 29u;          // "ChaCha20-RNG"
+            const CryptoAlgId kAlgIdX25519 = 30u;               // "X25519"
+            const CryptoAlgId kAlgIdEcdhP256 = 31u;             // "ECDH/P-256"
+            const CryptoAlgId kAlgIdEd25519 = 32u;              // "Ed25519"
+            const CryptoAlgId kAlgIdEcdsaP256Sha2_256 = 33u;    // "ECDSA/P-256/SHA2-256"
+            const CryptoAlgId kAlgIdRsa2048OaepSha2_256 = 34u;  // "RSA-2048/OAEP/SHA2-256"
+            const CryptoAlgId kAlgIdRsa3072OaepSha2_256 = 35u;  // "RSA-3072/OAEP/SHA2-256"
+            const CryptoAlgId kAlgIdRsa2048Kem = 36u;           // "RSA-2048/KEM/HKDF/SHA2-256"
+            const CryptoAlgId kAlgIdRsa3072Kem = 37u;           // "RSA-3072/KEM/HKDF/SHA2-256"
+            const CryptoAlgId kAlgIdRsaPkcs1Sha2_256 = 38u;     // "RSA/PKCS1-v1_5/SHA2-256" (verification only, up to 4096 bits)
+
+            /**
+             * @brief Registry of the unified names of all implemented crypto primitives. The name-to-ID lookup is
+             * served by a perfect hash table generated at compile time, and the ID-to-name lookup by a direct
+             * index into the dense table, so neither of them allocates memory or compares more than one string.
+             * The registry also owns one static CryptoPrimitiveId instance per primitive.
+             */
+            class AlgorithmRegistry
+            {
+            public:
+
+                /**
+                 * @brief Number of registered crypto primitives (i.e. the maximal registered algorithm ID).
+                 */
+                static const std::size_t kAlgorithmCount = 38u;
+
+                /**
+                 * @brief Convert a unified name of a crypto primitive to the correspondent algorithm ID.
+                 * @param[in] primitiveName the unified name of the crypto primitive (see "Crypto Primitives Naming Convention" for more details)
+                 * @return CryptoAlgId the algorithm ID or kAlgIdUndefined if the name is not registered
+                 */
+                static CryptoAlgId ToAlgId (ara::core::StringView primitiveName) noexcept;
+
+                /**
+                 * @brief Convert an algorithm ID to the unified name of the crypto primitive.
+                 * @param[in] algId the algorithm ID
+                 * @return ara::core::StringView the unified name (referring a static string) or an empty view if the ID is not registered
+                 */
+                static ara::core::StringView ToAlgName (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Get the static CryptoPrimitiveId instance of a registered crypto primitive. The instance
+                 * exists during the whole life-time of the process.
+                 * @param[in] algId the algorithm ID
+                 * @return const CryptoPrimitiveId* pointer to the static instance or nullptr if the ID is not registered
+                 */
+                static const CryptoPrimitiveId* GetPrimitiveId (CryptoAlgId algId) noexcept;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_ALGORITHM_REGISTRY_H
@@ -0,0 +1,17 @@
+#include "ara/crypto/cryp/auth_cipher_ctx.h"
+
+#include "ara/crypto/cryp/internal/digest_check.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            ara::core::Result<bool> AuthCipherCtx::Check (ReadOnlyMemRegion expectedTag) const noexcept
+            {
+                return internal::CheckDigest(*this, expectedTag);
+            }
+        }
+    }
+}
@@ -2,6 +2,8 @@
 #define ARA_CRYPTO_CRYP_AUTH_CIPHER_CTX_H
 
 #include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
 #include "ara/crypto/cryp/digest_service.h"
 
@@ -56,6 +58,40 @@ namespace ara
                  */
                 virtual ara::core::Result<bool> Check (const Signature &expected) const noexcept=0;
 
+                /**
+                 * @brief Check the calculated digest against an expected tag value without materializing a
+                 * "signature" object. Entire digest value is kept in the context up to next call Start(), therefore
+                 * it can be verified again. The default implementation compares the digest copied by
+                 * GetDigest(ReadWriteMemRegion, std::size_t) into a stack buffer in constant time (see
+                 * internal::ConstantTimeEqual()), so a context gets it by providing that accessor.
+                 * @param[in] expectedTag the expected digest value
+                 * @return ara::core::Result<bool>
+                 * @retval true if the expected tag is identical to the calculated digest
+                 * @retval false otherwise (also if the sizes differ)
+                 * @retval CryptoErrorDomain::kProcessingNotFinished if the digest calculation was not finished by a call of the Finish() method
+                 * @retval CryptoErrorDomain::kUnsupported if the context provides no copy of the digest
+                 */
+                virtual ara::core::Result<bool> Check (ReadOnlyMemRegion expectedTag) const noexcept;
+
+                /**
+                 * @brief Copy requested part of calculated digest to a caller provided buffer, the non-template
+                 * counterpart of GetDigest(offset). If (full_digest_size <= offset) then return_size = 0 bytes; else
+                 * return_size = min(output.size(), (full_digest_size - offset)) bytes. The default implementation
+                 * reports kUnsupported; a context keeping the calculated tag should override it.
+                 * @param[out] output the output buffer
+                 * @param[in] offset position of the first byte of digest that should be placed to the output buffer
+                 * @return ara::core::Result<std::size_t> number of digest bytes really stored to the output buffer
+                 * @retval CryptoErrorDomain::kProcessingNotFinished if the digest calculation was not finished by a call of the Finish() method
+                 * @retval CryptoErrorDomain::kUsageViolation if the buffered digest belongs to a MAC/HMAC/AE/AEAD context initialized by a key without kAllowSignature permission
+                 * @retval CryptoErrorDomain::kUnsupported if the context does not implement this copy
+                 */
+                virtual ara::core::Result<std::size_t> GetDigest (ReadWriteMemRegion output, std::size_t offset=0) const noexcept
+                {
+                    static_cast<void>(output);
+                    static_cast<void>(offset);
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+
                 /**
                  * @brief [SWS_CRYPT_20102]
                  * Get DigestService instance.
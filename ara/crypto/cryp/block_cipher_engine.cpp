@@ -0,0 +1,78 @@
+#include "ara/crypto/cryp/block_cipher_engine.h"
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            std::size_t BlockCipherEngine::GetKeySize () const noexcept
+            {
+                switch (mAlgId)
+                {
+                case kAlgIdAes128Ecb:
+                    return 16u;
+                case kAlgIdAes256Ecb:
+                    return 32u;
+                default:
+                    return 0u;
+                }
+            }
+
+            ara::core::Result<CryptoTransform> BlockCipherEngine::GetTransformation () const noexcept
+            {
+                if (!mAes.IsKeySet())
+                {
+                    return ara::core::Result<CryptoTransform>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                return ara::core::Result<CryptoTransform>::FromValue(mTransform);
+            }
+
+            ara::core::Result<void> BlockCipherEngine::SetKey (ReadOnlyMemRegion key, CryptoTransform transform) noexcept
+            {
+                const std::size_t keySize = GetKeySize();
+                if (keySize == 0u)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if ((transform != CryptoTransform::kEncrypt) && (transform != CryptoTransform::kDecrypt))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                if ((key.size() != keySize) || !mAes.SetKey(key.data(), key.size()))
+                {
+                    mAes.Clear();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                mTransform = transform;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> BlockCipherEngine::ProcessBlocks (ReadWriteMemRegion inOut) const noexcept
+            {
+                if (!mAes.IsKeySet())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if ((inOut.size() % internal::Aes::kBlockSize) != 0u)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                const std::size_t blockCount = inOut.size() / internal::Aes::kBlockSize;
+                if (mTransform == CryptoTransform::kEncrypt)
+                {
+                    mAes.EncryptBlocks(inOut.data(), inOut.data(), blockCount);
+                }
+                else
+                {
+                    mAes.DecryptBlocks(inOut.data(), inOut.data(), blockCount);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef ARA_CRYPTO_CRYP_BLOCK_CIPHER_ENGINE_H
+#define ARA_CRYPTO_CRYP_BLOCK_CIPHER_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/aes.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief AES-128/ECB and AES-256/ECB block transformation with the operations of
+             * SymmetricBlockCipherCtx over a raw key. ProcessBlocks() runs the multi-block kernel of internal::Aes
+             * directly on the caller's buffer, which is what an AES block cipher context would override the copying
+             * default of SymmetricBlockCipherCtx::ProcessBlocks(ReadWriteMemRegion) with; this tree has no such
+             * context or SymmetricKey object, so the engine is used on raw buffers. A keyed engine is not modified
+             * by ProcessBlocks() and may be used concurrently.
+             */
+            class BlockCipherEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Block Cipher Engine object.
+                 * @param[in] algId kAlgIdAes128Ecb or kAlgIdAes256Ecb
+                 */
+                explicit BlockCipherEngine (CryptoAlgId algId) noexcept : mAlgId(algId), mTransform(CryptoTransform::kEncrypt)
+                {
+                }
+
+                BlockCipherEngine (const BlockCipherEngine &) = delete;
+                BlockCipherEngine& operator= (const BlockCipherEngine &) = delete;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept
+                {
+                    return GetKeySize() != 0u;
+                }
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Get the block size of the cipher in bytes.
+                 * @return std::size_t
+                 */
+                std::size_t GetBlockSize () const noexcept
+                {
+                    return internal::Aes::kBlockSize;
+                }
+
+                /**
+                 * @brief Get the kind of transformation configured by SetKey() (as
+                 * SymmetricBlockCipherCtx::GetTransformation()).
+                 * @return ara::core::Result<CryptoTransform> kEncrypt or kDecrypt
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is deployed
+                 */
+                ara::core::Result<CryptoTransform> GetTransformation () const noexcept;
+
+                /**
+                 * @brief Deploy a key and expand its schedule (as SymmetricBlockCipherCtx::SetKey()).
+                 * @param[in] key the key value
+                 * @param[in] transform kEncrypt or kDecrypt
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidArgument if the transform is neither kEncrypt nor kDecrypt
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the key size does not match the algorithm
+                 */
+                ara::core::Result<void> SetKey (ReadOnlyMemRegion key, CryptoTransform transform=CryptoTransform::kEncrypt) noexcept;
+
+                /**
+                 * @brief Encrypt or decrypt blocks in place (as SymmetricBlockCipherCtx::ProcessBlocks(ReadWriteMemRegion)).
+                 * No output buffer is allocated and nothing is copied.
+                 * @param[in,out] inOut the blocks, the size must be divisible by the block size
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the size is not divisible by the block size
+                 */
+                ara::core::Result<void> ProcessBlocks (ReadWriteMemRegion inOut) const noexcept;
+
+                /**
+                 * @brief Wipe the key schedule (as SymmetricBlockCipherCtx::Reset()).
+                 */
+                void Reset () noexcept
+                {
+                    mAes.Clear();
+                }
+
+            private:
+                std::size_t GetKeySize () const noexcept;
+
+                CryptoAlgId mAlgId;
+                CryptoTransform mTransform;
+                internal::Aes mAes;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_BLOCK_CIPHER_ENGINE_H
@@ -0,0 +1,20 @@
+#include "ara/crypto/cryp/common/entry_point.h"
+
+#include "ara/crypto/cryp/secure_counter.h"
+#include "ara/crypto/cryp/system_random.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        ara::core::Result<ara::core::Vector<ara::core::Byte> > GenerateRandomData (std::uint32_t count) noexcept
+        {
+            return cryp::SystemRandom::Generate(count);
+        }
+
+        ara::core::Result<SecureCounter> GetSecureCounter () noexcept
+        {
+            return cryp::SecureCounterStore::GetDefault().Next();
+        }
+    }
+}
@@ -0,0 +1,430 @@
+#ifndef ARA_CRYPTO_CRYP_CONTEXT_POOL_H
+#define ARA_CRYPTO_CRYP_CONTEXT_POOL_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+#include "ara/core/result.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/crypto_provider.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Binding of a context interface to the correspondent factory method of the Crypto Provider.
+             * @tparam Ctx the context interface
+             */
+            template <class Ctx>
+            struct ContextFactory;
+
+            template <>
+            struct ContextFactory<AuthCipherCtx>
+            {
+                static ara::core::Result<AuthCipherCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateAuthCipherCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<DecryptorPrivateCtx>
+            {
+                static ara::core::Result<DecryptorPrivateCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateDecryptorPrivateCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<EncryptorPublicCtx>
+            {
+                static ara::core::Result<EncryptorPublicCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateEncryptorPublicCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<HashFunctionCtx>
+            {
+                static ara::core::Result<HashFunctionCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateHashFunctionCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<KeyAgreementPrivateCtx>
+            {
+                static ara::core::Result<KeyAgreementPrivateCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateKeyAgreementPrivateCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<KeyDecapsulatorPrivateCtx>
+            {
+                static ara::core::Result<KeyDecapsulatorPrivateCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateKeyDecapsulatorPrivateCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<KeyDerivationFunctionCtx>
+            {
+                static ara::core::Result<KeyDerivationFunctionCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateKeyDerivationFunctionCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<KeyEncapsulatorPublicCtx>
+            {
+                static ara::core::Result<KeyEncapsulatorPublicCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateKeyEncapsulatorPublicCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<MessageAuthnCodeCtx>
+            {
+                static ara::core::Result<MessageAuthnCodeCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateMessageAuthCodeCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<MsgRecoveryPublicCtx>
+            {
+                static ara::core::Result<MsgRecoveryPublicCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateMsgRecoveryPublicCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<RandomGeneratorCtx>
+            {
+                static ara::core::Result<RandomGeneratorCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateRandomGeneratorCtx(algId, true);
+                }
+            };
+
+            template <>
+            struct ContextFactory<SigEncodePrivateCtx>
+            {
+                static ara::core::Result<SigEncodePrivateCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateSigEncodePrivateCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<SignerPrivateCtx>
+            {
+                static ara::core::Result<SignerPrivateCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateSignerPrivateCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<StreamCipherCtx>
+            {
+                static ara::core::Result<StreamCipherCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateStreamCipherCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<SymmetricBlockCipherCtx>
+            {
+                static ara::core::Result<SymmetricBlockCipherCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateSymmetricBlockCipherCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<SymmetricKeyWrapperCtx>
+            {
+                static ara::core::Result<SymmetricKeyWrapperCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateSymmetricKeyWrapperCtx(algId);
+                }
+            };
+
+            template <>
+            struct ContextFactory<VerifierPublicCtx>
+            {
+                static ara::core::Result<VerifierPublicCtx::Uptr> Create (CryptoProvider &provider, CryptoAlgId algId) noexcept
+                {
+                    return provider.CreateVerifierPublicCtx(algId);
+                }
+            };
+
+            /**
+             * @brief Pool of reusable crypto contexts of a single interface type. Contexts acquired from the pool
+             * are returned to it by the custom deleter of the smart pointer: the deleter clears the context by
+             * Reset() (contexts without the Reset() method are recycled as is, because their Start() reinitializes
+             * them completely) and puts it to a free list, so the next Acquire() of the same algorithm avoids the
+             * heap allocation and the algorithm initialization. Free lists are sharded by the calling thread, so
+             * threads normally don't contend for a single lock; an empty shard borrows a context from the other
+             * ones before a new context is created. The pool may be destroyed before the contexts acquired from
+             * it: such contexts are destroyed on their release then.
+             * @tparam Ctx the context interface (e.g. MessageAuthnCodeCtx or SymmetricBlockCipherCtx)
+             */
+            template <class Ctx>
+            class ContextPool
+            {
+            public:
+
+                /**
+                 * @brief Type definition of vendor specific binary Crypto Primitive ID.
+                 */
+                using AlgId = CryptoAlgId;
+
+                /**
+                 * @brief Callable object creating a new context of the specified algorithm.
+                 */
+                using Factory = std::function<ara::core::Result<typename Ctx::Uptr> (AlgId)>;
+
+                /**
+                 * @brief Default maximal number of idle contexts kept per algorithm and per free-list shard.
+                 */
+                static const std::size_t kDefaultMaxIdle = 8u;
+
+                /**
+                 * @brief Number of free-list shards.
+                 */
+                static const std::size_t kShardCount = 8u;
+
+            private:
+
+                struct Shard
+                {
+                    std::mutex mMutex;
+                    std::unordered_map<AlgId, ara::core::Vector<typename Ctx::Uptr> > mIdle;
+                };
+
+                struct Shared
+                {
+                    Factory mFactory;
+                    std::size_t mMaxIdle;
+                    std::array<Shard, kShardCount> mShards;
+                };
+
+            public:
+
+                /**
+                 * @brief Custom deleter that returns a context to its pool.
+                 */
+                class Recycler
+                {
+                public:
+
+                    Recycler () noexcept=default;
+
+                    Recycler (std::weak_ptr<Shared> shared, AlgId algId) noexcept
+                    : mShared(std::move(shared)),
+                      mAlgId(algId)
+                    {
+                    }
+
+                    void operator() (Ctx *ctx) const noexcept
+                    {
+                        typename Ctx::Uptr owned(ctx);
+                        std::shared_ptr<Shared> shared = mShared.lock();
+                        if (owned && shared && ClearForReuse(*owned))
+                        {
+                            Release(*shared, mAlgId, std::move(owned));
+                        }
+                    }
+
+                private:
+                    std::weak_ptr<Shared> mShared;
+                    AlgId mAlgId = kAlgIdUndefined;
+                };
+
+                /**
+                 * @brief Unique smart pointer to a pooled context.
+                 */
+                using Uptr = std::unique_ptr<Ctx, Recycler>;
+
+                /**
+                 * @brief Construct a pool of contexts created by a custom factory.
+                 * @param[in] factory the callable object creating new contexts
+                 * @param[in] maxIdle maximal number of idle contexts kept per algorithm and per free-list shard
+                 */
+                explicit ContextPool (Factory factory, std::size_t maxIdle=kDefaultMaxIdle) noexcept
+                : mShared(std::make_shared<Shared>())
+                {
+                    mShared->mFactory = std::move(factory);
+                    mShared->mMaxIdle = maxIdle;
+                }
+
+                /**
+                 * @brief Construct a pool of contexts created by the correspondent factory method of a Crypto
+                 * Provider. The provider must outlive the pool and all contexts acquired from it.
+                 * @param[in] provider the Crypto Provider creating new contexts
+                 * @param[in] maxIdle maximal number of idle contexts kept per algorithm and per free-list shard
+                 */
+                explicit ContextPool (CryptoProvider &provider, std::size_t maxIdle=kDefaultMaxIdle) noexcept
+                : ContextPool([&provider] (AlgId algId) { return ContextFactory<Ctx>::Create(provider, algId); }, maxIdle)
+                {
+                }
+
+                ContextPool (const ContextPool &other)=delete;
+                ContextPool& operator= (const ContextPool &other)=delete;
+
+                /**
+                 * @brief Acquire a clear context of the specified algorithm: a recycled one if available or a new one
+                 * otherwise.
+                 * @param[in] algId identifier of the target crypto algorithm
+                 * @return ara::core::Result<Uptr> unique smart pointer returning the context to this pool on its destruction
+                 * @exception any error returned by the factory (e.g. CryptoErrorDomain::kUnknownIdentifier)
+                 */
+                ara::core::Result<Uptr> Acquire (AlgId algId) noexcept
+                {
+                    const std::size_t home = HomeShard();
+                    for (std::size_t i = 0; i < kShardCount; ++i)
+                    {
+                        Shard &shard = mShared->mShards[(home + i) % kShardCount];
+                        std::lock_guard<std::mutex> lock(shard.mMutex);
+                        auto idle = shard.mIdle.find(algId);
+                        if ((idle != shard.mIdle.end()) && !idle->second.empty())
+                        {
+                            Uptr ctx(idle->second.back().release(), Recycler(mShared, algId));
+                            idle->second.pop_back();
+                            return ara::core::Result<Uptr>::FromValue(std::move(ctx));
+                        }
+                    }
+
+                    ara::core::Result<typename Ctx::Uptr> created = mShared->mFactory(algId);
+                    if (!created.HasValue())
+                    {
+                        return ara::core::Result<Uptr>::FromError(created.Error());
+                    }
+                    return ara::core::Result<Uptr>::FromValue(Uptr(std::move(created).Value().release(), Recycler(mShared, algId)));
+                }
+
+                /**
+                 * @brief Pre-create idle contexts of the specified algorithm (e.g. at start-up of a service), so the
+                 * first requests on the hot path are served without allocations. The contexts are distributed over
+                 * the free-list shards; a shard never keeps more than the maximal number of idle contexts.
+                 * @param[in] algId identifier of the target crypto algorithm
+                 * @param[in] count number of contexts to create
+                 * @return ara::core::Result<void>
+                 * @exception any error returned by the factory (e.g. CryptoErrorDomain::kUnknownIdentifier)
+                 */
+                ara::core::Result<void> Prewarm (AlgId algId, std::size_t count) noexcept
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        ara::core::Result<typename Ctx::Uptr> created = mShared->mFactory(algId);
+                        if (!created.HasValue())
+                        {
+                            return ara::core::Result<void>::FromError(created.Error());
+                        }
+                        Shard &shard = mShared->mShards[i % kShardCount];
+                        std::lock_guard<std::mutex> lock(shard.mMutex);
+                        ara::core::Vector<typename Ctx::Uptr> &idle = shard.mIdle[algId];
+                        if (idle.size() < mShared->mMaxIdle)
+                        {
+                            idle.push_back(std::move(created).Value());
+                        }
+                    }
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * @brief Count idle contexts of the specified algorithm kept by the pool.
+                 * @param[in] algId identifier of the target crypto algorithm
+                 * @return std::size_t number of idle contexts
+                 */
+                std::size_t CountIdle (AlgId algId) const noexcept
+                {
+                    std::size_t count = 0u;
+                    for (Shard &shard : mShared->mShards)
+                    {
+                        std::lock_guard<std::mutex> lock(shard.mMutex);
+                        auto idle = shard.mIdle.find(algId);
+                        count += (idle != shard.mIdle.end()) ? idle->second.size() : 0u;
+                    }
+                    return count;
+                }
+
+                /**
+                 * @brief Destroy all idle contexts.
+                 */
+                void Clear () noexcept
+                {
+                    for (Shard &shard : mShared->mShards)
+                    {
+                        std::lock_guard<std::mutex> lock(shard.mMutex);
+                        shard.mIdle.clear();
+                    }
+                }
+
+            private:
+
+                template <class C>
+                static auto ResetContext (C &ctx, int) noexcept -> decltype(ctx.Reset(), bool())
+                {
+                    // A context that was never initialized has nothing to clear, even if its Reset() refuses to run.
+                    return ctx.Reset().HasValue() || !ctx.IsInitialized();
+                }
+
+                template <class C>
+                static bool ResetContext (C &, long) noexcept
+                {
+                    return true;
+                }
+
+                static bool ClearForReuse (Ctx &ctx) noexcept
+                {
+                    return ResetContext(ctx, 0);
+                }
+
+                static void Release (Shared &shared, AlgId algId, typename Ctx::Uptr ctx) noexcept
+                {
+                    Shard &shard = shared.mShards[HomeShard()];
+                    std::lock_guard<std::mutex> lock(shard.mMutex);
+                    ara::core::Vector<typename Ctx::Uptr> &idle = shard.mIdle[algId];
+                    if (idle.size() < shared.mMaxIdle)
+                    {
+                        idle.push_back(std::move(ctx));
+                    }
+                }
+
+                static std::size_t HomeShard () noexcept
+                {
+                    static thread_local const std::size_t home = std::hash<std::thread::id>()(std::this_thread::get_id()) % kShardCount;
+                    return home;
+                }
+
+                std::shared_ptr<Shared> mShared;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_CONTEXT_POOL_H
@@ -81,6 +81,17 @@ namespace ara
                  * @return CryptoPrimitiveId& *this, containing the contents of other
                  */
                 CryptoPrimitiveId& operator= (const CryptoPrimitiveId &&other)/*=default*/;
+
+            protected:
+
+                /**
+                 * @brief Construct a new Crypto Primitive Id object
+                 * @param[in] primitiveName the unified name of the primitive; the referred string must outlive this instance
+                 */
+                explicit CryptoPrimitiveId (ara::core::StringView primitiveName=ara::core::StringView()) noexcept
+                : mPrimitiveName(primitiveName)
+                {
+                }
             };
         }
     }
@@ -4,6 +4,7 @@
 #include "ara/crypto/cryp/common/volatile_trusted_container.h"
 #include "ara/crypto/cryp/common/io_interface.h"
 #include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
 
 #include "ara/crypto/cryp/cryobj/crypto_primitive_id.h"
 #include "ara/crypto/cryp/cryobj/crypto_object.h"
@@ -28,6 +29,9 @@
 #include "ara/crypto/cryp/symmetric_block_cipher_ctx.h"
 #include "ara/crypto/cryp/verifier_public_ctx.h"
 
+#include "ara/crypto/cryp/public_key_cache.h"
+#include "ara/crypto/cryp/algorithm_registry.h"
+
 #include "ara/core/result.h"
 #include "ara/core/string.h"
 
@@ -100,7 +104,10 @@ namespace ara
                  * @param[in] primitiveName the unified name of the crypto primitive (see "Crypto Primitives Naming Convention" for more details)
                  * @return AlgId vendor specific binary algorithm ID or kAlgId Undefined if a primitive with provided name is not supported
                  */
-                virtual AlgId ConvertToAlgId (ara::core::StringView primitiveName) const noexcept=0;
+                virtual AlgId ConvertToAlgId (ara::core::StringView primitiveName) const noexcept/*=0;*/
+                {
+                    return AlgorithmRegistry::ToAlgId(primitiveName);
+                }
 
                 /**
                  * @brief [SWS_CRYPT_20712]
@@ -109,7 +116,15 @@ namespace ara
                  * @return ara::core::Result<ara::core::String> the common name of the crypto algorithm (see "Crypto Primitives Naming Convention" for more details)
                  * @exception CryptoErrorDomain::kUnknownIdentifier if algId argument has an unsupported value
                  */
-                virtual ara::core::Result<ara::core::String> ConvertToAlgName (AlgId algId) const noexcept=0;
+                virtual ara::core::Result<ara::core::String> ConvertToAlgName (AlgId algId) const noexcept/*=0;*/
+                {
+                    const ara::core::StringView name = AlgorithmRegistry::ToAlgName(algId);
+                    if (name.empty())
+                    {
+                        return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                    }
+                    return ara::core::Result<ara::core::String>::FromValue(ara::core::String(name.data(), name.size()));
+                }
 
                 /**
                  * @brief [SWS_CRYPT_20731]
@@ -525,6 +540,19 @@ namespace ara
                  */
                 virtual ara::core::Result<VerifierPublicCtx::Uptr> CreateVerifierPublicCtx (AlgId algId) noexcept=0;
 
+                /**
+                 * @brief Get the cache of prepared public-key states shared by the public key contexts of this
+                 * provider. A context implementation may look up a key in it on deployment, so the key decoding
+                 * and precomputation are done once per key (and algorithm) instead of once per context. The
+                 * default implementation returns a cache shared by all providers that don't override it.
+                 * @return PublicKeyCache& a reference to the cache
+                 */
+                virtual PublicKeyCache& GetPublicKeyCache () noexcept
+                {
+                    static PublicKeyCache cCache;
+                    return cCache;
+                }
+
                 /**
                  * @brief [SWS_CRYPT_30216]
                  * Copy-assign another CryptoProvider to this instance.
@@ -0,0 +1,175 @@
+#include "ara/crypto/cryp/ecdh_engine.h"
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/curve25519.h"
+#include "ara/crypto/cryp/internal/p256.h"
+#include "ara/crypto/cryp/system_random.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // Maximal number of attempts to draw a P-256 scalar in [1, n - 1], the probability of a single
+                // failure is below 2^-32.
+                const std::size_t kMaxAttempts = 16u;
+
+                const std::size_t kMaxSecretSize = 32u;
+
+                void Wipe (void *data, std::size_t size) noexcept
+                {
+                    volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        bytes[i] = 0u;
+                    }
+                }
+            }
+
+            EcdhEngine::EcdhEngine (CryptoAlgId algId) noexcept : mAlgId(algId)
+            {
+            }
+
+            bool EcdhEngine::IsSupported () const noexcept
+            {
+                return (mAlgId == kAlgIdX25519) || (mAlgId == kAlgIdEcdhP256);
+            }
+
+            std::size_t EcdhEngine::GetPrivateKeySize () const noexcept
+            {
+                return (mAlgId == kAlgIdX25519) ? internal::X25519::kKeySize : internal::P256::kScalarSize;
+            }
+
+            std::size_t EcdhEngine::GetPublicKeySize () const noexcept
+            {
+                return (mAlgId == kAlgIdX25519) ? internal::X25519::kKeySize : internal::P256::kPublicKeySize;
+            }
+
+            std::size_t EcdhEngine::GetSharedSecretSize () const noexcept
+            {
+                return (mAlgId == kAlgIdX25519) ? internal::X25519::kKeySize : internal::P256::kScalarSize;
+            }
+
+            ara::core::Result<void> EcdhEngine::GenerateKeyPair (ReadWriteMemRegion privateKey, ReadWriteMemRegion publicKey) const noexcept
+            {
+                if (!IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if ((privateKey.size() < GetPrivateKeySize()) || (publicKey.size() < GetPublicKeySize()))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                const ReadWriteMemRegion scalar(privateKey.data(), GetPrivateKeySize());
+                for (std::size_t attempt = 0; attempt < kMaxAttempts; ++attempt)
+                {
+                    ara::core::Result<void> filled = SystemRandom::Fill(scalar);
+                    if (!filled.HasValue())
+                    {
+                        return filled;
+                    }
+
+                    if (mAlgId == kAlgIdX25519)
+                    {
+                        internal::X25519::ComputePublicKey(scalar.data(), publicKey.data());
+                        return ara::core::Result<void>::FromValue();
+                    }
+                    if (internal::P256::ComputePublicKey(scalar.data(), publicKey.data()))
+                    {
+                        return ara::core::Result<void>::FromValue();
+                    }
+                }
+
+                Wipe(scalar.data(), scalar.size());
+                return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+            }
+
+            ara::core::Result<void> EcdhEngine::ComputePublicKey (ReadOnlyMemRegion privateKey, ReadWriteMemRegion publicKey) const noexcept
+            {
+                if (!IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (privateKey.size() != GetPrivateKeySize())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                if (publicKey.size() < GetPublicKeySize())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                if (mAlgId == kAlgIdX25519)
+                {
+                    internal::X25519::ComputePublicKey(privateKey.data(), publicKey.data());
+                }
+                else if (!internal::P256::ComputePublicKey(privateKey.data(), publicKey.data()))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> EcdhEngine::Agree (ReadOnlyMemRegion privateKey, ReadOnlyMemRegion peerPublicKey, ReadWriteMemRegion sharedSecret) const noexcept
+            {
+                if (IsSupported() && (sharedSecret.size() < GetSharedSecretSize()))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+                return Compute(privateKey, peerPublicKey, sharedSecret.data());
+            }
+
+            ara::core::Result<void> EcdhEngine::AgreeAndDerive (ReadOnlyMemRegion privateKey, ReadOnlyMemRegion peerPublicKey, internal::HmacKdf &kdf, ReadOnlyMemRegion salt) const noexcept
+            {
+                if (!kdf.IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+
+                std::uint8_t secret[kMaxSecretSize];
+                ara::core::Result<void> computed = Compute(privateKey, peerPublicKey, secret);
+                if (computed.HasValue())
+                {
+                    kdf.SetSourceKeyMaterial(secret, GetSharedSecretSize(), salt.data(), salt.size());
+                }
+                Wipe(secret, sizeof(secret));
+                return computed;
+            }
+
+            ara::core::Result<void> EcdhEngine::Compute (ReadOnlyMemRegion privateKey, ReadOnlyMemRegion peerPublicKey, std::uint8_t *sharedSecret) const noexcept
+            {
+                if (!IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (privateKey.size() != GetPrivateKeySize())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                bool agreed;
+                if (mAlgId == kAlgIdX25519)
+                {
+                    agreed = (peerPublicKey.size() == internal::X25519::kKeySize) &&
+                        internal::X25519::Agree(privateKey.data(), peerPublicKey.data(), sharedSecret);
+                }
+                else
+                {
+                    agreed = internal::P256::Agree(privateKey.data(), peerPublicKey.data(), peerPublicKey.size(), sharedSecret);
+                }
+
+                if (!agreed)
+                {
+                    Wipe(sharedSecret, GetSharedSecretSize());
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef ARA_CRYPTO_CRYP_ECDH_ENGINE_H
+#define ARA_CRYPTO_CRYP_ECDH_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/hmac_kdf.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Elliptic curve Diffie-Hellman engine: X25519 (RFC 7748) and ECDH over NIST P-256 (the shared
+             * secret is the x-coordinate, SEC 1). The public keys are computed by fixed-base combs, the shared
+             * secrets by constant-time variable-base multiplications. The engine keeps no state besides the
+             * algorithm, so one object may be used concurrently. It is written for a KeyAgreementPrivateCtx and
+             * the key pair generation of a Crypto Provider; the tree implements neither, so it is called with
+             * raw key bytes.
+             */
+            class EcdhEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Ecdh Engine object.
+                 * @param[in] algId kAlgIdX25519 or kAlgIdEcdhP256
+                 */
+                explicit EcdhEngine (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept;
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Get the size of a private key in bytes.
+                 * @return std::size_t
+                 */
+                std::size_t GetPrivateKeySize () const noexcept;
+
+                /**
+                 * @brief Get the size of a public key produced by the engine in bytes (the uncompressed point for
+                 * P-256).
+                 * @return std::size_t
+                 */
+                std::size_t GetPublicKeySize () const noexcept;
+
+                /**
+                 * @brief Get the size of a shared secret in bytes.
+                 * @return std::size_t
+                 */
+                std::size_t GetSharedSecretSize () const noexcept;
+
+                /**
+                 * @brief Generate a new key pair by the system random generator.
+                 * @param[out] privateKey the buffer for the private key of GetPrivateKeySize() bytes
+                 * @param[out] publicKey the buffer for the public key of GetPublicKeySize() bytes
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if a buffer is too small
+                 * @exception CryptoErrorDomain::kBusyResource if the random generator failed
+                 */
+                ara::core::Result<void> GenerateKeyPair (ReadWriteMemRegion privateKey, ReadWriteMemRegion publicKey) const noexcept;
+
+                /**
+                 * @brief Compute the public key of a private key.
+                 * @param[in] privateKey the private key of GetPrivateKeySize() bytes
+                 * @param[out] publicKey the buffer for the public key of GetPublicKeySize() bytes
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the private key has a wrong size
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the publicKey buffer is too small
+                 * @exception CryptoErrorDomain::kInvalidArgument if the private key is out of range
+                 */
+                ara::core::Result<void> ComputePublicKey (ReadOnlyMemRegion privateKey, ReadWriteMemRegion publicKey) const noexcept;
+
+                /**
+                 * @brief Compute the shared secret.
+                 * @param[in] privateKey the own private key of GetPrivateKeySize() bytes
+                 * @param[in] peerPublicKey the public key of the other side (the compressed point is accepted too)
+                 * @param[out] sharedSecret the buffer for the shared secret of GetSharedSecretSize() bytes
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the private key has a wrong size
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the sharedSecret buffer is too small
+                 * @exception CryptoErrorDomain::kInvalidArgument if a key is invalid or the shared secret is degenerate
+                 */
+                ara::core::Result<void> Agree (ReadOnlyMemRegion privateKey, ReadOnlyMemRegion peerPublicKey, ReadWriteMemRegion sharedSecret) const noexcept;
+
+                /**
+                 * @brief Compute the shared secret and use it as the source key material of a key derivation
+                 * function. The shared secret is wiped before the method returns and never leaves the engine.
+                 * @param[in] privateKey the own private key of GetPrivateKeySize() bytes
+                 * @param[in] peerPublicKey the public key of the other side
+                 * @param[in,out] kdf the key derivation function to be keyed
+                 * @param[in] salt the optional salt of the KDF (used by HKDF)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm or the KDF is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the private key has a wrong size
+                 * @exception CryptoErrorDomain::kInvalidArgument if a key is invalid or the shared secret is degenerate
+                 */
+                ara::core::Result<void> AgreeAndDerive (ReadOnlyMemRegion privateKey, ReadOnlyMemRegion peerPublicKey, internal::HmacKdf &kdf, ReadOnlyMemRegion salt=ReadOnlyMemRegion()) const noexcept;
+
+            private:
+                ara::core::Result<void> Compute (ReadOnlyMemRegion privateKey, ReadOnlyMemRegion peerPublicKey, std::uint8_t *sharedSecret) const noexcept;
+
+                CryptoAlgId mAlgId;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_ECDH_ENGINE_H
@@ -0,0 +1,805 @@
+#include "ara/crypto/cryp/internal/aes.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARA_CRYPTO_AES_NI 1
+#include <immintrin.h>
+#define ARA_CRYPTO_AES_NI_TARGET __attribute__((target("aes,sse2")))
+#endif
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    // Transpose the 8x8 bit matrix whose row i is the byte i of the little-endian value: bit j
+                    // of byte i moves to bit i of byte j.
+                    inline std::uint64_t Transpose8x8 (std::uint64_t value) noexcept
+                    {
+                        std::uint64_t swap = (value ^ (value >> 7)) & 0x00aa00aa00aa00aaull;
+                        value ^= swap ^ (swap << 7);
+                        swap = (value ^ (value >> 14)) & 0x0000cccc0000ccccull;
+                        value ^= swap ^ (swap << 14);
+                        swap = (value ^ (value >> 28)) & 0x00000000f0f0f0f0ull;
+                        value ^= swap ^ (swap << 28);
+                        return value;
+                    }
+
+                    // Split 16 bytes into 8 bit planes: bit i of plane b is the bit b of byte i.
+                    inline void ToPlanes (const std::uint8_t *bytes, std::uint32_t planes[8]) noexcept
+                    {
+                        std::uint64_t halves[2] = {0u, 0u};
+                        for (std::size_t i = 0; i < 16u; ++i)
+                        {
+                            halves[i / 8u] |= static_cast<std::uint64_t>(bytes[i]) << (8u * (i % 8u));
+                        }
+                        const std::uint64_t low = Transpose8x8(halves[0]);
+                        const std::uint64_t high = Transpose8x8(halves[1]);
+                        for (std::size_t b = 0; b < 8u; ++b)
+                        {
+                            planes[b] = static_cast<std::uint32_t>(((low >> (8u * b)) & 0xffu) | (((high >> (8u * b)) & 0xffu) << 8));
+                        }
+                    }
+
+                    inline void FromPlanes (const std::uint32_t planes[8], std::uint8_t *bytes) noexcept
+                    {
+                        std::uint64_t low = 0u;
+                        std::uint64_t high = 0u;
+                        for (std::size_t b = 0; b < 8u; ++b)
+                        {
+                            low |= static_cast<std::uint64_t>(planes[b] & 0xffu) << (8u * b);
+                            high |= static_cast<std::uint64_t>((planes[b] >> 8) & 0xffu) << (8u * b);
+                        }
+                        low = Transpose8x8(low);
+                        high = Transpose8x8(high);
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            bytes[i] = static_cast<std::uint8_t>(low >> (8u * i));
+                            bytes[i + 8u] = static_cast<std::uint8_t>(high >> (8u * i));
+                        }
+                    }
+
+                    // The S-box circuit of Boyar and Peralta ("A new combinational logic minimization technique
+                    // with applications to cryptology", 2009) evaluated on bit planes, so the S-box costs the same
+                    // logical operations for any input and reads no table indexed by secret data. x0 is the most
+                    // significant bit (plane 7).
+                    void SBoxPlanes (std::uint32_t q[8]) noexcept
+                    {
+                        const std::uint32_t x0 = q[7];
+                        const std::uint32_t x1 = q[6];
+                        const std::uint32_t x2 = q[5];
+                        const std::uint32_t x3 = q[4];
+                        const std::uint32_t x4 = q[3];
+                        const std::uint32_t x5 = q[2];
+                        const std::uint32_t x6 = q[1];
+                        const std::uint32_t x7 = q[0];
+
+                        // Top linear transformation.
+                        const std::uint32_t y14 = x3 ^ x5;
+                        const std::uint32_t y13 = x0 ^ x6;
+                        const std::uint32_t y9 = x0 ^ x3;
+                        const std::uint32_t y8 = x0 ^ x5;
+                        const std::uint32_t t0 = x1 ^ x2;
+                        const std::uint32_t y1 = t0 ^ x7;
+                        const std::uint32_t y4 = y1 ^ x3;
+                        const std::uint32_t y12 = y13 ^ y14;
+                        const std::uint32_t y2 = y1 ^ x0;
+                        const std::uint32_t y5 = y1 ^ x6;
+                        const std::uint32_t y3 = y5 ^ y8;
+                        const std::uint32_t t1 = x4 ^ y12;
+                        const std::uint32_t y15 = t1 ^ x5;
+                        const std::uint32_t y20 = t1 ^ x1;
+                        const std::uint32_t y6 = y15 ^ x7;
+                        const std::uint32_t y10 = y15 ^ t0;
+                        const std::uint32_t y11 = y20 ^ y9;
+                        const std::uint32_t y7 = x7 ^ y11;
+                        const std::uint32_t y17 = y10 ^ y11;
+                        const std::uint32_t y19 = y10 ^ y8;
+                        const std::uint32_t y16 = t0 ^ y11;
+                        const std::uint32_t y21 = y13 ^ y16;
+                        const std::uint32_t y18 = x0 ^ y16;
+
+                        // Non-linear section: the inversion in GF(2^4)^2.
+                        const std::uint32_t t2 = y12 & y15;
+                        const std::uint32_t t3 = y3 & y6;
+                        const std::uint32_t t4 = t3 ^ t2;
+                        const std::uint32_t t5 = y4 & x7;
+                        const std::uint32_t t6 = t5 ^ t2;
+                        const std::uint32_t t7 = y13 & y16;
+                        const std::uint32_t t8 = y5 & y1;
+                        const std::uint32_t t9 = t8 ^ t7;
+                        const std::uint32_t t10 = y2 & y7;
+                        const std::uint32_t t11 = t10 ^ t7;
+                        const std::uint32_t t12 = y9 & y11;
+                        const std::uint32_t t13 = y14 & y17;
+                        const std::uint32_t t14 = t13 ^ t12;
+                        const std::uint32_t t15 = y8 & y10;
+                        const std::uint32_t t16 = t15 ^ t12;
+                        const std::uint32_t t17 = t4 ^ t14;
+                        const std::uint32_t t18 = t6 ^ t16;
+                        const std::uint32_t t19 = t9 ^ t14;
+                        const std::uint32_t t20 = t11 ^ t16;
+                        const std::uint32_t t21 = t17 ^ y20;
+                        const std::uint32_t t22 = t18 ^ y19;
+                        const std::uint32_t t23 = t19 ^ y21;
+                        const std::uint32_t t24 = t20 ^ y18;
+
+                        const std::uint32_t t25 = t21 ^ t22;
+                        const std::uint32_t t26 = t21 & t23;
+                        const std::uint32_t t27 = t24 ^ t26;
+                        const std::uint32_t t28 = t25 & t27;
+                        const std::uint32_t t29 = t28 ^ t22;
+                        const std::uint32_t t30 = t23 ^ t24;
+                        const std::uint32_t t31 = t22 ^ t26;
+                        const std::uint32_t t32 = t31 & t30;
+                        const std::uint32_t t33 = t32 ^ t24;
+                        const std::uint32_t t34 = t23 ^ t33;
+                        const std::uint32_t t35 = t27 ^ t33;
+                        const std::uint32_t t36 = t24 & t35;
+                        const std::uint32_t t37 = t36 ^ t34;
+                        const std::uint32_t t38 = t27 ^ t36;
+                        const std::uint32_t t39 = t29 & t38;
+                        const std::uint32_t t40 = t25 ^ t39;
+
+                        const std::uint32_t t41 = t40 ^ t37;
+                        const std::uint32_t t42 = t29 ^ t33;
+                        const std::uint32_t t43 = t29 ^ t40;
+                        const std::uint32_t t44 = t33 ^ t37;
+                        const std::uint32_t t45 = t42 ^ t41;
+                        const std::uint32_t z0 = t44 & y15;
+                        const std::uint32_t z1 = t37 & y6;
+                        const std::uint32_t z2 = t33 & x7;
+                        const std::uint32_t z3 = t43 & y16;
+                        const std::uint32_t z4 = t40 & y1;
+                        const std::uint32_t z5 = t29 & y7;
+                        const std::uint32_t z6 = t42 & y11;
+                        const std::uint32_t z7 = t45 & y17;
+                        const std::uint32_t z8 = t41 & y10;
+                        const std::uint32_t z9 = t44 & y12;
+                        const std::uint32_t z10 = t37 & y3;
+                        const std::uint32_t z11 = t33 & y4;
+                        const std::uint32_t z12 = t43 & y13;
+                        const std::uint32_t z13 = t40 & y5;
+                        const std::uint32_t z14 = t29 & y2;
+                        const std::uint32_t z15 = t42 & y9;
+                        const std::uint32_t z16 = t45 & y14;
+                        const std::uint32_t z17 = t41 & y8;
+
+                        // Bottom linear transformation.
+                        const std::uint32_t t46 = z15 ^ z16;
+                        const std::uint32_t t47 = z10 ^ z11;
+                        const std::uint32_t t48 = z5 ^ z13;
+                        const std::uint32_t t49 = z9 ^ z10;
+                        const std::uint32_t t50 = z2 ^ z12;
+                        const std::uint32_t t51 = z2 ^ z5;
+                        const std::uint32_t t52 = z7 ^ z8;
+                        const std::uint32_t t53 = z0 ^ z3;
+                        const std::uint32_t t54 = z6 ^ z7;
+                        const std::uint32_t t55 = z16 ^ z17;
+                        const std::uint32_t t56 = z12 ^ t48;
+                        const std::uint32_t t57 = t50 ^ t53;
+                        const std::uint32_t t58 = z4 ^ t46;
+                        const std::uint32_t t59 = z3 ^ t54;
+                        const std::uint32_t t60 = t46 ^ t57;
+                        const std::uint32_t t61 = z14 ^ t57;
+                        const std::uint32_t t62 = t52 ^ t58;
+                        const std::uint32_t t63 = t49 ^ t58;
+                        const std::uint32_t t64 = z4 ^ t59;
+                        const std::uint32_t t65 = t61 ^ t62;
+                        const std::uint32_t t66 = z1 ^ t63;
+                        const std::uint32_t t67 = t64 ^ t65;
+                        const std::uint32_t s3 = t53 ^ t66;
+
+                        q[7] = t59 ^ t63;
+                        q[6] = t64 ^ ~s3;
+                        q[5] = t55 ^ ~t67;
+                        q[4] = s3;
+                        q[3] = t51 ^ t66;
+                        q[2] = t47 ^ t65;
+                        q[1] = t56 ^ ~t62;
+                        q[0] = t48 ^ ~t60;
+                    }
+
+                    // The inverse of the affine transformation of the S-box, including its constant 0x63:
+                    // InvSBox(x) = B(SBox(B(x))).
+                    void InverseAffinePlanes (std::uint32_t q[8]) noexcept
+                    {
+                        const std::uint32_t q0 = ~q[0];
+                        const std::uint32_t q1 = ~q[1];
+                        const std::uint32_t q2 = q[2];
+                        const std::uint32_t q3 = q[3];
+                        const std::uint32_t q4 = q[4];
+                        const std::uint32_t q5 = ~q[5];
+                        const std::uint32_t q6 = ~q[6];
+                        const std::uint32_t q7 = q[7];
+                        q[7] = q1 ^ q4 ^ q6;
+                        q[6] = q0 ^ q3 ^ q5;
+                        q[5] = q7 ^ q2 ^ q4;
+                        q[4] = q6 ^ q1 ^ q3;
+                        q[3] = q5 ^ q0 ^ q2;
+                        q[2] = q4 ^ q7 ^ q1;
+                        q[1] = q3 ^ q6 ^ q0;
+                        q[0] = q2 ^ q5 ^ q7;
+                    }
+
+                    // Apply the S-box to 16 bytes in place.
+                    void SubBytes (std::uint8_t *bytes) noexcept
+                    {
+                        std::uint32_t planes[8];
+                        ToPlanes(bytes, planes);
+                        SBoxPlanes(planes);
+                        FromPlanes(planes, bytes);
+                    }
+
+                    // Apply the inverse S-box to 16 bytes in place.
+                    void InvSubBytes (std::uint8_t *bytes) noexcept
+                    {
+                        std::uint32_t planes[8];
+                        ToPlanes(bytes, planes);
+                        InverseAffinePlanes(planes);
+                        SBoxPlanes(planes);
+                        InverseAffinePlanes(planes);
+                        FromPlanes(planes, bytes);
+                    }
+
+                    inline std::uint8_t XTime (std::uint8_t value) noexcept
+                    {
+                        return static_cast<std::uint8_t>((value << 1) ^ (0x1Bu & (0u - (value >> 7))));
+                    }
+
+                    inline std::uint8_t Multiply (std::uint8_t value, std::uint8_t factor) noexcept
+                    {
+                        std::uint8_t result = 0u;
+                        while (factor != 0u)
+                        {
+                            if (factor & 1u)
+                            {
+                                result ^= value;
+                            }
+                            value = XTime(value);
+                            factor >>= 1;
+                        }
+                        return result;
+                    }
+
+                    inline void XorBlock (std::uint8_t *out, const std::uint8_t *lhs, const std::uint8_t *rhs) noexcept
+                    {
+                        for (std::size_t i = 0; i < Aes::kBlockSize; ++i)
+                        {
+                            out[i] = lhs[i] ^ rhs[i];
+                        }
+                    }
+
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+#ifdef ARA_CRYPTO_AES_NI
+                    // Number of blocks processed in parallel: 8 blocks keep the AES unit busy while a round of
+                    // the first block is still in flight, and together with a round key they fit into 16 XMM registers.
+                    const std::size_t kLanes = 8u;
+
+                    bool IsAesNiSupported () noexcept
+                    {
+                        static const bool cSupported = __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse2");
+                        return cSupported;
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void ExpandDecKeysNi (const std::uint8_t *encKeys, std::uint8_t *decKeys, std::size_t rounds) noexcept
+                    {
+                        const __m128i *ek = reinterpret_cast<const __m128i*>(encKeys);
+                        __m128i *dk = reinterpret_cast<__m128i*>(decKeys);
+                        dk[0] = ek[rounds];
+                        for (std::size_t i = 1; i < rounds; ++i)
+                        {
+                            dk[i] = _mm_aesimc_si128(ek[rounds - i]);
+                        }
+                        dk[rounds] = ek[0];
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    inline __m128i EncryptNi (__m128i block, const __m128i *rk, std::size_t rounds) noexcept
+                    {
+                        block = _mm_xor_si128(block, rk[0]);
+                        for (std::size_t r = 1; r < rounds; ++r)
+                        {
+                            block = _mm_aesenc_si128(block, rk[r]);
+                        }
+                        return _mm_aesenclast_si128(block, rk[rounds]);
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    inline __m128i DecryptNi (__m128i block, const __m128i *rk, std::size_t rounds) noexcept
+                    {
+                        block = _mm_xor_si128(block, rk[0]);
+                        for (std::size_t r = 1; r < rounds; ++r)
+                        {
+                            block = _mm_aesdec_si128(block, rk[r]);
+                        }
+                        return _mm_aesdeclast_si128(block, rk[rounds]);
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    inline void EncryptLanesNi (__m128i (&blocks)[kLanes], const __m128i *rk, std::size_t rounds) noexcept
+                    {
+                        for (std::size_t i = 0; i < kLanes; ++i)
+                        {
+                            blocks[i] = _mm_xor_si128(blocks[i], rk[0]);
+                        }
+                        for (std::size_t r = 1; r < rounds; ++r)
+                        {
+                            const __m128i key = rk[r];
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                blocks[i] = _mm_aesenc_si128(blocks[i], key);
+                            }
+                        }
+                        for (std::size_t i = 0; i < kLanes; ++i)
+                        {
+                            blocks[i] = _mm_aesenclast_si128(blocks[i], rk[rounds]);
+                        }
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    inline void DecryptLanesNi (__m128i (&blocks)[kLanes], const __m128i *rk, std::size_t rounds) noexcept
+                    {
+                        for (std::size_t i = 0; i < kLanes; ++i)
+                        {
+                            blocks[i] = _mm_xor_si128(blocks[i], rk[0]);
+                        }
+                        for (std::size_t r = 1; r < rounds; ++r)
+                        {
+                            const __m128i key = rk[r];
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                blocks[i] = _mm_aesdec_si128(blocks[i], key);
+                            }
+                        }
+                        for (std::size_t i = 0; i < kLanes; ++i)
+                        {
+                            blocks[i] = _mm_aesdeclast_si128(blocks[i], rk[rounds]);
+                        }
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void EncryptBlocksNi (const std::uint8_t *keys, std::size_t rounds, const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) noexcept
+                    {
+                        const __m128i *rk = reinterpret_cast<const __m128i*>(keys);
+                        for (; blockCount >= kLanes; blockCount -= kLanes, in += kLanes * Aes::kBlockSize, out += kLanes * Aes::kBlockSize)
+                        {
+                            __m128i blocks[kLanes];
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * Aes::kBlockSize));
+                            }
+                            EncryptLanesNi(blocks, rk, rounds);
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * Aes::kBlockSize), blocks[i]);
+                            }
+                        }
+                        for (; blockCount > 0u; --blockCount, in += Aes::kBlockSize, out += Aes::kBlockSize)
+                        {
+                            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), EncryptNi(block, rk, rounds));
+                        }
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void DecryptBlocksNi (const std::uint8_t *keys, std::size_t rounds, const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) noexcept
+                    {
+                        const __m128i *rk = reinterpret_cast<const __m128i*>(keys);
+                        for (; blockCount >= kLanes; blockCount -= kLanes, in += kLanes * Aes::kBlockSize, out += kLanes * Aes::kBlockSize)
+                        {
+                            __m128i blocks[kLanes];
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * Aes::kBlockSize));
+                            }
+                            DecryptLanesNi(blocks, rk, rounds);
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * Aes::kBlockSize), blocks[i]);
+                            }
+                        }
+                        for (; blockCount > 0u; --blockCount, in += Aes::kBlockSize, out += Aes::kBlockSize)
+                        {
+                            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), DecryptNi(block, rk, rounds));
+                        }
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void EncryptCbcNi (const std::uint8_t *keys, std::size_t rounds, std::uint8_t *iv, const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) noexcept
+                    {
+                        const __m128i *rk = reinterpret_cast<const __m128i*>(keys);
+                        __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+                        for (; blockCount > 0u; --blockCount, in += Aes::kBlockSize, out += Aes::kBlockSize)
+                        {
+                            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            chain = EncryptNi(_mm_xor_si128(block, chain), rk, rounds);
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chain);
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), chain);
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void MacCbcNi (const std::uint8_t *keys, std::size_t rounds, std::uint8_t *state, const std::uint8_t *in, std::size_t blockCount) noexcept
+                    {
+                        const __m128i *rk = reinterpret_cast<const __m128i*>(keys);
+                        __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+                        for (; blockCount > 0u; --blockCount, in += Aes::kBlockSize)
+                        {
+                            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            chain = EncryptNi(_mm_xor_si128(block, chain), rk, rounds);
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), chain);
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void DecryptCbcNi (const std::uint8_t *keys, std::size_t rounds, std::uint8_t *iv, const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) noexcept
+                    {
+                        const __m128i *rk = reinterpret_cast<const __m128i*>(keys);
+                        __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+                        for (; blockCount >= kLanes; blockCount -= kLanes, in += kLanes * Aes::kBlockSize, out += kLanes * Aes::kBlockSize)
+                        {
+                            // All ciphertext blocks are loaded before any store, so in == out is safe.
+                            __m128i cipher[kLanes];
+                            __m128i blocks[kLanes];
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                cipher[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * Aes::kBlockSize));
+                                blocks[i] = cipher[i];
+                            }
+                            DecryptLanesNi(blocks, rk, rounds);
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(blocks[0], chain));
+                            for (std::size_t i = 1; i < kLanes; ++i)
+                            {
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * Aes::kBlockSize), _mm_xor_si128(blocks[i], cipher[i - 1u]));
+                            }
+                            chain = cipher[kLanes - 1u];
+                        }
+                        for (; blockCount > 0u; --blockCount, in += Aes::kBlockSize, out += Aes::kBlockSize)
+                        {
+                            const __m128i cipher = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(DecryptNi(cipher, rk, rounds), chain));
+                            chain = cipher;
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), chain);
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    inline __m128i NextCounterNi (std::uint64_t &high, std::uint64_t &low) noexcept
+                    {
+                        const __m128i block = _mm_set_epi64x(static_cast<long long>(__builtin_bswap64(low)), static_cast<long long>(__builtin_bswap64(high)));
+                        if (++low == 0u)
+                        {
+                            ++high;
+                        }
+                        return block;
+                    }
+
+                    ARA_CRYPTO_AES_NI_TARGET
+                    void XorCtrNi (const std::uint8_t *keys, std::size_t rounds, std::uint8_t *counter, const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) noexcept
+                    {
+                        const __m128i *rk = reinterpret_cast<const __m128i*>(keys);
+                        std::uint64_t high = 0u;
+                        std::uint64_t low = 0u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            high = (high << 8) | counter[i];
+                            low = (low << 8) | counter[8u + i];
+                        }
+
+                        for (; blockCount >= kLanes; blockCount -= kLanes, in += kLanes * Aes::kBlockSize, out += kLanes * Aes::kBlockSize)
+                        {
+                            __m128i blocks[kLanes];
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                blocks[i] = NextCounterNi(high, low);
+                            }
+                            EncryptLanesNi(blocks, rk, rounds);
+                            for (std::size_t i = 0; i < kLanes; ++i)
+                            {
+                                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * Aes::kBlockSize));
+                                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * Aes::kBlockSize), _mm_xor_si128(data, blocks[i]));
+                            }
+                        }
+                        for (; blockCount > 0u; --blockCount, in += Aes::kBlockSize, out += Aes::kBlockSize)
+                        {
+                            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(data, EncryptNi(NextCounterNi(high, low), rk, rounds)));
+                        }
+
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            counter[7u - i] = static_cast<std::uint8_t>(high >> (8u * i));
+                            counter[15u - i] = static_cast<std::uint8_t>(low >> (8u * i));
+                        }
+                    }
+#endif
+                }
+
+                Aes::Aes () noexcept
+                : mEncKeys(),
+                  mDecKeys(),
+                  mRounds(0u),
+                  mAccelerated(false)
+                {
+                }
+
+                Aes::~Aes () noexcept
+                {
+                    Clear();
+                }
+
+                bool Aes::SetKey (const std::uint8_t *key, std::size_t keySize) noexcept
+                {
+                    if ((keySize != 16u) && (keySize != 24u) && (keySize != 32u))
+                    {
+                        return false;
+                    }
+
+                    const std::size_t keyWords = keySize / 4u;
+                    const std::size_t rounds = keyWords + 6u;
+                    const std::size_t totalWords = 4u * (rounds + 1u);
+
+                    std::memcpy(mEncKeys, key, keySize);
+                    std::uint8_t rcon = 0x01u;
+                    for (std::size_t i = keyWords; i < totalWords; ++i)
+                    {
+                        // SubWord() runs through the bitsliced S-box, the remaining lanes are unused.
+                        std::uint8_t temp[kBlockSize] = {};
+                        std::memcpy(temp, &mEncKeys[4u * (i - 1u)], 4u);
+                        if ((i % keyWords) == 0u)
+                        {
+                            const std::uint8_t first = temp[0];
+                            temp[0] = temp[1];
+                            temp[1] = temp[2];
+                            temp[2] = temp[3];
+                            temp[3] = first;
+                            SubBytes(temp);
+                            temp[0] = static_cast<std::uint8_t>(temp[0] ^ rcon);
+                            rcon = XTime(rcon);
+                        }
+                        else if ((keyWords > 6u) && ((i % keyWords) == 4u))
+                        {
+                            SubBytes(temp);
+                        }
+                        for (std::size_t j = 0; j < 4u; ++j)
+                        {
+                            mEncKeys[4u * i + j] = static_cast<std::uint8_t>(mEncKeys[4u * (i - keyWords) + j] ^ temp[j]);
+                        }
+                        SecureWipe(temp, sizeof(temp));
+                    }
+                    mRounds = rounds;
+
+#ifdef ARA_CRYPTO_AES_NI
+                    mAccelerated = IsAesNiSupported();
+                    if (mAccelerated)
+                    {
+                        ExpandDecKeysNi(mEncKeys, mDecKeys, mRounds);
+                    }
+#endif
+                    return true;
+                }
+
+                void Aes::Clear () noexcept
+                {
+                    SecureWipe(mEncKeys, sizeof(mEncKeys));
+                    SecureWipe(mDecKeys, sizeof(mDecKeys));
+                    mRounds = 0u;
+                    mAccelerated = false;
+                }
+
+                bool Aes::IsKeySet () const noexcept
+                {
+                    return (mRounds != 0u);
+                }
+
+                bool Aes::IsAccelerated () const noexcept
+                {
+                    return mAccelerated;
+                }
+
+                void Aes::EncryptBlocks (const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept
+                {
+#ifdef ARA_CRYPTO_AES_NI
+                    if (mAccelerated)
+                    {
+                        EncryptBlocksNi(mEncKeys, mRounds, in, out, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, in += kBlockSize, out += kBlockSize)
+                    {
+                        EncryptBlockPortable(in, out);
+                    }
+                }
+
+                void Aes::DecryptBlocks (const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept
+                {
+#ifdef ARA_CRYPTO_AES_NI
+                    if (mAccelerated)
+                    {
+                        DecryptBlocksNi(mDecKeys, mRounds, in, out, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, in += kBlockSize, out += kBlockSize)
+                    {
+                        DecryptBlockPortable(in, out);
+                    }
+                }
+
+                void Aes::EncryptCbc (std::uint8_t iv[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept
+                {
+#ifdef ARA_CRYPTO_AES_NI
+                    if (mAccelerated)
+                    {
+                        EncryptCbcNi(mEncKeys, mRounds, iv, in, out, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, in += kBlockSize, out += kBlockSize)
+                    {
+                        std::uint8_t block[kBlockSize];
+                        XorBlock(block, in, iv);
+                        EncryptBlockPortable(block, out);
+                        std::memcpy(iv, out, kBlockSize);
+                    }
+                }
+
+                void Aes::MacCbc (std::uint8_t state[kBlockSize], const std::uint8_t *in, std::size_t blockCount) const noexcept
+                {
+#ifdef ARA_CRYPTO_AES_NI
+                    if (mAccelerated)
+                    {
+                        MacCbcNi(mEncKeys, mRounds, state, in, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, in += kBlockSize)
+                    {
+                        std::uint8_t block[kBlockSize];
+                        XorBlock(block, in, state);
+                        EncryptBlockPortable(block, state);
+                    }
+                }
+
+                void Aes::DecryptCbc (std::uint8_t iv[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept
+                {
+#ifdef ARA_CRYPTO_AES_NI
+                    if (mAccelerated)
+                    {
+                        DecryptCbcNi(mDecKeys, mRounds, iv, in, out, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, in += kBlockSize, out += kBlockSize)
+                    {
+                        std::uint8_t cipher[kBlockSize];
+                        std::uint8_t block[kBlockSize];
+                        std::memcpy(cipher, in, kBlockSize);
+                        DecryptBlockPortable(cipher, block);
+                        XorBlock(out, block, iv);
+                        std::memcpy(iv, cipher, kBlockSize);
+                    }
+                }
+
+                void Aes::XorCtr (std::uint8_t counter[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept
+                {
+#ifdef ARA_CRYPTO_AES_NI
+                    if (mAccelerated)
+                    {
+                        XorCtrNi(mEncKeys, mRounds, counter, in, out, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, in += kBlockSize, out += kBlockSize)
+                    {
+                        std::uint8_t keyStream[kBlockSize];
+                        EncryptBlockPortable(counter, keyStream);
+                        XorBlock(out, in, keyStream);
+                        AddToCounter(counter, 1u);
+                    }
+                }
+
+                void Aes::AddToCounter (std::uint8_t counter[kBlockSize], std::uint64_t blockCount) noexcept
+                {
+                    std::uint64_t carry = blockCount;
+                    for (std::size_t i = kBlockSize; (i > 0u) && (carry != 0u); --i)
+                    {
+                        const std::uint64_t sum = static_cast<std::uint64_t>(counter[i - 1u]) + (carry & 0xFFu);
+                        counter[i - 1u] = static_cast<std::uint8_t>(sum);
+                        carry = (carry >> 8) + (sum >> 8);
+                    }
+                }
+
+                void Aes::EncryptBlockPortable (const std::uint8_t *in, std::uint8_t *out) const noexcept
+                {
+                    std::uint8_t state[kBlockSize];
+                    XorBlock(state, in, mEncKeys);
+                    for (std::size_t round = 1; round <= mRounds; ++round)
+                    {
+                        // SubBytes and ShiftRows: the byte of row r and column c moves to column (c - r).
+                        SubBytes(state);
+                        std::uint8_t shifted[kBlockSize];
+                        for (std::size_t column = 0; column < 4u; ++column)
+                        {
+                            for (std::size_t row = 0; row < 4u; ++row)
+                            {
+                                shifted[row + 4u * column] = state[row + 4u * ((column + row) % 4u)];
+                            }
+                        }
+
+                        if (round != mRounds)
+                        {
+                            for (std::size_t column = 0; column < 4u; ++column)
+                            {
+                                std::uint8_t *col = &shifted[4u * column];
+                                const std::uint8_t all = static_cast<std::uint8_t>(col[0] ^ col[1] ^ col[2] ^ col[3]);
+                                const std::uint8_t first = col[0];
+                                col[0] = static_cast<std::uint8_t>(col[0] ^ all ^ XTime(static_cast<std::uint8_t>(col[0] ^ col[1])));
+                                col[1] = static_cast<std::uint8_t>(col[1] ^ all ^ XTime(static_cast<std::uint8_t>(col[1] ^ col[2])));
+                                col[2] = static_cast<std::uint8_t>(col[2] ^ all ^ XTime(static_cast<std::uint8_t>(col[2] ^ col[3])));
+                                col[3] = static_cast<std::uint8_t>(col[3] ^ all ^ XTime(static_cast<std::uint8_t>(col[3] ^ first)));
+                            }
+                        }
+                        XorBlock(state, shifted, &mEncKeys[round * kBlockSize]);
+                    }
+                    std::memcpy(out, state, kBlockSize);
+                }
+
+                void Aes::DecryptBlockPortable (const std::uint8_t *in, std::uint8_t *out) const noexcept
+                {
+                    std::uint8_t state[kBlockSize];
+                    XorBlock(state, in, &mEncKeys[mRounds * kBlockSize]);
+                    for (std::size_t round = mRounds; round > 0u; --round)
+                    {
+                        // InvShiftRows and InvSubBytes: the byte of row r and column c moves to column (c + r).
+                        std::uint8_t shifted[kBlockSize];
+                        for (std::size_t column = 0; column < 4u; ++column)
+                        {
+                            for (std::size_t row = 0; row < 4u; ++row)
+                            {
+                                shifted[row + 4u * ((column + row) % 4u)] = state[row + 4u * column];
+                            }
+                        }
+                        InvSubBytes(shifted);
+                        XorBlock(state, shifted, &mEncKeys[(round - 1u) * kBlockSize]);
+
+                        if (round != 1u)
+                        {
+                            for (std::size_t column = 0; column < 4u; ++column)
+                            {
+                                std::uint8_t *col = &state[4u * column];
+                                const std::uint8_t a0 = col[0];
+                                const std::uint8_t a1 = col[1];
+                                const std::uint8_t a2 = col[2];
+                                const std::uint8_t a3 = col[3];
+                                col[0] = static_cast<std::uint8_t>(Multiply(a0, 14u) ^ Multiply(a1, 11u) ^ Multiply(a2, 13u) ^ Multiply(a3, 9u));
+                                col[1] = static_cast<std::uint8_t>(Multiply(a0, 9u) ^ Multiply(a1, 14u) ^ Multiply(a2, 11u) ^ Multiply(a3, 13u));
+                                col[2] = static_cast<std::uint8_t>(Multiply(a0, 13u) ^ Multiply(a1, 9u) ^ Multiply(a2, 14u) ^ Multiply(a3, 11u));
+                                col[3] = static_cast<std::uint8_t>(Multiply(a0, 11u) ^ Multiply(a1, 13u) ^ Multiply(a2, 9u) ^ Multiply(a3, 14u));
+                            }
+                        }
+                    }
+                    std::memcpy(out, state, kBlockSize);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_AES_H
+#define ARA_CRYPTO_CRYP_INTERNAL_AES_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief AES block cipher (FIPS 197) with the multi-block kernels of the block cipher modes.
+                 * On x86 processors supporting AES-NI the kernels pipeline up to 8 independent blocks through
+                 * the rounds (the round instructions have a latency of several cycles but a throughput of one
+                 * per cycle). Otherwise a portable constant-time implementation is used: the S-box is a bitsliced
+                 * circuit instead of a table lookup, so no memory access depends on the key or the data. All
+                 * kernels accept either disjoint or identical (in-place) input and output buffers; partially
+                 * overlapping buffers are not supported. A key-scheduled instance is immutable, so it can be
+                 * shared between threads.
+                 */
+                class Aes
+                {
+                public:
+
+                    /**
+                     * @brief Size of the AES block in bytes.
+                     */
+                    static const std::size_t kBlockSize = 16u;
+
+                    /**
+                     * @brief Maximal number of rounds (AES-256).
+                     */
+                    static const std::size_t kMaxRounds = 14u;
+
+                    Aes () noexcept;
+
+                    /**
+                     * @brief Destroy the Aes object wiping the key schedule.
+                     */
+                    ~Aes () noexcept;
+
+                    /**
+                     * @brief Expand the key schedule.
+                     * @param[in] key the key value
+                     * @param[in] keySize size of the key in bytes: 16, 24 or 32
+                     * @return true if the key is scheduled
+                     * @return false if the key size is invalid
+                     */
+                    bool SetKey (const std::uint8_t *key, std::size_t keySize) noexcept;
+
+                    /**
+                     * @brief Wipe the key schedule.
+                     */
+                    void Clear () noexcept;
+
+                    /**
+                     * @brief Check if a key is scheduled.
+                     * @return true if SetKey() has succeeded
+                     */
+                    bool IsKeySet () const noexcept;
+
+                    /**
+                     * @brief Check if the hardware accelerated kernels are used.
+                     * @return true if the processor supports AES-NI
+                     */
+                    bool IsAccelerated () const noexcept;
+
+                    /**
+                     * @brief Encrypt independent blocks (ECB mode).
+                     * @param[in] in the input blocks
+                     * @param[out] out the output blocks
+                     * @param[in] blockCount number of blocks
+                     */
+                    void EncryptBlocks (const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept;
+
+                    /**
+                     * @brief Decrypt independent blocks (ECB mode).
+                     * @param[in] in the input blocks
+                     * @param[out] out the output blocks
+                     * @param[in] blockCount number of blocks
+                     */
+                    void DecryptBlocks (const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept;
+
+                    /**
+                     * @brief Encrypt blocks in CBC mode. The encryption is inherently sequential.
+                     * @param[in,out] iv the initialization vector, updated to the last ciphertext block
+                     * @param[in] in the plaintext blocks
+                     * @param[out] out the ciphertext blocks
+                     * @param[in] blockCount number of blocks
+                     */
+                    void EncryptCbc (std::uint8_t iv[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept;
+
+                    /**
+                     * @brief Absorb blocks into a CBC-MAC state: state = E(state XOR block) for every block. It is
+                     * the CBC encryption without storing the intermediate ciphertext blocks (used by CMAC).
+                     * @param[in,out] state the chaining state
+                     * @param[in] in the input blocks
+                     * @param[in] blockCount number of blocks
+                     */
+                    void MacCbc (std::uint8_t state[kBlockSize], const std::uint8_t *in, std::size_t blockCount) const noexcept;
+
+                    /**
+                     * @brief Decrypt blocks in CBC mode. The block decryptions are independent, so they are
+                     * pipelined in the same way as in the ECB mode.
+                     * @param[in,out] iv the initialization vector, updated to the last ciphertext block
+                     * @param[in] in the ciphertext blocks
+                     * @param[out] out the plaintext blocks
+                     * @param[in] blockCount number of blocks
+                     */
+                    void DecryptCbc (std::uint8_t iv[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept;
+
+                    /**
+                     * @brief Apply the CTR mode key stream: out = in XOR E(counter++). The counter is a 128-bit
+                     * big-endian integer.
+                     * @param[in,out] counter the counter block, updated to the value following the last used one
+                     * @param[in] in the input blocks
+                     * @param[out] out the output blocks
+                     * @param[in] blockCount number of blocks
+                     */
+                    void XorCtr (std::uint8_t counter[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t blockCount) const noexcept;
+
+                    /**
+                     * @brief Add a number of blocks to a 128-bit big-endian counter block.
+                     * @param[in,out] counter the counter block
+                     * @param[in] blockCount the increment
+                     */
+                    static void AddToCounter (std::uint8_t counter[kBlockSize], std::uint64_t blockCount) noexcept;
+
+                private:
+
+                    void EncryptBlockPortable (const std::uint8_t *in, std::uint8_t *out) const noexcept;
+                    void DecryptBlockPortable (const std::uint8_t *in, std::uint8_t *out) const noexcept;
+
+                    alignas(16) std::uint8_t mEncKeys[(kMaxRounds + 1u) * kBlockSize];
+                    alignas(16) std::uint8_t mDecKeys[(kMaxRounds + 1u) * kBlockSize];   // equivalent inverse cipher schedule (AES-NI only)
+                    std::size_t mRounds;
+                    bool mAccelerated;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_AES_H
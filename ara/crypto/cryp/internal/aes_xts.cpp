@@ -0,0 +1,234 @@
+#include "ara/crypto/cryp/internal/aes_xts.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    // Number of blocks whitened and passed to the block kernel at once.
+                    const std::size_t kBatchBlocks = 32u;
+
+                    inline std::uint64_t LoadLe64 (const std::uint8_t *bytes) noexcept
+                    {
+                        std::uint64_t value = 0u;
+                        for (std::size_t i = 8u; i > 0u; --i)
+                        {
+                            value = (value << 8) | bytes[i - 1u];
+                        }
+                        return value;
+                    }
+
+                    inline void StoreLe64 (std::uint64_t value, std::uint8_t *bytes) noexcept
+                    {
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            bytes[i] = static_cast<std::uint8_t>(value >> (8u * i));
+                        }
+                    }
+
+                    /**
+                     * @brief Tweak value as a polynomial over GF(2^128) stored in the little-endian order.
+                     */
+                    struct Tweak
+                    {
+                        std::uint64_t mLow;
+                        std::uint64_t mHigh;
+
+                        void Store (std::uint8_t *bytes) const noexcept
+                        {
+                            StoreLe64(mLow, bytes);
+                            StoreLe64(mHigh, bytes + 8u);
+                        }
+
+                        // Multiplication by the primitive element alpha (x) modulo x^128 + x^7 + x^2 + x + 1.
+                        void Advance () noexcept
+                        {
+                            const std::uint64_t carry = mHigh >> 63;
+                            mHigh = (mHigh << 1) | (mLow >> 63);
+                            mLow = (mLow << 1) ^ (carry * 0x87u);
+                        }
+                    };
+
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+                }
+
+                bool AesXts::SetKey (const std::uint8_t *key, std::size_t keySize) noexcept
+                {
+                    Clear();
+                    if ((keySize != 32u) && (keySize != 64u))
+                    {
+                        return false;
+                    }
+
+                    // IEEE 1619-2018 requires independent halves of the key.
+                    const std::size_t halfSize = keySize / 2u;
+                    if (std::memcmp(key, key + halfSize, halfSize) == 0)
+                    {
+                        return false;
+                    }
+                    if (!mDataCipher.SetKey(key, halfSize) || !mTweakCipher.SetKey(key + halfSize, halfSize))
+                    {
+                        Clear();
+                        return false;
+                    }
+                    return true;
+                }
+
+                void AesXts::Clear () noexcept
+                {
+                    mDataCipher.Clear();
+                    mTweakCipher.Clear();
+                }
+
+                bool AesXts::IsKeySet () const noexcept
+                {
+                    return mDataCipher.IsKeySet() && mTweakCipher.IsKeySet();
+                }
+
+                void AesXts::MakeTweak (std::uint64_t dataUnit, std::uint8_t tweak[kBlockSize]) noexcept
+                {
+                    StoreLe64(dataUnit, tweak);
+                    StoreLe64(0u, tweak + 8u);
+                }
+
+                bool AesXts::Encrypt (const std::uint8_t tweak[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    return Process(true, tweak, in, out, size);
+                }
+
+                bool AesXts::Decrypt (const std::uint8_t tweak[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    return Process(false, tweak, in, out, size);
+                }
+
+                bool AesXts::ProcessDataUnits (bool encrypt, std::uint64_t firstDataUnit, std::size_t dataUnitSize, const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    if ((dataUnitSize < kBlockSize) || ((size % dataUnitSize) != 0u && (size % dataUnitSize) < kBlockSize))
+                    {
+                        return false;
+                    }
+
+                    std::uint8_t tweak[kBlockSize];
+                    for (std::size_t offset = 0; offset < size; offset += dataUnitSize, ++firstDataUnit)
+                    {
+                        MakeTweak(firstDataUnit, tweak);
+                        if (!Process(encrypt, tweak, in + offset, out + offset, std::min(dataUnitSize, size - offset)))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                bool AesXts::Process (bool encrypt, const std::uint8_t tweak[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    if (!IsKeySet() || (size < kBlockSize))
+                    {
+                        return false;
+                    }
+
+                    std::uint8_t bytes[kBlockSize];
+                    mTweakCipher.EncryptBlocks(tweak, bytes, 1u);
+                    Tweak current = {LoadLe64(bytes), LoadLe64(bytes + 8u)};
+
+                    auto cipherBlocks = [this, encrypt] (const std::uint8_t *src, std::uint8_t *dst, std::size_t count)
+                    {
+                        if (encrypt)
+                        {
+                            mDataCipher.EncryptBlocks(src, dst, count);
+                        }
+                        else
+                        {
+                            mDataCipher.DecryptBlocks(src, dst, count);
+                        }
+                    };
+
+                    // With ciphertext stealing the last complete block is processed together with the partial one.
+                    const std::size_t tailSize = size % kBlockSize;
+                    std::size_t bulkBlocks = (size / kBlockSize) - ((tailSize != 0u) ? 1u : 0u);
+
+                    std::uint8_t tweaks[kBatchBlocks * kBlockSize];
+                    std::uint8_t buffer[kBatchBlocks * kBlockSize];
+                    while (bulkBlocks > 0u)
+                    {
+                        const std::size_t count = std::min(bulkBlocks, kBatchBlocks);
+                        const std::size_t length = count * kBlockSize;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            current.Store(&tweaks[i * kBlockSize]);
+                            current.Advance();
+                        }
+                        for (std::size_t i = 0; i < length; ++i)
+                        {
+                            buffer[i] = static_cast<std::uint8_t>(in[i] ^ tweaks[i]);
+                        }
+                        cipherBlocks(buffer, buffer, count);
+                        for (std::size_t i = 0; i < length; ++i)
+                        {
+                            out[i] = static_cast<std::uint8_t>(buffer[i] ^ tweaks[i]);
+                        }
+                        in += length;
+                        out += length;
+                        bulkBlocks -= count;
+                    }
+
+                    if (tailSize != 0u)
+                    {
+                        // tweaks[0..15] is the tweak of the last complete block, tweaks[16..31] of the stolen one.
+                        current.Store(tweaks);
+                        current.Advance();
+                        current.Store(tweaks + kBlockSize);
+                        const std::uint8_t *firstTweak = encrypt ? tweaks : (tweaks + kBlockSize);
+                        const std::uint8_t *secondTweak = encrypt ? (tweaks + kBlockSize) : tweaks;
+
+                        std::uint8_t *block = buffer;
+                        std::uint8_t *stolen = buffer + kBlockSize;
+                        for (std::size_t i = 0; i < kBlockSize; ++i)
+                        {
+                            block[i] = static_cast<std::uint8_t>(in[i] ^ firstTweak[i]);
+                        }
+                        cipherBlocks(block, block, 1u);
+                        for (std::size_t i = 0; i < kBlockSize; ++i)
+                        {
+                            block[i] ^= firstTweak[i];
+                        }
+
+                        // The partial block borrows the trailing bytes of the processed complete block.
+                        std::memcpy(stolen, in + kBlockSize, tailSize);
+                        std::memcpy(stolen + tailSize, block + tailSize, kBlockSize - tailSize);
+                        std::memcpy(out + kBlockSize, block, tailSize);
+
+                        for (std::size_t i = 0; i < kBlockSize; ++i)
+                        {
+                            stolen[i] ^= secondTweak[i];
+                        }
+                        cipherBlocks(stolen, stolen, 1u);
+                        for (std::size_t i = 0; i < kBlockSize; ++i)
+                        {
+                            out[i] = static_cast<std::uint8_t>(stolen[i] ^ secondTweak[i]);
+                        }
+                    }
+
+                    SecureWipe(buffer, sizeof(buffer));
+                    SecureWipe(tweaks, sizeof(tweaks));
+                    return true;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_AES_XTS_H
+#define ARA_CRYPTO_CRYP_INTERNAL_AES_XTS_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/aes.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief XTS-AES mode of the storage encryption (IEEE 1619, NIST SP 800-38E) with ciphertext
+                 * stealing. Each data unit (e.g. a disk sector) is encrypted independently under its own tweak, so
+                 * any data unit can be processed without touching the preceding ones. Blocks of a data unit are
+                 * processed in batches through the multi-block kernels of Aes. Input and output buffers may be
+                 * identical (in-place processing).
+                 */
+                class AesXts
+                {
+                public:
+
+                    /**
+                     * @brief Size of the AES block in bytes (also the minimal size of a data unit).
+                     */
+                    static const std::size_t kBlockSize = Aes::kBlockSize;
+
+                    /**
+                     * @brief Expand the data and tweak key schedules.
+                     * @param[in] key the concatenation of the data key and the tweak key
+                     * @param[in] keySize size of the concatenated key in bytes: 32 (XTS-AES-128) or 64 (XTS-AES-256)
+                     * @return true if the key is scheduled
+                     * @return false if the key size is invalid or the data key equals to the tweak key
+                     */
+                    bool SetKey (const std::uint8_t *key, std::size_t keySize) noexcept;
+
+                    /**
+                     * @brief Wipe the key schedules.
+                     */
+                    void Clear () noexcept;
+
+                    /**
+                     * @brief Check if a key is scheduled.
+                     * @return true if SetKey() has succeeded
+                     */
+                    bool IsKeySet () const noexcept;
+
+                    /**
+                     * @brief Build the tweak of a data unit: its sequence number as a 128-bit little-endian integer.
+                     * @param[in] dataUnit the data unit sequence number
+                     * @param[out] tweak the tweak value
+                     */
+                    static void MakeTweak (std::uint64_t dataUnit, std::uint8_t tweak[kBlockSize]) noexcept;
+
+                    /**
+                     * @brief Encrypt a single data unit.
+                     * @param[in] tweak the tweak value of the data unit
+                     * @param[in] in the plaintext
+                     * @param[out] out the ciphertext
+                     * @param[in] size size of the data unit in bytes (at least kBlockSize)
+                     * @return true on success
+                     * @return false if the size is below kBlockSize or the key is not set
+                     */
+                    bool Encrypt (const std::uint8_t tweak[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Decrypt a single data unit.
+                     * @param[in] tweak the tweak value of the data unit
+                     * @param[in] in the ciphertext
+                     * @param[out] out the plaintext
+                     * @param[in] size size of the data unit in bytes (at least kBlockSize)
+                     * @return true on success
+                     * @return false if the size is below kBlockSize or the key is not set
+                     */
+                    bool Decrypt (const std::uint8_t tweak[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Encrypt or decrypt a run of consecutive data units of the same size. The last data unit
+                     * may be shorter than dataUnitSize (but not shorter than kBlockSize).
+                     * @param[in] encrypt the direction: encryption (if true) or decryption (if false)
+                     * @param[in] firstDataUnit the sequence number of the first data unit
+                     * @param[in] dataUnitSize size of a data unit in bytes (at least kBlockSize)
+                     * @param[in] in the input data
+                     * @param[out] out the output data
+                     * @param[in] size size of the data in bytes
+                     * @return true on success
+                     * @return false if the sizes are invalid or the key is not set
+                     */
+                    bool ProcessDataUnits (bool encrypt, std::uint64_t firstDataUnit, std::size_t dataUnitSize, const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept;
+
+                private:
+
+                    bool Process (bool encrypt, const std::uint8_t tweak[kBlockSize], const std::uint8_t *in, std::uint8_t *out, std::size_t size) const noexcept;
+
+                    Aes mDataCipher;
+                    Aes mTweakCipher;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_AES_XTS_H
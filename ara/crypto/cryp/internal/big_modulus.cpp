@@ -0,0 +1,730 @@
+#include "ara/crypto/cryp/internal/big_modulus.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ARA_CRYPTO_IFMA 1
+#include <immintrin.h>
+#define ARA_CRYPTO_IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+#endif
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    using Wide = unsigned __int128;
+
+                    const std::size_t kWindowBits = 4u;
+                    const std::size_t kWindowSize = 1u << kWindowBits;
+
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    // Load up to 8 bytes of a big-endian integer into a limb, starting at the least significant
+                    // byte with the index "position".
+                    std::uint64_t LoadLimb (const std::uint8_t *bytes, std::size_t size, std::size_t position) noexcept
+                    {
+                        std::uint64_t limb = 0u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            const std::size_t index = position + i;
+                            if (index < size)
+                            {
+                                limb |= static_cast<std::uint64_t>(bytes[size - 1u - index]) << (8u * i);
+                            }
+                        }
+                        return limb;
+                    }
+
+                    // Get the 4-bit window with the index "window" counted from the least significant one (0 beyond
+                    // the exponent).
+                    inline std::size_t GetWindow (const std::uint8_t *exponent, std::size_t size, std::size_t window) noexcept
+                    {
+                        if (window >= 2u * size)
+                        {
+                            return 0u;
+                        }
+                        const std::uint8_t byte = exponent[size - 1u - window / 2u];
+                        return ((window & 1u) != 0u) ? (byte >> 4) : (byte & 0x0fu);
+                    }
+
+#ifdef ARA_CRYPTO_IFMA
+                    const std::size_t kDigitBits = 52u;
+                    const std::uint64_t kDigitMask = (static_cast<std::uint64_t>(1u) << kDigitBits) - 1u;
+                    const std::size_t kDigitsPerVector = 8u;
+
+                    bool IsIfmaSupported () noexcept
+                    {
+                        static const bool cSupported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+                        return cSupported;
+                    }
+
+                    // Split little-endian 64-bit limbs into 52-bit digits.
+                    void ToDigits (std::uint64_t *digits, std::size_t digitCount, const std::uint64_t *limbs, std::size_t limbCount) noexcept
+                    {
+                        for (std::size_t i = 0; i < digitCount; ++i)
+                        {
+                            const std::size_t limb = (kDigitBits * i) / 64u;
+                            const std::size_t shift = (kDigitBits * i) % 64u;
+                            std::uint64_t digit = 0u;
+                            if (limb < limbCount)
+                            {
+                                digit = limbs[limb] >> shift;
+                                if ((shift > 64u - kDigitBits) && (limb + 1u < limbCount))
+                                {
+                                    digit |= limbs[limb + 1u] << (64u - shift);
+                                }
+                            }
+                            digits[i] = digit & kDigitMask;
+                        }
+                    }
+
+                    // Join 52-bit digits into little-endian 64-bit limbs, the bits beyond limbCount limbs are dropped.
+                    void FromDigits (std::uint64_t *limbs, std::size_t limbCount, const std::uint64_t *digits, std::size_t digitCount) noexcept
+                    {
+                        std::memset(limbs, 0, limbCount * sizeof(std::uint64_t));
+                        for (std::size_t i = 0; i < digitCount; ++i)
+                        {
+                            const std::size_t limb = (kDigitBits * i) / 64u;
+                            const std::size_t shift = (kDigitBits * i) % 64u;
+                            if (limb < limbCount)
+                            {
+                                limbs[limb] |= digits[i] << shift;
+                            }
+                            if ((shift > 64u - kDigitBits) && (limb + 1u < limbCount))
+                            {
+                                limbs[limb + 1u] |= digits[i] >> (64u - shift);
+                            }
+                        }
+                    }
+
+                    // One of the exponentiations run by ExponentiateIfma() over 52-bit digits.
+                    struct DigitPower
+                    {
+                        std::uint64_t *mResult;         // the ordinary power (below 2m)
+                        const std::uint64_t *mBase;     // the ordinary base
+                        const std::uint8_t *mExponent;
+                        std::size_t mSize;
+                        const std::uint64_t *mModulus;
+                        const std::uint64_t *mR2;       // R'^2 mod m
+                        std::uint64_t mInverse;         // -m^-1 mod 2^52
+                    };
+
+                    // W independent almost Montgomery products r = a * b / R' mod m of V vectors of 52-bit digits
+                    // (R' = 2^(416 * V)). For a, b < 2m and R' > 4m the product is below 2m as well, so it can be fed
+                    // back without the final subtraction. The high halves of the digit products are added by copies
+                    // of a and m shifted up by one digit (the top digits of a and m are 0), so they do not wait for
+                    // the shift of the accumulator; the lanes collect the carries (at most 4 * 8V products of 52 bits
+                    // per lane) until the single normalization at the end. Each step waits for the reduction digit y
+                    // of the previous one, the W chains hide the latency of each other.
+                    template <std::size_t V, std::size_t W>
+                    ARA_CRYPTO_IFMA_TARGET
+                    void MultiplyIfma (std::uint64_t *const r[W], const std::uint64_t *const a[W], const std::uint64_t *const b[W], const DigitPower *powers) noexcept
+                    {
+                        const __m512i zero = _mm512_setzero_si512();
+                        __m512i va[W][V];
+                        __m512i vm[W][V];
+                        __m512i sa[W][V];
+                        __m512i sm[W][V];
+                        __m512i acc[W][V];
+#pragma GCC unroll 2
+                        for (std::size_t w = 0; w < W; ++w)
+                        {
+#pragma GCC unroll 10
+                            for (std::size_t v = 0; v < V; ++v)
+                            {
+                                va[w][v] = _mm512_loadu_si512(a[w] + kDigitsPerVector * v);
+                                vm[w][v] = _mm512_loadu_si512(powers[w].mModulus + kDigitsPerVector * v);
+                                sa[w][v] = _mm512_alignr_epi64(va[w][v], (v == 0u) ? zero : va[w][v - 1u], 7);
+                                sm[w][v] = _mm512_alignr_epi64(vm[w][v], (v == 0u) ? zero : vm[w][v - 1u], 7);
+                                acc[w][v] = zero;
+                            }
+                        }
+
+                        for (std::size_t i = 0; i < kDigitsPerVector * V; ++i)
+                        {
+#pragma GCC unroll 2
+                            for (std::size_t w = 0; w < W; ++w)
+                            {
+                                // acc += a * b[i] + m * y, where y makes the lowest digit 0 mod 2^52
+                                const __m512i bi = _mm512_set1_epi64(static_cast<long long>(b[w][i]));
+#pragma GCC unroll 10
+                                for (std::size_t v = 0; v < V; ++v)
+                                {
+                                    acc[w][v] = _mm512_madd52lo_epu64(acc[w][v], va[w][v], bi);
+                                }
+                                const std::uint64_t lowest = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(_mm512_castsi512_si256(acc[w][0]))));
+                                const __m512i y = _mm512_set1_epi64(static_cast<long long>((lowest * powers[w].mInverse) & kDigitMask));
+#pragma GCC unroll 10
+                                for (std::size_t v = 0; v < V; ++v)
+                                {
+                                    acc[w][v] = _mm512_madd52hi_epu64(acc[w][v], sa[w][v], bi);
+                                }
+#pragma GCC unroll 10
+                                for (std::size_t v = 0; v < V; ++v)
+                                {
+                                    acc[w][v] = _mm512_madd52lo_epu64(acc[w][v], vm[w][v], y);
+                                }
+                                const __m512i carry = _mm512_srli_epi64(acc[w][0], kDigitBits);
+#pragma GCC unroll 10
+                                for (std::size_t v = 0; v < V; ++v)
+                                {
+                                    acc[w][v] = _mm512_madd52hi_epu64(acc[w][v], sm[w][v], y);
+                                }
+
+                                // acc /= 2^52, the carry of the lowest digit goes to the next one
+#pragma GCC unroll 10
+                                for (std::size_t v = 0; v + 1u < V; ++v)
+                                {
+                                    acc[w][v] = _mm512_alignr_epi64(acc[w][v + 1u], acc[w][v], 1);
+                                }
+                                acc[w][V - 1u] = _mm512_alignr_epi64(zero, acc[w][V - 1u], 1);
+                                acc[w][0] = _mm512_mask_add_epi64(acc[w][0], 1u, acc[w][0], carry);
+                            }
+                        }
+
+                        for (std::size_t w = 0; w < W; ++w)
+                        {
+                            alignas(64) std::uint64_t t[kDigitsPerVector * V];
+                            for (std::size_t v = 0; v < V; ++v)
+                            {
+                                _mm512_store_si512(t + kDigitsPerVector * v, acc[w][v]);
+                            }
+                            std::uint64_t carry = 0u;
+                            for (std::size_t i = 0; i < kDigitsPerVector * V; ++i)
+                            {
+                                const std::uint64_t digit = t[i] + carry;
+                                r[w][i] = digit & kDigitMask;
+                                carry = digit >> kDigitBits;
+                            }
+                            SecureWipe(t, sizeof(t));
+                        }
+                    }
+
+                    // The counterpart of BigModulus::Exponentiate() over 52-bit digits for W moduli of V vectors.
+                    template <std::size_t V, std::size_t W>
+                    ARA_CRYPTO_IFMA_TARGET
+                    void ExponentiateIfma (const DigitPower *powers) noexcept
+                    {
+                        const std::size_t digitCount = kDigitsPerVector * V;
+                        alignas(64) std::uint64_t one[digitCount] = {1u};
+                        alignas(64) std::uint64_t table[W][kWindowSize][digitCount];
+                        alignas(64) std::uint64_t selected[W][digitCount];
+                        alignas(64) std::uint64_t accumulator[W][digitCount];
+                        std::uint64_t *results[W];
+                        std::uint64_t *accumulators[W];
+                        const std::uint64_t *operands[W];
+                        const std::uint64_t *factors[W];
+                        std::size_t windowCount = 0u;
+
+                        // table[i] = x^i * R' mod m
+                        for (std::size_t w = 0; w < W; ++w)
+                        {
+                            results[w] = table[w][0];
+                            operands[w] = powers[w].mR2;
+                            factors[w] = one;
+                            windowCount = (2u * powers[w].mSize > windowCount) ? 2u * powers[w].mSize : windowCount;
+                        }
+                        MultiplyIfma<V, W>(results, operands, factors, powers);
+                        for (std::size_t w = 0; w < W; ++w)
+                        {
+                            results[w] = table[w][1];
+                            operands[w] = powers[w].mBase;
+                            factors[w] = powers[w].mR2;
+                        }
+                        MultiplyIfma<V, W>(results, operands, factors, powers);
+                        for (std::size_t i = 2u; i < kWindowSize; ++i)
+                        {
+                            for (std::size_t w = 0; w < W; ++w)
+                            {
+                                results[w] = table[w][i];
+                                operands[w] = table[w][i - 1u];
+                                factors[w] = table[w][1];
+                            }
+                            MultiplyIfma<V, W>(results, operands, factors, powers);
+                        }
+
+                        for (std::size_t w = 0; w < W; ++w)
+                        {
+                            std::memcpy(accumulator[w], table[w][0], sizeof(accumulator[w]));
+                            accumulators[w] = accumulator[w];
+                        }
+                        for (std::size_t window = windowCount; window > 0u; --window)
+                        {
+                            for (std::size_t i = 0; i < kWindowBits; ++i)
+                            {
+                                MultiplyIfma<V, W>(accumulators, accumulators, accumulators, powers);
+                            }
+
+                            // Scan the whole table, so the memory accesses do not depend on the window value.
+                            for (std::size_t w = 0; w < W; ++w)
+                            {
+                                const std::size_t value = GetWindow(powers[w].mExponent, powers[w].mSize, window - 1u);
+                                __m512i chosen[V];
+                                for (std::size_t v = 0; v < V; ++v)
+                                {
+                                    chosen[v] = _mm512_setzero_si512();
+                                }
+                                for (std::size_t entry = 0; entry < kWindowSize; ++entry)
+                                {
+                                    const __m512i mask = _mm512_set1_epi64(-static_cast<long long>(entry == value));
+                                    for (std::size_t v = 0; v < V; ++v)
+                                    {
+                                        chosen[v] = _mm512_or_si512(chosen[v], _mm512_and_si512(_mm512_load_si512(table[w][entry] + kDigitsPerVector * v), mask));
+                                    }
+                                }
+                                for (std::size_t v = 0; v < V; ++v)
+                                {
+                                    _mm512_store_si512(selected[w] + kDigitsPerVector * v, chosen[v]);
+                                }
+                                factors[w] = selected[w];
+                            }
+                            MultiplyIfma<V, W>(accumulators, accumulators, factors, powers);
+                        }
+
+                        for (std::size_t w = 0; w < W; ++w)
+                        {
+                            results[w] = powers[w].mResult;
+                            factors[w] = one;
+                        }
+                        MultiplyIfma<V, W>(results, accumulators, factors, powers);
+
+                        SecureWipe(table, sizeof(table));
+                        SecureWipe(selected, sizeof(selected));
+                        SecureWipe(accumulator, sizeof(accumulator));
+                    }
+
+                    template <std::size_t W>
+                    void ExponentiateIfma (std::size_t vectors, const DigitPower *powers) noexcept
+                    {
+                        switch (vectors)
+                        {
+                        case 1u: ExponentiateIfma<1u, W>(powers); break;
+                        case 2u: ExponentiateIfma<2u, W>(powers); break;
+                        case 3u: ExponentiateIfma<3u, W>(powers); break;
+                        case 4u: ExponentiateIfma<4u, W>(powers); break;
+                        case 5u: ExponentiateIfma<5u, W>(powers); break;
+                        case 6u: ExponentiateIfma<6u, W>(powers); break;
+                        case 7u: ExponentiateIfma<7u, W>(powers); break;
+                        case 8u: ExponentiateIfma<8u, W>(powers); break;
+                        case 9u: ExponentiateIfma<9u, W>(powers); break;
+                        default: ExponentiateIfma<10u, W>(powers); break;
+                        }
+                    }
+#endif
+                }
+
+                BigModulus::BigModulus () noexcept : mInverse(0u), mLimbCount(0u), mDigitInverse(0u), mVectorCount(0u)
+                {
+                }
+
+                BigModulus::~BigModulus () noexcept
+                {
+                    Clear();
+                }
+
+                bool BigModulus::SetModulus (const std::uint8_t *bytes, std::size_t size) noexcept
+                {
+                    while ((size != 0u) && (bytes[0] == 0u))
+                    {
+                        ++bytes;
+                        --size;
+                    }
+                    if ((size == 0u) || (size > kMaxSize) || ((bytes[size - 1u] & 1u) == 0u) || ((size == 1u) && (bytes[0] == 1u)))
+                    {
+                        return false;
+                    }
+
+                    mLimbCount = (size + 7u) / 8u;
+                    std::memset(&mModulus, 0, sizeof(mModulus));
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        mModulus.mLimb[i] = LoadLimb(bytes, size, 8u * i);
+                    }
+
+                    // Newton iteration doubles the number of correct low bits of m^-1 mod 2^64.
+                    std::uint64_t inverse = 1u;
+                    for (std::size_t i = 0; i < 6u; ++i)
+                    {
+                        inverse *= 2u - mModulus.mLimb[0] * inverse;
+                    }
+                    mInverse = 0u - inverse;
+
+                    // R mod m and R^2 mod m by modular doublings of 1, R^3 = R^2 * R^2 / R.
+                    const std::size_t bits = 64u * mLimbCount;
+                    Element value;
+                    std::memset(&value, 0, sizeof(value));
+                    value.mLimb[0] = 1u;
+                    for (std::size_t bit = 1u; bit <= 2u * bits; ++bit)
+                    {
+                        std::uint64_t doubled[kMaxLimbs];
+                        std::uint64_t carry = 0u;
+                        for (std::size_t i = 0; i < mLimbCount; ++i)
+                        {
+                            doubled[i] = (value.mLimb[i] << 1) | carry;
+                            carry = value.mLimb[i] >> 63;
+                        }
+                        ReduceOnce(value, doubled, carry);
+                        if (bit == bits)
+                        {
+                            mOne = value;
+                        }
+                    }
+                    mR2 = value;
+                    Multiply(mR3, mR2, mR2);
+
+                    mVectorCount = 0u;
+#ifdef ARA_CRYPTO_IFMA
+                    if (IsIfmaSupported())
+                    {
+                        // R' = 2^(416 * vectors) > 4m and the top digit of values below 2m is 0,
+                        // R'^2 mod m by further doublings of R^2 mod m.
+                        const std::size_t vectors = (bits + 1u + kDigitBits + 415u) / 416u;
+                        for (std::size_t bit = 2u * bits; bit < 2u * 416u * vectors; ++bit)
+                        {
+                            std::uint64_t doubled[kMaxLimbs];
+                            std::uint64_t carry = 0u;
+                            for (std::size_t i = 0; i < mLimbCount; ++i)
+                            {
+                                doubled[i] = (value.mLimb[i] << 1) | carry;
+                                carry = value.mLimb[i] >> 63;
+                            }
+                            ReduceOnce(value, doubled, carry);
+                        }
+                        ToDigits(mDigitModulus, kDigitsPerVector * vectors, mModulus.mLimb, mLimbCount);
+                        ToDigits(mDigitR2, kDigitsPerVector * vectors, value.mLimb, mLimbCount);
+                        mDigitInverse = mInverse & kDigitMask;
+                        mVectorCount = vectors;
+                    }
+#endif
+                    SecureWipe(&value, sizeof(value));
+                    return true;
+                }
+
+                std::size_t BigModulus::GetBitLength () const noexcept
+                {
+                    if (mLimbCount == 0u)
+                    {
+                        return 0u;
+                    }
+                    std::size_t bits = 64u * mLimbCount;
+                    for (std::uint64_t top = mModulus.mLimb[mLimbCount - 1u]; (top >> 63) == 0u; top <<= 1)
+                    {
+                        --bits;
+                    }
+                    return bits;
+                }
+
+                bool BigModulus::Decode (Element &r, const std::uint8_t *bytes, std::size_t size) const noexcept
+                {
+                    for (; (size > 8u * mLimbCount) && (bytes[0] == 0u); --size)
+                    {
+                        ++bytes;
+                    }
+                    if (size > 8u * mLimbCount)
+                    {
+                        return false;
+                    }
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        r.mLimb[i] = LoadLimb(bytes, size, 8u * i);
+                    }
+
+                    // r < m if r - m borrows
+                    std::uint64_t borrow = 0u;
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        const Wide difference = (Wide)r.mLimb[i] - mModulus.mLimb[i] - borrow;
+                        borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                    }
+                    return borrow != 0u;
+                }
+
+                void BigModulus::Encode (std::uint8_t *bytes, std::size_t size, const Element &a) const noexcept
+                {
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        const std::size_t limb = i / 8u;
+                        bytes[size - 1u - i] = (limb < mLimbCount) ? static_cast<std::uint8_t>(a.mLimb[limb] >> (8u * (i % 8u))) : 0u;
+                    }
+                }
+
+                void BigModulus::Reduce (Element &r, const std::uint64_t *limbs, std::size_t limbCount) const noexcept
+                {
+                    // x = high * R + low = low * R^2 / R + high * R^3 / R (in the Montgomery form)
+                    Element low = {};
+                    Element high = {};
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        low.mLimb[i] = (i < limbCount) ? limbs[i] : 0u;
+                        high.mLimb[i] = (mLimbCount + i < limbCount) ? limbs[mLimbCount + i] : 0u;
+                    }
+                    Multiply(low, low, mR2);
+                    Multiply(high, high, mR3);
+                    Add(r, low, high);
+                    SecureWipe(&low, sizeof(low));
+                    SecureWipe(&high, sizeof(high));
+                }
+
+                void BigModulus::ToMontgomery (Element &r, const Element &a) const noexcept
+                {
+                    Multiply(r, a, mR2);
+                }
+
+                void BigModulus::FromMontgomery (Element &r, const Element &a) const noexcept
+                {
+                    Element one;
+                    std::memset(&one, 0, sizeof(one));
+                    one.mLimb[0] = 1u;
+                    Multiply(r, a, one);
+                }
+
+                void BigModulus::Multiply (Element &r, const Element &a, const Element &b) const noexcept
+                {
+                    const std::size_t k = mLimbCount;
+                    std::uint64_t t[kMaxLimbs + 2u] = {};
+                    for (std::size_t i = 0; i < k; ++i)
+                    {
+                        // t += a * b[i]
+                        const std::uint64_t bi = b.mLimb[i];
+                        std::uint64_t carry = 0u;
+                        for (std::size_t j = 0; j < k; ++j)
+                        {
+                            const Wide product = (Wide)a.mLimb[j] * bi + t[j] + carry;
+                            t[j] = static_cast<std::uint64_t>(product);
+                            carry = static_cast<std::uint64_t>(product >> 64);
+                        }
+                        Wide sum = (Wide)t[k] + carry;
+                        t[k] = static_cast<std::uint64_t>(sum);
+                        t[k + 1u] = static_cast<std::uint64_t>(sum >> 64);
+
+                        // t = (t + u * m) / 2^64
+                        const std::uint64_t u = t[0] * mInverse;
+                        Wide product = (Wide)u * mModulus.mLimb[0] + t[0];
+                        carry = static_cast<std::uint64_t>(product >> 64);
+                        for (std::size_t j = 1u; j < k; ++j)
+                        {
+                            product = (Wide)u * mModulus.mLimb[j] + t[j] + carry;
+                            t[j - 1u] = static_cast<std::uint64_t>(product);
+                            carry = static_cast<std::uint64_t>(product >> 64);
+                        }
+                        sum = (Wide)t[k] + carry;
+                        t[k - 1u] = static_cast<std::uint64_t>(sum);
+                        t[k] = t[k + 1u] + static_cast<std::uint64_t>(sum >> 64);
+                    }
+                    ReduceOnce(r, t, t[k]);
+                }
+
+                void BigModulus::Add (Element &r, const Element &a, const Element &b) const noexcept
+                {
+                    std::uint64_t t[kMaxLimbs];
+                    std::uint64_t carry = 0u;
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        const Wide sum = (Wide)a.mLimb[i] + b.mLimb[i] + carry;
+                        t[i] = static_cast<std::uint64_t>(sum);
+                        carry = static_cast<std::uint64_t>(sum >> 64);
+                    }
+                    ReduceOnce(r, t, carry);
+                }
+
+                void BigModulus::Subtract (Element &r, const Element &a, const Element &b) const noexcept
+                {
+                    // a - b, plus m if it borrows
+                    std::uint64_t borrow = 0u;
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        const Wide difference = (Wide)a.mLimb[i] - b.mLimb[i] - borrow;
+                        r.mLimb[i] = static_cast<std::uint64_t>(difference);
+                        borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                    }
+                    const std::uint64_t mask = 0u - borrow;
+                    std::uint64_t carry = 0u;
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        const Wide sum = (Wide)r.mLimb[i] + (mModulus.mLimb[i] & mask) + carry;
+                        r.mLimb[i] = static_cast<std::uint64_t>(sum);
+                        carry = static_cast<std::uint64_t>(sum >> 64);
+                    }
+                }
+
+                void BigModulus::Exponentiate (Element &r, const Element &base, const std::uint8_t *exponent, std::size_t size) const noexcept
+                {
+#ifdef ARA_CRYPTO_IFMA
+                    if (mVectorCount != 0u)
+                    {
+                        const BigModulus *moduli[1] = {this};
+                        const Power powers[1] = {{&r, &base, exponent, size}};
+                        ExponentiateAccelerated(moduli, powers, 1u);
+                        return;
+                    }
+#endif
+                    // table[i] = base^i
+                    Element table[kWindowSize];
+                    table[0] = mOne;
+                    table[1] = base;
+                    for (std::size_t i = 2u; i < kWindowSize; ++i)
+                    {
+                        Multiply(table[i], table[i - 1u], base);
+                    }
+
+                    Element selected;
+                    Element accumulator = mOne;
+                    for (std::size_t window = 2u * size; window > 0u; --window)
+                    {
+                        for (std::size_t i = 0; i < kWindowBits; ++i)
+                        {
+                            Multiply(accumulator, accumulator, accumulator);
+                        }
+
+                        // Scan the whole table, so the memory accesses do not depend on the window value.
+                        const std::size_t value = GetWindow(exponent, size, window - 1u);
+                        std::memset(&selected, 0, sizeof(selected));
+                        for (std::size_t entry = 0; entry < kWindowSize; ++entry)
+                        {
+                            const std::uint64_t mask = 0u - static_cast<std::uint64_t>(entry == value);
+                            for (std::size_t i = 0; i < mLimbCount; ++i)
+                            {
+                                selected.mLimb[i] |= table[entry].mLimb[i] & mask;
+                            }
+                        }
+                        Multiply(accumulator, accumulator, selected);
+                    }
+                    r = accumulator;
+
+                    SecureWipe(table, sizeof(table));
+                    SecureWipe(&selected, sizeof(selected));
+                    SecureWipe(&accumulator, sizeof(accumulator));
+                }
+
+                void BigModulus::ExponentiatePair (const BigModulus &modulus1, const Power &power1, const BigModulus &modulus2, const Power &power2) noexcept
+                {
+#ifdef ARA_CRYPTO_IFMA
+                    if ((modulus1.mVectorCount != 0u) && (modulus1.mVectorCount == modulus2.mVectorCount))
+                    {
+                        const BigModulus *moduli[2] = {&modulus1, &modulus2};
+                        const Power powers[2] = {power1, power2};
+                        ExponentiateAccelerated(moduli, powers, 2u);
+                        return;
+                    }
+#endif
+                    modulus1.Exponentiate(*power1.mResult, *power1.mBase, power1.mExponent, power1.mSize);
+                    modulus2.Exponentiate(*power2.mResult, *power2.mBase, power2.mExponent, power2.mSize);
+                }
+
+#ifdef ARA_CRYPTO_IFMA
+                void BigModulus::ExponentiateAccelerated (const BigModulus *const moduli[], const Power *powers, std::size_t count) noexcept
+                {
+                    // The bases are converted from the Montgomery form (R = 2^(64 * limbs)) to the ordinary 52-bit
+                    // digits and the powers back, the kernel works in its own Montgomery form (R').
+                    std::uint64_t digits[2][kMaxDigits];
+                    DigitPower digitPowers[2];
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const BigModulus &modulus = *moduli[i];
+                        Element x;
+                        modulus.FromMontgomery(x, *powers[i].mBase);
+                        ToDigits(digits[i], kDigitsPerVector * modulus.mVectorCount, x.mLimb, modulus.mLimbCount);
+                        SecureWipe(&x, sizeof(x));
+                        digitPowers[i] = {digits[i], digits[i], powers[i].mExponent, powers[i].mSize, modulus.mDigitModulus, modulus.mDigitR2, modulus.mDigitInverse};
+                    }
+
+                    if (count == 2u)
+                    {
+                        ExponentiateIfma<2u>(moduli[0]->mVectorCount, digitPowers);
+                    }
+                    else
+                    {
+                        ExponentiateIfma<1u>(moduli[0]->mVectorCount, digitPowers);
+                    }
+
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const BigModulus &modulus = *moduli[i];
+                        std::uint64_t t[kMaxLimbs + 1u];
+                        Element x;
+                        FromDigits(t, modulus.mLimbCount + 1u, digits[i], kDigitsPerVector * modulus.mVectorCount);
+                        modulus.ReduceOnce(x, t, t[modulus.mLimbCount]);
+                        modulus.ToMontgomery(*powers[i].mResult, x);
+                        SecureWipe(t, sizeof(t));
+                        SecureWipe(&x, sizeof(x));
+                    }
+                    SecureWipe(digits, sizeof(digits));
+                }
+#endif
+
+                void BigModulus::ExponentiatePublic (Element &r, const Element &base, const std::uint8_t *exponent, std::size_t size) const noexcept
+                {
+                    Element accumulator = mOne;
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        for (std::size_t bit = 8u; bit > 0u; --bit)
+                        {
+                            Multiply(accumulator, accumulator, accumulator);
+                            if (((exponent[i] >> (bit - 1u)) & 1u) != 0u)
+                            {
+                                Multiply(accumulator, accumulator, base);
+                            }
+                        }
+                    }
+                    r = accumulator;
+                }
+
+                bool BigModulus::IsEqual (const Element &a, const Element &b) const noexcept
+                {
+                    std::uint64_t difference = 0u;
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        difference |= a.mLimb[i] ^ b.mLimb[i];
+                    }
+                    return difference == 0u;
+                }
+
+                void BigModulus::Clear () noexcept
+                {
+                    SecureWipe(&mModulus, sizeof(mModulus));
+                    SecureWipe(&mOne, sizeof(mOne));
+                    SecureWipe(&mR2, sizeof(mR2));
+                    SecureWipe(&mR3, sizeof(mR3));
+                    mInverse = 0u;
+                    mLimbCount = 0u;
+                    SecureWipe(mDigitModulus, sizeof(mDigitModulus));
+                    SecureWipe(mDigitR2, sizeof(mDigitR2));
+                    mDigitInverse = 0u;
+                    mVectorCount = 0u;
+                }
+
+                void BigModulus::ReduceOnce (Element &r, const std::uint64_t *t, std::uint64_t carry) const noexcept
+                {
+                    // r = t - m if (carry || t) >= m, else t
+                    std::uint64_t reduced[kMaxLimbs];
+                    std::uint64_t borrow = 0u;
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        const Wide difference = (Wide)t[i] - mModulus.mLimb[i] - borrow;
+                        reduced[i] = static_cast<std::uint64_t>(difference);
+                        borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                    }
+                    // keep t if the subtraction borrowed beyond the carry
+                    const std::uint64_t keep = 0u - (borrow & (carry ^ 1u));
+                    for (std::size_t i = 0; i < mLimbCount; ++i)
+                    {
+                        r.mLimb[i] = (t[i] & keep) | (reduced[i] & ~keep);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,225 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_BIG_MODULUS_H
+#define ARA_CRYPTO_CRYP_INTERNAL_BIG_MODULUS_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Constant-time arithmetic modulo an odd modulus of up to 4096 bits, e.g. an RSA modulus or
+                 * one of its prime factors. The products are computed in the Montgomery form (R = 2^(64 * limbs))
+                 * by the coarsely integrated operand scanning method over 64-bit limbs; the Montgomery constants
+                 * are derived once by SetModulus(). The elements of a modulus of k limbs use the leading k limbs
+                 * of an Element only. On CPUs with AVX-512 IFMA the secret exponentiation runs over 52-bit digits
+                 * held in 512-bit vectors (almost Montgomery multiplication without the final subtractions), the
+                 * constants of that representation are derived by SetModulus() as well.
+                 */
+                class BigModulus
+                {
+                public:
+
+                    /**
+                     * @brief Maximal number of 64-bit limbs of the modulus.
+                     */
+                    static const std::size_t kMaxLimbs = 64u;
+
+                    /**
+                     * @brief Maximal size of the modulus in bytes.
+                     */
+                    static const std::size_t kMaxSize = kMaxLimbs * 8u;
+
+                    /**
+                     * @brief Residue in little-endian 64-bit limbs.
+                     */
+                    struct Element
+                    {
+                        std::uint64_t mLimb[kMaxLimbs];
+                    };
+
+                    /**
+                     * @brief An exponentiation of ExponentiatePair().
+                     */
+                    struct Power
+                    {
+                        Element *mResult;               // the power in the Montgomery form
+                        const Element *mBase;           // the base in the Montgomery form
+                        const std::uint8_t *mExponent;  // the big-endian exponent
+                        std::size_t mSize;              // size of the exponent in bytes
+                    };
+
+                    BigModulus () noexcept;
+
+                    /**
+                     * @brief Destroy the Big Modulus object wiping the modulus (the prime factors are secret).
+                     */
+                    ~BigModulus () noexcept;
+
+                    /**
+                     * @brief Set the modulus and derive the Montgomery constants.
+                     * @param[in] bytes the big-endian modulus (leading zero bytes are ignored)
+                     * @param[in] size size of the modulus in bytes
+                     * @return true if the modulus is odd, greater than 1 and at most kMaxSize bytes long
+                     */
+                    bool SetModulus (const std::uint8_t *bytes, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Get the number of limbs of the modulus.
+                     * @return std::size_t
+                     */
+                    std::size_t GetLimbCount () const noexcept
+                    {
+                        return mLimbCount;
+                    }
+
+                    /**
+                     * @brief Check if Exponentiate() uses the AVX-512 IFMA kernel.
+                     * @return true if the CPU supports AVX-512 IFMA and a modulus is set
+                     */
+                    bool IsAccelerated () const noexcept
+                    {
+                        return mVectorCount != 0u;
+                    }
+
+                    /**
+                     * @brief Get the length of the modulus in bits.
+                     * @return std::size_t
+                     */
+                    std::size_t GetBitLength () const noexcept;
+
+                    /**
+                     * @brief Get the modulus.
+                     * @return const Element&
+                     */
+                    const Element& GetModulus () const noexcept
+                    {
+                        return mModulus;
+                    }
+
+                    /**
+                     * @brief Decode a big-endian integer that must be below the modulus.
+                     * @param[out] r the integer in the ordinary (not Montgomery) form
+                     * @param[in] bytes the integer
+                     * @param[in] size size of the integer in bytes
+                     * @return true if the integer is below the modulus
+                     */
+                    bool Decode (Element &r, const std::uint8_t *bytes, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Encode a residue to a big-endian integer of a fixed size.
+                     * @param[out] bytes the encoding
+                     * @param[in] size size of the encoding in bytes
+                     * @param[in] a the residue in the ordinary form
+                     */
+                    void Encode (std::uint8_t *bytes, std::size_t size, const Element &a) const noexcept;
+
+                    /**
+                     * @brief Reduce an integer of up to twice the limbs of the modulus and convert it to the
+                     * Montgomery form. The integer must be below m * R (e.g. a residue of a product of m and a
+                     * smaller modulus).
+                     * @param[out] r the residue in the Montgomery form
+                     * @param[in] limbs the little-endian limbs of the integer
+                     * @param[in] limbCount number of the limbs (at most 2 * GetLimbCount())
+                     */
+                    void Reduce (Element &r, const std::uint64_t *limbs, std::size_t limbCount) const noexcept;
+
+                    /**
+                     * @brief Convert a reduced residue to the Montgomery form (a * R mod m).
+                     */
+                    void ToMontgomery (Element &r, const Element &a) const noexcept;
+
+                    /**
+                     * @brief Convert a residue from the Montgomery form (a / R mod m).
+                     */
+                    void FromMontgomery (Element &r, const Element &a) const noexcept;
+
+                    /**
+                     * @brief Montgomery product r = a * b / R mod m. The argument b must be reduced, a may be any
+                     * value below R.
+                     */
+                    void Multiply (Element &r, const Element &a, const Element &b) const noexcept;
+
+                    /**
+                     * @brief Modular sum r = a + b mod m of reduced arguments (in any, but the same, form).
+                     */
+                    void Add (Element &r, const Element &a, const Element &b) const noexcept;
+
+                    /**
+                     * @brief Modular difference r = a - b mod m of reduced arguments (in any, but the same, form).
+                     */
+                    void Subtract (Element &r, const Element &a, const Element &b) const noexcept;
+
+                    /**
+                     * @brief Modular exponentiation by a secret exponent with a fixed 4-bit window: the sequence of
+                     * operations and the memory accesses do not depend on the exponent.
+                     * @param[out] r the power in the Montgomery form
+                     * @param[in] base the base in the Montgomery form
+                     * @param[in] exponent the big-endian exponent
+                     * @param[in] size size of the exponent in bytes
+                     */
+                    void Exponentiate (Element &r, const Element &base, const std::uint8_t *exponent, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Two modular exponentiations by secret exponents as by Exponentiate(), e.g. the halves of
+                     * an RSA private operation by the CRT. If both moduli have the same number of limbs, the IFMA
+                     * kernel interleaves the two chains of products, so each one hides the latency of the other.
+                     * @param[in] modulus1 the modulus of the first exponentiation
+                     * @param[in,out] power1 the first exponentiation
+                     * @param[in] modulus2 the modulus of the second exponentiation
+                     * @param[in,out] power2 the second exponentiation
+                     */
+                    static void ExponentiatePair (const BigModulus &modulus1, const Power &power1, const BigModulus &modulus2, const Power &power2) noexcept;
+
+                    /**
+                     * @brief Modular exponentiation by a public exponent (e.g. the RSA public exponent) by the
+                     * left-to-right binary method; the time depends on the exponent.
+                     * @param[out] r the power in the Montgomery form
+                     * @param[in] base the base in the Montgomery form
+                     * @param[in] exponent the big-endian exponent
+                     * @param[in] size size of the exponent in bytes
+                     */
+                    void ExponentiatePublic (Element &r, const Element &base, const std::uint8_t *exponent, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Check (in constant time) if two residues are equal.
+                     * @return true if the leading GetLimbCount() limbs are equal
+                     */
+                    bool IsEqual (const Element &a, const Element &b) const noexcept;
+
+                    /**
+                     * @brief Wipe the modulus and the Montgomery constants.
+                     */
+                    void Clear () noexcept;
+
+                private:
+
+                    // Maximal number of 52-bit digits: 4096 bits plus 2 bits of headroom, rounded up to whole vectors.
+                    static const std::size_t kMaxDigits = 80u;
+
+                    void ReduceOnce (Element &r, const std::uint64_t *t, std::uint64_t carry) const noexcept;
+
+                    static void ExponentiateAccelerated (const BigModulus *const moduli[], const Power *powers, std::size_t count) noexcept;
+
+                    Element mModulus;
+                    Element mOne;           // R mod m
+                    Element mR2;            // R^2 mod m
+                    Element mR3;            // R^3 mod m
+                    std::uint64_t mInverse; // -m^-1 mod 2^64
+                    std::size_t mLimbCount;
+                    std::uint64_t mDigitModulus[kMaxDigits];    // m in 52-bit digits
+                    std::uint64_t mDigitR2[kMaxDigits];         // R'^2 mod m in 52-bit digits, R' = 2^(52 * digits)
+                    std::uint64_t mDigitInverse;                // -m^-1 mod 2^52
+                    std::size_t mVectorCount;                   // 8 digits per vector, 0 if the IFMA kernel is not used
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_BIG_MODULUS_H
@@ -0,0 +1,141 @@
+#include "ara/crypto/cryp/internal/chacha20.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    inline std::uint32_t RotateLeft (std::uint32_t value, unsigned bits) noexcept
+                    {
+                        return (value << bits) | (value >> (32u - bits));
+                    }
+
+                    inline std::uint32_t LoadLe32 (const std::uint8_t *bytes) noexcept
+                    {
+                        return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+                               (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+                    }
+
+                    inline void QuarterRound (std::uint32_t *x, std::size_t a, std::size_t b, std::size_t c, std::size_t d) noexcept
+                    {
+                        x[a] += x[b]; x[d] = RotateLeft(x[d] ^ x[a], 16u);
+                        x[c] += x[d]; x[b] = RotateLeft(x[b] ^ x[c], 12u);
+                        x[a] += x[b]; x[d] = RotateLeft(x[d] ^ x[a], 8u);
+                        x[c] += x[d]; x[b] = RotateLeft(x[b] ^ x[c], 7u);
+                    }
+
+                    void InitState (const std::uint8_t *key, const std::uint8_t *nonce, std::uint32_t counter, std::uint32_t state[16]) noexcept
+                    {
+                        state[0] = 0x61707865u;
+                        state[1] = 0x3320646eu;
+                        state[2] = 0x79622d32u;
+                        state[3] = 0x6b206574u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            state[4u + i] = LoadLe32(key + 4u * i);
+                        }
+                        state[12] = counter;
+                        for (std::size_t i = 0; i < 3u; ++i)
+                        {
+                            state[13u + i] = LoadLe32(nonce + 4u * i);
+                        }
+                    }
+
+                    void ComputeBlock (const std::uint32_t state[16], std::uint8_t *block) noexcept
+                    {
+                        std::uint32_t x[16];
+                        for (std::size_t i = 0; i < 16u; ++i)
+                        {
+                            x[i] = state[i];
+                        }
+                        for (std::size_t round = 0; round < 10u; ++round)
+                        {
+                            QuarterRound(x, 0u, 4u, 8u, 12u);
+                            QuarterRound(x, 1u, 5u, 9u, 13u);
+                            QuarterRound(x, 2u, 6u, 10u, 14u);
+                            QuarterRound(x, 3u, 7u, 11u, 15u);
+                            QuarterRound(x, 0u, 5u, 10u, 15u);
+                            QuarterRound(x, 1u, 6u, 11u, 12u);
+                            QuarterRound(x, 2u, 7u, 8u, 13u);
+                            QuarterRound(x, 3u, 4u, 9u, 14u);
+                        }
+                        for (std::size_t i = 0; i < 16u; ++i)
+                        {
+                            const std::uint32_t word = x[i] + state[i];
+                            block[4u * i] = static_cast<std::uint8_t>(word);
+                            block[4u * i + 1u] = static_cast<std::uint8_t>(word >> 8);
+                            block[4u * i + 2u] = static_cast<std::uint8_t>(word >> 16);
+                            block[4u * i + 3u] = static_cast<std::uint8_t>(word >> 24);
+                        }
+                    }
+
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+                }
+
+                void ChaCha20::Block (const std::uint8_t key[kKeySize], const std::uint8_t nonce[kNonceSize], std::uint32_t counter, std::uint8_t block[kBlockSize]) noexcept
+                {
+                    std::uint32_t state[16];
+                    InitState(key, nonce, counter, state);
+                    ComputeBlock(state, block);
+                    Wipe(state, sizeof(state));
+                }
+
+                void ChaCha20::Xor (const std::uint8_t key[kKeySize], const std::uint8_t nonce[kNonceSize], std::uint32_t counter, const std::uint8_t *in, std::uint8_t *out, std::size_t size) noexcept
+                {
+                    std::uint32_t state[16];
+                    std::uint8_t block[kBlockSize];
+                    InitState(key, nonce, counter, state);
+                    while (size != 0u)
+                    {
+                        ComputeBlock(state, block);
+                        ++state[12];
+                        const std::size_t length = (size < kBlockSize) ? size : kBlockSize;
+                        for (std::size_t i = 0; i < length; ++i)
+                        {
+                            out[i] = static_cast<std::uint8_t>(in[i] ^ block[i]);
+                        }
+                        in += length;
+                        out += length;
+                        size -= length;
+                    }
+                    Wipe(state, sizeof(state));
+                    Wipe(block, sizeof(block));
+                }
+
+                void ChaCha20::KeyStream (const std::uint8_t key[kKeySize], const std::uint8_t nonce[kNonceSize], std::uint32_t counter, std::uint8_t *out, std::size_t size) noexcept
+                {
+                    std::uint32_t state[16];
+                    InitState(key, nonce, counter, state);
+                    for (; size >= kBlockSize; size -= kBlockSize, out += kBlockSize)
+                    {
+                        ComputeBlock(state, out);
+                        ++state[12];
+                    }
+                    if (size != 0u)
+                    {
+                        std::uint8_t block[kBlockSize];
+                        ComputeBlock(state, block);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            out[i] = block[i];
+                        }
+                        Wipe(block, sizeof(block));
+                    }
+                    Wipe(state, sizeof(state));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_CHACHA20_H
+#define ARA_CRYPTO_CRYP_INTERNAL_CHACHA20_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief ChaCha20 stream cipher with the 96-bit nonce and 32-bit block counter (RFC 8439).
+                 */
+                class ChaCha20
+                {
+                public:
+
+                    /**
+                     * @brief Size of the key in bytes.
+                     */
+                    static const std::size_t kKeySize = 32u;
+
+                    /**
+                     * @brief Size of the nonce in bytes.
+                     */
+                    static const std::size_t kNonceSize = 12u;
+
+                    /**
+                     * @brief Size of the key stream block in bytes.
+                     */
+                    static const std::size_t kBlockSize = 64u;
+
+                    /**
+                     * @brief Compute a single key stream block.
+                     * @param[in] key the key
+                     * @param[in] nonce the nonce
+                     * @param[in] counter the block counter
+                     * @param[out] block the key stream block of kBlockSize bytes
+                     */
+                    static void Block (const std::uint8_t key[kKeySize], const std::uint8_t nonce[kNonceSize], std::uint32_t counter, std::uint8_t block[kBlockSize]) noexcept;
+
+                    /**
+                     * @brief XOR data with the key stream starting at a block: out = in XOR keystream. The input and
+                     * output buffers may be identical. A partial last block consumes a whole key stream block.
+                     * @param[in] key the key
+                     * @param[in] nonce the nonce
+                     * @param[in] counter the block counter of the first key stream block
+                     * @param[in] in the input data
+                     * @param[out] out the output data
+                     * @param[in] size size of the data in bytes
+                     */
+                    static void Xor (const std::uint8_t key[kKeySize], const std::uint8_t nonce[kNonceSize], std::uint32_t counter, const std::uint8_t *in, std::uint8_t *out, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Write the key stream starting at a block: out = keystream.
+                     * @param[in] key the key
+                     * @param[in] nonce the nonce
+                     * @param[in] counter the block counter of the first key stream block
+                     * @param[out] out the output buffer
+                     * @param[in] size size of the output in bytes
+                     */
+                    static void KeyStream (const std::uint8_t key[kKeySize], const std::uint8_t nonce[kNonceSize], std::uint32_t counter, std::uint8_t *out, std::size_t size) noexcept;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_CHACHA20_H
@@ -0,0 +1,141 @@
+#include "ara/crypto/cryp/internal/cmac.h"
+
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    // Doubling in GF(2^128): shift left by one bit, reduce by 0x87 if the top bit was set.
+                    void Double (const std::uint8_t in[Aes::kBlockSize], std::uint8_t out[Aes::kBlockSize]) noexcept
+                    {
+                        const std::uint8_t mask = static_cast<std::uint8_t>(0u - (in[0] >> 7));
+                        for (std::size_t i = 0; i < (Aes::kBlockSize - 1u); ++i)
+                        {
+                            out[i] = static_cast<std::uint8_t>((in[i] << 1) | (in[i + 1u] >> 7));
+                        }
+                        out[Aes::kBlockSize - 1u] = static_cast<std::uint8_t>((in[Aes::kBlockSize - 1u] << 1) ^ (0x87u & mask));
+                    }
+                }
+
+                Cmac::Cmac () noexcept : mBuffered(0u)
+                {
+                    std::memset(mK1, 0, sizeof(mK1));
+                    std::memset(mK2, 0, sizeof(mK2));
+                    std::memset(mState, 0, sizeof(mState));
+                    std::memset(mBuffer, 0, sizeof(mBuffer));
+                }
+
+                Cmac::~Cmac () noexcept
+                {
+                    Clear();
+                }
+
+                bool Cmac::SetKey (const std::uint8_t *key, std::size_t keySize) noexcept
+                {
+                    if (!mAes.SetKey(key, keySize))
+                    {
+                        return false;
+                    }
+                    std::uint8_t l[Aes::kBlockSize] = {};
+                    mAes.EncryptBlocks(l, l, 1u);
+                    Double(l, mK1);
+                    Double(mK1, mK2);
+                    SecureWipe(l, sizeof(l));
+                    Start();
+                    return true;
+                }
+
+                void Cmac::Start () noexcept
+                {
+                    std::memset(mState, 0, sizeof(mState));
+                    mBuffered = 0u;
+                }
+
+                void Cmac::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    // A full buffer is absorbed only when more data follows, the final block stays buffered.
+                    if (size == 0u)
+                    {
+                        return;
+                    }
+                    if (mBuffered != 0u)
+                    {
+                        const std::size_t taken = (size < (Aes::kBlockSize - mBuffered)) ? size : (Aes::kBlockSize - mBuffered);
+                        std::memcpy(mBuffer + mBuffered, data, taken);
+                        mBuffered += taken;
+                        data += taken;
+                        size -= taken;
+                        if (size == 0u)
+                        {
+                            return;
+                        }
+                        mAes.MacCbc(mState, mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+
+                    const std::size_t blockCount = (size - 1u) / Aes::kBlockSize;
+                    if (blockCount != 0u)
+                    {
+                        mAes.MacCbc(mState, data, blockCount);
+                        data += blockCount * Aes::kBlockSize;
+                        size -= blockCount * Aes::kBlockSize;
+                    }
+                    std::memcpy(mBuffer, data, size);
+                    mBuffered = size;
+                }
+
+                void Cmac::Finish (std::uint8_t *mac) noexcept
+                {
+                    std::uint8_t last[Aes::kBlockSize];
+                    if (mBuffered == Aes::kBlockSize)
+                    {
+                        for (std::size_t i = 0; i < Aes::kBlockSize; ++i)
+                        {
+                            last[i] = mBuffer[i] ^ mK1[i];
+                        }
+                    }
+                    else
+                    {
+                        std::memset(mBuffer + mBuffered, 0, Aes::kBlockSize - mBuffered);
+                        mBuffer[mBuffered] = 0x80u;
+                        for (std::size_t i = 0; i < Aes::kBlockSize; ++i)
+                        {
+                            last[i] = mBuffer[i] ^ mK2[i];
+                        }
+                    }
+                    mAes.MacCbc(mState, last, 1u);
+                    std::memcpy(mac, mState, kDigestSize);
+                    SecureWipe(last, sizeof(last));
+                    SecureWipe(mBuffer, sizeof(mBuffer));
+                    Start();
+                }
+
+                void Cmac::Clear () noexcept
+                {
+                    mAes.Clear();
+                    SecureWipe(mK1, sizeof(mK1));
+                    SecureWipe(mK2, sizeof(mK2));
+                    SecureWipe(mState, sizeof(mState));
+                    SecureWipe(mBuffer, sizeof(mBuffer));
+                    mBuffered = 0u;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_CMAC_H
+#define ARA_CRYPTO_CRYP_INTERNAL_CMAC_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/aes.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief CMAC over AES (NIST SP 800-38B, RFC 4493). The key schedule and the subkeys K1 and K2
+                 * are computed once by SetKey(), so Start() only clears the chaining state. The full blocks of
+                 * a message are absorbed by the CBC-MAC kernel of Aes (AES-NI if available); the last block is
+                 * held back until Finish() because it is masked by a subkey. The object is copyable, so the
+                 * keyed state can be saved and restored.
+                 */
+                class Cmac
+                {
+                public:
+
+                    /**
+                     * @brief Size of the block and of the MAC in bytes.
+                     */
+                    static const std::size_t kDigestSize = Aes::kBlockSize;
+
+                    Cmac () noexcept;
+
+                    /**
+                     * @brief Destroy the Cmac object wiping the keyed state.
+                     */
+                    ~Cmac () noexcept;
+
+                    /**
+                     * @brief Deploy a key and start a new computation.
+                     * @param[in] key the AES key
+                     * @param[in] keySize size of the key in bytes: 16, 24 or 32
+                     * @return false if the key size is invalid
+                     */
+                    bool SetKey (const std::uint8_t *key, std::size_t keySize) noexcept;
+
+                    /**
+                     * @brief Check if a key is deployed.
+                     * @return true if SetKey() has succeeded
+                     */
+                    bool IsKeySet () const noexcept
+                    {
+                        return mAes.IsKeySet();
+                    }
+
+                    /**
+                     * @brief Restart the computation with the deployed key.
+                     */
+                    void Start () noexcept;
+
+                    /**
+                     * @brief Authenticate a portion of the message.
+                     * @param[in] data the message portion
+                     * @param[in] size size of the portion in bytes
+                     */
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Finish the computation and restart it with the deployed key.
+                     * @param[out] mac the MAC value of kDigestSize bytes
+                     */
+                    void Finish (std::uint8_t *mac) noexcept;
+
+                    /**
+                     * @brief Wipe the keyed state.
+                     */
+                    void Clear () noexcept;
+
+                private:
+                    Aes mAes;
+                    std::uint8_t mK1[Aes::kBlockSize];
+                    std::uint8_t mK2[Aes::kBlockSize];
+                    std::uint8_t mState[Aes::kBlockSize];
+                    std::uint8_t mBuffer[Aes::kBlockSize];
+                    std::size_t mBuffered;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_CMAC_H
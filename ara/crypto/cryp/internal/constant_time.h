@@ -0,0 +1,38 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_CONSTANT_TIME_H
+#define ARA_CRYPTO_CRYP_INTERNAL_CONSTANT_TIME_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Compare two byte sequences of the same size in constant time. The running time depends on
+                 * the size only, never on the position of the first difference, so comparing a received
+                 * authentication tag does not leak how many of its leading bytes were correct.
+                 * @param[in] first the first sequence
+                 * @param[in] second the second sequence
+                 * @param[in] size size of both sequences in bytes
+                 * @return true if the sequences are equal
+                 */
+                inline bool ConstantTimeEqual (const std::uint8_t *first, const std::uint8_t *second, std::size_t size) noexcept
+                {
+                    volatile std::uint8_t difference = 0u;
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        difference = difference | static_cast<std::uint8_t>(first[i] ^ second[i]);
+                    }
+                    return difference == 0u;
+                }
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_CONSTANT_TIME_H
@@ -0,0 +1,821 @@
+#include "ara/crypto/cryp/internal/curve25519.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    using Fe = Curve25519::FieldElement;
+                    using Point = Curve25519::Point;
+                    using Wide = unsigned __int128;
+
+                    const std::uint64_t kMask51 = (1ull << 51) - 1u;
+
+                    // d of the Edwards curve, d = -121665/121666
+                    const Fe kD = {{0x34dca135978a3ull, 0x1a8283b156ebdull, 0x5e7a26001c029ull, 0x739c663a03cbbull, 0x52036cee2b6ffull}};
+                    const Fe kD2 = {{0x69b9426b2f159ull, 0x35050762add7aull, 0x3cf44c0038052ull, 0x6738cc7407977ull, 0x2406d9dc56dffull}};
+
+                    // The base point: y = 4/5 and positive x
+                    const Fe kBaseX = {{0x62d608f25d51aull, 0x412a4b4f6592aull, 0x75b7171a4b31dull, 0x1ff60527118feull, 0x216936d3cd6e5ull}};
+                    const Fe kBaseY = {{0x6666666666658ull, 0x4ccccccccccccull, 0x1999999999999ull, 0x3333333333333ull, 0x6666666666666ull}};
+
+                    // A square root of -1: 2^((p - 1) / 4)
+                    const Fe kSqrtM1 = {{0x61b274a0ea0b0ull, 0x0d5a5fc8f189dull, 0x7ef5e9cbd0c60ull, 0x78595a6804c9eull, 0x2b8324804fc1dull}};
+
+                    // (A - 2) / 4 of the Montgomery curve
+                    const std::uint64_t kA24 = 121665u;
+
+                    inline std::uint64_t Load64 (const std::uint8_t *bytes) noexcept
+                    {
+                        std::uint64_t value = 0u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            value |= static_cast<std::uint64_t>(bytes[i]) << (8u * i);
+                        }
+                        return value;
+                    }
+
+                    inline void Store64 (std::uint64_t value, std::uint8_t *bytes) noexcept
+                    {
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            bytes[i] = static_cast<std::uint8_t>(value >> (8u * i));
+                        }
+                    }
+
+                    inline void FeZero (Fe &h) noexcept
+                    {
+                        h = Fe{{0u, 0u, 0u, 0u, 0u}};
+                    }
+
+                    inline void FeOne (Fe &h) noexcept
+                    {
+                        h = Fe{{1u, 0u, 0u, 0u, 0u}};
+                    }
+
+                    // Reduce the limbs to 51 bits (plus a small excess of the second limb).
+                    inline void FeCarry (Fe &h) noexcept
+                    {
+                        std::uint64_t *l = h.mLimb;
+                        l[1] += l[0] >> 51; l[0] &= kMask51;
+                        l[2] += l[1] >> 51; l[1] &= kMask51;
+                        l[3] += l[2] >> 51; l[2] &= kMask51;
+                        l[4] += l[3] >> 51; l[3] &= kMask51;
+                        l[0] += 19u * (l[4] >> 51); l[4] &= kMask51;
+                        l[1] += l[0] >> 51; l[0] &= kMask51;
+                    }
+
+                    inline void FeAdd (Fe &h, const Fe &f, const Fe &g) noexcept
+                    {
+                        for (std::size_t i = 0; i < 5u; ++i)
+                        {
+                            h.mLimb[i] = f.mLimb[i] + g.mLimb[i];
+                        }
+                        FeCarry(h);
+                    }
+
+                    inline void FeSub (Fe &h, const Fe &f, const Fe &g) noexcept
+                    {
+                        // f + 2p - g keeps the limbs non-negative
+                        h.mLimb[0] = f.mLimb[0] + 0xFFFFFFFFFFFDAull - g.mLimb[0];
+                        for (std::size_t i = 1; i < 5u; ++i)
+                        {
+                            h.mLimb[i] = f.mLimb[i] + 0xFFFFFFFFFFFFEull - g.mLimb[i];
+                        }
+                        FeCarry(h);
+                    }
+
+                    inline void FeNeg (Fe &h, const Fe &f) noexcept
+                    {
+                        Fe zero;
+                        FeZero(zero);
+                        FeSub(h, zero, f);
+                    }
+
+                    inline void FeReduceWide (Fe &h, Wide r0, Wide r1, Wide r2, Wide r3, Wide r4) noexcept
+                    {
+                        r1 += static_cast<std::uint64_t>(r0 >> 51);
+                        r2 += static_cast<std::uint64_t>(r1 >> 51);
+                        r3 += static_cast<std::uint64_t>(r2 >> 51);
+                        r4 += static_cast<std::uint64_t>(r3 >> 51);
+                        h.mLimb[0] = (static_cast<std::uint64_t>(r0) & kMask51) + 19u * static_cast<std::uint64_t>(r4 >> 51);
+                        h.mLimb[1] = static_cast<std::uint64_t>(r1) & kMask51;
+                        h.mLimb[2] = static_cast<std::uint64_t>(r2) & kMask51;
+                        h.mLimb[3] = static_cast<std::uint64_t>(r3) & kMask51;
+                        h.mLimb[4] = static_cast<std::uint64_t>(r4) & kMask51;
+                        h.mLimb[1] += h.mLimb[0] >> 51;
+                        h.mLimb[0] &= kMask51;
+                    }
+
+                    void FeMul (Fe &h, const Fe &f, const Fe &g) noexcept
+                    {
+                        const std::uint64_t f0 = f.mLimb[0], f1 = f.mLimb[1], f2 = f.mLimb[2], f3 = f.mLimb[3], f4 = f.mLimb[4];
+                        const std::uint64_t g0 = g.mLimb[0], g1 = g.mLimb[1], g2 = g.mLimb[2], g3 = g.mLimb[3], g4 = g.mLimb[4];
+                        const std::uint64_t g1_19 = 19u * g1, g2_19 = 19u * g2, g3_19 = 19u * g3, g4_19 = 19u * g4;
+
+                        const Wide r0 = (Wide)f0 * g0 + (Wide)f1 * g4_19 + (Wide)f2 * g3_19 + (Wide)f3 * g2_19 + (Wide)f4 * g1_19;
+                        const Wide r1 = (Wide)f0 * g1 + (Wide)f1 * g0 + (Wide)f2 * g4_19 + (Wide)f3 * g3_19 + (Wide)f4 * g2_19;
+                        const Wide r2 = (Wide)f0 * g2 + (Wide)f1 * g1 + (Wide)f2 * g0 + (Wide)f3 * g4_19 + (Wide)f4 * g3_19;
+                        const Wide r3 = (Wide)f0 * g3 + (Wide)f1 * g2 + (Wide)f2 * g1 + (Wide)f3 * g0 + (Wide)f4 * g4_19;
+                        const Wide r4 = (Wide)f0 * g4 + (Wide)f1 * g3 + (Wide)f2 * g2 + (Wide)f3 * g1 + (Wide)f4 * g0;
+                        FeReduceWide(h, r0, r1, r2, r3, r4);
+                    }
+
+                    void FeSquare (Fe &h, const Fe &f) noexcept
+                    {
+                        const std::uint64_t f0 = f.mLimb[0], f1 = f.mLimb[1], f2 = f.mLimb[2], f3 = f.mLimb[3], f4 = f.mLimb[4];
+                        const std::uint64_t f0_2 = 2u * f0, f1_2 = 2u * f1, f2_2 = 2u * f2, f3_2 = 2u * f3;
+                        const std::uint64_t f3_19 = 19u * f3, f4_19 = 19u * f4;
+
+                        const Wide r0 = (Wide)f0 * f0 + (Wide)f1_2 * f4_19 + (Wide)f2_2 * f3_19;
+                        const Wide r1 = (Wide)f0_2 * f1 + (Wide)f2_2 * f4_19 + (Wide)f3 * f3_19;
+                        const Wide r2 = (Wide)f0_2 * f2 + (Wide)f1 * f1 + (Wide)f3_2 * f4_19;
+                        const Wide r3 = (Wide)f0_2 * f3 + (Wide)f1_2 * f2 + (Wide)f4 * f4_19;
+                        const Wide r4 = (Wide)f0_2 * f4 + (Wide)f1_2 * f3 + (Wide)f2 * f2;
+                        FeReduceWide(h, r0, r1, r2, r3, r4);
+                    }
+
+                    void FeSquareTimes (Fe &h, const Fe &f, unsigned count) noexcept
+                    {
+                        FeSquare(h, f);
+                        for (unsigned i = 1; i < count; ++i)
+                        {
+                            FeSquare(h, h);
+                        }
+                    }
+
+                    void FeMulSmall (Fe &h, const Fe &f, std::uint64_t g) noexcept
+                    {
+                        FeReduceWide(h, (Wide)f.mLimb[0] * g, (Wide)f.mLimb[1] * g, (Wide)f.mLimb[2] * g, (Wide)f.mLimb[3] * g, (Wide)f.mLimb[4] * g);
+                    }
+
+                    // z^(p - 2) by the addition chain of ref10
+                    void FeInvert (Fe &out, const Fe &z) noexcept
+                    {
+                        Fe t0, t1, t2, t3;
+                        FeSquare(t0, z);                // 2
+                        FeSquareTimes(t1, t0, 2u);      // 8
+                        FeMul(t1, z, t1);               // 9
+                        FeMul(t0, t0, t1);              // 11
+                        FeSquare(t2, t0);               // 22
+                        FeMul(t1, t1, t2);              // 2^5 - 1
+                        FeSquareTimes(t2, t1, 5u);
+                        FeMul(t1, t2, t1);              // 2^10 - 1
+                        FeSquareTimes(t2, t1, 10u);
+                        FeMul(t2, t2, t1);              // 2^20 - 1
+                        FeSquareTimes(t3, t2, 20u);
+                        FeMul(t2, t3, t2);              // 2^40 - 1
+                        FeSquareTimes(t2, t2, 10u);
+                        FeMul(t1, t2, t1);              // 2^50 - 1
+                        FeSquareTimes(t2, t1, 50u);
+                        FeMul(t2, t2, t1);              // 2^100 - 1
+                        FeSquareTimes(t3, t2, 100u);
+                        FeMul(t2, t3, t2);              // 2^200 - 1
+                        FeSquareTimes(t2, t2, 50u);
+                        FeMul(t1, t2, t1);              // 2^250 - 1
+                        FeSquareTimes(t1, t1, 5u);
+                        FeMul(out, t1, t0);             // 2^255 - 21
+                    }
+
+                    // z^((p - 5) / 8) = z^(2^252 - 3) for the square root of the point decoding
+                    void FePow22523 (Fe &out, const Fe &z) noexcept
+                    {
+                        Fe t0, t1, t2;
+                        FeSquare(t0, z);                // 2
+                        FeSquareTimes(t1, t0, 2u);      // 8
+                        FeMul(t1, z, t1);               // 9
+                        FeMul(t0, t0, t1);              // 11
+                        FeSquare(t0, t0);               // 22
+                        FeMul(t0, t1, t0);              // 2^5 - 1
+                        FeSquareTimes(t1, t0, 5u);
+                        FeMul(t0, t1, t0);              // 2^10 - 1
+                        FeSquareTimes(t1, t0, 10u);
+                        FeMul(t1, t1, t0);              // 2^20 - 1
+                        FeSquareTimes(t2, t1, 20u);
+                        FeMul(t1, t2, t1);              // 2^40 - 1
+                        FeSquareTimes(t1, t1, 10u);
+                        FeMul(t0, t1, t0);              // 2^50 - 1
+                        FeSquareTimes(t1, t0, 50u);
+                        FeMul(t1, t1, t0);              // 2^100 - 1
+                        FeSquareTimes(t2, t1, 100u);
+                        FeMul(t1, t2, t1);              // 2^200 - 1
+                        FeSquareTimes(t1, t1, 50u);
+                        FeMul(t0, t1, t0);              // 2^250 - 1
+                        FeSquareTimes(t0, t0, 2u);
+                        FeMul(out, t0, z);              // 2^252 - 3
+                    }
+
+                    void FeFromBytes (Fe &h, const std::uint8_t *s) noexcept
+                    {
+                        h.mLimb[0] = Load64(s) & kMask51;
+                        h.mLimb[1] = (Load64(s + 6) >> 3) & kMask51;
+                        h.mLimb[2] = (Load64(s + 12) >> 6) & kMask51;
+                        h.mLimb[3] = (Load64(s + 19) >> 1) & kMask51;
+                        h.mLimb[4] = (Load64(s + 24) >> 12) & kMask51;
+                    }
+
+                    void FeToBytes (std::uint8_t *s, const Fe &f) noexcept
+                    {
+                        Fe h = f;
+                        FeCarry(h);
+                        FeCarry(h);
+
+                        // q = 1 if h >= p, computed as the carry of h + 19 out of 2^255
+                        std::uint64_t q = (h.mLimb[0] + 19u) >> 51;
+                        q = (h.mLimb[1] + q) >> 51;
+                        q = (h.mLimb[2] + q) >> 51;
+                        q = (h.mLimb[3] + q) >> 51;
+                        q = (h.mLimb[4] + q) >> 51;
+
+                        h.mLimb[0] += 19u * q;
+                        h.mLimb[1] += h.mLimb[0] >> 51; h.mLimb[0] &= kMask51;
+                        h.mLimb[2] += h.mLimb[1] >> 51; h.mLimb[1] &= kMask51;
+                        h.mLimb[3] += h.mLimb[2] >> 51; h.mLimb[2] &= kMask51;
+                        h.mLimb[4] += h.mLimb[3] >> 51; h.mLimb[3] &= kMask51;
+                        h.mLimb[4] &= kMask51;
+
+                        Store64(h.mLimb[0] | (h.mLimb[1] << 51), s);
+                        Store64((h.mLimb[1] >> 13) | (h.mLimb[2] << 38), s + 8);
+                        Store64((h.mLimb[2] >> 26) | (h.mLimb[3] << 25), s + 16);
+                        Store64((h.mLimb[3] >> 39) | (h.mLimb[4] << 12), s + 24);
+                    }
+
+                    inline void FeCswap (Fe &f, Fe &g, std::uint64_t bit) noexcept
+                    {
+                        const std::uint64_t mask = 0u - bit;
+                        for (std::size_t i = 0; i < 5u; ++i)
+                        {
+                            const std::uint64_t x = mask & (f.mLimb[i] ^ g.mLimb[i]);
+                            f.mLimb[i] ^= x;
+                            g.mLimb[i] ^= x;
+                        }
+                    }
+
+                    inline void FeCmov (Fe &f, const Fe &g, std::uint64_t bit) noexcept
+                    {
+                        const std::uint64_t mask = 0u - bit;
+                        for (std::size_t i = 0; i < 5u; ++i)
+                        {
+                            f.mLimb[i] ^= mask & (f.mLimb[i] ^ g.mLimb[i]);
+                        }
+                    }
+
+                    /**
+                     * @brief Affine point in the form used by the mixed addition: (y + x, y - x, 2dxy).
+                     */
+                    struct Precomputed
+                    {
+                        Fe mYPlusX;
+                        Fe mYMinusX;
+                        Fe mXY2D;
+                    };
+
+                    void PointIdentity (Point &p) noexcept
+                    {
+                        FeZero(p.mX);
+                        FeOne(p.mY);
+                        FeOne(p.mZ);
+                        FeZero(p.mT);
+                    }
+
+                    // Convert the completed point ((X : Z), (Y : T)) to the extended coordinates.
+                    inline void FromCompleted (Point &r, const Fe &x, const Fe &y, const Fe &z, const Fe &t) noexcept
+                    {
+                        FeMul(r.mX, x, t);
+                        FeMul(r.mY, y, z);
+                        FeMul(r.mZ, z, t);
+                        FeMul(r.mT, x, y);
+                    }
+
+                    void PointDouble (Point &r, const Point &p) noexcept
+                    {
+                        Fe xx, yy, b, a, aa, x, y, z, t;
+                        FeSquare(xx, p.mX);
+                        FeSquare(yy, p.mY);
+                        FeSquare(b, p.mZ);
+                        FeAdd(b, b, b);
+                        FeAdd(a, p.mX, p.mY);
+                        FeSquare(aa, a);
+                        FeAdd(y, yy, xx);
+                        FeSub(z, yy, xx);
+                        FeSub(x, aa, y);
+                        FeSub(t, b, z);
+                        FromCompleted(r, x, y, z, t);
+                    }
+
+                    void PointAddPrecomputed (Point &r, const Point &p, const Precomputed &q) noexcept
+                    {
+                        Fe a, b, c, d, x, y, z, t;
+                        FeAdd(a, p.mY, p.mX);
+                        FeSub(b, p.mY, p.mX);
+                        FeMul(a, a, q.mYPlusX);
+                        FeMul(b, b, q.mYMinusX);
+                        FeMul(c, q.mXY2D, p.mT);
+                        FeAdd(d, p.mZ, p.mZ);
+                        FeSub(x, a, b);
+                        FeAdd(y, a, b);
+                        FeAdd(z, d, c);
+                        FeSub(t, d, c);
+                        FromCompleted(r, x, y, z, t);
+                    }
+
+                    void ToPrecomputed (Precomputed &r, const Point &p) noexcept
+                    {
+                        Fe zInverse, x, y;
+                        FeInvert(zInverse, p.mZ);
+                        FeMul(x, p.mX, zInverse);
+                        FeMul(y, p.mY, zInverse);
+                        FeAdd(r.mYPlusX, y, x);
+                        FeSub(r.mYMinusX, y, x);
+                        FeMul(r.mXY2D, x, y);
+                        FeMul(r.mXY2D, r.mXY2D, kD2);
+                    }
+
+                    // Variable time, for public values only.
+                    bool FeIsZero (const Fe &f) noexcept
+                    {
+                        std::uint8_t bytes[Curve25519::kSize];
+                        FeToBytes(bytes, f);
+                        std::uint8_t accumulated = 0u;
+                        for (std::size_t i = 0; i < Curve25519::kSize; ++i)
+                        {
+                            accumulated |= bytes[i];
+                        }
+                        return (accumulated == 0u);
+                    }
+
+                    /**
+                     * @brief Projective point in the form used by the general addition: (Y + X, Y - X, 2Z, 2dT).
+                     */
+                    struct Cached
+                    {
+                        Fe mYPlusX;
+                        Fe mYMinusX;
+                        Fe mZ2;
+                        Fe mT2D;
+                    };
+
+                    void ToCached (Cached &r, const Point &p) noexcept
+                    {
+                        FeAdd(r.mYPlusX, p.mY, p.mX);
+                        FeSub(r.mYMinusX, p.mY, p.mX);
+                        FeAdd(r.mZ2, p.mZ, p.mZ);
+                        FeMul(r.mT2D, p.mT, kD2);
+                    }
+
+                    void PointAddCached (Point &r, const Point &p, const Cached &q) noexcept
+                    {
+                        Fe a, b, c, d, x, y, z, t;
+                        FeAdd(a, p.mY, p.mX);
+                        FeSub(b, p.mY, p.mX);
+                        FeMul(a, a, q.mYPlusX);
+                        FeMul(b, b, q.mYMinusX);
+                        FeMul(c, q.mT2D, p.mT);
+                        FeMul(d, p.mZ, q.mZ2);
+                        FeSub(x, a, b);
+                        FeAdd(y, a, b);
+                        FeAdd(z, d, c);
+                        FeSub(t, d, c);
+                        FromCompleted(r, x, y, z, t);
+                    }
+
+                    // r = p - q: the negation swaps Y + X with Y - X and negates T.
+                    void PointSubCached (Point &r, const Point &p, const Cached &q) noexcept
+                    {
+                        Fe a, b, c, d, x, y, z, t;
+                        FeAdd(a, p.mY, p.mX);
+                        FeSub(b, p.mY, p.mX);
+                        FeMul(a, a, q.mYMinusX);
+                        FeMul(b, b, q.mYPlusX);
+                        FeMul(c, q.mT2D, p.mT);
+                        FeMul(d, p.mZ, q.mZ2);
+                        FeSub(x, a, b);
+                        FeAdd(y, a, b);
+                        FeSub(z, d, c);
+                        FeAdd(t, d, c);
+                        FromCompleted(r, x, y, z, t);
+                    }
+
+                    // Odd multiples P, 3P, ..., 15P of the sliding windows.
+                    const std::size_t kWindowSize = 8u;
+
+                    /**
+                     * @brief Recode a scalar below 2^255 to 256 signed digits: every non-zero digit is odd, in
+                     * [-15, 15], and followed by at least four zero digits (the sliding window of ref10).
+                     */
+                    void ToSlidingWindow (std::int8_t digits[256], const std::uint8_t scalar[Curve25519::kSize]) noexcept
+                    {
+                        for (std::size_t i = 0; i < 256u; ++i)
+                        {
+                            digits[i] = static_cast<std::int8_t>((scalar[i >> 3] >> (i & 7u)) & 1u);
+                        }
+                        for (std::size_t i = 0; i < 256u; ++i)
+                        {
+                            if (digits[i] == 0)
+                            {
+                                continue;
+                            }
+                            for (std::size_t b = 1; (b <= 6u) && (i + b < 256u); ++b)
+                            {
+                                if (digits[i + b] == 0)
+                                {
+                                    continue;
+                                }
+                                const int shifted = digits[i + b] << b;
+                                if (digits[i] + shifted <= 15)
+                                {
+                                    digits[i] = static_cast<std::int8_t>(digits[i] + shifted);
+                                    digits[i + b] = 0;
+                                }
+                                else if (digits[i] - shifted >= -15)
+                                {
+                                    digits[i] = static_cast<std::int8_t>(digits[i] - shifted);
+                                    for (std::size_t k = i + b; k < 256u; ++k)
+                                    {
+                                        if (digits[k] == 0)
+                                        {
+                                            digits[k] = 1;
+                                            break;
+                                        }
+                                        digits[k] = 0;
+                                    }
+                                }
+                                else
+                                {
+                                    break;
+                                }
+                            }
+                        }
+                    }
+
+                    /**
+                     * @brief Comb of the base point B: mPoint[i][j] = (j + 1) * 256^i * B. It is public data built
+                     * once; the lookup of an entry by a secret digit scans a whole row.
+                     */
+                    struct BaseTable
+                    {
+                        Precomputed mPoint[32][8];
+
+                        BaseTable () noexcept
+                        {
+                            Point base;
+                            base.mX = kBaseX;
+                            base.mY = kBaseY;
+                            FeOne(base.mZ);
+                            FeMul(base.mT, kBaseX, kBaseY);
+
+                            for (std::size_t i = 0; i < 32u; ++i)
+                            {
+                                Precomputed step;
+                                ToPrecomputed(step, base);
+                                Point multiple = base;
+                                for (std::size_t j = 0; j < 8u; ++j)
+                                {
+                                    ToPrecomputed(mPoint[i][j], multiple);
+                                    PointAddPrecomputed(multiple, multiple, step);
+                                }
+                                for (std::size_t k = 0; k < 8u; ++k)
+                                {
+                                    PointDouble(base, base);
+                                }
+                            }
+                        }
+                    };
+
+                    const BaseTable& GetBaseTable () noexcept
+                    {
+                        static const BaseTable table;
+                        return table;
+                    }
+
+                    inline std::uint64_t Equal (std::uint64_t a, std::uint64_t b) noexcept
+                    {
+                        return ((a ^ b) - 1u) >> 63;
+                    }
+
+                    // r = digit * 256^position * B for a signed digit in [-8, 8], without secret-dependent accesses.
+                    void SelectBase (Precomputed &r, const BaseTable &table, std::size_t position, std::int8_t digit) noexcept
+                    {
+                        const std::uint64_t negative = static_cast<std::uint64_t>(static_cast<std::uint8_t>(digit)) >> 7;
+                        const std::uint64_t magnitude = static_cast<std::uint64_t>(digit) ^ (0u - negative);
+                        const std::uint64_t absolute = (magnitude + negative) & 0xFFu;
+
+                        FeOne(r.mYPlusX);
+                        FeOne(r.mYMinusX);
+                        FeZero(r.mXY2D);
+                        for (std::size_t j = 0; j < 8u; ++j)
+                        {
+                            const std::uint64_t selected = Equal(absolute, j + 1u);
+                            FeCmov(r.mYPlusX, table.mPoint[position][j].mYPlusX, selected);
+                            FeCmov(r.mYMinusX, table.mPoint[position][j].mYMinusX, selected);
+                            FeCmov(r.mXY2D, table.mPoint[position][j].mXY2D, selected);
+                        }
+
+                        Precomputed minus;
+                        minus.mYPlusX = r.mYMinusX;
+                        minus.mYMinusX = r.mYPlusX;
+                        FeNeg(minus.mXY2D, r.mXY2D);
+                        FeCmov(r.mYPlusX, minus.mYPlusX, negative);
+                        FeCmov(r.mYMinusX, minus.mYMinusX, negative);
+                        FeCmov(r.mXY2D, minus.mXY2D, negative);
+                    }
+
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+                }
+
+                void Curve25519::ScalarMultBase (const std::uint8_t scalar[kSize], Point &result) noexcept
+                {
+                    // Signed radix-16 digits in [-8, 8).
+                    std::int8_t digits[64];
+                    for (std::size_t i = 0; i < kSize; ++i)
+                    {
+                        digits[2u * i] = static_cast<std::int8_t>(scalar[i] & 15u);
+                        digits[2u * i + 1u] = static_cast<std::int8_t>(scalar[i] >> 4);
+                    }
+                    std::int8_t carry = 0;
+                    for (std::size_t i = 0; i < 63u; ++i)
+                    {
+                        digits[i] = static_cast<std::int8_t>(digits[i] + carry);
+                        carry = static_cast<std::int8_t>((digits[i] + 8) >> 4);
+                        digits[i] = static_cast<std::int8_t>(digits[i] - carry * 16);
+                    }
+                    digits[63] = static_cast<std::int8_t>(digits[63] + carry);
+
+                    const BaseTable &table = GetBaseTable();
+                    Precomputed selected;
+                    PointIdentity(result);
+                    // sum(digits[2i + 1] * 16 * 256^i * B) + sum(digits[2i] * 256^i * B)
+                    for (std::size_t i = 1; i < 64u; i += 2u)
+                    {
+                        SelectBase(selected, table, i / 2u, digits[i]);
+                        PointAddPrecomputed(result, result, selected);
+                    }
+                    for (std::size_t k = 0; k < 4u; ++k)
+                    {
+                        PointDouble(result, result);
+                    }
+                    for (std::size_t i = 0; i < 64u; i += 2u)
+                    {
+                        SelectBase(selected, table, i / 2u, digits[i]);
+                        PointAddPrecomputed(result, result, selected);
+                    }
+
+                    Wipe(digits, sizeof(digits));
+                    Wipe(&selected, sizeof(selected));
+                }
+
+                void Curve25519::EncodeEdwards (const Point &point, std::uint8_t out[kSize]) noexcept
+                {
+                    Fe zInverse, x, y;
+                    FeInvert(zInverse, point.mZ);
+                    FeMul(x, point.mX, zInverse);
+                    FeMul(y, point.mY, zInverse);
+                    std::uint8_t xBytes[kSize];
+                    FeToBytes(xBytes, x);
+                    FeToBytes(out, y);
+                    out[31] ^= static_cast<std::uint8_t>((xBytes[0] & 1u) << 7);
+                }
+
+                bool Curve25519::DecodeEdwards (const std::uint8_t in[kSize], Point &point) noexcept
+                {
+                    // The y-coordinate must be below p: its canonical encoding is the input without the sign bit.
+                    FeFromBytes(point.mY, in);
+                    std::uint8_t canonical[kSize];
+                    FeToBytes(canonical, point.mY);
+                    for (std::size_t i = 0; i < kSize; ++i)
+                    {
+                        if (canonical[i] != static_cast<std::uint8_t>((i == kSize - 1u) ? (in[i] & 127u) : in[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    const std::uint8_t sign = static_cast<std::uint8_t>(in[kSize - 1u] >> 7);
+
+                    // x^2 = u / v with u = y^2 - 1 and v = d * y^2 + 1; the candidate root is x = u * v^3 * (u * v^7)^((p - 5) / 8).
+                    Fe one, u, v, v3, x, check;
+                    FeOne(one);
+                    FeSquare(u, point.mY);
+                    FeMul(v, u, kD);
+                    FeSub(u, u, one);
+                    FeAdd(v, v, one);
+                    FeSquare(v3, v);
+                    FeMul(v3, v3, v);
+                    FeSquare(x, v3);
+                    FeMul(x, x, v);
+                    FeMul(x, x, u);
+                    FePow22523(x, x);
+                    FeMul(x, x, v3);
+                    FeMul(x, x, u);
+
+                    FeSquare(check, x);
+                    FeMul(check, check, v);
+                    FeSub(check, check, u);
+                    if (!FeIsZero(check))
+                    {
+                        FeAdd(check, check, u);
+                        FeAdd(check, check, u);
+                        if (!FeIsZero(check))
+                        {
+                            return false;
+                        }
+                        FeMul(x, x, kSqrtM1);
+                    }
+
+                    std::uint8_t xBytes[kSize];
+                    FeToBytes(xBytes, x);
+                    if (FeIsZero(x) && (sign != 0u))
+                    {
+                        return false;
+                    }
+                    if ((xBytes[0] & 1u) != sign)
+                    {
+                        FeNeg(x, x);
+                    }
+                    point.mX = x;
+                    FeOne(point.mZ);
+                    FeMul(point.mT, point.mX, point.mY);
+                    return true;
+                }
+
+                bool Curve25519::CheckCofactoredSum (const std::uint8_t baseScalar[kSize], const std::uint8_t (*scalars)[kSize], const Point *points, std::size_t count) noexcept
+                {
+                    if (count > kMaxSumCount)
+                    {
+                        return false;
+                    }
+
+                    Cached table[kMaxSumCount][kWindowSize];
+                    std::int8_t digits[kMaxSumCount][256];
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        ToSlidingWindow(digits[i], scalars[i]);
+                        Point twice, multiple = points[i];
+                        PointDouble(twice, points[i]);
+                        Cached step;
+                        ToCached(step, twice);
+                        ToCached(table[i][0], multiple);
+                        for (std::size_t j = 1; j < kWindowSize; ++j)
+                        {
+                            PointAddCached(multiple, multiple, step);
+                            ToCached(table[i][j], multiple);
+                        }
+                    }
+
+                    Point sum;
+                    PointIdentity(sum);
+                    bool started = false;
+                    for (std::size_t bit = 256u; bit-- > 0u; )
+                    {
+                        if (started)
+                        {
+                            PointDouble(sum, sum);
+                        }
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            const std::int8_t digit = digits[i][bit];
+                            if (digit > 0)
+                            {
+                                PointAddCached(sum, sum, table[i][digit / 2]);
+                                started = true;
+                            }
+                            else if (digit < 0)
+                            {
+                                PointSubCached(sum, sum, table[i][-digit / 2]);
+                                started = true;
+                            }
+                        }
+                    }
+
+                    // The base point term by the comb, subtracted once at the end.
+                    Point base;
+                    ScalarMultBase(baseScalar, base);
+                    Cached baseCached;
+                    ToCached(baseCached, base);
+                    PointSubCached(sum, sum, baseCached);
+                    for (std::size_t k = 0; k < 3u; ++k)
+                    {
+                        PointDouble(sum, sum);
+                    }
+
+                    // The identity is (0 : Z : Z).
+                    Fe difference;
+                    FeSub(difference, sum.mY, sum.mZ);
+                    return FeIsZero(sum.mX) && FeIsZero(difference);
+                }
+
+                void Curve25519::EncodeMontgomery (const Point &point, std::uint8_t out[kSize]) noexcept
+                {
+                    // u = (1 + y) / (1 - y) = (Z + Y) / (Z - Y)
+                    Fe numerator, denominator, u;
+                    FeAdd(numerator, point.mZ, point.mY);
+                    FeSub(denominator, point.mZ, point.mY);
+                    FeInvert(denominator, denominator);
+                    FeMul(u, numerator, denominator);
+                    FeToBytes(out, u);
+                }
+
+                void Curve25519::ScalarMultMontgomery (const std::uint8_t scalar[kSize], const std::uint8_t u[kSize], std::uint8_t out[kSize]) noexcept
+                {
+                    Fe x1, x2, z2, x3, z3, a, aa, b, bb, e, c, d, da, cb;
+                    FeFromBytes(x1, u);
+                    FeOne(x2);
+                    FeZero(z2);
+                    x3 = x1;
+                    FeOne(z3);
+
+                    std::uint64_t swap = 0u;
+                    for (int t = 254; t >= 0; --t)
+                    {
+                        const std::uint64_t bit = (scalar[t >> 3] >> (t & 7)) & 1u;
+                        swap ^= bit;
+                        FeCswap(x2, x3, swap);
+                        FeCswap(z2, z3, swap);
+                        swap = bit;
+
+                        FeAdd(a, x2, z2);
+                        FeSquare(aa, a);
+                        FeSub(b, x2, z2);
+                        FeSquare(bb, b);
+                        FeSub(e, aa, bb);
+                        FeAdd(c, x3, z3);
+                        FeSub(d, x3, z3);
+                        FeMul(da, d, a);
+                        FeMul(cb, c, b);
+                        FeAdd(x3, da, cb);
+                        FeSquare(x3, x3);
+                        FeSub(z3, da, cb);
+                        FeSquare(z3, z3);
+                        FeMul(z3, x1, z3);
+                        FeMul(x2, aa, bb);
+                        FeMulSmall(z2, e, kA24);
+                        FeAdd(z2, aa, z2);
+                        FeMul(z2, e, z2);
+                    }
+                    FeCswap(x2, x3, swap);
+                    FeCswap(z2, z3, swap);
+
+                    FeInvert(z2, z2);
+                    FeMul(x2, x2, z2);
+                    FeToBytes(out, x2);
+
+                    Wipe(&x2, sizeof(x2));
+                    Wipe(&z2, sizeof(z2));
+                    Wipe(&x3, sizeof(x3));
+                    Wipe(&z3, sizeof(z3));
+                }
+
+                void X25519::ComputePublicKey (const std::uint8_t privateKey[kKeySize], std::uint8_t publicKey[kKeySize]) noexcept
+                {
+                    std::uint8_t scalar[kKeySize];
+                    for (std::size_t i = 0; i < kKeySize; ++i)
+                    {
+                        scalar[i] = privateKey[i];
+                    }
+                    scalar[0] &= 248u;
+                    scalar[31] &= 127u;
+                    scalar[31] |= 64u;
+
+                    Curve25519::Point point;
+                    Curve25519::ScalarMultBase(scalar, point);
+                    Curve25519::EncodeMontgomery(point, publicKey);
+                    Wipe(scalar, sizeof(scalar));
+                    Wipe(&point, sizeof(point));
+                }
+
+                bool X25519::Agree (const std::uint8_t privateKey[kKeySize], const std::uint8_t peerPublicKey[kKeySize], std::uint8_t sharedSecret[kKeySize]) noexcept
+                {
+                    std::uint8_t scalar[kKeySize];
+                    for (std::size_t i = 0; i < kKeySize; ++i)
+                    {
+                        scalar[i] = privateKey[i];
+                    }
+                    scalar[0] &= 248u;
+                    scalar[31] &= 127u;
+                    scalar[31] |= 64u;
+
+                    Curve25519::ScalarMultMontgomery(scalar, peerPublicKey, sharedSecret);
+                    Wipe(scalar, sizeof(scalar));
+
+                    std::uint8_t accumulated = 0u;
+                    for (std::size_t i = 0; i < kKeySize; ++i)
+                    {
+                        accumulated |= sharedSecret[i];
+                    }
+                    return (accumulated != 0u);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_CURVE25519_H
+#define ARA_CRYPTO_CRYP_INTERNAL_CURVE25519_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Group operations of Curve25519 shared by X25519 and Ed25519. The field GF(2^255 - 19) is
+                 * represented by five 51-bit limbs multiplied with 128-bit products. All operations on secret
+                 * scalars are constant-time: the fixed-base multiplication uses a comb of precomputed multiples of
+                 * the base point (built once, on first use) selected by masked scans, and the variable-base
+                 * multiplication is the Montgomery ladder with masked swaps. Only the point decoding and the
+                 * multi-scalar check of signature verification, which work on public data, run in variable time.
+                 */
+                class Curve25519
+                {
+                public:
+
+                    /**
+                     * @brief Size of an encoded scalar, field element or point in bytes.
+                     */
+                    static const std::size_t kSize = 32u;
+
+                    /**
+                     * @brief Element of GF(2^255 - 19).
+                     */
+                    struct FieldElement
+                    {
+                        std::uint64_t mLimb[5];
+                    };
+
+                    /**
+                     * @brief Point of the twisted Edwards curve in extended coordinates (x = X/Z, y = Y/Z, xy = T/Z).
+                     */
+                    struct Point
+                    {
+                        FieldElement mX;
+                        FieldElement mY;
+                        FieldElement mZ;
+                        FieldElement mT;
+                    };
+
+                    /**
+                     * @brief Multiply the base point of the Edwards curve by a scalar.
+                     * @param[in] scalar little-endian scalar of kSize bytes, the most significant bit must be zero
+                     * @param[out] result the product
+                     */
+                    static void ScalarMultBase (const std::uint8_t scalar[kSize], Point &result) noexcept;
+
+                    /**
+                     * @brief Encode a point of the Edwards curve (RFC 8032): the y-coordinate and the sign of x.
+                     * @param[in] point the point
+                     * @param[out] out the encoding of kSize bytes
+                     */
+                    static void EncodeEdwards (const Point &point, std::uint8_t out[kSize]) noexcept;
+
+                    /**
+                     * @brief Decode a point of the Edwards curve (RFC 8032, section 5.1.3). The encoding is public
+                     * data, the time depends on it.
+                     * @param[in] in the encoding of kSize bytes
+                     * @param[out] point the point
+                     * @return false if the y-coordinate is not canonical or the encoding is not a point of the curve
+                     */
+                    static bool DecodeEdwards (const std::uint8_t in[kSize], Point &point) noexcept;
+
+                    /**
+                     * @brief Maximal number of points of one CheckCofactoredSum() call.
+                     */
+                    static const std::size_t kMaxSumCount = 16u;
+
+                    /**
+                     * @brief Check the equation [8](scalars[0] * points[0] + ... - baseScalar * B) = O of signature
+                     * verification. The terms share their doublings (the Straus method) and are added by signed
+                     * sliding windows of odd multiples, so the time depends on the scalars, which must be public.
+                     * @param[in] baseScalar little-endian scalar of the base point, the most significant bit must be zero
+                     * @param[in] scalars little-endian scalars of the points, the most significant bits must be zero
+                     * @param[in] points the points
+                     * @param[in] count number of the points, at most kMaxSumCount
+                     * @return true if the equation holds
+                     */
+                    static bool CheckCofactoredSum (const std::uint8_t baseScalar[kSize], const std::uint8_t (*scalars)[kSize], const Point *points, std::size_t count) noexcept;
+
+                    /**
+                     * @brief Encode the u-coordinate of the birationally equivalent point of the Montgomery curve.
+                     * @param[in] point the point of the Edwards curve
+                     * @param[out] out the little-endian u-coordinate of kSize bytes
+                     */
+                    static void EncodeMontgomery (const Point &point, std::uint8_t out[kSize]) noexcept;
+
+                    /**
+                     * @brief Multiply a point of the Montgomery curve by a scalar (the X25519 function without the
+                     * clamping of the scalar).
+                     * @param[in] scalar little-endian scalar of kSize bytes
+                     * @param[in] u the little-endian u-coordinate of the point (the most significant bit is ignored)
+                     * @param[out] out the little-endian u-coordinate of the product
+                     */
+                    static void ScalarMultMontgomery (const std::uint8_t scalar[kSize], const std::uint8_t u[kSize], std::uint8_t out[kSize]) noexcept;
+                };
+
+                /**
+                 * @brief X25519 Diffie-Hellman function (RFC 7748).
+                 */
+                class X25519
+                {
+                public:
+
+                    /**
+                     * @brief Size of the private key, the public key and the shared secret in bytes.
+                     */
+                    static const std::size_t kKeySize = Curve25519::kSize;
+
+                    /**
+                     * @brief Compute the public key of a private key by the fixed-base comb.
+                     * @param[in] privateKey the private key (it is clamped internally)
+                     * @param[out] publicKey the public key
+                     */
+                    static void ComputePublicKey (const std::uint8_t privateKey[kKeySize], std::uint8_t publicKey[kKeySize]) noexcept;
+
+                    /**
+                     * @brief Compute the shared secret.
+                     * @param[in] privateKey the own private key (it is clamped internally)
+                     * @param[in] peerPublicKey the public key of the other side
+                     * @param[out] sharedSecret the shared secret
+                     * @return false if the shared secret is all-zero, i.e. the public key is of a small order
+                     */
+                    static bool Agree (const std::uint8_t privateKey[kKeySize], const std::uint8_t peerPublicKey[kKeySize], std::uint8_t sharedSecret[kKeySize]) noexcept;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_CURVE25519_H
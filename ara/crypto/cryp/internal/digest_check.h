@@ -0,0 +1,69 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_DIGEST_CHECK_H
+#define ARA_CRYPTO_CRYP_INTERNAL_DIGEST_CHECK_H
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/constant_time.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Compare the digest kept in a context with an expected tag in constant time. The digest is
+                 * copied by GetDigest(ReadWriteMemRegion, std::size_t) piece by piece into a stack buffer, which
+                 * is wiped afterwards, so a digest of any size is compared without an allocation.
+                 * @tparam Context a context with GetDigest(ReadWriteMemRegion output, std::size_t offset)
+                 * @param[in] context the context holding the finished digest
+                 * @param[in] expectedTag the expected digest value
+                 * @return ara::core::Result<bool> true if the tag is identical to the digest, false otherwise (also
+                 * if the sizes differ), or the error of GetDigest()
+                 */
+                template <class Context>
+                ara::core::Result<bool> CheckDigest (const Context &context, ReadOnlyMemRegion expectedTag) noexcept
+                {
+                    // The largest digest of SHA2-512 fits in one piece.
+                    const std::size_t kPieceSize = 64u;
+                    std::uint8_t buffer[kPieceSize] = {};
+                    bool equal = true;
+
+                    ara::core::Result<std::size_t> copied = ara::core::Result<std::size_t>::FromValue(0u);
+                    for (std::size_t offset = 0; copied.HasValue() && (offset < expectedTag.size()); offset += kPieceSize)
+                    {
+                        const std::size_t size = std::min(kPieceSize, expectedTag.size() - offset);
+                        copied = context.GetDigest(ReadWriteMemRegion(buffer, size), offset);
+                        // A shorter digest differs; the comparison still covers the whole piece.
+                        equal = copied.HasValue() && ((copied.Value() == size) & ConstantTimeEqual(buffer, expectedTag.data() + offset, size) & equal);
+                    }
+                    // A digest longer than the tag differs too.
+                    if (copied.HasValue())
+                    {
+                        copied = context.GetDigest(ReadWriteMemRegion(buffer, 1u), expectedTag.size());
+                    }
+
+                    volatile std::uint8_t *wiped = buffer;
+                    for (std::size_t i = 0; i < kPieceSize; ++i)
+                    {
+                        wiped[i] = 0u;
+                    }
+                    if (!copied.HasValue())
+                    {
+                        return ara::core::Result<bool>::FromError(copied.Error());
+                    }
+                    return ara::core::Result<bool>::FromValue(equal && (copied.Value() == 0u));
+                }
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_DIGEST_CHECK_H
@@ -0,0 +1,318 @@
+#include "ara/crypto/cryp/internal/drbg.h"
+
+#include <cstring>
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/internal/chacha20.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    // The "provided data" of the CTR_DRBG functions: a string padded by zeros up to the seed length.
+                    void Pad (const std::uint8_t *data, std::size_t size, std::uint8_t *padded, std::size_t paddedSize) noexcept
+                    {
+                        std::memset(padded, 0, paddedSize);
+                        if (size != 0u)
+                        {
+                            std::memcpy(padded, data, size);
+                        }
+                    }
+                }
+
+                std::unique_ptr<Drbg> Drbg::Create (CryptoAlgId algId) noexcept
+                {
+                    switch (algId)
+                    {
+                    case kAlgIdCtrDrbgAes256:
+                        return std::unique_ptr<Drbg>(new (std::nothrow) CtrDrbg());
+                    case kAlgIdHmacDrbgSha2_256:
+                        return std::unique_ptr<Drbg>(new (std::nothrow) HmacDrbg());
+                    case kAlgIdChaCha20Rng:
+                        return std::unique_ptr<Drbg>(new (std::nothrow) ChaCha20Rng());
+                    default:
+                        return nullptr;
+                    }
+                }
+
+                Drbg::Status Drbg::Generate (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    if (!IsInstantiated())
+                    {
+                        return Status::kUninstantiated;
+                    }
+                    if ((size > kMaxRequestSize) || (additionalSize > GetSeedSize()))
+                    {
+                        return Status::kRequestTooLarge;
+                    }
+                    if (mReseedCounter > mReseedInterval)
+                    {
+                        return Status::kReseedRequired;
+                    }
+                    GenerateBytes(out, size, additional, additionalSize);
+                    ++mReseedCounter;
+                    return Status::kOk;
+                }
+
+                CtrDrbg::~CtrDrbg () noexcept
+                {
+                    Clear();
+                }
+
+                std::size_t CtrDrbg::GetSeedSize () const noexcept
+                {
+                    return kSeedSize;
+                }
+
+                void CtrDrbg::Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization, std::size_t personalizationSize) noexcept
+                {
+                    std::uint8_t seed[kSeedSize];
+                    Pad(personalization, (personalizationSize < kSeedSize) ? personalizationSize : kSeedSize, seed, kSeedSize);
+                    for (std::size_t i = 0; i < kSeedSize; ++i)
+                    {
+                        seed[i] ^= entropy[i];
+                    }
+
+                    const std::uint8_t zeroKey[32] = {};
+                    mAes.SetKey(zeroKey, sizeof(zeroKey));
+                    std::memset(mV, 0, sizeof(mV));
+                    Update(seed);
+                    Wipe(seed, sizeof(seed));
+                    mReseedCounter = 1u;
+                }
+
+                void CtrDrbg::Reseed (const std::uint8_t *entropy, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    std::uint8_t seed[kSeedSize];
+                    Pad(additional, (additionalSize < kSeedSize) ? additionalSize : kSeedSize, seed, kSeedSize);
+                    for (std::size_t i = 0; i < kSeedSize; ++i)
+                    {
+                        seed[i] ^= entropy[i];
+                    }
+                    Update(seed);
+                    Wipe(seed, sizeof(seed));
+                    mReseedCounter = 1u;
+                }
+
+                void CtrDrbg::Clear () noexcept
+                {
+                    mAes.Clear();
+                    Wipe(mV, sizeof(mV));
+                    mReseedCounter = 0u;
+                }
+
+                void CtrDrbg::Update (const std::uint8_t provided[kSeedSize]) noexcept
+                {
+                    // temp = E(K, V + 1) || E(K, V + 2) || E(K, V + 3), i.e. the CTR key stream starting at V + 1.
+                    std::uint8_t temp[kSeedSize] = {};
+                    std::uint8_t counter[Aes::kBlockSize];
+                    std::memcpy(counter, mV, sizeof(counter));
+                    Aes::AddToCounter(counter, 1u);
+                    mAes.XorCtr(counter, temp, temp, kSeedSize / Aes::kBlockSize);
+                    for (std::size_t i = 0; i < kSeedSize; ++i)
+                    {
+                        temp[i] ^= provided[i];
+                    }
+                    mAes.SetKey(temp, 32u);
+                    std::memcpy(mV, temp + 32u, sizeof(mV));
+                    Wipe(temp, sizeof(temp));
+                    Wipe(counter, sizeof(counter));
+                }
+
+                void CtrDrbg::GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    std::uint8_t provided[kSeedSize];
+                    Pad(additional, additionalSize, provided, kSeedSize);
+                    if (additionalSize != 0u)
+                    {
+                        Update(provided);
+                    }
+
+                    const std::size_t blockCount = size / Aes::kBlockSize;
+                    const std::size_t tailSize = size % Aes::kBlockSize;
+                    std::uint8_t counter[Aes::kBlockSize];
+                    std::memcpy(counter, mV, sizeof(counter));
+                    Aes::AddToCounter(counter, 1u);
+
+                    std::memset(out, 0, blockCount * Aes::kBlockSize);
+                    mAes.XorCtr(counter, out, out, blockCount);
+                    if (tailSize != 0u)
+                    {
+                        std::uint8_t block[Aes::kBlockSize] = {};
+                        mAes.XorCtr(counter, block, block, 1u);
+                        std::memcpy(out + blockCount * Aes::kBlockSize, block, tailSize);
+                        Wipe(block, sizeof(block));
+                    }
+                    // V is the last used counter value.
+                    Aes::AddToCounter(mV, blockCount + ((tailSize != 0u) ? 1u : 0u));
+
+                    Update(provided);
+                    Wipe(provided, sizeof(provided));
+                    Wipe(counter, sizeof(counter));
+                }
+
+                HmacDrbg::~HmacDrbg () noexcept
+                {
+                    Clear();
+                }
+
+                std::size_t HmacDrbg::GetSeedSize () const noexcept
+                {
+                    return kSeedSize;
+                }
+
+                void HmacDrbg::Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization, std::size_t personalizationSize) noexcept
+                {
+                    std::memset(mKey, 0x00, sizeof(mKey));
+                    std::memset(mV, 0x01, sizeof(mV));
+                    Update(entropy, kSeedSize, personalization, personalizationSize);
+                    mReseedCounter = 1u;
+                }
+
+                void HmacDrbg::Reseed (const std::uint8_t *entropy, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    Update(entropy, kSeedSize, additional, additionalSize);
+                    mReseedCounter = 1u;
+                }
+
+                void HmacDrbg::Clear () noexcept
+                {
+                    mHmac.Clear();
+                    Wipe(mKey, sizeof(mKey));
+                    Wipe(mV, sizeof(mV));
+                    mReseedCounter = 0u;
+                }
+
+                void HmacDrbg::Update (const std::uint8_t *first, std::size_t firstSize, const std::uint8_t *second, std::size_t secondSize) noexcept
+                {
+                    const bool provided = ((firstSize + secondSize) != 0u);
+                    for (std::uint8_t round = 0x00u; round <= (provided ? 0x01u : 0x00u); ++round)
+                    {
+                        // K = HMAC(K, V || round || provided_data); V = HMAC(K, V)
+                        mHmac.SetKey(mKey, sizeof(mKey));
+                        mHmac.Update(mV, sizeof(mV));
+                        mHmac.Update(&round, 1u);
+                        if (firstSize != 0u)
+                        {
+                            mHmac.Update(first, firstSize);
+                        }
+                        if (secondSize != 0u)
+                        {
+                            mHmac.Update(second, secondSize);
+                        }
+                        mHmac.Finish(mKey);
+                        mHmac.SetKey(mKey, sizeof(mKey));
+                        mHmac.Update(mV, sizeof(mV));
+                        mHmac.Finish(mV);
+                    }
+                }
+
+                void HmacDrbg::GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    if (additionalSize != 0u)
+                    {
+                        Update(additional, additionalSize, nullptr, 0u);
+                    }
+
+                    // The key stays the same during the generation, so its padded states are computed once.
+                    mHmac.SetKey(mKey, sizeof(mKey));
+                    while (size != 0u)
+                    {
+                        mHmac.Update(mV, sizeof(mV));
+                        mHmac.Finish(mV);
+                        const std::size_t length = (size < sizeof(mV)) ? size : sizeof(mV);
+                        std::memcpy(out, mV, length);
+                        out += length;
+                        size -= length;
+                    }
+
+                    Update(additional, additionalSize, nullptr, 0u);
+                }
+
+                ChaCha20Rng::~ChaCha20Rng () noexcept
+                {
+                    Clear();
+                }
+
+                std::size_t ChaCha20Rng::GetSeedSize () const noexcept
+                {
+                    return kSeedSize;
+                }
+
+                void ChaCha20Rng::Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization, std::size_t personalizationSize) noexcept
+                {
+                    Wipe(mKey, sizeof(mKey));
+                    Sha256 hash;
+                    hash.Update(entropy, kSeedSize);
+                    if (personalizationSize != 0u)
+                    {
+                        hash.Update(personalization, personalizationSize);
+                    }
+                    hash.Finish(mKey);
+                    mReseedCounter = 1u;
+                }
+
+                void ChaCha20Rng::Reseed (const std::uint8_t *entropy, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    Mix(entropy, kSeedSize, additional, additionalSize);
+                    mReseedCounter = 1u;
+                }
+
+                void ChaCha20Rng::Clear () noexcept
+                {
+                    Wipe(mKey, sizeof(mKey));
+                    mReseedCounter = 0u;
+                }
+
+                void ChaCha20Rng::Mix (const std::uint8_t *first, std::size_t firstSize, const std::uint8_t *second, std::size_t secondSize) noexcept
+                {
+                    Sha256 hash;
+                    hash.Update(mKey, sizeof(mKey));
+                    hash.Update(first, firstSize);
+                    if (secondSize != 0u)
+                    {
+                        hash.Update(second, secondSize);
+                    }
+                    hash.Finish(mKey);
+                }
+
+                void ChaCha20Rng::GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    if (additionalSize != 0u)
+                    {
+                        Mix(additional, additionalSize, nullptr, 0u);
+                    }
+
+                    // The nonce is fixed: every request uses a fresh key, so the key stream never repeats.
+                    const std::uint8_t nonce[ChaCha20::kNonceSize] = {};
+                    std::uint8_t first[ChaCha20::kBlockSize];
+                    ChaCha20::Block(mKey, nonce, 0u, first);
+                    const std::size_t headSize = ChaCha20::kBlockSize - sizeof(mKey);
+                    const std::size_t taken = (size < headSize) ? size : headSize;
+                    std::memcpy(out, first + sizeof(mKey), taken);
+                    if (size > taken)
+                    {
+                        ChaCha20::KeyStream(mKey, nonce, 1u, out + taken, size - taken);
+                    }
+                    std::memcpy(mKey, first, sizeof(mKey));
+                    Wipe(first, sizeof(first));
+                }
+            }
+        }
+    }
+}
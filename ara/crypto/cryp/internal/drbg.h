@@ -0,0 +1,199 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_DRBG_H
+#define ARA_CRYPTO_CRYP_INTERNAL_DRBG_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/internal/aes.h"
+#include "ara/crypto/cryp/internal/hmac.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Deterministic Random Bit Generator mechanism. An instance is not thread-safe: a caller
+                 * owns it exclusively (e.g. one instance per thread).
+                 */
+                class Drbg
+                {
+                public:
+
+                    /**
+                     * @brief Outcome of a Generate() request.
+                     */
+                    enum class Status : std::uint8_t
+                    {
+                        kOk = 0,                // the output is generated
+                        kUninstantiated = 1,    // Instantiate() has not been called yet
+                        kReseedRequired = 2,    // the reseed interval is exhausted, Reseed() must be called first
+                        kRequestTooLarge = 3    // the request exceeds kMaxRequestSize or the additional input is too long
+                    };
+
+                    /**
+                     * @brief Maximal number of bytes produced by a single Generate() request.
+                     */
+                    static const std::size_t kMaxRequestSize = 65536u;
+
+                    /**
+                     * @brief Default number of Generate() requests between two reseeds.
+                     */
+                    static const std::uint64_t kDefaultReseedInterval = 1ull << 24;
+
+                    virtual ~Drbg () noexcept=default;
+
+                    /**
+                     * @brief Create a DRBG by the algorithm ID.
+                     * @param[in] algId kAlgIdCtrDrbgAes256, kAlgIdHmacDrbgSha2_256 or kAlgIdChaCha20Rng
+                     * @return std::unique_ptr<Drbg> the uninstantiated DRBG or nullptr if the algorithm ID is unsupported
+                     */
+                    static std::unique_ptr<Drbg> Create (CryptoAlgId algId) noexcept;
+
+                    /**
+                     * @brief Get the number of full-entropy bytes expected by Instantiate() and Reseed(). It is also
+                     * the maximal size of the personalization string and of the additional input.
+                     * @return std::size_t size of the seed in bytes
+                     */
+                    virtual std::size_t GetSeedSize () const noexcept=0;
+
+                    /**
+                     * @brief Instantiate the DRBG.
+                     * @param[in] entropy GetSeedSize() bytes of the entropy input (including the nonce)
+                     * @param[in] personalization an optional personalization string
+                     * @param[in] personalizationSize size of the personalization string (up to GetSeedSize())
+                     */
+                    virtual void Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization=nullptr, std::size_t personalizationSize=0u) noexcept=0;
+
+                    /**
+                     * @brief Reseed the DRBG and restart the reseed counter.
+                     * @param[in] entropy GetSeedSize() bytes of the entropy input
+                     * @param[in] additional an optional additional input
+                     * @param[in] additionalSize size of the additional input (up to GetSeedSize())
+                     */
+                    virtual void Reseed (const std::uint8_t *entropy, const std::uint8_t *additional=nullptr, std::size_t additionalSize=0u) noexcept=0;
+
+                    /**
+                     * @brief Generate pseudorandom bytes.
+                     * @param[out] out the output buffer
+                     * @param[in] size number of bytes to generate (up to kMaxRequestSize)
+                     * @param[in] additional an optional additional input
+                     * @param[in] additionalSize size of the additional input (up to GetSeedSize())
+                     * @return Status the outcome of the request
+                     */
+                    Status Generate (std::uint8_t *out, std::size_t size, const std::uint8_t *additional=nullptr, std::size_t additionalSize=0u) noexcept;
+
+                    /**
+                     * @brief Wipe the internal state; the DRBG must be instantiated again.
+                     */
+                    virtual void Clear () noexcept=0;
+
+                    /**
+                     * @brief Set the number of Generate() requests between two reseeds.
+                     * @param[in] interval the reseed interval
+                     */
+                    void SetReseedInterval (std::uint64_t interval) noexcept
+                    {
+                        mReseedInterval = interval;
+                    }
+
+                    /**
+                     * @brief Check if the DRBG is instantiated.
+                     * @return true if Instantiate() has been called after the construction or the last Clear()
+                     */
+                    bool IsInstantiated () const noexcept
+                    {
+                        return (mReseedCounter != 0u);
+                    }
+
+                protected:
+
+                    virtual void GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept=0;
+
+                    std::uint64_t mReseedCounter = 0u;  // 0 means "not instantiated"
+                    std::uint64_t mReseedInterval = kDefaultReseedInterval;
+                };
+
+                /**
+                 * @brief CTR_DRBG over AES-256 without the derivation function (NIST SP 800-90A). The output is
+                 * produced by the pipelined CTR kernel of Aes.
+                 */
+                class CtrDrbg final : public Drbg
+                {
+                public:
+                    ~CtrDrbg () noexcept override;
+
+                    std::size_t GetSeedSize () const noexcept override;
+                    void Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization=nullptr, std::size_t personalizationSize=0u) noexcept override;
+                    void Reseed (const std::uint8_t *entropy, const std::uint8_t *additional=nullptr, std::size_t additionalSize=0u) noexcept override;
+                    void Clear () noexcept override;
+
+                private:
+                    static const std::size_t kSeedSize = 48u;
+
+                    void GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept override;
+                    void Update (const std::uint8_t provided[kSeedSize]) noexcept;
+
+                    Aes mAes;
+                    std::uint8_t mV[Aes::kBlockSize] = {};
+                };
+
+                /**
+                 * @brief HMAC_DRBG over SHA2-256 (NIST SP 800-90A).
+                 */
+                class HmacDrbg final : public Drbg
+                {
+                public:
+                    ~HmacDrbg () noexcept override;
+
+                    std::size_t GetSeedSize () const noexcept override;
+                    void Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization=nullptr, std::size_t personalizationSize=0u) noexcept override;
+                    void Reseed (const std::uint8_t *entropy, const std::uint8_t *additional=nullptr, std::size_t additionalSize=0u) noexcept override;
+                    void Clear () noexcept override;
+
+                private:
+                    static const std::size_t kSeedSize = 48u;   // 256-bit entropy input and 128-bit nonce
+
+                    void GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept override;
+                    void Update (const std::uint8_t *first, std::size_t firstSize, const std::uint8_t *second, std::size_t secondSize) noexcept;
+
+                    Hmac<Sha256> mHmac;
+                    std::uint8_t mKey[Sha256::kDigestSize] = {};
+                    std::uint8_t mV[Sha256::kDigestSize] = {};
+                };
+
+                /**
+                 * @brief Fast-key-erasure generator over the ChaCha20 key stream: the first 32 bytes of the key
+                 * stream of every request replace the key, so a compromised state does not reveal earlier output.
+                 * The seed and the additional input are mixed into the key by SHA2-256.
+                 */
+                class ChaCha20Rng final : public Drbg
+                {
+                public:
+                    ~ChaCha20Rng () noexcept override;
+
+                    std::size_t GetSeedSize () const noexcept override;
+                    void Instantiate (const std::uint8_t *entropy, const std::uint8_t *personalization=nullptr, std::size_t personalizationSize=0u) noexcept override;
+                    void Reseed (const std::uint8_t *entropy, const std::uint8_t *additional=nullptr, std::size_t additionalSize=0u) noexcept override;
+                    void Clear () noexcept override;
+
+                private:
+                    static const std::size_t kSeedSize = 32u;
+
+                    void GenerateBytes (std::uint8_t *out, std::size_t size, const std::uint8_t *additional, std::size_t additionalSize) noexcept override;
+                    void Mix (const std::uint8_t *first, std::size_t firstSize, const std::uint8_t *second, std::size_t secondSize) noexcept;
+
+                    std::uint8_t mKey[32] = {};
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_DRBG_H
@@ -0,0 +1,173 @@
+#include "ara/crypto/cryp/internal/ecdsa.h"
+
+#include "ara/crypto/cryp/internal/hmac.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    // n = FFFFFFFF 00000000 FFFFFFFF FFFFFFFF BCE6FAAD A7179E84 F3B9CAC2 FC632551
+                    const std::uint64_t kOrder[4] = {0xf3b9cac2fc632551u, 0xbce6faada7179e84u, 0xffffffffffffffffu, 0xffffffff00000000u};
+
+                    const std::size_t kSize = P256::kScalarSize;
+
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    const ScalarModulus& GetOrder () noexcept
+                    {
+                        static const ScalarModulus order(kOrder);
+                        return order;
+                    }
+
+                    /**
+                     * @brief Nonce generator of RFC 6979 (section 3.2) for qlen = hlen = 256.
+                     */
+                    class NonceGenerator
+                    {
+                    public:
+                        NonceGenerator (const std::uint8_t privateKey[kSize], const std::uint8_t digest[kSize]) noexcept
+                        {
+                            // V = 0x01..01, K = 0x00..00
+                            // K = HMAC_K(V || 0x00 || x || h), V = HMAC_K(V), K = HMAC_K(V || 0x01 || x || h), V = HMAC_K(V)
+                            std::uint8_t key[kSize] = {};
+                            for (std::size_t i = 0; i < kSize; ++i)
+                            {
+                                mV[i] = 0x01u;
+                            }
+                            for (std::uint8_t separator = 0u; separator < 2u; ++separator)
+                            {
+                                mHmac.SetKey(key, sizeof(key));
+                                mHmac.Update(mV, sizeof(mV));
+                                mHmac.Update(&separator, 1u);
+                                mHmac.Update(privateKey, kSize);
+                                mHmac.Update(digest, kSize);
+                                mHmac.Finish(key);
+                                mHmac.SetKey(key, sizeof(key));
+                                mHmac.Update(mV, sizeof(mV));
+                                mHmac.Finish(mV);
+                            }
+                            Wipe(key, sizeof(key));
+                        }
+
+                        ~NonceGenerator () noexcept
+                        {
+                            Wipe(mV, sizeof(mV));
+                        }
+
+                        // The next candidate T = V = HMAC_K(V).
+                        void Next (std::uint8_t candidate[kSize]) noexcept
+                        {
+                            mHmac.Update(mV, sizeof(mV));
+                            mHmac.Finish(mV);
+                            for (std::size_t i = 0; i < kSize; ++i)
+                            {
+                                candidate[i] = mV[i];
+                            }
+                        }
+
+                        // Rejection of a candidate: K = HMAC_K(V || 0x00), V = HMAC_K(V).
+                        void Reject () noexcept
+                        {
+                            const std::uint8_t separator = 0x00u;
+                            std::uint8_t key[kSize];
+                            mHmac.Update(mV, sizeof(mV));
+                            mHmac.Update(&separator, 1u);
+                            mHmac.Finish(key);
+                            mHmac.SetKey(key, sizeof(key));
+                            mHmac.Update(mV, sizeof(mV));
+                            mHmac.Finish(mV);
+                            Wipe(key, sizeof(key));
+                        }
+
+                    private:
+                        Hmac<Sha256> mHmac;
+                        std::uint8_t mV[kSize];
+                    };
+                }
+
+                bool EcdsaP256::ExpandKey (const std::uint8_t privateKey[kPrivateKeySize], SigningKey &key) noexcept
+                {
+                    if (!P256::ComputePublicKey(privateKey, key.mPublicKey))
+                    {
+                        return false;
+                    }
+                    const ScalarModulus &order = GetOrder();
+                    ScalarModulus::Element scalar;
+                    order.Reduce(scalar, privateKey, kPrivateKeySize, true);
+                    order.ToMontgomery(key.mScalar, scalar);
+                    for (std::size_t i = 0; i < kPrivateKeySize; ++i)
+                    {
+                        key.mPrivateKey[i] = privateKey[i];
+                    }
+                    Wipe(&scalar, sizeof(scalar));
+                    return true;
+                }
+
+                void EcdsaP256::Sign (const SigningKey &key, const std::uint8_t *digest, std::size_t digestSize, std::uint8_t signature[kSignatureSize]) noexcept
+                {
+                    const ScalarModulus &order = GetOrder();
+
+                    // e = bits2int(H) mod n; bits2octets(H) of RFC 6979 is the same value
+                    ScalarModulus::Element e;
+                    order.Reduce(e, digest, (digestSize < kSize) ? digestSize : kSize, true);
+                    std::uint8_t reducedDigest[kSize];
+                    ScalarModulus::ToBytes(reducedDigest, e, true);
+
+                    NonceGenerator generator(key.mPrivateKey, reducedDigest);
+                    std::uint8_t nonce[kSize];
+                    std::uint8_t point[P256::kPublicKeySize];
+                    ScalarModulus::Element k;
+                    ScalarModulus::Element r;
+                    ScalarModulus::Element s;
+                    for (;;)
+                    {
+                        generator.Next(nonce);
+                        // R = k * G, r = x(R) mod n
+                        if (P256::ComputePublicKey(nonce, point))
+                        {
+                            order.Reduce(r, point + 1u, kSize, true);
+
+                            // s = k^-1 * (e + r * d) mod n
+                            order.Reduce(k, nonce, kSize, true);
+                            order.ToMontgomery(k, k);
+                            order.Invert(k, k);
+                            order.Multiply(s, r, key.mScalar);
+                            order.Add(s, s, e);
+                            order.Multiply(s, s, k);
+                            if (!ScalarModulus::IsZero(r) && !ScalarModulus::IsZero(s))
+                            {
+                                break;
+                            }
+                        }
+                        generator.Reject();
+                    }
+
+                    ScalarModulus::ToBytes(signature, r, true);
+                    ScalarModulus::ToBytes(signature + kSize, s, true);
+                    Wipe(nonce, sizeof(nonce));
+                    Wipe(&k, sizeof(k));
+                    Wipe(point, sizeof(point));
+                }
+
+                void EcdsaP256::Clear (SigningKey &key) noexcept
+                {
+                    Wipe(&key, sizeof(key));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_ECDSA_H
+#define ARA_CRYPTO_CRYP_INTERNAL_ECDSA_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/p256.h"
+#include "ara/crypto/cryp/internal/scalar_modulus.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief ECDSA over NIST P-256 (FIPS 186-4) with deterministic nonces (RFC 6979, HMAC/SHA2-256).
+                 * The nonce multiplication uses the fixed-base comb of P256 and the scalar arithmetic modulo the
+                 * group order is constant-time. The signature is the fixed-size concatenation r || s (IEEE P1363).
+                 */
+                class EcdsaP256
+                {
+                public:
+
+                    /**
+                     * @brief Size of the private key in bytes.
+                     */
+                    static const std::size_t kPrivateKeySize = P256::kScalarSize;
+
+                    /**
+                     * @brief Size of the signature (r || s) in bytes.
+                     */
+                    static const std::size_t kSignatureSize = 2u * P256::kScalarSize;
+
+                    /**
+                     * @brief Signing key prepared once for any number of signatures.
+                     */
+                    struct SigningKey
+                    {
+                        std::uint8_t mPrivateKey[kPrivateKeySize];     // big-endian d, the key of the nonce generator
+                        ScalarModulus::Element mScalar;                 // d in the Montgomery form modulo n
+                        std::uint8_t mPublicKey[P256::kPublicKeySize];
+                    };
+
+                    /**
+                     * @brief Prepare a signing key.
+                     * @param[in] privateKey the big-endian private key
+                     * @param[out] key the signing key
+                     * @return false if the private key is not in the range [1, n - 1]
+                     */
+                    static bool ExpandKey (const std::uint8_t privateKey[kPrivateKeySize], SigningKey &key) noexcept;
+
+                    /**
+                     * @brief Sign a message digest.
+                     * @param[in] key the signing key
+                     * @param[in] digest the message digest (its leftmost 256 bits are used)
+                     * @param[in] digestSize size of the digest in bytes
+                     * @param[out] signature the signature r || s
+                     */
+                    static void Sign (const SigningKey &key, const std::uint8_t *digest, std::size_t digestSize, std::uint8_t signature[kSignatureSize]) noexcept;
+
+                    /**
+                     * @brief Wipe a signing key.
+                     * @param[out] key the key
+                     */
+                    static void Clear (SigningKey &key) noexcept;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_ECDSA_H
@@ -0,0 +1,274 @@
+#include "ara/crypto/cryp/internal/ed25519.h"
+
+#include <algorithm>
+
+#include "ara/crypto/cryp/internal/entropy_source.h"
+#include "ara/crypto/cryp/internal/sha512.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    // L = 2^252 + 27742317777372353535851937790883648493
+                    const std::uint64_t kOrder[4] = {0x5812631a5cf5d3edu, 0x14def9dea2f79cd6u, 0x0u, 0x1000000000000000u};
+
+                    const char kDomainPrefix[] = "SigEd25519 no Ed25519 collisions";
+
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    const ScalarModulus& GetOrder () noexcept
+                    {
+                        static const ScalarModulus order(kOrder);
+                        return order;
+                    }
+
+                    // dom2(0, context) of Ed25519ctx, nothing for plain Ed25519
+                    void UpdateDomain (Sha512 &hash, const std::uint8_t *context, std::size_t contextSize) noexcept
+                    {
+                        if (contextSize != 0u)
+                        {
+                            const std::uint8_t parameters[2] = {0u, static_cast<std::uint8_t>(contextSize)};
+                            hash.Update(reinterpret_cast<const std::uint8_t*>(kDomainPrefix), sizeof(kDomainPrefix) - 1u);
+                            hash.Update(parameters, sizeof(parameters));
+                            hash.Update(context, contextSize);
+                        }
+                    }
+
+                    // k = H(dom || R || A || M) mod L
+                    void ComputeChallenge (ScalarModulus::Element &challenge, const std::uint8_t *publicKey, const std::uint8_t *message, std::size_t messageSize, const std::uint8_t *context, std::size_t contextSize, const std::uint8_t *signature) noexcept
+                    {
+                        std::uint8_t digest[Sha512::kDigestSize];
+                        Sha512 hash;
+                        UpdateDomain(hash, context, contextSize);
+                        hash.Update(signature, Curve25519::kSize);
+                        hash.Update(publicKey, Ed25519::kPublicKeySize);
+                        hash.Update(message, messageSize);
+                        hash.Finish(digest);
+                        GetOrder().Reduce(challenge, digest, sizeof(digest), false);
+                    }
+
+                    // S of a signature, which must be below L.
+                    bool DecodeScalar (ScalarModulus::Element &scalar, const std::uint8_t *bytes) noexcept
+                    {
+                        GetOrder().Reduce(scalar, bytes, Curve25519::kSize, false);
+                        std::uint8_t canonical[Curve25519::kSize];
+                        ScalarModulus::ToBytes(canonical, scalar, false);
+                        return std::equal(canonical, canonical + Curve25519::kSize, bytes);
+                    }
+                }
+
+                void Ed25519::ExpandKey (const std::uint8_t seed[kSeedSize], SigningKey &key) noexcept
+                {
+                    std::uint8_t digest[Sha512::kDigestSize];
+                    Sha512::Compute(seed, kSeedSize, digest);
+                    digest[0] &= 248u;
+                    digest[31] &= 127u;
+                    digest[31] |= 64u;
+
+                    Curve25519::Point point;
+                    Curve25519::ScalarMultBase(digest, point);
+                    Curve25519::EncodeEdwards(point, key.mPublicKey);
+
+                    const ScalarModulus &order = GetOrder();
+                    ScalarModulus::Element scalar;
+                    order.Reduce(scalar, digest, Curve25519::kSize, false);
+                    order.ToMontgomery(key.mScalar, scalar);
+                    for (std::size_t i = 0; i < Curve25519::kSize; ++i)
+                    {
+                        key.mPrefix[i] = digest[Curve25519::kSize + i];
+                    }
+                    Wipe(digest, sizeof(digest));
+                    Wipe(&scalar, sizeof(scalar));
+                    Wipe(&point, sizeof(point));
+                }
+
+                bool Ed25519::Sign (const SigningKey &key, const std::uint8_t *message, std::size_t messageSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t signature[kSignatureSize]) noexcept
+                {
+                    if (contextSize > kMaxContextSize)
+                    {
+                        return false;
+                    }
+                    const ScalarModulus &order = GetOrder();
+                    std::uint8_t digest[Sha512::kDigestSize];
+
+                    // r = H(dom || prefix || M) mod L, R = r * B
+                    Sha512 hash;
+                    UpdateDomain(hash, context, contextSize);
+                    hash.Update(key.mPrefix, sizeof(key.mPrefix));
+                    hash.Update(message, messageSize);
+                    hash.Finish(digest);
+                    ScalarModulus::Element nonce;
+                    order.Reduce(nonce, digest, sizeof(digest), false);
+                    std::uint8_t nonceBytes[Curve25519::kSize];
+                    ScalarModulus::ToBytes(nonceBytes, nonce, false);
+                    Curve25519::Point point;
+                    Curve25519::ScalarMultBase(nonceBytes, point);
+                    Curve25519::EncodeEdwards(point, signature);
+
+                    // k = H(dom || R || A || M) mod L, S = r + k * s mod L
+                    UpdateDomain(hash, context, contextSize);
+                    hash.Update(signature, Curve25519::kSize);
+                    hash.Update(key.mPublicKey, sizeof(key.mPublicKey));
+                    hash.Update(message, messageSize);
+                    hash.Finish(digest);
+                    ScalarModulus::Element challenge;
+                    order.Reduce(challenge, digest, sizeof(digest), false);
+                    order.Multiply(challenge, challenge, key.mScalar);
+                    order.Add(challenge, challenge, nonce);
+                    ScalarModulus::ToBytes(signature + Curve25519::kSize, challenge, false);
+
+                    Wipe(digest, sizeof(digest));
+                    Wipe(&nonce, sizeof(nonce));
+                    Wipe(nonceBytes, sizeof(nonceBytes));
+                    Wipe(&point, sizeof(point));
+                    return true;
+                }
+
+                bool Ed25519::Verify (const std::uint8_t publicKey[kPublicKeySize], const std::uint8_t *message, std::size_t messageSize, const std::uint8_t *context, std::size_t contextSize, const std::uint8_t signature[kSignatureSize]) noexcept
+                {
+                    Curve25519::Point points[2];
+                    ScalarModulus::Element scalar;
+                    if ((contextSize > kMaxContextSize) || !Curve25519::DecodeEdwards(signature, points[0]) ||
+                        !Curve25519::DecodeEdwards(publicKey, points[1]) || !DecodeScalar(scalar, signature + Curve25519::kSize))
+                    {
+                        return false;
+                    }
+                    ScalarModulus::Element challenge;
+                    ComputeChallenge(challenge, publicKey, message, messageSize, context, contextSize, signature);
+
+                    // [8](1 * R + k * A - S * B) = O
+                    std::uint8_t scalars[2][Curve25519::kSize] = {};
+                    scalars[0][0] = 1u;
+                    ScalarModulus::ToBytes(scalars[1], challenge, false);
+                    return Curve25519::CheckCofactoredSum(signature + Curve25519::kSize, scalars, points, 2u);
+                }
+
+                void Ed25519::VerifyBatch (const BatchItem *items, std::size_t count, const std::uint8_t *context, std::size_t contextSize, bool *verified) noexcept
+                {
+                    std::fill(verified, verified + count, false);
+                    if (contextSize > kMaxContextSize)
+                    {
+                        return;
+                    }
+                    const ScalarModulus &order = GetOrder();
+                    std::uint8_t seed[Curve25519::kSize];
+                    const bool randomized = GetSystemEntropy(seed, sizeof(seed));
+
+                    for (std::size_t first = 0; first < count; first += kMaxBatchSize)
+                    {
+                        const std::size_t end = std::min(count, first + kMaxBatchSize);
+                        if (!randomized)
+                        {
+                            for (std::size_t i = first; i < end; ++i)
+                            {
+                                verified[i] = Verify(items[i].mPublicKey, items[i].mMessage, items[i].mMessageSize, context, contextSize, items[i].mSignature);
+                            }
+                            continue;
+                        }
+
+                        // Terms of the combination: the R_i with z_i and each distinct A with the sum of its z_i * k_i.
+                        Curve25519::Point points[Curve25519::kMaxSumCount];
+                        ScalarModulus::Element coefficients[Curve25519::kMaxSumCount];
+                        std::size_t termCount = 0;
+                        const std::uint8_t *keys[kMaxBatchSize];
+                        std::size_t keyTerms[kMaxBatchSize];
+                        std::size_t keyCount = 0;
+                        ScalarModulus::Element baseCoefficient = {{0u, 0u, 0u, 0u}};
+                        std::size_t pending[kMaxBatchSize];
+                        std::size_t pendingCount = 0;
+
+                        for (std::size_t i = first; i < end; ++i)
+                        {
+                            const BatchItem &item = items[i];
+                            Curve25519::Point nonce;
+                            ScalarModulus::Element scalar;
+                            if (!Curve25519::DecodeEdwards(item.mSignature, nonce) || !DecodeScalar(scalar, item.mSignature + Curve25519::kSize))
+                            {
+                                continue;
+                            }
+                            std::size_t key = 0;
+                            while ((key < keyCount) && !std::equal(item.mPublicKey, item.mPublicKey + kPublicKeySize, keys[key]))
+                            {
+                                ++key;
+                            }
+                            if (key == keyCount)
+                            {
+                                if (!Curve25519::DecodeEdwards(item.mPublicKey, points[termCount]))
+                                {
+                                    continue;
+                                }
+                                coefficients[termCount] = ScalarModulus::Element{{0u, 0u, 0u, 0u}};
+                                keys[keyCount] = item.mPublicKey;
+                                keyTerms[keyCount++] = termCount++;
+                            }
+
+                            // z_i = H(seed || i || R || S || A) truncated to 128 bits
+                            std::uint8_t digest[Sha512::kDigestSize];
+                            std::uint8_t index[8];
+                            for (std::size_t j = 0; j < sizeof(index); ++j)
+                            {
+                                index[j] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(i) >> (8u * j));
+                            }
+                            Sha512 hash;
+                            hash.Update(seed, sizeof(seed));
+                            hash.Update(index, sizeof(index));
+                            hash.Update(item.mSignature, kSignatureSize);
+                            hash.Update(item.mPublicKey, kPublicKeySize);
+                            hash.Finish(digest);
+                            ScalarModulus::Element weight, weightMontgomery, challenge, product;
+                            order.Reduce(weight, digest, 16u, false);
+                            order.ToMontgomery(weightMontgomery, weight);
+
+                            ComputeChallenge(challenge, item.mPublicKey, item.mMessage, item.mMessageSize, context, contextSize, item.mSignature);
+                            order.Multiply(product, weightMontgomery, challenge);
+                            order.Add(coefficients[keyTerms[key]], coefficients[keyTerms[key]], product);
+                            order.Multiply(product, weightMontgomery, scalar);
+                            order.Add(baseCoefficient, baseCoefficient, product);
+
+                            points[termCount] = nonce;
+                            coefficients[termCount++] = weight;
+                            pending[pendingCount++] = i;
+                        }
+                        if (pendingCount == 0u)
+                        {
+                            continue;
+                        }
+
+                        std::uint8_t scalars[Curve25519::kMaxSumCount][Curve25519::kSize];
+                        for (std::size_t t = 0; t < termCount; ++t)
+                        {
+                            ScalarModulus::ToBytes(scalars[t], coefficients[t], false);
+                        }
+                        std::uint8_t baseScalar[Curve25519::kSize];
+                        ScalarModulus::ToBytes(baseScalar, baseCoefficient, false);
+                        const bool valid = Curve25519::CheckCofactoredSum(baseScalar, scalars, points, termCount);
+                        for (std::size_t p = 0; p < pendingCount; ++p)
+                        {
+                            const BatchItem &item = items[pending[p]];
+                            verified[pending[p]] = valid || Verify(item.mPublicKey, item.mMessage, item.mMessageSize, context, contextSize, item.mSignature);
+                        }
+                    }
+                    Wipe(seed, sizeof(seed));
+                }
+
+                void Ed25519::Clear (SigningKey &key) noexcept
+                {
+                    Wipe(&key, sizeof(key));
+                }
+            }
+        }
+    }
+}
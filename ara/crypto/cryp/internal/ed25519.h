@@ -0,0 +1,135 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_ED25519_H
+#define ARA_CRYPTO_CRYP_INTERNAL_ED25519_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/curve25519.h"
+#include "ara/crypto/cryp/internal/scalar_modulus.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Ed25519 signature scheme (RFC 8032). A signature with an empty context is a plain Ed25519
+                 * signature, a non-empty context selects the Ed25519ctx variant. The nonce is derived from the key
+                 * and the message, both base point multiplications of a signature use the fixed-base comb of
+                 * Curve25519. Verification works on public data only and is not constant-time.
+                 */
+                class Ed25519
+                {
+                public:
+
+                    /**
+                     * @brief Size of the private key (seed) in bytes.
+                     */
+                    static const std::size_t kSeedSize = Curve25519::kSize;
+
+                    /**
+                     * @brief Size of the public key in bytes.
+                     */
+                    static const std::size_t kPublicKeySize = Curve25519::kSize;
+
+                    /**
+                     * @brief Size of the signature (R || S) in bytes.
+                     */
+                    static const std::size_t kSignatureSize = 2u * Curve25519::kSize;
+
+                    /**
+                     * @brief Maximal size of the Ed25519ctx context in bytes.
+                     */
+                    static const std::size_t kMaxContextSize = 255u;
+
+                    /**
+                     * @brief Signing key expanded from the seed once, so a signature costs only the two hashes of
+                     * the message and one base point multiplication.
+                     */
+                    struct SigningKey
+                    {
+                        ScalarModulus::Element mScalar;         // the secret scalar modulo L in the Montgomery form
+                        std::uint8_t mPrefix[Curve25519::kSize];
+                        std::uint8_t mPublicKey[kPublicKeySize];
+                    };
+
+                    /**
+                     * @brief Expand a private key.
+                     * @param[in] seed the private key
+                     * @param[out] key the expanded signing key
+                     */
+                    static void ExpandKey (const std::uint8_t seed[kSeedSize], SigningKey &key) noexcept;
+
+                    /**
+                     * @brief Sign a message.
+                     * @param[in] key the expanded signing key
+                     * @param[in] message the message
+                     * @param[in] messageSize size of the message in bytes
+                     * @param[in] context the context of Ed25519ctx (may be nullptr if contextSize is zero)
+                     * @param[in] contextSize size of the context in bytes
+                     * @param[out] signature the signature
+                     * @return false if the context is longer than kMaxContextSize
+                     */
+                    static bool Sign (const SigningKey &key, const std::uint8_t *message, std::size_t messageSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t signature[kSignatureSize]) noexcept;
+
+                    /**
+                     * @brief Maximal number of signatures checked by one equation of VerifyBatch().
+                     */
+                    static const std::size_t kMaxBatchSize = Curve25519::kMaxSumCount / 2u;
+
+                    /**
+                     * @brief Signature of a batch verification.
+                     */
+                    struct BatchItem
+                    {
+                        const std::uint8_t *mPublicKey;     // kPublicKeySize bytes
+                        const std::uint8_t *mMessage;
+                        std::size_t mMessageSize;
+                        const std::uint8_t *mSignature;     // kSignatureSize bytes
+                    };
+
+                    /**
+                     * @brief Verify a signature by the cofactored equation [8](S * B) = [8](R + k * A), which RFC 8032
+                     * permits and VerifyBatch() needs to agree with single verifications.
+                     * @param[in] publicKey the public key
+                     * @param[in] message the message
+                     * @param[in] messageSize size of the message in bytes
+                     * @param[in] context the context of Ed25519ctx (may be nullptr if contextSize is zero)
+                     * @param[in] contextSize size of the context in bytes
+                     * @param[in] signature the signature
+                     * @return true if the signature is valid, false otherwise (also if the context is longer than
+                     * kMaxContextSize)
+                     */
+                    static bool Verify (const std::uint8_t publicKey[kPublicKeySize], const std::uint8_t *message, std::size_t messageSize, const std::uint8_t *context, std::size_t contextSize, const std::uint8_t signature[kSignatureSize]) noexcept;
+
+                    /**
+                     * @brief Verify signatures in batches of up to kMaxBatchSize by one random linear combination of
+                     * their equations: [8](sum(z_i * S_i) * B) = [8](sum(z_i * R_i) + sum(z_i * k_i * A_i)) with
+                     * secret 128-bit z_i derived from system entropy, so a forged signature passes with a probability
+                     * of at most 2^-128. The doublings are shared by the whole batch and the terms of a public key
+                     * repeated in a batch are merged into one. If a batch fails, its signatures are verified one by
+                     * one to find the invalid ones; without system entropy all of them are.
+                     * @param[in] items the signatures
+                     * @param[in] count number of the signatures
+                     * @param[in] context the context of Ed25519ctx common to all signatures (may be nullptr if
+                     * contextSize is zero)
+                     * @param[in] contextSize size of the context in bytes
+                     * @param[out] verified the results, true if the correspondent signature is valid
+                     */
+                    static void VerifyBatch (const BatchItem *items, std::size_t count, const std::uint8_t *context, std::size_t contextSize, bool *verified) noexcept;
+
+                    /**
+                     * @brief Wipe an expanded signing key.
+                     * @param[out] key the key
+                     */
+                    static void Clear (SigningKey &key) noexcept;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_ED25519_H
@@ -0,0 +1,79 @@
+#include "ara/crypto/cryp/internal/entropy_source.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    bool ReadUrandom (std::uint8_t *out, std::size_t size) noexcept
+                    {
+                        const int fd = ::open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+                        if (fd < 0)
+                        {
+                            return false;
+                        }
+                        while (size != 0u)
+                        {
+                            const ssize_t received = ::read(fd, out, size);
+                            if (received < 0)
+                            {
+                                if (errno == EINTR)
+                                {
+                                    continue;
+                                }
+                                ::close(fd);
+                                return false;
+                            }
+                            if (received == 0)
+                            {
+                                ::close(fd);
+                                return false;
+                            }
+                            out += received;
+                            size -= static_cast<std::size_t>(received);
+                        }
+                        ::close(fd);
+                        return true;
+                    }
+                }
+
+                bool GetSystemEntropy (std::uint8_t *out, std::size_t size) noexcept
+                {
+#if defined(__linux__) && defined(SYS_getrandom)
+                    while (size != 0u)
+                    {
+                        const long received = ::syscall(SYS_getrandom, out, size, 0);
+                        if (received < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            // Kernels older than 3.17 do not provide the system call.
+                            return (errno == ENOSYS) && ReadUrandom(out, size);
+                        }
+                        out += received;
+                        size -= static_cast<std::size_t>(received);
+                    }
+                    return true;
+#else
+                    return ReadUrandom(out, size);
+#endif
+                }
+            }
+        }
+    }
+}
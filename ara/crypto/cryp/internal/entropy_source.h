@@ -0,0 +1,29 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_ENTROPY_SOURCE_H
+#define ARA_CRYPTO_CRYP_INTERNAL_ENTROPY_SOURCE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Read full-entropy bytes from the operating system: the getrandom() system call on Linux
+                 * (blocking only until the kernel pool is initialized after boot), otherwise /dev/urandom.
+                 * @param[out] out the output buffer
+                 * @param[in] size number of bytes to read
+                 * @return true if the whole buffer is filled
+                 * @return false if the entropy source is not available
+                 */
+                bool GetSystemEntropy (std::uint8_t *out, std::size_t size) noexcept;
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_ENTROPY_SOURCE_H
@@ -0,0 +1,313 @@
+#include "ara/crypto/cryp/internal/ghash.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARA_CRYPTO_PCLMUL 1
+#include <immintrin.h>
+#define ARA_CRYPTO_PCLMUL_TARGET __attribute__((target("pclmul,ssse3,sse2")))
+#endif
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    inline std::uint64_t LoadBe64 (const std::uint8_t *bytes) noexcept
+                    {
+                        std::uint64_t value = 0u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            value = (value << 8) | bytes[i];
+                        }
+                        return value;
+                    }
+
+                    inline void StoreBe64 (std::uint64_t value, std::uint8_t *bytes) noexcept
+                    {
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            bytes[7u - i] = static_cast<std::uint8_t>(value >> (8u * i));
+                        }
+                    }
+
+                    /**
+                     * @brief Portable multiplication X = X * H in GF(2^128) (SP 800-38D, algorithm 1) with masks
+                     * instead of branches. The blocks are kept as two big-endian 64-bit halves.
+                     */
+                    void MultiplyPortable (std::uint64_t x[2], const std::uint64_t h[2]) noexcept
+                    {
+                        std::uint64_t z0 = 0u;
+                        std::uint64_t z1 = 0u;
+                        std::uint64_t v0 = h[0];
+                        std::uint64_t v1 = h[1];
+                        for (std::size_t i = 0; i < 128u; ++i)
+                        {
+                            const std::uint64_t word = (i < 64u) ? x[0] : x[1];
+                            const std::uint64_t bit = 0u - ((word >> (63u - (i % 64u))) & 1u);
+                            z0 ^= v0 & bit;
+                            z1 ^= v1 & bit;
+                            const std::uint64_t carry = 0u - (v1 & 1u);
+                            v1 = (v1 >> 1) | (v0 << 63);
+                            v0 = (v0 >> 1) ^ (0xE100000000000000u & carry);
+                        }
+                        x[0] = z0;
+                        x[1] = z1;
+                    }
+
+#ifdef ARA_CRYPTO_PCLMUL
+                    bool IsPclmulSupported () noexcept
+                    {
+                        static const bool cSupported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+                        return cSupported;
+                    }
+
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    inline __m128i ReverseBytes (__m128i block) noexcept
+                    {
+                        return _mm_shuffle_epi8(block, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+                    }
+
+                    // 256-bit carry-less product of two byte-reflected blocks, the reduction is deferred.
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    inline void MultiplyWide (__m128i a, __m128i b, __m128i &low, __m128i &high) noexcept
+                    {
+                        __m128i middle = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+                        low = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(middle, 8));
+                        high = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(middle, 8));
+                    }
+
+                    // Reduction of a 256-bit product modulo x^128 + x^7 + x^2 + x + 1 in the reflected
+                    // representation (Intel carry-less multiplication guide, algorithm 5): shift the product
+                    // left by one bit, then fold the low half twice.
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    inline __m128i Reduce (__m128i low, __m128i high) noexcept
+                    {
+                        __m128i carryLow = _mm_srli_epi32(low, 31);
+                        __m128i carryHigh = _mm_srli_epi32(high, 31);
+                        low = _mm_slli_epi32(low, 1);
+                        high = _mm_slli_epi32(high, 1);
+                        const __m128i crossing = _mm_srli_si128(carryLow, 12);
+                        carryHigh = _mm_slli_si128(carryHigh, 4);
+                        carryLow = _mm_slli_si128(carryLow, 4);
+                        low = _mm_or_si128(low, carryLow);
+                        high = _mm_or_si128(_mm_or_si128(high, carryHigh), crossing);
+
+                        __m128i fold = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(low, 31), _mm_slli_epi32(low, 30)), _mm_slli_epi32(low, 25));
+                        const __m128i rest = _mm_srli_si128(fold, 4);
+                        fold = _mm_slli_si128(fold, 12);
+                        low = _mm_xor_si128(low, fold);
+
+                        __m128i second = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(low, 1), _mm_srli_epi32(low, 2)), _mm_srli_epi32(low, 7));
+                        second = _mm_xor_si128(second, rest);
+                        low = _mm_xor_si128(low, second);
+                        return _mm_xor_si128(high, low);
+                    }
+
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    inline __m128i MultiplyNi (__m128i a, __m128i b) noexcept
+                    {
+                        __m128i low;
+                        __m128i high;
+                        MultiplyWide(a, b, low, high);
+                        return Reduce(low, high);
+                    }
+
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    void SetKeyNi (const std::uint8_t key[Ghash::kBlockSize], std::uint8_t powers[4][Ghash::kBlockSize]) noexcept
+                    {
+                        const __m128i h = ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(key)));
+                        __m128i power = h;
+                        _mm_store_si128(reinterpret_cast<__m128i*>(powers[0]), power);
+                        for (std::size_t i = 1; i < 4u; ++i)
+                        {
+                            power = MultiplyNi(power, h);
+                            _mm_store_si128(reinterpret_cast<__m128i*>(powers[i]), power);
+                        }
+                    }
+
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    void BlocksNi (const std::uint8_t powers[4][Ghash::kBlockSize], std::uint8_t state[Ghash::kBlockSize], const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                    {
+                        const __m128i h1 = _mm_load_si128(reinterpret_cast<const __m128i*>(powers[0]));
+                        const __m128i h2 = _mm_load_si128(reinterpret_cast<const __m128i*>(powers[1]));
+                        const __m128i h3 = _mm_load_si128(reinterpret_cast<const __m128i*>(powers[2]));
+                        const __m128i h4 = _mm_load_si128(reinterpret_cast<const __m128i*>(powers[3]));
+                        __m128i y = _mm_load_si128(reinterpret_cast<const __m128i*>(state));
+
+                        // Y' = (Y + X0) * H^4 + X1 * H^3 + X2 * H^2 + X3 * H with a single reduction.
+                        for (; blockCount >= 4u; blockCount -= 4u, blocks += 4u * Ghash::kBlockSize)
+                        {
+                            const __m128i x0 = ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks)));
+                            const __m128i x1 = ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16u)));
+                            const __m128i x2 = ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 32u)));
+                            const __m128i x3 = ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 48u)));
+                            __m128i low;
+                            __m128i high;
+                            __m128i partLow;
+                            __m128i partHigh;
+                            MultiplyWide(_mm_xor_si128(y, x0), h4, low, high);
+                            MultiplyWide(x1, h3, partLow, partHigh);
+                            low = _mm_xor_si128(low, partLow);
+                            high = _mm_xor_si128(high, partHigh);
+                            MultiplyWide(x2, h2, partLow, partHigh);
+                            low = _mm_xor_si128(low, partLow);
+                            high = _mm_xor_si128(high, partHigh);
+                            MultiplyWide(x3, h1, partLow, partHigh);
+                            low = _mm_xor_si128(low, partLow);
+                            high = _mm_xor_si128(high, partHigh);
+                            y = Reduce(low, high);
+                        }
+                        for (; blockCount > 0u; --blockCount, blocks += Ghash::kBlockSize)
+                        {
+                            const __m128i x = ReverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks)));
+                            y = MultiplyNi(_mm_xor_si128(y, x), h1);
+                        }
+                        _mm_store_si128(reinterpret_cast<__m128i*>(state), y);
+                    }
+
+                    ARA_CRYPTO_PCLMUL_TARGET
+                    void OutputNi (const std::uint8_t state[Ghash::kBlockSize], std::uint8_t out[Ghash::kBlockSize]) noexcept
+                    {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), ReverseBytes(_mm_load_si128(reinterpret_cast<const __m128i*>(state))));
+                    }
+#endif
+                }
+
+                Ghash::Ghash () noexcept : mBuffered(0u), mAccelerated(false)
+                {
+                    std::memset(mPowers, 0, sizeof(mPowers));
+                    std::memset(mState, 0, sizeof(mState));
+                    std::memset(mBuffer, 0, sizeof(mBuffer));
+                }
+
+                Ghash::~Ghash () noexcept
+                {
+                    Clear();
+                }
+
+                void Ghash::SetKey (const std::uint8_t key[kBlockSize]) noexcept
+                {
+#ifdef ARA_CRYPTO_PCLMUL
+                    mAccelerated = IsPclmulSupported();
+                    if (mAccelerated)
+                    {
+                        SetKeyNi(key, mPowers);
+                        Start();
+                        return;
+                    }
+#endif
+                    std::memcpy(mPowers[0], key, kBlockSize);
+                    Start();
+                }
+
+                void Ghash::Start () noexcept
+                {
+                    std::memset(mState, 0, sizeof(mState));
+                    mBuffered = 0u;
+                }
+
+                void Ghash::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    if (mBuffered != 0u)
+                    {
+                        const std::size_t taken = (size < (kBlockSize - mBuffered)) ? size : (kBlockSize - mBuffered);
+                        std::memcpy(mBuffer + mBuffered, data, taken);
+                        mBuffered += taken;
+                        data += taken;
+                        size -= taken;
+                        if (mBuffered < kBlockSize)
+                        {
+                            return;
+                        }
+                        Blocks(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+
+                    const std::size_t blockCount = size / kBlockSize;
+                    if (blockCount != 0u)
+                    {
+                        Blocks(data, blockCount);
+                        data += blockCount * kBlockSize;
+                        size -= blockCount * kBlockSize;
+                    }
+                    if (size != 0u)
+                    {
+                        std::memcpy(mBuffer, data, size);
+                        mBuffered = size;
+                    }
+                }
+
+                void Ghash::Pad () noexcept
+                {
+                    if (mBuffered != 0u)
+                    {
+                        std::memset(mBuffer + mBuffered, 0, kBlockSize - mBuffered);
+                        Blocks(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+                }
+
+                void Ghash::Finish (std::uint64_t aadBits, std::uint64_t textBits, std::uint8_t out[kBlockSize]) noexcept
+                {
+                    Pad();
+                    std::uint8_t lengths[kBlockSize];
+                    StoreBe64(aadBits, lengths);
+                    StoreBe64(textBits, lengths + 8u);
+                    Blocks(lengths, 1u);
+#ifdef ARA_CRYPTO_PCLMUL
+                    if (mAccelerated)
+                    {
+                        OutputNi(mState, out);
+                        return;
+                    }
+#endif
+                    std::memcpy(out, mState, kBlockSize);
+                }
+
+                void Ghash::Clear () noexcept
+                {
+                    SecureWipe(mPowers, sizeof(mPowers));
+                    SecureWipe(mState, sizeof(mState));
+                    SecureWipe(mBuffer, sizeof(mBuffer));
+                    mBuffered = 0u;
+                }
+
+                void Ghash::Blocks (const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                {
+#ifdef ARA_CRYPTO_PCLMUL
+                    if (mAccelerated)
+                    {
+                        BlocksNi(mPowers, mState, blocks, blockCount);
+                        return;
+                    }
+#endif
+                    const std::uint64_t h[2] = {LoadBe64(mPowers[0]), LoadBe64(mPowers[0] + 8u)};
+                    std::uint64_t y[2] = {LoadBe64(mState), LoadBe64(mState + 8u)};
+                    for (; blockCount > 0u; --blockCount, blocks += kBlockSize)
+                    {
+                        y[0] ^= LoadBe64(blocks);
+                        y[1] ^= LoadBe64(blocks + 8u);
+                        MultiplyPortable(y, h);
+                    }
+                    StoreBe64(y[0], mState);
+                    StoreBe64(y[1], mState + 8u);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_GHASH_H
+#define ARA_CRYPTO_CRYP_INTERNAL_GHASH_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief GHASH universal hash function of GCM and GMAC (NIST SP 800-38D). On x86 processors
+                 * supporting the carry-less multiplication (PCLMULQDQ) four blocks are multiplied by the
+                 * precomputed powers H^4 ... H^1 and reduced once; otherwise a portable constant-time bitwise
+                 * multiplication is used. The object is copyable, so the keyed state can be saved and restored.
+                 */
+                class Ghash
+                {
+                public:
+
+                    /**
+                     * @brief Size of the block, the key and the output in bytes.
+                     */
+                    static const std::size_t kBlockSize = 16u;
+
+                    Ghash () noexcept;
+
+                    /**
+                     * @brief Destroy the Ghash object wiping the key and the state.
+                     */
+                    ~Ghash () noexcept;
+
+                    /**
+                     * @brief Deploy the hash key H and start a new computation.
+                     * @param[in] key the hash key
+                     */
+                    void SetKey (const std::uint8_t key[kBlockSize]) noexcept;
+
+                    /**
+                     * @brief Restart the computation with the deployed key.
+                     */
+                    void Start () noexcept;
+
+                    /**
+                     * @brief Hash a portion of the input. Portions are concatenated, a partial block is kept until
+                     * more input arrives or Pad() is called.
+                     * @param[in] data the input portion
+                     * @param[in] size size of the portion in bytes
+                     */
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Pad a buffered partial block with zeros and hash it (the end of the AAD or the text).
+                     */
+                    void Pad () noexcept;
+
+                    /**
+                     * @brief Pad the input, hash the length block and output the hash value.
+                     * @param[in] aadBits length of the additional authenticated data in bits
+                     * @param[in] textBits length of the text in bits
+                     * @param[out] out the hash value
+                     */
+                    void Finish (std::uint64_t aadBits, std::uint64_t textBits, std::uint8_t out[kBlockSize]) noexcept;
+
+                    /**
+                     * @brief Wipe the key and the state.
+                     */
+                    void Clear () noexcept;
+
+                private:
+
+                    void Blocks (const std::uint8_t *blocks, std::size_t blockCount) noexcept;
+
+                    // The powers H^1 ... H^4 in the byte-reflected form of the PCLMULQDQ kernel, or H as two
+                    // big-endian halves in mPowers[0] of the portable one.
+                    alignas(16) std::uint8_t mPowers[4][kBlockSize];
+                    alignas(16) std::uint8_t mState[kBlockSize];
+                    std::uint8_t mBuffer[kBlockSize];
+                    std::size_t mBuffered;
+                    bool mAccelerated;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_GHASH_H
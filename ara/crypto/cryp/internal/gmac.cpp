@@ -0,0 +1,105 @@
+#include "ara/crypto/cryp/internal/gmac.h"
+
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+                }
+
+                Gmac::Gmac () noexcept : mLength(0u)
+                {
+                    std::memset(mMask, 0, sizeof(mMask));
+                }
+
+                Gmac::~Gmac () noexcept
+                {
+                    Clear();
+                }
+
+                bool Gmac::SetKey (const std::uint8_t *key, std::size_t keySize) noexcept
+                {
+                    if (!mAes.SetKey(key, keySize))
+                    {
+                        return false;
+                    }
+                    std::uint8_t h[Aes::kBlockSize] = {};
+                    mAes.EncryptBlocks(h, h, 1u);
+                    mKeyedHash.SetKey(h);
+                    mHash = mKeyedHash;
+                    SecureWipe(h, sizeof(h));
+                    return true;
+                }
+
+                bool Gmac::Start (const std::uint8_t *iv, std::size_t ivSize) noexcept
+                {
+                    if (ivSize == 0u)
+                    {
+                        return false;
+                    }
+
+                    // J0 = IV || 0^31 || 1 for a 96-bit IV, otherwise GHASH(IV || 0^s || [0]_64 || [len(IV)]_64)
+                    std::uint8_t counter[Aes::kBlockSize] = {};
+                    if (ivSize == kIvSize)
+                    {
+                        std::memcpy(counter, iv, kIvSize);
+                        counter[Aes::kBlockSize - 1u] = 1u;
+                    }
+                    else
+                    {
+                        mHash = mKeyedHash;
+                        mHash.Update(iv, ivSize);
+                        mHash.Finish(0u, static_cast<std::uint64_t>(ivSize) * 8u, counter);
+                    }
+                    mAes.EncryptBlocks(counter, mMask, 1u);
+                    mHash = mKeyedHash;
+                    mLength = 0u;
+                    return true;
+                }
+
+                void Gmac::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    mHash.Update(data, size);
+                    mLength += size;
+                }
+
+                void Gmac::Finish (std::uint8_t *mac) noexcept
+                {
+                    std::uint8_t tag[Aes::kBlockSize];
+                    mHash.Finish(mLength * 8u, 0u, tag);
+                    for (std::size_t i = 0; i < kDigestSize; ++i)
+                    {
+                        mac[i] = tag[i] ^ mMask[i];
+                    }
+                    SecureWipe(mMask, sizeof(mMask));
+                    mHash = mKeyedHash;
+                    mLength = 0u;
+                }
+
+                void Gmac::Clear () noexcept
+                {
+                    mAes.Clear();
+                    mKeyedHash.Clear();
+                    mHash.Clear();
+                    SecureWipe(mMask, sizeof(mMask));
+                    mLength = 0u;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_GMAC_H
+#define ARA_CRYPTO_CRYP_INTERNAL_GMAC_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/aes.h"
+#include "ara/crypto/cryp/internal/ghash.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief GMAC over AES (NIST SP 800-38D): GCM authenticating the message as the additional data
+                 * of an empty plaintext. The hash key H and its powers are computed once by SetKey(); Start()
+                 * costs one block encryption of the pre-counter block. The IV must never repeat under a key.
+                 * The object is copyable, so the keyed state can be saved and restored.
+                 */
+                class Gmac
+                {
+                public:
+
+                    /**
+                     * @brief Size of the MAC in bytes.
+                     */
+                    static const std::size_t kDigestSize = Aes::kBlockSize;
+
+                    /**
+                     * @brief Recommended size of the IV in bytes (other sizes are hashed by GHASH).
+                     */
+                    static const std::size_t kIvSize = 12u;
+
+                    Gmac () noexcept;
+
+                    /**
+                     * @brief Destroy the Gmac object wiping the keyed state.
+                     */
+                    ~Gmac () noexcept;
+
+                    /**
+                     * @brief Deploy a key.
+                     * @param[in] key the AES key
+                     * @param[in] keySize size of the key in bytes: 16, 24 or 32
+                     * @return false if the key size is invalid
+                     */
+                    bool SetKey (const std::uint8_t *key, std::size_t keySize) noexcept;
+
+                    /**
+                     * @brief Check if a key is deployed.
+                     * @return true if SetKey() has succeeded
+                     */
+                    bool IsKeySet () const noexcept
+                    {
+                        return mAes.IsKeySet();
+                    }
+
+                    /**
+                     * @brief Start a new computation with the deployed key.
+                     * @param[in] iv the initialization vector
+                     * @param[in] ivSize size of the IV in bytes
+                     * @return false if the IV is empty
+                     */
+                    bool Start (const std::uint8_t *iv, std::size_t ivSize) noexcept;
+
+                    /**
+                     * @brief Authenticate a portion of the message.
+                     * @param[in] data the message portion
+                     * @param[in] size size of the portion in bytes
+                     */
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Finish the computation. A new one needs a new IV passed to Start().
+                     * @param[out] mac the MAC value of kDigestSize bytes
+                     */
+                    void Finish (std::uint8_t *mac) noexcept;
+
+                    /**
+                     * @brief Wipe the keyed state.
+                     */
+                    void Clear () noexcept;
+
+                private:
+                    Aes mAes;
+                    Ghash mKeyedHash;   // GHASH with the deployed key and an empty state
+                    Ghash mHash;
+                    std::uint8_t mMask[Aes::kBlockSize];
+                    std::uint64_t mLength;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_GMAC_H
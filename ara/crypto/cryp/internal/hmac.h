@@ -0,0 +1,165 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_HMAC_H
+#define ARA_CRYPTO_CRYP_INTERNAL_HMAC_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief HMAC (RFC 2104, FIPS 198-1) over a hash function class providing kBlockSize, kDigestSize,
+                 * Update(), Finish() and copy semantics. The hash states after absorbing the inner and outer padded
+                 * keys are computed once by SetKey(), so every following MAC costs only the message blocks plus two
+                 * finalizations, and Start() restarts a computation by a plain copy of the saved inner state.
+                 * @tparam Hash the hash function class
+                 */
+                template <class Hash>
+                class Hmac
+                {
+                public:
+
+                    /**
+                     * @brief Size of the MAC in bytes.
+                     */
+                    static const std::size_t kDigestSize = Hash::kDigestSize;
+
+                    /**
+                     * @brief Size of the hash function input block in bytes.
+                     */
+                    static const std::size_t kBlockSize = Hash::kBlockSize;
+
+                    /**
+                     * @brief Destroy the Hmac object wiping the keyed states.
+                     */
+                    ~Hmac () noexcept
+                    {
+                        Clear();
+                    }
+
+                    /**
+                     * @brief Deploy a key and start a new computation.
+                     * @param[in] key the key value
+                     * @param[in] keySize size of the key in bytes (keys longer than kBlockSize are hashed)
+                     */
+                    void SetKey (const std::uint8_t *key, std::size_t keySize) noexcept
+                    {
+                        std::uint8_t block[kBlockSize] = {};
+                        if (keySize > kBlockSize)
+                        {
+                            Hash hash;
+                            hash.Update(key, keySize);
+                            hash.Finish(block);
+                        }
+                        else
+                        {
+                            for (std::size_t i = 0; i < keySize; ++i)
+                            {
+                                block[i] = key[i];
+                            }
+                        }
+
+                        for (std::size_t i = 0; i < kBlockSize; ++i)
+                        {
+                            block[i] ^= 0x36u;
+                        }
+                        mInnerStart.Reset();
+                        mInnerStart.Update(block, kBlockSize);
+                        for (std::size_t i = 0; i < kBlockSize; ++i)
+                        {
+                            block[i] ^= (0x36u ^ 0x5Cu);
+                        }
+                        mOuterStart.Reset();
+                        mOuterStart.Update(block, kBlockSize);
+                        Wipe(block, sizeof(block));
+                        Start();
+                    }
+
+                    /**
+                     * @brief Restart the computation with the deployed key.
+                     */
+                    void Start () noexcept
+                    {
+                        mInner = mInnerStart;
+                    }
+
+                    /**
+                     * @brief Authenticate a portion of the message.
+                     * @param[in] data the message portion
+                     * @param[in] size size of the portion in bytes
+                     */
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept
+                    {
+                        mInner.Update(data, size);
+                    }
+
+                    /**
+                     * @brief Finish the computation and restart it with the deployed key.
+                     * @param[out] mac the MAC value of kDigestSize bytes
+                     */
+                    void Finish (std::uint8_t *mac) noexcept
+                    {
+                        std::uint8_t innerDigest[kDigestSize];
+                        mInner.Finish(innerDigest);
+                        Hash outer = mOuterStart;
+                        outer.Update(innerDigest, kDigestSize);
+                        outer.Finish(mac);
+                        Wipe(innerDigest, sizeof(innerDigest));
+                        Start();
+                    }
+
+                    /**
+                     * @brief Wipe the keyed states.
+                     */
+                    void Clear () noexcept
+                    {
+                        Wipe(&mInnerStart, sizeof(mInnerStart));
+                        Wipe(&mOuterStart, sizeof(mOuterStart));
+                        Wipe(&mInner, sizeof(mInner));
+                        mInnerStart.Reset();
+                        mOuterStart.Reset();
+                        mInner.Reset();
+                    }
+
+                    /**
+                     * @brief Compute the MAC of a message at once.
+                     * @param[in] key the key value
+                     * @param[in] keySize size of the key in bytes
+                     * @param[in] data the message
+                     * @param[in] size size of the message in bytes
+                     * @param[out] mac the MAC value of kDigestSize bytes
+                     */
+                    static void Compute (const std::uint8_t *key, std::size_t keySize, const std::uint8_t *data, std::size_t size, std::uint8_t *mac) noexcept
+                    {
+                        Hmac hmac;
+                        hmac.SetKey(key, keySize);
+                        hmac.Update(data, size);
+                        hmac.Finish(mac);
+                    }
+
+                private:
+
+                    static void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    Hash mInnerStart;
+                    Hash mOuterStart;
+                    Hash mInner;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_HMAC_H
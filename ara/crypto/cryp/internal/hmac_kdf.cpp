@@ -0,0 +1,252 @@
+#include "ara/crypto/cryp/internal/hmac_kdf.h"
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    const std::uint8_t kSeparator = 0x00u;
+
+                    // Maximal output of HKDF-Expand: 255 blocks of the hash.
+                    const std::size_t kMaxHkdfSize = 255u * Sha256::kDigestSize;
+
+                    // Maximal output of the SP 800-108 KDF: its bit length is encoded by 32 bits.
+                    const std::size_t kMaxCounterSize = 0xFFFFFFFFu / 8u;
+
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    void StoreBe32 (std::uint32_t value, std::uint8_t *bytes) noexcept
+                    {
+                        bytes[0] = static_cast<std::uint8_t>(value >> 24);
+                        bytes[1] = static_cast<std::uint8_t>(value >> 16);
+                        bytes[2] = static_cast<std::uint8_t>(value >> 8);
+                        bytes[3] = static_cast<std::uint8_t>(value);
+                    }
+
+                    template <class Prf>
+                    void UpdateInfo (Prf &prf, const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize) noexcept
+                    {
+                        if (labelSize != 0u)
+                        {
+                            prf.Update(label, labelSize);
+                        }
+                        if (contextSize != 0u)
+                        {
+                            prf.Update(&kSeparator, 1u);
+                            prf.Update(context, contextSize);
+                        }
+                    }
+                }
+
+                HmacKdf::HmacKdf (CryptoAlgId algId) noexcept :
+                    mAlgId(algId),
+                    mIterations((algId == kAlgIdPbkdf2HmacSha2_256) ? kDefaultIterations : 1u),
+                    mKeySet(false)
+                {
+                }
+
+                bool HmacKdf::IsSupported () const noexcept
+                {
+                    return (mAlgId == kAlgIdHkdfSha2_256) || (mAlgId == kAlgIdKdfCtrHmacSha2_256) || (mAlgId == kAlgIdPbkdf2HmacSha2_256);
+                }
+
+                std::uint32_t HmacKdf::ConfigIterations (std::uint32_t iterations) noexcept
+                {
+                    if (mAlgId == kAlgIdPbkdf2HmacSha2_256)
+                    {
+                        mIterations = (iterations == 0u) ? kDefaultIterations : iterations;
+                    }
+                    return mIterations;
+                }
+
+                void HmacKdf::SetSourceKeyMaterial (const std::uint8_t *keyMaterial, std::size_t size, const std::uint8_t *salt, std::size_t saltSize) noexcept
+                {
+                    if (mAlgId == kAlgIdHkdfSha2_256)
+                    {
+                        // HKDF-Extract: PRK = HMAC(salt, IKM), an absent salt is a string of HashLen zeros.
+                        const std::uint8_t zeroSalt[Sha256::kDigestSize] = {};
+                        std::uint8_t prk[Sha256::kDigestSize];
+                        if (saltSize == 0u)
+                        {
+                            Prf::Compute(zeroSalt, sizeof(zeroSalt), keyMaterial, size, prk);
+                        }
+                        else
+                        {
+                            Prf::Compute(salt, saltSize, keyMaterial, size, prk);
+                        }
+                        mPrf.SetKey(prk, sizeof(prk));
+                        Wipe(prk, sizeof(prk));
+                    }
+                    else
+                    {
+                        mPrf.SetKey(keyMaterial, size);
+                    }
+                    mKeySet = true;
+                }
+
+                bool HmacKdf::Derive (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    if (!mKeySet || !IsSupported())
+                    {
+                        return false;
+                    }
+
+                    switch (mAlgId)
+                    {
+                    case kAlgIdHkdfSha2_256:
+                        if (size > kMaxHkdfSize)
+                        {
+                            return false;
+                        }
+                        ExpandHkdf(label, labelSize, context, contextSize, out, size);
+                        break;
+                    case kAlgIdKdfCtrHmacSha2_256:
+                        if (size > kMaxCounterSize)
+                        {
+                            return false;
+                        }
+                        ExpandCounter(label, labelSize, context, contextSize, out, size);
+                        break;
+                    default:
+                        ExpandPbkdf2(label, labelSize, context, contextSize, out, size);
+                        break;
+                    }
+                    return true;
+                }
+
+                bool HmacKdf::DeriveBatch (const Label *labels, std::size_t count, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t keySize) const noexcept
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        if (!Derive(labels[i].mData, labels[i].mSize, context, contextSize, out + i * keySize, keySize))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                void HmacKdf::Clear () noexcept
+                {
+                    mPrf.Clear();
+                    mKeySet = false;
+                }
+
+                void HmacKdf::ExpandHkdf (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    // T(i) = HMAC(PRK, T(i - 1) || info || i)
+                    Prf prf = mPrf;
+                    std::uint8_t block[Sha256::kDigestSize];
+                    for (std::uint8_t counter = 1u; size != 0u; ++counter)
+                    {
+                        if (counter != 1u)
+                        {
+                            prf.Update(block, sizeof(block));
+                        }
+                        UpdateInfo(prf, label, labelSize, context, contextSize);
+                        prf.Update(&counter, 1u);
+                        prf.Finish(block);
+
+                        const std::size_t length = (size < sizeof(block)) ? size : sizeof(block);
+                        for (std::size_t i = 0; i < length; ++i)
+                        {
+                            out[i] = block[i];
+                        }
+                        out += length;
+                        size -= length;
+                    }
+                    Wipe(block, sizeof(block));
+                }
+
+                void HmacKdf::ExpandCounter (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    // K(i) = HMAC(KI, [i]_32 || Label || 0x00 || Context || [L]_32)
+                    Prf prf = mPrf;
+                    std::uint8_t block[Sha256::kDigestSize];
+                    std::uint8_t counter[4];
+                    std::uint8_t bitLength[4];
+                    StoreBe32(static_cast<std::uint32_t>(size * 8u), bitLength);
+                    for (std::uint32_t i = 1u; size != 0u; ++i)
+                    {
+                        StoreBe32(i, counter);
+                        prf.Update(counter, sizeof(counter));
+                        if (labelSize != 0u)
+                        {
+                            prf.Update(label, labelSize);
+                        }
+                        prf.Update(&kSeparator, 1u);
+                        if (contextSize != 0u)
+                        {
+                            prf.Update(context, contextSize);
+                        }
+                        prf.Update(bitLength, sizeof(bitLength));
+                        prf.Finish(block);
+
+                        const std::size_t length = (size < sizeof(block)) ? size : sizeof(block);
+                        for (std::size_t j = 0; j < length; ++j)
+                        {
+                            out[j] = block[j];
+                        }
+                        out += length;
+                        size -= length;
+                    }
+                    Wipe(block, sizeof(block));
+                }
+
+                void HmacKdf::ExpandPbkdf2 (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept
+                {
+                    // T_i = U_1 ^ ... ^ U_c, U_1 = PRF(P, S || INT(i)), U_j = PRF(P, U_{j-1})
+                    Prf prf = mPrf;
+                    std::uint8_t u[Sha256::kDigestSize];
+                    std::uint8_t t[Sha256::kDigestSize];
+                    std::uint8_t index[4];
+                    for (std::uint32_t i = 1u; size != 0u; ++i)
+                    {
+                        UpdateInfo(prf, label, labelSize, context, contextSize);
+                        StoreBe32(i, index);
+                        prf.Update(index, sizeof(index));
+                        prf.Finish(u);
+                        for (std::size_t k = 0; k < sizeof(t); ++k)
+                        {
+                            t[k] = u[k];
+                        }
+
+                        for (std::uint32_t j = 1u; j < mIterations; ++j)
+                        {
+                            prf.Update(u, sizeof(u));
+                            prf.Finish(u);
+                            for (std::size_t k = 0; k < sizeof(t); ++k)
+                            {
+                                t[k] ^= u[k];
+                            }
+                        }
+
+                        const std::size_t length = (size < sizeof(t)) ? size : sizeof(t);
+                        for (std::size_t k = 0; k < length; ++k)
+                        {
+                            out[k] = t[k];
+                        }
+                        out += length;
+                        size -= length;
+                    }
+                    Wipe(u, sizeof(u));
+                    Wipe(t, sizeof(t));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_HMAC_KDF_H
+#define ARA_CRYPTO_CRYP_INTERNAL_HMAC_KDF_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/internal/hmac.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Key derivation functions over HMAC/SHA2-256:
+                 * - HKDF (RFC 5869): the pseudorandom key is extracted once by SetSourceKeyMaterial(), the info of
+                 *   the expansion is Label || 0x00 || Context;
+                 * - KDF in counter mode (NIST SP 800-108): K(i) = PRF(KI, [i]_32 || Label || 0x00 || Context || [L]_32);
+                 * - PBKDF2 (RFC 8018): the salt is Label || 0x00 || Context.
+                 * The separator and the Context are omitted for HKDF and PBKDF2 if the Context is empty. The HMAC
+                 * states after absorbing the padded key are computed once by SetSourceKeyMaterial(), so every
+                 * derivation costs only the compressions of its own input (two per PBKDF2 iteration). Derive() does
+                 * not modify the object and may be called concurrently. KdfEngine exposes it with the parameters
+                 * of KeyDerivationFunctionCtx; EcdhEngine and RsaEngine derive their keys by it.
+                 */
+                class HmacKdf
+                {
+                public:
+
+                    /**
+                     * @brief A label of a batch derivation.
+                     */
+                    struct Label
+                    {
+                        const std::uint8_t *mData;
+                        std::size_t mSize;
+                    };
+
+                    /**
+                     * @brief Default number of PBKDF2 iterations.
+                     */
+                    static const std::uint32_t kDefaultIterations = 10000u;
+
+                    /**
+                     * @brief Construct a new HmacKdf object.
+                     * @param[in] algId kAlgIdHkdfSha2_256, kAlgIdKdfCtrHmacSha2_256 or kAlgIdPbkdf2HmacSha2_256
+                     */
+                    explicit HmacKdf (CryptoAlgId algId) noexcept;
+
+                    /**
+                     * @brief Check if the algorithm ID passed to the constructor is supported.
+                     * @return true if the algorithm is supported
+                     */
+                    bool IsSupported () const noexcept;
+
+                    /**
+                     * @brief Get the algorithm ID.
+                     * @return CryptoAlgId the algorithm ID passed to the constructor
+                     */
+                    CryptoAlgId GetAlgId () const noexcept
+                    {
+                        return mAlgId;
+                    }
+
+                    /**
+                     * @brief Configure the number of iterations. Only PBKDF2 is iterated, the other functions always
+                     * use 1.
+                     * @param[in] iterations the required number of iterations (0 means kDefaultIterations)
+                     * @return std::uint32_t the configured number of iterations
+                     */
+                    std::uint32_t ConfigIterations (std::uint32_t iterations=0) noexcept;
+
+                    /**
+                     * @brief Deploy the source key-material (the HKDF input keying material, the SP 800-108 key
+                     * derivation key or the PBKDF2 password) and precompute the keyed HMAC state.
+                     * @param[in] keyMaterial the source key-material
+                     * @param[in] size size of the key-material in bytes
+                     * @param[in] salt an optional HKDF extraction salt (ignored by other functions)
+                     * @param[in] saltSize size of the salt in bytes
+                     */
+                    void SetSourceKeyMaterial (const std::uint8_t *keyMaterial, std::size_t size, const std::uint8_t *salt=nullptr, std::size_t saltSize=0u) noexcept;
+
+                    /**
+                     * @brief Check if the source key-material is deployed.
+                     * @return true if SetSourceKeyMaterial() has been called after the construction or the last Clear()
+                     */
+                    bool IsKeySet () const noexcept
+                    {
+                        return mKeySet;
+                    }
+
+                    /**
+                     * @brief Derive a key.
+                     * @param[in] label the label (purpose) of the derived key
+                     * @param[in] labelSize size of the label in bytes
+                     * @param[in] context the context (e.g. identities of the parties) of the derived key
+                     * @param[in] contextSize size of the context in bytes
+                     * @param[out] out the derived key
+                     * @param[in] size size of the derived key in bytes (up to 8160 for HKDF)
+                     * @return true on success, false if the key-material is not deployed or the size is not supported
+                     */
+                    bool Derive (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Derive keys of the same size and context for a batch of labels.
+                     * @param[in] labels the labels
+                     * @param[in] count number of the labels
+                     * @param[in] context the common context
+                     * @param[in] contextSize size of the context in bytes
+                     * @param[out] out the derived keys, stored one after another (count * keySize bytes)
+                     * @param[in] keySize size of every derived key in bytes
+                     * @return true on success, false if the key-material is not deployed or the size is not supported
+                     */
+                    bool DeriveBatch (const Label *labels, std::size_t count, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t keySize) const noexcept;
+
+                    /**
+                     * @brief Wipe the keyed state.
+                     */
+                    void Clear () noexcept;
+
+                private:
+                    using Prf = Hmac<Sha256>;
+
+                    void ExpandHkdf (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept;
+                    void ExpandCounter (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept;
+                    void ExpandPbkdf2 (const std::uint8_t *label, std::size_t labelSize, const std::uint8_t *context, std::size_t contextSize, std::uint8_t *out, std::size_t size) const noexcept;
+
+                    CryptoAlgId mAlgId;
+                    std::uint32_t mIterations;
+                    bool mKeySet;
+                    Prf mPrf;   // keyed by the HKDF pseudorandom key or by the source key-material
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_HMAC_KDF_H
@@ -0,0 +1,341 @@
+#include "ara/crypto/cryp/internal/key_wrap.h"
+
+#include <cstring>
+
+#include "ara/crypto/cryp/internal/constant_time.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    // Default initial value of KW (RFC 3394) and the constant part of the KWP one (RFC 5649)
+                    const std::uint8_t kDefaultIv[KeyWrap::kSemiblockSize] = {0xa6u, 0xa6u, 0xa6u, 0xa6u, 0xa6u, 0xa6u, 0xa6u, 0xa6u};
+                    const std::uint8_t kAlternativeIv[4] = {0xa6u, 0x59u, 0x59u, 0xa6u};
+
+                    // 2^32 - 1 is the maximal KWP message length indicator
+                    const std::uint64_t kMaxPaddedKeySize = 0xffffffffu;
+
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    // A ^= [t]_64
+                    inline void XorStep (std::uint8_t a[KeyWrap::kSemiblockSize], std::uint64_t t) noexcept
+                    {
+                        for (std::size_t i = KeyWrap::kSemiblockSize; i > 0u; --i, t >>= 8)
+                        {
+                            a[i - 1u] ^= static_cast<std::uint8_t>(t);
+                        }
+                    }
+
+                    inline std::size_t StepCount (std::size_t semiblockCount) noexcept
+                    {
+                        // A single padded semiblock is encrypted by one AES call, otherwise W runs 6 rounds over n
+                        return (semiblockCount == 1u) ? 1u : 6u * semiblockCount;
+                    }
+                }
+
+                KeyWrap::KeyWrap (bool padded) noexcept : mPadded(padded)
+                {
+                }
+
+                bool KeyWrap::SetKey (const std::uint8_t *kek, std::size_t kekSize) noexcept
+                {
+                    return mAes.SetKey(kek, kekSize);
+                }
+
+                std::size_t KeyWrap::GetWrappedSize (std::size_t keySize) const noexcept
+                {
+                    if (mPadded)
+                    {
+                        if ((keySize == 0u) || (static_cast<std::uint64_t>(keySize) > kMaxPaddedKeySize))
+                        {
+                            return 0u;
+                        }
+                        return ((keySize + kSemiblockSize - 1u) / kSemiblockSize + 1u) * kSemiblockSize;
+                    }
+                    if ((keySize < 2u * kSemiblockSize) || ((keySize % kSemiblockSize) != 0u))
+                    {
+                        return 0u;
+                    }
+                    return keySize + kSemiblockSize;
+                }
+
+                bool KeyWrap::Wrap (const std::uint8_t *key, std::size_t keySize, std::uint8_t *out) const noexcept
+                {
+                    Item item = {key, keySize, out, 0u};
+                    return WrapBatch(&item, 1u);
+                }
+
+                bool KeyWrap::Unwrap (const std::uint8_t *wrapped, std::size_t wrappedSize, std::uint8_t *out, std::size_t &keySize) const noexcept
+                {
+                    Item item = {wrapped, wrappedSize, out, 0u};
+                    const bool result = UnwrapBatch(&item, 1u);
+                    keySize = item.mOutSize;
+                    return result;
+                }
+
+                bool KeyWrap::WrapBatch (Item *items, std::size_t count) const noexcept
+                {
+                    bool result = true;
+                    Lane lanes[kLanes];
+                    std::size_t laneCount = 0u;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        if (!PrepareWrap(items[i], lanes[laneCount]))
+                        {
+                            result = false;
+                            continue;
+                        }
+                        if (++laneCount == kLanes)
+                        {
+                            WrapLanes(lanes, laneCount);
+                            laneCount = 0u;
+                        }
+                    }
+                    WrapLanes(lanes, laneCount);
+                    return result;
+                }
+
+                bool KeyWrap::UnwrapBatch (Item *items, std::size_t count) const noexcept
+                {
+                    bool result = true;
+                    Lane lanes[kLanes];
+                    std::size_t laneCount = 0u;
+                    for (std::size_t i = 0; i <= count; ++i)
+                    {
+                        if ((laneCount == kLanes) || ((i == count) && (laneCount != 0u)))
+                        {
+                            UnwrapLanes(lanes, laneCount);
+                            for (std::size_t j = 0; j < laneCount; ++j)
+                            {
+                                result = FinishUnwrap(lanes[j]) && result;
+                            }
+                            laneCount = 0u;
+                        }
+                        if (i == count)
+                        {
+                            break;
+                        }
+                        if (!PrepareUnwrap(items[i], lanes[laneCount]))
+                        {
+                            result = false;
+                            continue;
+                        }
+                        ++laneCount;
+                    }
+                    return result;
+                }
+
+                void KeyWrap::Clear () noexcept
+                {
+                    mAes.Clear();
+                }
+
+                bool KeyWrap::PrepareWrap (Item &item, Lane &lane) const noexcept
+                {
+                    item.mOutSize = 0u;
+                    const std::size_t wrappedSize = GetWrappedSize(item.mInSize);
+                    if ((wrappedSize == 0u) || !mAes.IsKeySet())
+                    {
+                        return false;
+                    }
+
+                    lane.mItem = &item;
+                    lane.mR = item.mOut + kSemiblockSize;
+                    lane.mCount = wrappedSize / kSemiblockSize - 1u;
+                    std::memmove(lane.mR, item.mIn, item.mInSize);
+                    std::memset(lane.mR + item.mInSize, 0, wrappedSize - kSemiblockSize - item.mInSize);
+                    if (mPadded)
+                    {
+                        const std::uint32_t length = static_cast<std::uint32_t>(item.mInSize);
+                        std::memcpy(lane.mA, kAlternativeIv, sizeof(kAlternativeIv));
+                        lane.mA[4] = static_cast<std::uint8_t>(length >> 24);
+                        lane.mA[5] = static_cast<std::uint8_t>(length >> 16);
+                        lane.mA[6] = static_cast<std::uint8_t>(length >> 8);
+                        lane.mA[7] = static_cast<std::uint8_t>(length);
+                    }
+                    else
+                    {
+                        std::memcpy(lane.mA, kDefaultIv, kSemiblockSize);
+                    }
+                    return true;
+                }
+
+                bool KeyWrap::PrepareUnwrap (Item &item, Lane &lane) const noexcept
+                {
+                    item.mOutSize = 0u;
+                    const std::size_t minSize = mPadded ? (2u * kSemiblockSize) : (3u * kSemiblockSize);
+                    if ((item.mInSize < minSize) || ((item.mInSize % kSemiblockSize) != 0u) || !mAes.IsKeySet())
+                    {
+                        return false;
+                    }
+
+                    lane.mItem = &item;
+                    lane.mR = item.mOut;
+                    lane.mCount = item.mInSize / kSemiblockSize - 1u;
+                    std::memcpy(lane.mA, item.mIn, kSemiblockSize);
+                    std::memmove(lane.mR, item.mIn + kSemiblockSize, item.mInSize - kSemiblockSize);
+                    return true;
+                }
+
+                bool KeyWrap::FinishUnwrap (Lane &lane) const noexcept
+                {
+                    const std::size_t size = lane.mCount * kSemiblockSize;
+                    std::size_t keySize = size;
+                    bool valid;
+                    if (mPadded)
+                    {
+                        // The IV holds the length in (8 * (n - 1), 8 * n] and the padding must be zero.
+                        const std::uint32_t length = (static_cast<std::uint32_t>(lane.mA[4]) << 24) |
+                            (static_cast<std::uint32_t>(lane.mA[5]) << 16) |
+                            (static_cast<std::uint32_t>(lane.mA[6]) << 8) |
+                            static_cast<std::uint32_t>(lane.mA[7]);
+                        valid = ConstantTimeEqual(lane.mA, kAlternativeIv, sizeof(kAlternativeIv)) &&
+                            (length > size - kSemiblockSize) && (length <= size);
+                        std::uint8_t padding = 0u;
+                        for (std::size_t i = size - kSemiblockSize; i < size; ++i)
+                        {
+                            // every byte of the last semiblock at or after the length indicator
+                            const std::uint8_t mask = static_cast<std::uint8_t>(0u - static_cast<std::uint8_t>(i >= length));
+                            padding |= lane.mR[i] & mask;
+                        }
+                        valid = valid && (padding == 0u);
+                        keySize = length;
+                    }
+                    else
+                    {
+                        valid = ConstantTimeEqual(lane.mA, kDefaultIv, kSemiblockSize);
+                    }
+
+                    SecureWipe(lane.mA, sizeof(lane.mA));
+                    if (!valid)
+                    {
+                        SecureWipe(lane.mR, size);
+                        return false;
+                    }
+                    lane.mItem->mOutSize = keySize;
+                    return true;
+                }
+
+                void KeyWrap::WrapLanes (Lane *lanes, std::size_t laneCount) const noexcept
+                {
+                    std::size_t stepCount = 0u;
+                    for (std::size_t i = 0; i < laneCount; ++i)
+                    {
+                        const std::size_t steps = StepCount(lanes[i].mCount);
+                        stepCount = (steps > stepCount) ? steps : stepCount;
+                    }
+
+                    alignas(16) std::uint8_t blocks[kLanes * Aes::kBlockSize];
+                    for (std::size_t step = 0; step < stepCount; ++step)
+                    {
+                        // B = E(A || R[i]) of every lane still running
+                        std::size_t blockCount = 0u;
+                        for (std::size_t i = 0; i < laneCount; ++i)
+                        {
+                            const Lane &lane = lanes[i];
+                            if (step < StepCount(lane.mCount))
+                            {
+                                std::uint8_t *block = blocks + blockCount * Aes::kBlockSize;
+                                std::memcpy(block, lane.mA, kSemiblockSize);
+                                std::memcpy(block + kSemiblockSize, lane.mR + (step % lane.mCount) * kSemiblockSize, kSemiblockSize);
+                                ++blockCount;
+                            }
+                        }
+                        mAes.EncryptBlocks(blocks, blocks, blockCount);
+
+                        // A = MSB(B) ^ t, R[i] = LSB(B)
+                        blockCount = 0u;
+                        for (std::size_t i = 0; i < laneCount; ++i)
+                        {
+                            Lane &lane = lanes[i];
+                            if (step < StepCount(lane.mCount))
+                            {
+                                const std::uint8_t *block = blocks + blockCount * Aes::kBlockSize;
+                                std::memcpy(lane.mA, block, kSemiblockSize);
+                                std::memcpy(lane.mR + (step % lane.mCount) * kSemiblockSize, block + kSemiblockSize, kSemiblockSize);
+                                if (lane.mCount != 1u)
+                                {
+                                    XorStep(lane.mA, step + 1u);
+                                }
+                                ++blockCount;
+                            }
+                        }
+                    }
+                    SecureWipe(blocks, sizeof(blocks));
+
+                    for (std::size_t i = 0; i < laneCount; ++i)
+                    {
+                        Lane &lane = lanes[i];
+                        std::memcpy(lane.mItem->mOut, lane.mA, kSemiblockSize);
+                        lane.mItem->mOutSize = (lane.mCount + 1u) * kSemiblockSize;
+                    }
+                }
+
+                void KeyWrap::UnwrapLanes (Lane *lanes, std::size_t laneCount) const noexcept
+                {
+                    std::size_t stepCount = 0u;
+                    for (std::size_t i = 0; i < laneCount; ++i)
+                    {
+                        const std::size_t steps = StepCount(lanes[i].mCount);
+                        stepCount = (steps > stepCount) ? steps : stepCount;
+                    }
+
+                    alignas(16) std::uint8_t blocks[kLanes * Aes::kBlockSize];
+                    for (std::size_t step = 0; step < stepCount; ++step)
+                    {
+                        // B = D((A ^ t) || R[i]) with t running down from 6 * n of every lane still running
+                        std::size_t blockCount = 0u;
+                        for (std::size_t i = 0; i < laneCount; ++i)
+                        {
+                            Lane &lane = lanes[i];
+                            const std::size_t steps = StepCount(lane.mCount);
+                            if (step < steps)
+                            {
+                                const std::size_t t = steps - step;
+                                std::uint8_t *block = blocks + blockCount * Aes::kBlockSize;
+                                if (lane.mCount != 1u)
+                                {
+                                    XorStep(lane.mA, t);
+                                }
+                                std::memcpy(block, lane.mA, kSemiblockSize);
+                                std::memcpy(block + kSemiblockSize, lane.mR + ((t - 1u) % lane.mCount) * kSemiblockSize, kSemiblockSize);
+                                ++blockCount;
+                            }
+                        }
+                        mAes.DecryptBlocks(blocks, blocks, blockCount);
+
+                        // A = MSB(B), R[i] = LSB(B)
+                        blockCount = 0u;
+                        for (std::size_t i = 0; i < laneCount; ++i)
+                        {
+                            Lane &lane = lanes[i];
+                            const std::size_t steps = StepCount(lane.mCount);
+                            if (step < steps)
+                            {
+                                const std::size_t t = steps - step;
+                                const std::uint8_t *block = blocks + blockCount * Aes::kBlockSize;
+                                std::memcpy(lane.mA, block, kSemiblockSize);
+                                std::memcpy(lane.mR + ((t - 1u) % lane.mCount) * kSemiblockSize, block + kSemiblockSize, kSemiblockSize);
+                                ++blockCount;
+                            }
+                        }
+                    }
+                    SecureWipe(blocks, sizeof(blocks));
+                }
+            }
+        }
+    }
+}
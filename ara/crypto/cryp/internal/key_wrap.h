@@ -0,0 +1,154 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_KEY_WRAP_H
+#define ARA_CRYPTO_CRYP_INTERNAL_KEY_WRAP_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/aes.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief AES key wrap without padding (KW, RFC 3394) and with padding (KWP, RFC 5649). The key
+                 * encryption key is scheduled once by SetKey(). The batch methods process up to kLanes keys in
+                 * lockstep: the step j of every key is gathered into one multi-block call of the AES kernel, so the
+                 * otherwise serial chain of 6 * n block encryptions of a single key is pipelined across the keys.
+                 * A keyed instance is immutable, so it can be shared between threads.
+                 */
+                class KeyWrap
+                {
+                public:
+
+                    /**
+                     * @brief A key of a batch operation.
+                     */
+                    struct Item
+                    {
+                        const std::uint8_t *mIn;    // the key (wrap) or the wrapped key (unwrap)
+                        std::size_t mInSize;
+                        std::uint8_t *mOut;         // GetWrappedSize(mInSize) (wrap) or mInSize - 8 (unwrap) bytes
+                        std::size_t mOutSize;       // set to the size of the result, 0 if the item failed
+                    };
+
+                    /**
+                     * @brief Size of the semiblock (the wrap granularity) in bytes.
+                     */
+                    static const std::size_t kSemiblockSize = 8u;
+
+                    /**
+                     * @brief Maximal number of keys processed in lockstep.
+                     */
+                    static const std::size_t kLanes = 32u;
+
+                    /**
+                     * @brief Construct a new Key Wrap object.
+                     * @param[in] padded true for KWP (RFC 5649), false for KW (RFC 3394)
+                     */
+                    explicit KeyWrap (bool padded=false) noexcept;
+
+                    /**
+                     * @brief Check if the padded variant is used.
+                     * @return true for KWP
+                     */
+                    bool IsPadded () const noexcept
+                    {
+                        return mPadded;
+                    }
+
+                    /**
+                     * @brief Schedule the key encryption key.
+                     * @param[in] kek the key encryption key
+                     * @param[in] kekSize size of the key in bytes: 16, 24 or 32
+                     * @return true if the key is scheduled
+                     */
+                    bool SetKey (const std::uint8_t *kek, std::size_t kekSize) noexcept;
+
+                    /**
+                     * @brief Check if the key encryption key is scheduled.
+                     * @return true if SetKey() has succeeded
+                     */
+                    bool IsKeySet () const noexcept
+                    {
+                        return mAes.IsKeySet();
+                    }
+
+                    /**
+                     * @brief Get the size of a wrapped key.
+                     * @param[in] keySize size of the key in bytes
+                     * @return std::size_t size of the wrapped key, 0 if the key size is not supported (KW needs a
+                     * multiple of 8 and at least 16 bytes, KWP at least 1 byte)
+                     */
+                    std::size_t GetWrappedSize (std::size_t keySize) const noexcept;
+
+                    /**
+                     * @brief Wrap a key.
+                     * @param[in] key the key
+                     * @param[in] keySize size of the key in bytes
+                     * @param[out] out the wrapped key of GetWrappedSize(keySize) bytes
+                     * @return true on success, false if the key size is not supported or the KEK is not scheduled
+                     */
+                    bool Wrap (const std::uint8_t *key, std::size_t keySize, std::uint8_t *out) const noexcept;
+
+                    /**
+                     * @brief Unwrap and authenticate a key.
+                     * @param[in] wrapped the wrapped key
+                     * @param[in] wrappedSize size of the wrapped key in bytes
+                     * @param[out] out the buffer for the key of (wrappedSize - 8) bytes (the padding of KWP is
+                     * stored too and wiped on failure)
+                     * @param[out] keySize size of the unwrapped key in bytes
+                     * @return true on success, false if the size is invalid or the integrity check failed
+                     */
+                    bool Unwrap (const std::uint8_t *wrapped, std::size_t wrappedSize, std::uint8_t *out, std::size_t &keySize) const noexcept;
+
+                    /**
+                     * @brief Wrap a batch of keys.
+                     * @param[in,out] items the keys
+                     * @param[in] count number of the keys
+                     * @return true if all keys are wrapped
+                     */
+                    bool WrapBatch (Item *items, std::size_t count) const noexcept;
+
+                    /**
+                     * @brief Unwrap and authenticate a batch of keys. The output of an item failing the integrity
+                     * check is wiped, the other items are unwrapped regardless.
+                     * @param[in,out] items the wrapped keys
+                     * @param[in] count number of the keys
+                     * @return true if all keys are unwrapped
+                     */
+                    bool UnwrapBatch (Item *items, std::size_t count) const noexcept;
+
+                    /**
+                     * @brief Wipe the key schedule.
+                     */
+                    void Clear () noexcept;
+
+                private:
+                    struct Lane
+                    {
+                        std::uint8_t mA[kSemiblockSize];
+                        std::uint8_t *mR;       // the semiblocks R[1] ... R[n]
+                        std::size_t mCount;     // n
+                        Item *mItem;
+                    };
+
+                    void WrapLanes (Lane *lanes, std::size_t laneCount) const noexcept;
+                    void UnwrapLanes (Lane *lanes, std::size_t laneCount) const noexcept;
+                    bool PrepareWrap (Item &item, Lane &lane) const noexcept;
+                    bool PrepareUnwrap (Item &item, Lane &lane) const noexcept;
+                    bool FinishUnwrap (Lane &lane) const noexcept;
+
+                    Aes mAes;
+                    bool mPadded;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_KEY_WRAP_H
@@ -0,0 +1,680 @@
+#include "ara/crypto/cryp/internal/p256.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    using Wide = unsigned __int128;
+
+                    /**
+                     * @brief 256-bit integer in little-endian 64-bit limbs.
+                     */
+                    struct Fe
+                    {
+                        std::uint64_t mLimb[4];
+                    };
+
+                    const Fe kP = {{0xffffffffffffffffull, 0x00000000ffffffffull, 0x0000000000000000ull, 0xffffffff00000001ull}};
+                    const Fe kN = {{0xf3b9cac2fc632551ull, 0xbce6faada7179e84ull, 0xffffffffffffffffull, 0xffffffff00000000ull}};
+
+                    // Montgomery forms (R = 2^256) of 1, R, b and the base point.
+                    const Fe kOne = {{0x0000000000000001ull, 0xffffffff00000000ull, 0xffffffffffffffffull, 0x00000000fffffffeull}};
+                    const Fe kR2 = {{0x0000000000000003ull, 0xfffffffbffffffffull, 0xfffffffffffffffeull, 0x00000004fffffffdull}};
+                    const Fe kB = {{0xd89cdf6229c4bddfull, 0xacf005cd78843090ull, 0xe5a220abf7212ed6ull, 0xdc30061d04874834ull}};
+                    const Fe kGx = {{0x79e730d418a9143cull, 0x75ba95fc5fedb601ull, 0x79fb732b77622510ull, 0x18905f76a53755c6ull}};
+                    const Fe kGy = {{0xddf25357ce95560aull, 0x8b4ab8e4ba19e45cull, 0xd2e88688dd21f325ull, 0x8571ff1825885d85ull}};
+
+                    inline std::uint64_t Select (std::uint64_t mask, std::uint64_t a, std::uint64_t b) noexcept
+                    {
+                        return (a & mask) | (b & ~mask);
+                    }
+
+                    inline void FeCmov (Fe &r, const Fe &a, std::uint64_t bit) noexcept
+                    {
+                        const std::uint64_t mask = 0u - bit;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            r.mLimb[i] = Select(mask, a.mLimb[i], r.mLimb[i]);
+                        }
+                    }
+
+                    inline std::uint64_t FeIsZero (const Fe &a) noexcept
+                    {
+                        const std::uint64_t bits = a.mLimb[0] | a.mLimb[1] | a.mLimb[2] | a.mLimb[3];
+                        return ((bits | (0u - bits)) >> 63) ^ 1u;
+                    }
+
+                    inline std::uint64_t FeEqual (const Fe &a, const Fe &b) noexcept
+                    {
+                        Fe difference;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            difference.mLimb[i] = a.mLimb[i] ^ b.mLimb[i];
+                        }
+                        return FeIsZero(difference);
+                    }
+
+                    // Borrow of a - m, i.e. 1 if a < m.
+                    inline std::uint64_t FeLess (const Fe &a, const Fe &m) noexcept
+                    {
+                        std::uint64_t borrow = 0u;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            const Wide difference = (Wide)a.mLimb[i] - m.mLimb[i] - borrow;
+                            borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                        }
+                        return borrow;
+                    }
+
+                    // r = (carry * 2^256 + t) mod m for t + carry * 2^256 < 2m
+                    inline void ReduceOnce (Fe &r, const std::uint64_t t[4], std::uint64_t carry, const Fe &m) noexcept
+                    {
+                        std::uint64_t u[4];
+                        std::uint64_t borrow = 0u;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            const Wide difference = (Wide)t[i] - m.mLimb[i] - borrow;
+                            u[i] = static_cast<std::uint64_t>(difference);
+                            borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                        }
+                        const std::uint64_t mask = 0u - (carry | (borrow ^ 1u));
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            r.mLimb[i] = Select(mask, u[i], t[i]);
+                        }
+                    }
+
+                    void FeAdd (Fe &r, const Fe &a, const Fe &b, const Fe &m=kP) noexcept
+                    {
+                        std::uint64_t t[4];
+                        std::uint64_t carry = 0u;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            const Wide sum = (Wide)a.mLimb[i] + b.mLimb[i] + carry;
+                            t[i] = static_cast<std::uint64_t>(sum);
+                            carry = static_cast<std::uint64_t>(sum >> 64);
+                        }
+                        ReduceOnce(r, t, carry, m);
+                    }
+
+                    void FeSub (Fe &r, const Fe &a, const Fe &b, const Fe &m=kP) noexcept
+                    {
+                        std::uint64_t t[4];
+                        std::uint64_t borrow = 0u;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            const Wide difference = (Wide)a.mLimb[i] - b.mLimb[i] - borrow;
+                            t[i] = static_cast<std::uint64_t>(difference);
+                            borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                        }
+                        const std::uint64_t mask = 0u - borrow;
+                        std::uint64_t carry = 0u;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            const Wide sum = (Wide)t[i] + (m.mLimb[i] & mask) + carry;
+                            r.mLimb[i] = static_cast<std::uint64_t>(sum);
+                            carry = static_cast<std::uint64_t>(sum >> 64);
+                        }
+                    }
+
+                    /**
+                     * @brief Montgomery multiplication r = a * b / 2^256 mod p (interleaved, CIOS). The reduction
+                     * exploits the special form of p: -p^-1 mod 2^64 = 1, p[0] = 2^64 - 1 and p[2] = 0. The state is
+                     * kept in scalar variables, so it stays in registers.
+                     */
+                    void FeMul (Fe &r, const Fe &a, const Fe &b) noexcept
+                    {
+                        std::uint64_t t0 = 0u, t1 = 0u, t2 = 0u, t3 = 0u, t4 = 0u, t5;
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            const std::uint64_t bi = b.mLimb[i];
+                            Wide sum = (Wide)a.mLimb[0] * bi + t0;
+                            t0 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)a.mLimb[1] * bi + t1 + static_cast<std::uint64_t>(sum >> 64);
+                            t1 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)a.mLimb[2] * bi + t2 + static_cast<std::uint64_t>(sum >> 64);
+                            t2 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)a.mLimb[3] * bi + t3 + static_cast<std::uint64_t>(sum >> 64);
+                            t3 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)t4 + static_cast<std::uint64_t>(sum >> 64);
+                            t4 = static_cast<std::uint64_t>(sum);
+                            t5 = static_cast<std::uint64_t>(sum >> 64);
+
+                            // t = (t + m * p) / 2^64 with m = t0
+                            const std::uint64_t m = t0;
+                            sum = (Wide)m * kP.mLimb[0] + t0;
+                            sum = (Wide)m * kP.mLimb[1] + t1 + static_cast<std::uint64_t>(sum >> 64);
+                            t0 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)t2 + static_cast<std::uint64_t>(sum >> 64);
+                            t1 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)m * kP.mLimb[3] + t3 + static_cast<std::uint64_t>(sum >> 64);
+                            t2 = static_cast<std::uint64_t>(sum);
+                            sum = (Wide)t4 + static_cast<std::uint64_t>(sum >> 64);
+                            t3 = static_cast<std::uint64_t>(sum);
+                            t4 = t5 + static_cast<std::uint64_t>(sum >> 64);
+                        }
+                        const std::uint64_t t[4] = {t0, t1, t2, t3};
+                        ReduceOnce(r, t, t4, kP);
+                    }
+
+                    inline void FeSquare (Fe &r, const Fe &a) noexcept
+                    {
+                        FeMul(r, a, a);
+                    }
+
+                    void FeSquareTimes (Fe &r, const Fe &a, unsigned count) noexcept
+                    {
+                        FeSquare(r, a);
+                        for (unsigned i = 1; i < count; ++i)
+                        {
+                            FeSquare(r, r);
+                        }
+                    }
+
+                    // r = a^e for a public exponent e
+                    void FePow (Fe &r, const Fe &a, const Fe &e) noexcept
+                    {
+                        Fe result = kOne;
+                        for (int bit = 255; bit >= 0; --bit)
+                        {
+                            FeSquare(result, result);
+                            if ((e.mLimb[bit / 64] >> (bit % 64)) & 1u)
+                            {
+                                FeMul(result, result, a);
+                            }
+                        }
+                        r = result;
+                    }
+
+                    // a^(p - 2) by an addition chain (xN = a^(2^N - 1))
+                    void FeInvert (Fe &r, const Fe &a) noexcept
+                    {
+                        Fe x2, x3, x6, x12, x15, x30, x32, t;
+                        FeSquare(x2, a);
+                        FeMul(x2, x2, a);
+                        FeSquare(x3, x2);
+                        FeMul(x3, x3, a);
+                        FeSquareTimes(x6, x3, 3u);
+                        FeMul(x6, x6, x3);
+                        FeSquareTimes(x12, x6, 6u);
+                        FeMul(x12, x12, x6);
+                        FeSquareTimes(x15, x12, 3u);
+                        FeMul(x15, x15, x3);
+                        FeSquareTimes(x30, x15, 15u);
+                        FeMul(x30, x30, x15);
+                        FeSquareTimes(x32, x30, 2u);
+                        FeMul(x32, x32, x2);
+
+                        // p - 2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+                        FeSquareTimes(t, x32, 32u);
+                        FeMul(t, t, a);
+                        FeSquareTimes(t, t, 128u);
+                        FeMul(t, t, x32);
+                        FeSquareTimes(t, t, 32u);
+                        FeMul(t, t, x32);
+                        FeSquareTimes(t, t, 30u);
+                        FeMul(t, t, x30);
+                        FeSquareTimes(t, t, 2u);
+                        FeMul(r, t, a);
+                    }
+
+                    void FeFromBytes (Fe &r, const std::uint8_t *bytes) noexcept
+                    {
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            std::uint64_t limb = 0u;
+                            for (std::size_t j = 0; j < 8u; ++j)
+                            {
+                                limb = (limb << 8) | bytes[(3u - i) * 8u + j];
+                            }
+                            r.mLimb[i] = limb;
+                        }
+                    }
+
+                    void FeToBytes (std::uint8_t *bytes, const Fe &a) noexcept
+                    {
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            for (std::size_t j = 0; j < 8u; ++j)
+                            {
+                                bytes[(3u - i) * 8u + j] = static_cast<std::uint8_t>(a.mLimb[i] >> (56u - 8u * j));
+                            }
+                        }
+                    }
+
+                    inline void ToMontgomery (Fe &r, const Fe &a) noexcept
+                    {
+                        FeMul(r, a, kR2);
+                    }
+
+                    inline void FromMontgomery (Fe &r, const Fe &a) noexcept
+                    {
+                        const Fe one = {{1u, 0u, 0u, 0u}};
+                        FeMul(r, a, one);
+                    }
+
+                    /**
+                     * @brief Projective point (x = X/Z, y = Y/Z), the neutral element is (0 : 1 : 0).
+                     */
+                    struct Point
+                    {
+                        Fe mX;
+                        Fe mY;
+                        Fe mZ;
+                    };
+
+                    struct AffinePoint
+                    {
+                        Fe mX;
+                        Fe mY;
+                    };
+
+                    inline void PointIdentity (Point &p) noexcept
+                    {
+                        p.mX = Fe{{0u, 0u, 0u, 0u}};
+                        p.mY = kOne;
+                        p.mZ = Fe{{0u, 0u, 0u, 0u}};
+                    }
+
+                    inline void PointCmov (Point &r, const Point &a, std::uint64_t bit) noexcept
+                    {
+                        FeCmov(r.mX, a.mX, bit);
+                        FeCmov(r.mY, a.mY, bit);
+                        FeCmov(r.mZ, a.mZ, bit);
+                    }
+
+                    // Complete addition for a = -3 (Renes, Costello, Batina: algorithm 4).
+                    void PointAdd (Point &r, const Point &p, const Point &q) noexcept
+                    {
+                        Fe t0, t1, t2, t3, t4, x3, y3, z3;
+                        FeMul(t0, p.mX, q.mX);
+                        FeMul(t1, p.mY, q.mY);
+                        FeMul(t2, p.mZ, q.mZ);
+                        FeAdd(t3, p.mX, p.mY);
+                        FeAdd(t4, q.mX, q.mY);
+                        FeMul(t3, t3, t4);
+                        FeAdd(t4, t0, t1);
+                        FeSub(t3, t3, t4);
+                        FeAdd(t4, p.mY, p.mZ);
+                        FeAdd(x3, q.mY, q.mZ);
+                        FeMul(t4, t4, x3);
+                        FeAdd(x3, t1, t2);
+                        FeSub(t4, t4, x3);
+                        FeAdd(x3, p.mX, p.mZ);
+                        FeAdd(y3, q.mX, q.mZ);
+                        FeMul(x3, x3, y3);
+                        FeAdd(y3, t0, t2);
+                        FeSub(y3, x3, y3);
+                        FeMul(z3, kB, t2);
+                        FeSub(x3, y3, z3);
+                        FeAdd(z3, x3, x3);
+                        FeAdd(x3, x3, z3);
+                        FeSub(z3, t1, x3);
+                        FeAdd(x3, t1, x3);
+                        FeMul(y3, kB, y3);
+                        FeAdd(t1, t2, t2);
+                        FeAdd(t2, t1, t2);
+                        FeSub(y3, y3, t2);
+                        FeSub(y3, y3, t0);
+                        FeAdd(t1, y3, y3);
+                        FeAdd(y3, t1, y3);
+                        FeAdd(t1, t0, t0);
+                        FeAdd(t0, t1, t0);
+                        FeSub(t0, t0, t2);
+                        FeMul(t1, t4, y3);
+                        FeMul(t2, t0, y3);
+                        FeMul(y3, x3, z3);
+                        FeAdd(y3, y3, t2);
+                        FeMul(x3, x3, t3);
+                        FeSub(x3, x3, t1);
+                        FeMul(z3, t4, z3);
+                        FeMul(t1, t3, t0);
+                        FeAdd(z3, z3, t1);
+                        r.mX = x3;
+                        r.mY = y3;
+                        r.mZ = z3;
+                    }
+
+                    // Complete mixed addition with an affine point (algorithm 5).
+                    void PointAddAffine (Point &r, const Point &p, const AffinePoint &q) noexcept
+                    {
+                        Fe t0, t1, t2, t3, t4, x3, y3, z3;
+                        FeMul(t0, p.mX, q.mX);
+                        FeMul(t1, p.mY, q.mY);
+                        FeAdd(t3, q.mX, q.mY);
+                        FeAdd(t4, p.mX, p.mY);
+                        FeMul(t3, t3, t4);
+                        FeAdd(t4, t0, t1);
+                        FeSub(t3, t3, t4);
+                        FeMul(t4, q.mY, p.mZ);
+                        FeAdd(t4, t4, p.mY);
+                        FeMul(y3, q.mX, p.mZ);
+                        FeAdd(y3, y3, p.mX);
+                        FeMul(z3, kB, p.mZ);
+                        FeSub(x3, y3, z3);
+                        FeAdd(z3, x3, x3);
+                        FeAdd(x3, x3, z3);
+                        FeSub(z3, t1, x3);
+                        FeAdd(x3, t1, x3);
+                        FeMul(y3, kB, y3);
+                        FeAdd(t1, p.mZ, p.mZ);
+                        FeAdd(t2, t1, p.mZ);
+                        FeSub(y3, y3, t2);
+                        FeSub(y3, y3, t0);
+                        FeAdd(t1, y3, y3);
+                        FeAdd(y3, t1, y3);
+                        FeAdd(t1, t0, t0);
+                        FeAdd(t0, t1, t0);
+                        FeSub(t0, t0, t2);
+                        FeMul(t1, t4, y3);
+                        FeMul(t2, t0, y3);
+                        FeMul(y3, x3, z3);
+                        FeAdd(y3, y3, t2);
+                        FeMul(x3, x3, t3);
+                        FeSub(x3, x3, t1);
+                        FeMul(z3, t4, z3);
+                        FeMul(t1, t3, t0);
+                        FeAdd(z3, z3, t1);
+                        r.mX = x3;
+                        r.mY = y3;
+                        r.mZ = z3;
+                    }
+
+                    // Complete doubling for a = -3 (algorithm 6).
+                    void PointDouble (Point &r, const Point &p) noexcept
+                    {
+                        Fe t0, t1, t2, t3, x3, y3, z3;
+                        FeSquare(t0, p.mX);
+                        FeSquare(t1, p.mY);
+                        FeSquare(t2, p.mZ);
+                        FeMul(t3, p.mX, p.mY);
+                        FeAdd(t3, t3, t3);
+                        FeMul(z3, p.mX, p.mZ);
+                        FeAdd(z3, z3, z3);
+                        FeMul(y3, kB, t2);
+                        FeSub(y3, y3, z3);
+                        FeAdd(x3, y3, y3);
+                        FeAdd(y3, x3, y3);
+                        FeSub(x3, t1, y3);
+                        FeAdd(y3, t1, y3);
+                        FeMul(y3, x3, y3);
+                        FeMul(x3, x3, t3);
+                        FeAdd(t3, t2, t2);
+                        FeAdd(t2, t2, t3);
+                        FeMul(z3, kB, z3);
+                        FeSub(z3, z3, t2);
+                        FeSub(z3, z3, t0);
+                        FeAdd(t3, z3, z3);
+                        FeAdd(z3, z3, t3);
+                        FeAdd(t3, t0, t0);
+                        FeAdd(t0, t3, t0);
+                        FeSub(t0, t0, t2);
+                        FeMul(t0, t0, z3);
+                        FeAdd(y3, y3, t0);
+                        FeMul(t0, p.mY, p.mZ);
+                        FeAdd(t0, t0, t0);
+                        FeMul(z3, t0, z3);
+                        FeSub(x3, x3, z3);
+                        FeMul(z3, t0, t1);
+                        FeAdd(z3, z3, z3);
+                        FeAdd(z3, z3, z3);
+                        r.mX = x3;
+                        r.mY = y3;
+                        r.mZ = z3;
+                    }
+
+                    // Affine coordinates (in the Montgomery form); false for the neutral element.
+                    bool ToAffine (AffinePoint &r, const Point &p) noexcept
+                    {
+                        Fe zInverse;
+                        FeInvert(zInverse, p.mZ);
+                        FeMul(r.mX, p.mX, zInverse);
+                        FeMul(r.mY, p.mY, zInverse);
+                        return (FeIsZero(p.mZ) == 0u);
+                    }
+
+                    // Right-hand side of the curve equation: x^3 - 3x + b
+                    void CurveRhs (Fe &r, const Fe &x) noexcept
+                    {
+                        Fe x3, threeX;
+                        FeSquare(x3, x);
+                        FeMul(x3, x3, x);
+                        FeAdd(threeX, x, x);
+                        FeAdd(threeX, threeX, x);
+                        FeSub(r, x3, threeX);
+                        FeAdd(r, r, kB);
+                    }
+
+                    bool DecodePoint (AffinePoint &r, const std::uint8_t *encoded, std::size_t size) noexcept
+                    {
+                        Fe x, rhs;
+                        if ((size == P256::kPublicKeySize) && (encoded[0] == 0x04u))
+                        {
+                            Fe y, ySquare;
+                            FeFromBytes(x, encoded + 1);
+                            FeFromBytes(y, encoded + 1 + P256::kScalarSize);
+                            if ((FeLess(x, kP) == 0u) || (FeLess(y, kP) == 0u))
+                            {
+                                return false;
+                            }
+                            ToMontgomery(r.mX, x);
+                            ToMontgomery(r.mY, y);
+                            CurveRhs(rhs, r.mX);
+                            FeSquare(ySquare, r.mY);
+                            return (FeEqual(ySquare, rhs) == 1u);
+                        }
+
+                        if ((size == P256::kCompressedPublicKeySize) && ((encoded[0] == 0x02u) || (encoded[0] == 0x03u)))
+                        {
+                            FeFromBytes(x, encoded + 1);
+                            if (FeLess(x, kP) == 0u)
+                            {
+                                return false;
+                            }
+                            ToMontgomery(r.mX, x);
+                            CurveRhs(rhs, r.mX);
+
+                            // p = 3 mod 4: y = rhs^((p + 1) / 4)
+                            const Fe exponent = {{0x0000000000000000ull, 0x0000000040000000ull, 0x4000000000000000ull, 0x3fffffffc0000000ull}};
+                            Fe ySquare, y;
+                            FePow(r.mY, rhs, exponent);
+                            FeSquare(ySquare, r.mY);
+                            if (FeEqual(ySquare, rhs) == 0u)
+                            {
+                                return false;
+                            }
+                            FromMontgomery(y, r.mY);
+                            if ((y.mLimb[0] & 1u) != (encoded[0] & 1u))
+                            {
+                                const Fe zero = {{0u, 0u, 0u, 0u}};
+                                FeSub(r.mY, zero, r.mY);
+                            }
+                            return true;
+                        }
+                        return false;
+                    }
+
+                    inline std::uint64_t Equal (std::uint64_t a, std::uint64_t b) noexcept
+                    {
+                        return ((a ^ b) - 1u) >> 63;
+                    }
+
+                    // The digit of 4 bits at the position (from the least significant one) of a big-endian scalar.
+                    inline std::uint64_t Digit (const std::uint8_t scalar[P256::kScalarSize], std::size_t position) noexcept
+                    {
+                        return (scalar[31u - position / 2u] >> (4u * (position & 1u))) & 15u;
+                    }
+
+                    /**
+                     * @brief Comb of the base point G: mPoint[i][j] = (j + 1) * 16^i * G in affine coordinates.
+                     */
+                    struct BaseTable
+                    {
+                        AffinePoint mPoint[64][15];
+
+                        BaseTable () noexcept
+                        {
+                            Point base;
+                            base.mX = kGx;
+                            base.mY = kGy;
+                            base.mZ = kOne;
+
+                            for (std::size_t i = 0; i < 64u; ++i)
+                            {
+                                Point multiples[15];
+                                multiples[0] = base;
+                                for (std::size_t j = 1; j < 15u; ++j)
+                                {
+                                    PointAdd(multiples[j], multiples[j - 1u], base);
+                                }
+
+                                // Batch inversion of the Z coordinates.
+                                Fe prefix[15];
+                                prefix[0] = multiples[0].mZ;
+                                for (std::size_t j = 1; j < 15u; ++j)
+                                {
+                                    FeMul(prefix[j], prefix[j - 1u], multiples[j].mZ);
+                                }
+                                Fe inverse;
+                                FeInvert(inverse, prefix[14]);
+                                for (std::size_t j = 14u; j > 0u; --j)
+                                {
+                                    Fe zInverse;
+                                    FeMul(zInverse, inverse, prefix[j - 1u]);
+                                    FeMul(inverse, inverse, multiples[j].mZ);
+                                    FeMul(mPoint[i][j].mX, multiples[j].mX, zInverse);
+                                    FeMul(mPoint[i][j].mY, multiples[j].mY, zInverse);
+                                }
+                                FeMul(mPoint[i][0].mX, multiples[0].mX, inverse);
+                                FeMul(mPoint[i][0].mY, multiples[0].mY, inverse);
+
+                                PointAdd(base, multiples[14], base);
+                            }
+                        }
+                    };
+
+                    const BaseTable& GetBaseTable () noexcept
+                    {
+                        static const BaseTable table;
+                        return table;
+                    }
+
+                    void ScalarMultBase (Point &r, const std::uint8_t scalar[P256::kScalarSize]) noexcept
+                    {
+                        const BaseTable &table = GetBaseTable();
+                        PointIdentity(r);
+                        for (std::size_t i = 0; i < 64u; ++i)
+                        {
+                            const std::uint64_t digit = Digit(scalar, i);
+                            AffinePoint selected = table.mPoint[i][0];
+                            for (std::size_t j = 1; j < 15u; ++j)
+                            {
+                                const std::uint64_t hit = Equal(digit, j + 1u);
+                                FeCmov(selected.mX, table.mPoint[i][j].mX, hit);
+                                FeCmov(selected.mY, table.mPoint[i][j].mY, hit);
+                            }
+                            // The neutral element has no affine form: a zero digit discards the sum.
+                            Point sum;
+                            PointAddAffine(sum, r, selected);
+                            PointCmov(r, sum, Equal(digit, 0u) ^ 1u);
+                        }
+                    }
+
+                    void ScalarMult (Point &r, const Point &p, const std::uint8_t scalar[P256::kScalarSize]) noexcept
+                    {
+                        Point table[16];
+                        PointIdentity(table[0]);
+                        table[1] = p;
+                        for (std::size_t j = 2; j < 16u; ++j)
+                        {
+                            PointAdd(table[j], table[j - 1u], p);
+                        }
+
+                        PointIdentity(r);
+                        for (std::size_t i = 64u; i > 0u; --i)
+                        {
+                            for (std::size_t k = 0; k < 4u; ++k)
+                            {
+                                PointDouble(r, r);
+                            }
+                            const std::uint64_t digit = Digit(scalar, i - 1u);
+                            Point selected = table[0];
+                            for (std::size_t j = 1; j < 16u; ++j)
+                            {
+                                PointCmov(selected, table[j], Equal(digit, j));
+                            }
+                            PointAdd(r, r, selected);
+                        }
+                    }
+
+                    void Wipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+                }
+
+                bool P256::IsValidScalar (const std::uint8_t scalar[kScalarSize]) noexcept
+                {
+                    Fe value;
+                    FeFromBytes(value, scalar);
+                    const std::uint64_t valid = FeLess(value, kN) & (FeIsZero(value) ^ 1u);
+                    Wipe(&value, sizeof(value));
+                    return (valid == 1u);
+                }
+
+                bool P256::ComputePublicKey (const std::uint8_t privateKey[kScalarSize], std::uint8_t publicKey[kPublicKeySize]) noexcept
+                {
+                    if (!IsValidScalar(privateKey))
+                    {
+                        return false;
+                    }
+
+                    Point point;
+                    AffinePoint affine;
+                    ScalarMultBase(point, privateKey);
+                    ToAffine(affine, point);
+                    FromMontgomery(affine.mX, affine.mX);
+                    FromMontgomery(affine.mY, affine.mY);
+                    publicKey[0] = 0x04u;
+                    FeToBytes(publicKey + 1, affine.mX);
+                    FeToBytes(publicKey + 1 + kScalarSize, affine.mY);
+                    Wipe(&point, sizeof(point));
+                    return true;
+                }
+
+                bool P256::Agree (const std::uint8_t privateKey[kScalarSize], const std::uint8_t *peerPublicKey, std::size_t peerPublicKeySize, std::uint8_t sharedSecret[kScalarSize]) noexcept
+                {
+                    AffinePoint peer;
+                    if (!IsValidScalar(privateKey) || !DecodePoint(peer, peerPublicKey, peerPublicKeySize))
+                    {
+                        return false;
+                    }
+
+                    Point point;
+                    point.mX = peer.mX;
+                    point.mY = peer.mY;
+                    point.mZ = kOne;
+                    ScalarMult(point, point, privateKey);
+
+                    AffinePoint affine;
+                    const bool finite = ToAffine(affine, point);
+                    FromMontgomery(affine.mX, affine.mX);
+                    FeToBytes(sharedSecret, affine.mX);
+                    Wipe(&point, sizeof(point));
+                    Wipe(&affine, sizeof(affine));
+                    return finite;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_P256_H
+#define ARA_CRYPTO_CRYP_INTERNAL_P256_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Elliptic curve NIST P-256 (secp256r1). The field elements are kept in the Montgomery form
+                 * in four 64-bit limbs, the points in projective coordinates with the complete addition formulas of
+                 * Renes, Costello and Batina, so no operation branches on a secret. The base point multiplication
+                 * uses a comb of 64 x 15 precomputed affine multiples (built once, on first use) and needs no
+                 * doublings; the variable-base multiplication uses a fixed 4-bit window. Table lookups by secret
+                 * digits scan whole rows.
+                 */
+                class P256
+                {
+                public:
+
+                    /**
+                     * @brief Size of a big-endian scalar, private key, coordinate or shared secret in bytes.
+                     */
+                    static const std::size_t kScalarSize = 32u;
+
+                    /**
+                     * @brief Size of an uncompressed public key (0x04 || X || Y) in bytes.
+                     */
+                    static const std::size_t kPublicKeySize = 65u;
+
+                    /**
+                     * @brief Size of a compressed public key (0x02 or 0x03 || X) in bytes.
+                     */
+                    static const std::size_t kCompressedPublicKeySize = 33u;
+
+                    /**
+                     * @brief Check (in constant time) that a scalar is in the range [1, n - 1].
+                     * @param[in] scalar the big-endian scalar
+                     * @return true if the scalar is a valid private key
+                     */
+                    static bool IsValidScalar (const std::uint8_t scalar[kScalarSize]) noexcept;
+
+                    /**
+                     * @brief Compute the uncompressed public key of a private key by the fixed-base comb.
+                     * @param[in] privateKey the big-endian private key
+                     * @param[out] publicKey the uncompressed public key
+                     * @return false if the private key is not in the range [1, n - 1]
+                     */
+                    static bool ComputePublicKey (const std::uint8_t privateKey[kScalarSize], std::uint8_t publicKey[kPublicKeySize]) noexcept;
+
+                    /**
+                     * @brief Compute the ECDH shared secret (the x-coordinate of the product).
+                     * @param[in] privateKey the own big-endian private key
+                     * @param[in] peerPublicKey the uncompressed or compressed public key of the other side
+                     * @param[in] peerPublicKeySize size of the public key in bytes
+                     * @param[out] sharedSecret the big-endian shared secret
+                     * @return false if the private key is invalid or the public key is malformed or not on the curve
+                     */
+                    static bool Agree (const std::uint8_t privateKey[kScalarSize], const std::uint8_t *peerPublicKey, std::size_t peerPublicKeySize, std::uint8_t sharedSecret[kScalarSize]) noexcept;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_P256_H
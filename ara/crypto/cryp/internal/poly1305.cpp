@@ -0,0 +1,227 @@
+#include "ara/crypto/cryp/internal/poly1305.h"
+
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    using Wide = unsigned __int128;
+
+                    const std::uint64_t kMask44 = 0xfffffffffffu;
+                    const std::uint64_t kMask42 = 0x3ffffffffffu;
+
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    inline std::uint64_t LoadLe64 (const std::uint8_t *bytes) noexcept
+                    {
+                        std::uint64_t value = 0u;
+                        for (std::size_t i = 8u; i > 0u; --i)
+                        {
+                            value = (value << 8) | bytes[i - 1u];
+                        }
+                        return value;
+                    }
+
+                    inline void StoreLe64 (std::uint64_t value, std::uint8_t *bytes) noexcept
+                    {
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            bytes[i] = static_cast<std::uint8_t>(value >> (8u * i));
+                        }
+                    }
+                }
+
+                Poly1305::Poly1305 () noexcept : mBuffered(0u)
+                {
+                    std::memset(mR, 0, sizeof(mR));
+                    std::memset(mS, 0, sizeof(mS));
+                    std::memset(mPad, 0, sizeof(mPad));
+                    std::memset(mH, 0, sizeof(mH));
+                    std::memset(mBuffer, 0, sizeof(mBuffer));
+                }
+
+                Poly1305::~Poly1305 () noexcept
+                {
+                    Clear();
+                }
+
+                void Poly1305::SetKey (const std::uint8_t key[kKeySize]) noexcept
+                {
+                    // r &= 0x0ffffffc0ffffffc0ffffffc0fffffff, split into 44 + 44 + 42 bits
+                    const std::uint64_t t0 = LoadLe64(key);
+                    const std::uint64_t t1 = LoadLe64(key + 8u);
+                    mR[0] = t0 & 0xffc0fffffffu;
+                    mR[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffffu;
+                    mR[2] = (t1 >> 24) & 0x00ffffffc0fu;
+                    // 2^130 = 5 mod p and the limbs above 2^88 wrap with a factor of 2^132 / 2^130 = 4
+                    mS[0] = mR[1] * 20u;
+                    mS[1] = mR[2] * 20u;
+                    mPad[0] = LoadLe64(key + 16u);
+                    mPad[1] = LoadLe64(key + 24u);
+                    Start();
+                }
+
+                void Poly1305::Start () noexcept
+                {
+                    mH[0] = 0u;
+                    mH[1] = 0u;
+                    mH[2] = 0u;
+                    mBuffered = 0u;
+                }
+
+                void Poly1305::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    if (mBuffered != 0u)
+                    {
+                        const std::size_t taken = (size < (kBlockSize - mBuffered)) ? size : (kBlockSize - mBuffered);
+                        std::memcpy(mBuffer + mBuffered, data, taken);
+                        mBuffered += taken;
+                        data += taken;
+                        size -= taken;
+                        if (mBuffered < kBlockSize)
+                        {
+                            return;
+                        }
+                        Blocks(mBuffer, 1u, 1ull << 40);
+                        mBuffered = 0u;
+                    }
+
+                    const std::size_t blockCount = size / kBlockSize;
+                    if (blockCount != 0u)
+                    {
+                        Blocks(data, blockCount, 1ull << 40);
+                        data += blockCount * kBlockSize;
+                        size -= blockCount * kBlockSize;
+                    }
+                    if (size != 0u)
+                    {
+                        std::memcpy(mBuffer, data, size);
+                        mBuffered = size;
+                    }
+                }
+
+                void Poly1305::Finish (std::uint8_t *mac) noexcept
+                {
+                    if (mBuffered != 0u)
+                    {
+                        // The partial block is padded by 0x01 and zeros instead of the 2^128 bit.
+                        mBuffer[mBuffered] = 0x01u;
+                        std::memset(mBuffer + mBuffered + 1u, 0, kBlockSize - mBuffered - 1u);
+                        Blocks(mBuffer, 1u, 0u);
+                    }
+
+                    // Full carry propagation.
+                    std::uint64_t h0 = mH[0];
+                    std::uint64_t h1 = mH[1];
+                    std::uint64_t h2 = mH[2];
+                    std::uint64_t carry = h1 >> 44;
+                    h1 &= kMask44;
+                    h2 += carry;
+                    carry = h2 >> 42;
+                    h2 &= kMask42;
+                    h0 += carry * 5u;
+                    carry = h0 >> 44;
+                    h0 &= kMask44;
+                    h1 += carry;
+                    carry = h1 >> 44;
+                    h1 &= kMask44;
+                    h2 += carry;
+                    carry = h2 >> 42;
+                    h2 &= kMask42;
+                    h0 += carry * 5u;
+                    carry = h0 >> 44;
+                    h0 &= kMask44;
+                    h1 += carry;
+
+                    // g = h + 5 - 2^130, select h if g is negative
+                    std::uint64_t g0 = h0 + 5u;
+                    carry = g0 >> 44;
+                    g0 &= kMask44;
+                    std::uint64_t g1 = h1 + carry;
+                    carry = g1 >> 44;
+                    g1 &= kMask44;
+                    std::uint64_t g2 = h2 + carry - (1ull << 42);
+                    const std::uint64_t keep = (g2 >> 63) - 1u;    // all ones if g >= 0
+                    h0 = (h0 & ~keep) | (g0 & keep);
+                    h1 = (h1 & ~keep) | (g1 & keep);
+                    h2 = (h2 & ~keep) | (g2 & keep & kMask42);
+
+                    // mac = (h + s) mod 2^128
+                    const std::uint64_t low = h0 | (h1 << 44);
+                    const std::uint64_t high = (h1 >> 20) | (h2 << 24);
+                    const Wide sum = (Wide)low + mPad[0];
+                    StoreLe64(static_cast<std::uint64_t>(sum), mac);
+                    StoreLe64(high + mPad[1] + static_cast<std::uint64_t>(sum >> 64), mac + 8u);
+
+                    SecureWipe(mBuffer, sizeof(mBuffer));
+                    Start();
+                }
+
+                void Poly1305::Clear () noexcept
+                {
+                    SecureWipe(mR, sizeof(mR));
+                    SecureWipe(mS, sizeof(mS));
+                    SecureWipe(mPad, sizeof(mPad));
+                    SecureWipe(mH, sizeof(mH));
+                    SecureWipe(mBuffer, sizeof(mBuffer));
+                    mBuffered = 0u;
+                }
+
+                void Poly1305::Blocks (const std::uint8_t *blocks, std::size_t blockCount, std::uint64_t highBit) noexcept
+                {
+                    const std::uint64_t r0 = mR[0];
+                    const std::uint64_t r1 = mR[1];
+                    const std::uint64_t r2 = mR[2];
+                    const std::uint64_t s1 = mS[0];
+                    const std::uint64_t s2 = mS[1];
+                    std::uint64_t h0 = mH[0];
+                    std::uint64_t h1 = mH[1];
+                    std::uint64_t h2 = mH[2];
+                    for (; blockCount > 0u; --blockCount, blocks += kBlockSize)
+                    {
+                        // h = (h + m) * r mod 2^130 - 5
+                        const std::uint64_t t0 = LoadLe64(blocks);
+                        const std::uint64_t t1 = LoadLe64(blocks + 8u);
+                        h0 += t0 & kMask44;
+                        h1 += ((t0 >> 44) | (t1 << 20)) & kMask44;
+                        h2 += ((t1 >> 24) & kMask42) | highBit;
+
+                        const Wide d0 = (Wide)h0 * r0 + (Wide)h1 * s2 + (Wide)h2 * s1;
+                        Wide d1 = (Wide)h0 * r1 + (Wide)h1 * r0 + (Wide)h2 * s2;
+                        Wide d2 = (Wide)h0 * r2 + (Wide)h1 * r1 + (Wide)h2 * r0;
+
+                        std::uint64_t carry = static_cast<std::uint64_t>(d0 >> 44);
+                        h0 = static_cast<std::uint64_t>(d0) & kMask44;
+                        d1 += carry;
+                        carry = static_cast<std::uint64_t>(d1 >> 44);
+                        h1 = static_cast<std::uint64_t>(d1) & kMask44;
+                        d2 += carry;
+                        carry = static_cast<std::uint64_t>(d2 >> 42);
+                        h2 = static_cast<std::uint64_t>(d2) & kMask42;
+                        h0 += carry * 5u;
+                        carry = h0 >> 44;
+                        h0 &= kMask44;
+                        h1 += carry;
+                    }
+                    mH[0] = h0;
+                    mH[1] = h1;
+                    mH[2] = h2;
+                }
+            }
+        }
+    }
+}
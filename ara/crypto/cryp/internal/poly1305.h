@@ -0,0 +1,92 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_POLY1305_H
+#define ARA_CRYPTO_CRYP_INTERNAL_POLY1305_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Poly1305 one-time authenticator (RFC 8439). The accumulator is kept in three limbs of
+                 * 44, 44 and 42 bits multiplied with 128-bit products; the clamped key r and the multiples 20 * r
+                 * used by the reduction are computed once by SetKey(). A key must authenticate a single message
+                 * only. The object is copyable, so the keyed state can be saved and restored.
+                 */
+                class Poly1305
+                {
+                public:
+
+                    /**
+                     * @brief Size of the key (r || s) in bytes.
+                     */
+                    static const std::size_t kKeySize = 32u;
+
+                    /**
+                     * @brief Size of the MAC in bytes.
+                     */
+                    static const std::size_t kDigestSize = 16u;
+
+                    /**
+                     * @brief Size of the input block in bytes.
+                     */
+                    static const std::size_t kBlockSize = 16u;
+
+                    Poly1305 () noexcept;
+
+                    /**
+                     * @brief Destroy the Poly1305 object wiping the keyed state.
+                     */
+                    ~Poly1305 () noexcept;
+
+                    /**
+                     * @brief Deploy a key and start a new computation.
+                     * @param[in] key the one-time key of kKeySize bytes
+                     */
+                    void SetKey (const std::uint8_t key[kKeySize]) noexcept;
+
+                    /**
+                     * @brief Restart the computation with the deployed key.
+                     */
+                    void Start () noexcept;
+
+                    /**
+                     * @brief Authenticate a portion of the message.
+                     * @param[in] data the message portion
+                     * @param[in] size size of the portion in bytes
+                     */
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Finish the computation and restart it with the deployed key.
+                     * @param[out] mac the MAC value of kDigestSize bytes
+                     */
+                    void Finish (std::uint8_t *mac) noexcept;
+
+                    /**
+                     * @brief Wipe the keyed state.
+                     */
+                    void Clear () noexcept;
+
+                private:
+
+                    void Blocks (const std::uint8_t *blocks, std::size_t blockCount, std::uint64_t highBit) noexcept;
+
+                    std::uint64_t mR[3];
+                    std::uint64_t mS[2];    // 20 * r1, 20 * r2
+                    std::uint64_t mPad[2];
+                    std::uint64_t mH[3];
+                    std::uint8_t mBuffer[kBlockSize];
+                    std::size_t mBuffered;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_POLY1305_H
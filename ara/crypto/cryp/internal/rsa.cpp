@@ -0,0 +1,458 @@
+#include "ara/crypto/cryp/internal/rsa.h"
+
+#include <cstring>
+
+#include "ara/crypto/cryp/internal/sha256.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    using Wide = unsigned __int128;
+                    using Element = BigModulus::Element;
+
+                    const std::size_t kMinModulusSize = 64u;
+
+                    // DER encoded DigestInfo of SHA2-256 preceding the digest (RFC 8017 9.2).
+                    const std::uint8_t kSha256DigestInfo[] = {
+                        0x30u, 0x31u, 0x30u, 0x0du, 0x06u, 0x09u, 0x60u, 0x86u, 0x48u, 0x01u,
+                        0x65u, 0x03u, 0x04u, 0x02u, 0x01u, 0x05u, 0x00u, 0x04u, 0x20u};
+
+                    void SecureWipe (void *data, std::size_t size) noexcept
+                    {
+                        volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            bytes[i] = 0u;
+                        }
+                    }
+
+                    // Skip the leading zero bytes of a big-endian integer.
+                    Rsa::Integer Strip (const Rsa::Integer &value) noexcept
+                    {
+                        Rsa::Integer stripped = value;
+                        while ((stripped.mSize != 0u) && (stripped.mData[0] == 0u))
+                        {
+                            ++stripped.mData;
+                            --stripped.mSize;
+                        }
+                        return stripped;
+                    }
+
+                    bool CopyExponent (const Rsa::Integer &value, std::uint8_t *exponent, std::size_t &size, std::size_t maxSize) noexcept
+                    {
+                        const Rsa::Integer stripped = Strip(value);
+                        if ((stripped.mSize == 0u) || (stripped.mSize > maxSize))
+                        {
+                            return false;
+                        }
+                        std::memcpy(exponent, stripped.mData, stripped.mSize);
+                        size = stripped.mSize;
+                        return true;
+                    }
+
+                    // Load a big-endian integer into little-endian limbs.
+                    void LoadLimbs (std::uint64_t *limbs, std::size_t limbCount, const std::uint8_t *bytes, std::size_t size) noexcept
+                    {
+                        for (std::size_t i = 0; i < limbCount; ++i)
+                        {
+                            std::uint64_t limb = 0u;
+                            for (std::size_t j = 8u; j > 0u; --j)
+                            {
+                                const std::size_t index = 8u * i + j - 1u;
+                                limb = (limb << 8) | ((index < size) ? bytes[size - 1u - index] : 0u);
+                            }
+                            limbs[i] = limb;
+                        }
+                    }
+
+                    // out ^= MGF1(seed) with SHA2-256
+                    void Mgf1Xor (const std::uint8_t *seed, std::size_t seedSize, std::uint8_t *out, std::size_t size) noexcept
+                    {
+                        std::uint8_t mask[Sha256::kDigestSize];
+                        for (std::uint32_t counter = 0u; size != 0u; ++counter)
+                        {
+                            const std::uint8_t encoded[4] = {
+                                static_cast<std::uint8_t>(counter >> 24), static_cast<std::uint8_t>(counter >> 16),
+                                static_cast<std::uint8_t>(counter >> 8), static_cast<std::uint8_t>(counter)};
+                            Sha256 hash;
+                            hash.Update(seed, seedSize);
+                            hash.Update(encoded, sizeof(encoded));
+                            hash.Finish(mask);
+                            const std::size_t taken = (size < sizeof(mask)) ? size : sizeof(mask);
+                            for (std::size_t i = 0; i < taken; ++i)
+                            {
+                                out[i] ^= mask[i];
+                            }
+                            out += taken;
+                            size -= taken;
+                        }
+                        SecureWipe(mask, sizeof(mask));
+                    }
+
+                    // All ones if the value is zero, otherwise zero.
+                    inline std::size_t ZeroMask (std::size_t value) noexcept
+                    {
+                        return static_cast<std::size_t>(0u) - static_cast<std::size_t>(((value | (0u - value)) >> (8u * sizeof(std::size_t) - 1u)) ^ 1u);
+                    }
+                }
+
+                Rsa::Rsa () noexcept :
+                    mPublicExponentSize(0u),
+                    mExponent1Size(0u),
+                    mExponent2Size(0u),
+                    mModulusSize(0u),
+                    mHasPrivateKey(false)
+                {
+                }
+
+                Rsa::~Rsa () noexcept
+                {
+                    Clear();
+                }
+
+                bool Rsa::SetPublicKey (const Integer &modulus, const Integer &publicExponent) noexcept
+                {
+                    Clear();
+                    const Integer stripped = Strip(modulus);
+                    if ((stripped.mSize < kMinModulusSize) || !mModulus.SetModulus(stripped.mData, stripped.mSize) ||
+                        !CopyExponent(publicExponent, mPublicExponent, mPublicExponentSize, stripped.mSize) ||
+                        ((mPublicExponent[mPublicExponentSize - 1u] & 1u) == 0u) ||
+                        ((mPublicExponentSize == 1u) && (mPublicExponent[0] == 1u)))
+                    {
+                        Clear();
+                        return false;
+                    }
+                    mModulusSize = stripped.mSize;
+                    return true;
+                }
+
+                bool Rsa::SetPrivateKey (const PrivateKey &key) noexcept
+                {
+                    if (!SetPublicKey(key.mModulus, key.mPublicExponent))
+                    {
+                        return false;
+                    }
+
+                    const Integer p = Strip(key.mPrime1);
+                    const Integer q = Strip(key.mPrime2);
+                    const Integer coefficient = Strip(key.mCoefficient);
+                    Element value;
+                    bool valid = mPrime1.SetModulus(p.mData, p.mSize) && mPrime2.SetModulus(q.mData, q.mSize) &&
+                        (mPrime1.GetLimbCount() == mPrime2.GetLimbCount()) &&
+                        (mModulus.GetLimbCount() <= 2u * mPrime1.GetLimbCount()) &&
+                        CopyExponent(key.mExponent1, mExponent1, mExponent1Size, p.mSize) &&
+                        CopyExponent(key.mExponent2, mExponent2, mExponent2Size, q.mSize) &&
+                        mPrime1.Decode(value, coefficient.mData, coefficient.mSize);
+
+                    if (valid)
+                    {
+                        // n = p * q
+                        const std::size_t k = mPrime1.GetLimbCount();
+                        std::uint64_t product[2u * BigModulus::kMaxLimbs] = {};
+                        for (std::size_t i = 0; i < k; ++i)
+                        {
+                            std::uint64_t carry = 0u;
+                            for (std::size_t j = 0; j < k; ++j)
+                            {
+                                const Wide sum = (Wide)mPrime1.GetModulus().mLimb[i] * mPrime2.GetModulus().mLimb[j] + product[i + j] + carry;
+                                product[i + j] = static_cast<std::uint64_t>(sum);
+                                carry = static_cast<std::uint64_t>(sum >> 64);
+                            }
+                            product[i + k] = carry;
+                        }
+                        for (std::size_t i = 0; i < 2u * k; ++i)
+                        {
+                            const std::uint64_t expected = (i < mModulus.GetLimbCount()) ? mModulus.GetModulus().mLimb[i] : 0u;
+                            valid = valid && (product[i] == expected);
+                        }
+                    }
+                    if (!valid)
+                    {
+                        SecureWipe(&value, sizeof(value));
+                        Clear();
+                        return false;
+                    }
+
+                    mPrime1.ToMontgomery(mCoefficient, value);
+                    SecureWipe(&value, sizeof(value));
+                    mHasPrivateKey = true;
+                    return true;
+                }
+
+                std::size_t Rsa::GetMaxOaepMessageSize () const noexcept
+                {
+                    return (mModulusSize > 2u * kHashSize + 2u) ? (mModulusSize - 2u * kHashSize - 2u) : 0u;
+                }
+
+                bool Rsa::PublicOperation (const std::uint8_t *in, std::uint8_t *out) const noexcept
+                {
+                    Element value;
+                    if ((mModulusSize == 0u) || !mModulus.Decode(value, in, mModulusSize))
+                    {
+                        return false;
+                    }
+                    mModulus.ToMontgomery(value, value);
+                    mModulus.ExponentiatePublic(value, value, mPublicExponent, mPublicExponentSize);
+                    mModulus.FromMontgomery(value, value);
+                    mModulus.Encode(out, mModulusSize, value);
+                    return true;
+                }
+
+                bool Rsa::InitBlinding (Blinding &blinding, const std::uint8_t *random, std::size_t size) const noexcept
+                {
+                    if (!mHasPrivateKey || (size > 2u * mModulusSize))
+                    {
+                        return false;
+                    }
+
+                    // r mod n, r^e
+                    std::uint64_t limbs[2u * BigModulus::kMaxLimbs];
+                    const std::size_t limbCount = 2u * mModulus.GetLimbCount();
+                    LoadLimbs(limbs, limbCount, random, size);
+                    Element r;
+                    mModulus.Reduce(r, limbs, limbCount);
+                    mModulus.ExponentiatePublic(blinding.mFactor, r, mPublicExponent, mPublicExponentSize);
+
+                    // r^-1 = CRT(r^(p - 2) mod p, r^(q - 2) mod q)
+                    mModulus.FromMontgomery(r, r);
+                    std::uint8_t exponent[kMaxModulusSize];
+                    Element inverses[2];
+                    const BigModulus *primes[2] = {&mPrime1, &mPrime2};
+                    bool invertible = true;
+                    for (std::size_t i = 0; i < 2u; ++i)
+                    {
+                        const BigModulus &prime = *primes[i];
+                        const std::size_t primeSize = 8u * prime.GetLimbCount();
+                        prime.Encode(exponent, primeSize, prime.GetModulus());
+                        std::uint8_t borrow = 2u;
+                        for (std::size_t j = primeSize; j > 0u; --j)
+                        {
+                            const std::uint8_t byte = exponent[j - 1u];
+                            exponent[j - 1u] = static_cast<std::uint8_t>(byte - borrow);
+                            borrow = (byte < borrow) ? 1u : 0u;
+                        }
+                        prime.Reduce(inverses[i], r.mLimb, mModulus.GetLimbCount());
+                        prime.Exponentiate(inverses[i], inverses[i], exponent, primeSize);
+
+                        std::uint64_t nonZero = 0u;
+                        for (std::size_t j = 0; j < prime.GetLimbCount(); ++j)
+                        {
+                            nonZero |= inverses[i].mLimb[j];
+                        }
+                        invertible = invertible && (nonZero != 0u);
+                    }
+                    Combine(r, inverses[0], inverses[1]);
+                    mModulus.ToMontgomery(blinding.mInverse, r);
+
+                    SecureWipe(limbs, sizeof(limbs));
+                    SecureWipe(&r, sizeof(r));
+                    SecureWipe(inverses, sizeof(inverses));
+                    return invertible;
+                }
+
+                void Rsa::AdvanceBlinding (Blinding &blinding) const noexcept
+                {
+                    mModulus.Multiply(blinding.mFactor, blinding.mFactor, blinding.mFactor);
+                    mModulus.Multiply(blinding.mInverse, blinding.mInverse, blinding.mInverse);
+                }
+
+                bool Rsa::PrivateOperation (const std::uint8_t *in, std::uint8_t *out, const Blinding &blinding) const noexcept
+                {
+                    Element input;
+                    if (!mHasPrivateKey || !mModulus.Decode(input, in, mModulusSize))
+                    {
+                        return false;
+                    }
+
+                    // x = c * r^e mod n
+                    Element x;
+                    mModulus.ToMontgomery(x, input);
+                    mModulus.Multiply(x, x, blinding.mFactor);
+                    mModulus.FromMontgomery(x, x);
+
+                    // m1 = x^dp mod p, m2 = x^dq mod q
+                    Element m1;
+                    Element m2;
+                    mPrime1.Reduce(m1, x.mLimb, mModulus.GetLimbCount());
+                    mPrime2.Reduce(m2, x.mLimb, mModulus.GetLimbCount());
+                    BigModulus::ExponentiatePair(mPrime1, {&m1, &m1, mExponent1, mExponent1Size}, mPrime2, {&m2, &m2, mExponent2, mExponent2Size});
+                    Combine(x, m1, m2);
+
+                    // m = x * r^-1 mod n, verified by m^e = c before it is released
+                    mModulus.ToMontgomery(x, x);
+                    mModulus.Multiply(x, x, blinding.mInverse);
+                    Element check;
+                    mModulus.ExponentiatePublic(check, x, mPublicExponent, mPublicExponentSize);
+                    mModulus.FromMontgomery(check, check);
+                    mModulus.FromMontgomery(x, x);
+                    const bool valid = mModulus.IsEqual(check, input);
+                    if (valid)
+                    {
+                        mModulus.Encode(out, mModulusSize, x);
+                    }
+
+                    SecureWipe(&x, sizeof(x));
+                    SecureWipe(&m1, sizeof(m1));
+                    SecureWipe(&m2, sizeof(m2));
+                    return valid;
+                }
+
+                bool Rsa::EncryptOaep (const std::uint8_t *message, std::size_t size, const std::uint8_t *label, std::size_t labelSize, const std::uint8_t seed[kHashSize], std::uint8_t *out) const noexcept
+                {
+                    if ((mModulusSize == 0u) || (size > GetMaxOaepMessageSize()))
+                    {
+                        return false;
+                    }
+
+                    // EM = 0x00 || maskedSeed || maskedDB, DB = lHash || PS || 0x01 || M
+                    std::uint8_t encoded[kMaxModulusSize];
+                    std::uint8_t *maskedSeed = encoded + 1u;
+                    std::uint8_t *db = maskedSeed + kHashSize;
+                    const std::size_t dbSize = mModulusSize - kHashSize - 1u;
+                    encoded[0] = 0u;
+                    Sha256::Compute(label, labelSize, db);
+                    std::memset(db + kHashSize, 0, dbSize - kHashSize - size - 1u);
+                    db[dbSize - size - 1u] = 0x01u;
+                    std::memcpy(db + dbSize - size, message, size);
+                    std::memcpy(maskedSeed, seed, kHashSize);
+                    Mgf1Xor(maskedSeed, kHashSize, db, dbSize);
+                    Mgf1Xor(db, dbSize, maskedSeed, kHashSize);
+
+                    const bool result = PublicOperation(encoded, out);
+                    SecureWipe(encoded, mModulusSize);
+                    return result;
+                }
+
+                bool Rsa::DecryptOaep (const std::uint8_t *in, const std::uint8_t *label, std::size_t labelSize, const Blinding &blinding, std::uint8_t *out, std::size_t &size) const noexcept
+                {
+                    size = 0u;
+                    std::uint8_t encoded[kMaxModulusSize];
+                    if ((GetMaxOaepMessageSize() == 0u) || !PrivateOperation(in, encoded, blinding))
+                    {
+                        return false;
+                    }
+
+                    std::uint8_t *seed = encoded + 1u;
+                    std::uint8_t *db = seed + kHashSize;
+                    const std::size_t dbSize = mModulusSize - kHashSize - 1u;
+                    Mgf1Xor(db, dbSize, seed, kHashSize);
+                    Mgf1Xor(seed, kHashSize, db, dbSize);
+
+                    // Y = 0, lHash' = lHash, then zeros up to the first 0x01
+                    std::uint8_t labelHash[kHashSize];
+                    Sha256::Compute(label, labelSize, labelHash);
+                    std::size_t bad = encoded[0];
+                    for (std::size_t i = 0; i < kHashSize; ++i)
+                    {
+                        bad |= db[i] ^ labelHash[i];
+                    }
+                    std::size_t found = 0u;         // all ones after the separator is found
+                    std::size_t separator = 0u;
+                    for (std::size_t i = kHashSize; i < dbSize; ++i)
+                    {
+                        const std::size_t isZero = ZeroMask(db[i]);
+                        const std::size_t isOne = ZeroMask(db[i] ^ 0x01u);
+                        separator |= i & isOne & ~found;
+                        bad |= ~found & ~isZero & ~isOne;
+                        found |= isOne;
+                    }
+                    bad |= ~found;
+
+                    const bool valid = (bad == 0u);
+                    if (valid)
+                    {
+                        size = dbSize - separator - 1u;
+                        std::memcpy(out, db + separator + 1u, size);
+                    }
+                    SecureWipe(encoded, mModulusSize);
+                    return valid;
+                }
+
+                bool Rsa::VerifyPkcs1Sha256 (const std::uint8_t digest[kHashSize], const std::uint8_t *signature, std::size_t signatureSize) const noexcept
+                {
+                    std::uint8_t decoded[kMaxModulusSize];
+                    if ((signatureSize != mModulusSize) || !PublicOperation(signature, decoded))
+                    {
+                        return false;
+                    }
+
+                    // EM = 0x00 || 0x01 || PS (0xff) || 0x00 || DigestInfo || digest
+                    std::uint8_t expected[kMaxModulusSize];
+                    const std::size_t tSize = sizeof(kSha256DigestInfo) + kHashSize;
+                    expected[0] = 0x00u;
+                    expected[1] = 0x01u;
+                    std::memset(expected + 2, 0xff, mModulusSize - tSize - 3u);
+                    expected[mModulusSize - tSize - 1u] = 0x00u;
+                    std::memcpy(expected + mModulusSize - tSize, kSha256DigestInfo, sizeof(kSha256DigestInfo));
+                    std::memcpy(expected + mModulusSize - kHashSize, digest, kHashSize);
+                    return std::memcmp(decoded, expected, mModulusSize) == 0;
+                }
+
+                void Rsa::Clear () noexcept
+                {
+                    mModulus.Clear();
+                    mPrime1.Clear();
+                    mPrime2.Clear();
+                    SecureWipe(&mCoefficient, sizeof(mCoefficient));
+                    SecureWipe(mExponent1, sizeof(mExponent1));
+                    SecureWipe(mExponent2, sizeof(mExponent2));
+                    mPublicExponentSize = 0u;
+                    mExponent1Size = 0u;
+                    mExponent2Size = 0u;
+                    mModulusSize = 0u;
+                    mHasPrivateKey = false;
+                }
+
+                void Rsa::Combine (Element &r, const Element &mp, const Element &mq) const noexcept
+                {
+                    // Garner: h = (m1 - m2) * q^-1 mod p, r = m2 + h * q
+                    const std::size_t k = mPrime1.GetLimbCount();
+                    Element m2;
+                    mPrime2.FromMontgomery(m2, mq);
+                    Element h;
+                    mPrime1.Reduce(h, m2.mLimb, k);
+                    mPrime1.Subtract(h, mp, h);
+                    mPrime1.Multiply(h, h, mCoefficient);
+                    mPrime1.FromMontgomery(h, h);
+
+                    std::uint64_t sum[2u * BigModulus::kMaxLimbs] = {};
+                    for (std::size_t i = 0; i < k; ++i)
+                    {
+                        sum[i] = m2.mLimb[i];
+                    }
+                    for (std::size_t i = 0; i < k; ++i)
+                    {
+                        std::uint64_t carry = 0u;
+                        for (std::size_t j = 0; j < k; ++j)
+                        {
+                            const Wide product = (Wide)h.mLimb[i] * mPrime2.GetModulus().mLimb[j] + sum[i + j] + carry;
+                            sum[i + j] = static_cast<std::uint64_t>(product);
+                            carry = static_cast<std::uint64_t>(product >> 64);
+                        }
+                        for (std::size_t j = i + k; j < 2u * k; ++j)
+                        {
+                            const Wide added = (Wide)sum[j] + carry;
+                            sum[j] = static_cast<std::uint64_t>(added);
+                            carry = static_cast<std::uint64_t>(added >> 64);
+                        }
+                    }
+                    for (std::size_t i = 0; i < mModulus.GetLimbCount(); ++i)
+                    {
+                        r.mLimb[i] = sum[i];
+                    }
+
+                    SecureWipe(&m2, sizeof(m2));
+                    SecureWipe(&h, sizeof(h));
+                    SecureWipe(sum, sizeof(sum));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,216 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_RSA_H
+#define ARA_CRYPTO_CRYP_INTERNAL_RSA_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/crypto/cryp/internal/big_modulus.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief RSA primitives (RFC 8017), the OAEP encryption scheme with SHA2-256 and MGF1/SHA2-256 and the
+                 * PKCS #1 v1.5 signature verification with SHA2-256.
+                 * SetPrivateKey() precomputes the Montgomery constants of the modulus and both primes and the
+                 * CRT coefficient in the Montgomery form once per key, so a private operation costs two
+                 * half-size constant-time exponentiations. The private operation is blinded by a pair
+                 * (r^e, r^-1) prepared by InitBlinding() from caller supplied randomness and refreshed by
+                 * AdvanceBlinding() (squaring both values) for the next operation, and its result is verified
+                 * by the public operation before it is released. A keyed instance is immutable, so it can be
+                 * shared between threads; the blinding pairs are owned by the caller.
+                 */
+                class Rsa
+                {
+                public:
+
+                    /**
+                     * @brief A big-endian integer.
+                     */
+                    struct Integer
+                    {
+                        const std::uint8_t *mData;
+                        std::size_t mSize;
+                    };
+
+                    /**
+                     * @brief Components of a private key in the CRT representation (PKCS #1 RSAPrivateKey).
+                     */
+                    struct PrivateKey
+                    {
+                        Integer mModulus;           // n = p * q
+                        Integer mPublicExponent;    // e
+                        Integer mPrime1;            // p
+                        Integer mPrime2;            // q
+                        Integer mExponent1;         // d mod (p - 1)
+                        Integer mExponent2;         // d mod (q - 1)
+                        Integer mCoefficient;       // q^-1 mod p
+                    };
+
+                    /**
+                     * @brief Blinding pair in the Montgomery form modulo n.
+                     */
+                    struct Blinding
+                    {
+                        BigModulus::Element mFactor;    // r^e
+                        BigModulus::Element mInverse;   // r^-1
+                    };
+
+                    /**
+                     * @brief Maximal size of the modulus in bytes.
+                     */
+                    static const std::size_t kMaxModulusSize = BigModulus::kMaxSize;
+
+                    /**
+                     * @brief Size of the OAEP hash (SHA2-256) in bytes.
+                     */
+                    static const std::size_t kHashSize = 32u;
+
+                    Rsa () noexcept;
+
+                    /**
+                     * @brief Destroy the Rsa object wiping the key.
+                     */
+                    ~Rsa () noexcept;
+
+                    /**
+                     * @brief Deploy a public key.
+                     * @param[in] modulus the modulus n (at least 64 bytes)
+                     * @param[in] publicExponent the public exponent e (odd, greater than 1)
+                     * @return true if the key is valid
+                     */
+                    bool SetPublicKey (const Integer &modulus, const Integer &publicExponent) noexcept;
+
+                    /**
+                     * @brief Deploy a private key and precompute its CRT constants. The primes must have the same
+                     * number of 64-bit limbs and their product must be the modulus.
+                     * @param[in] key the key components
+                     * @return true if the key is valid
+                     */
+                    bool SetPrivateKey (const PrivateKey &key) noexcept;
+
+                    /**
+                     * @brief Check if a private key is deployed.
+                     * @return true if SetPrivateKey() has succeeded
+                     */
+                    bool HasPrivateKey () const noexcept
+                    {
+                        return mHasPrivateKey;
+                    }
+
+                    /**
+                     * @brief Get the size of the modulus in bytes (0 if no key is deployed).
+                     * @return std::size_t
+                     */
+                    std::size_t GetModulusSize () const noexcept
+                    {
+                        return mModulusSize;
+                    }
+
+                    /**
+                     * @brief Get the maximal size of an OAEP message in bytes.
+                     * @return std::size_t
+                     */
+                    std::size_t GetMaxOaepMessageSize () const noexcept;
+
+                    /**
+                     * @brief Raw public operation out = in^e mod n.
+                     * @param[in] in the big-endian input of GetModulusSize() bytes
+                     * @param[out] out the big-endian output of GetModulusSize() bytes
+                     * @return true on success, false if no key is deployed or the input is not below n
+                     */
+                    bool PublicOperation (const std::uint8_t *in, std::uint8_t *out) const noexcept;
+
+                    /**
+                     * @brief Prepare a blinding pair.
+                     * @param[out] blinding the blinding pair
+                     * @param[in] random uniformly random bytes (GetModulusSize() + 8 bytes are recommended)
+                     * @param[in] size number of the random bytes (at most 2 * GetModulusSize())
+                     * @return true on success, false if no private key is deployed or r is not invertible
+                     */
+                    bool InitBlinding (Blinding &blinding, const std::uint8_t *random, std::size_t size) const noexcept;
+
+                    /**
+                     * @brief Refresh a blinding pair for the next operation: (r^e, r^-1) becomes (r^2e, r^-2).
+                     * @param[in,out] blinding the blinding pair
+                     */
+                    void AdvanceBlinding (Blinding &blinding) const noexcept;
+
+                    /**
+                     * @brief Raw blinded private operation out = in^d mod n by the CRT.
+                     * @param[in] in the big-endian input of GetModulusSize() bytes
+                     * @param[out] out the big-endian output of GetModulusSize() bytes
+                     * @param[in] blinding a blinding pair not used by another operation
+                     * @return true on success, false if no private key is deployed, the input is not below n or
+                     * the verification of the result failed
+                     */
+                    bool PrivateOperation (const std::uint8_t *in, std::uint8_t *out, const Blinding &blinding) const noexcept;
+
+                    /**
+                     * @brief Encrypt a message by RSAES-OAEP.
+                     * @param[in] message the message
+                     * @param[in] size size of the message (at most GetMaxOaepMessageSize() bytes)
+                     * @param[in] label the label
+                     * @param[in] labelSize size of the label in bytes
+                     * @param[in] seed the random seed of kHashSize bytes
+                     * @param[out] out the ciphertext of GetModulusSize() bytes
+                     * @return true on success, false if no key is deployed or the message is too long
+                     */
+                    bool EncryptOaep (const std::uint8_t *message, std::size_t size, const std::uint8_t *label, std::size_t labelSize, const std::uint8_t seed[kHashSize], std::uint8_t *out) const noexcept;
+
+                    /**
+                     * @brief Decrypt a message by RSAES-OAEP. The decoding does not branch on the secret encoded
+                     * message until the single success or failure result.
+                     * @param[in] in the ciphertext of GetModulusSize() bytes
+                     * @param[in] label the label
+                     * @param[in] labelSize size of the label in bytes
+                     * @param[in] blinding a blinding pair not used by another operation
+                     * @param[out] out the buffer for the message of GetMaxOaepMessageSize() bytes
+                     * @param[out] size size of the message in bytes
+                     * @return true on success, false on a decryption error
+                     */
+                    bool DecryptOaep (const std::uint8_t *in, const std::uint8_t *label, std::size_t labelSize, const Blinding &blinding, std::uint8_t *out, std::size_t &size) const noexcept;
+
+                    /**
+                     * @brief Verify an RSASSA-PKCS1-v1_5 signature with SHA2-256 (e.g. sha256WithRSAEncryption of
+                     * X.509). The encoded message is rebuilt and compared as a whole.
+                     * @param[in] digest the SHA2-256 digest of the message
+                     * @param[in] signature the big-endian signature
+                     * @param[in] signatureSize size of the signature (must be GetModulusSize() bytes)
+                     * @return true if the signature is valid
+                     */
+                    bool VerifyPkcs1Sha256 (const std::uint8_t digest[kHashSize], const std::uint8_t *signature, std::size_t signatureSize) const noexcept;
+
+                    /**
+                     * @brief Wipe the key.
+                     */
+                    void Clear () noexcept;
+
+                private:
+
+                    void Combine (BigModulus::Element &r, const BigModulus::Element &mp, const BigModulus::Element &mq) const noexcept;
+
+                    BigModulus mModulus;
+                    BigModulus mPrime1;
+                    BigModulus mPrime2;
+                    BigModulus::Element mCoefficient;   // q^-1 mod p in the Montgomery form
+                    std::uint8_t mPublicExponent[kMaxModulusSize];
+                    std::uint8_t mExponent1[kMaxModulusSize];
+                    std::uint8_t mExponent2[kMaxModulusSize];
+                    std::size_t mPublicExponentSize;
+                    std::size_t mExponent1Size;
+                    std::size_t mExponent2Size;
+                    std::size_t mModulusSize;
+                    bool mHasPrivateKey;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_RSA_H
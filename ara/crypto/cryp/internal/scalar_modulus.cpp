@@ -0,0 +1,212 @@
+#include "ara/crypto/cryp/internal/scalar_modulus.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    using Wide = unsigned __int128;
+
+                    const std::size_t kLimbCount = 4u;
+
+                    // Load up to 8 bytes of a big- or little-endian integer into a limb, starting at the
+                    // least significant byte with the index "position".
+                    std::uint64_t LoadLimb (const std::uint8_t *bytes, std::size_t size, bool bigEndian, std::size_t position) noexcept
+                    {
+                        std::uint64_t limb = 0u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            const std::size_t index = position + i;
+                            if (index < size)
+                            {
+                                const std::uint8_t byte = bigEndian ? bytes[size - 1u - index] : bytes[index];
+                                limb |= static_cast<std::uint64_t>(byte) << (8u * i);
+                            }
+                        }
+                        return limb;
+                    }
+                }
+
+                ScalarModulus::ScalarModulus (const std::uint64_t modulus[4]) noexcept
+                {
+                    for (std::size_t i = 0; i < kLimbCount; ++i)
+                    {
+                        mModulus.mLimb[i] = modulus[i];
+                    }
+
+                    // Newton iteration doubles the number of correct low bits of m^-1 mod 2^64.
+                    std::uint64_t inverse = 1u;
+                    for (std::size_t i = 0; i < 6u; ++i)
+                    {
+                        inverse *= 2u - modulus[0] * inverse;
+                    }
+                    mInverse = 0u - inverse;
+
+                    // R mod m and R^2 mod m by 512 modular doublings of 1.
+                    Element value = {{1u, 0u, 0u, 0u}};
+                    for (std::size_t bit = 1u; bit <= 512u; ++bit)
+                    {
+                        std::uint64_t doubled[kLimbCount];
+                        std::uint64_t carry = 0u;
+                        for (std::size_t i = 0; i < kLimbCount; ++i)
+                        {
+                            doubled[i] = (value.mLimb[i] << 1) | carry;
+                            carry = value.mLimb[i] >> 63;
+                        }
+                        ReduceOnce(value, doubled, carry);
+                        if (bit == 256u)
+                        {
+                            mR = value;
+                        }
+                    }
+                    mR2 = value;
+                }
+
+                void ScalarModulus::Reduce (Element &r, const std::uint8_t *bytes, std::size_t size, bool bigEndian) const noexcept
+                {
+                    // x = high * 2^256 + low = low * R / R + high * R^2 / R
+                    Element low;
+                    Element high;
+                    for (std::size_t i = 0; i < kLimbCount; ++i)
+                    {
+                        low.mLimb[i] = LoadLimb(bytes, size, bigEndian, 8u * i);
+                        high.mLimb[i] = LoadLimb(bytes, size, bigEndian, kSize + 8u * i);
+                    }
+                    Multiply(low, low, mR);
+                    Multiply(high, high, mR2);
+                    Add(r, low, high);
+                }
+
+                void ScalarModulus::ToBytes (std::uint8_t *bytes, const Element &a, bool bigEndian) noexcept
+                {
+                    for (std::size_t i = 0; i < kSize; ++i)
+                    {
+                        const std::uint8_t byte = static_cast<std::uint8_t>(a.mLimb[i / 8u] >> (8u * (i % 8u)));
+                        bytes[bigEndian ? (kSize - 1u - i) : i] = byte;
+                    }
+                }
+
+                void ScalarModulus::ToMontgomery (Element &r, const Element &a) const noexcept
+                {
+                    Multiply(r, a, mR2);
+                }
+
+                void ScalarModulus::FromMontgomery (Element &r, const Element &a) const noexcept
+                {
+                    const Element one = {{1u, 0u, 0u, 0u}};
+                    Multiply(r, a, one);
+                }
+
+                void ScalarModulus::Multiply (Element &r, const Element &a, const Element &b) const noexcept
+                {
+                    // CIOS: t = (t + a * b[i] + u * m) / 2^64 with u = t[0] * (-m^-1) mod 2^64. The result is below
+                    // 2m for a < 2^256 and b < m, so a single conditional subtraction completes the reduction. The
+                    // state is kept in scalar variables, so it stays in registers.
+                    const std::uint64_t *m = mModulus.mLimb;
+                    std::uint64_t t0 = 0u, t1 = 0u, t2 = 0u, t3 = 0u, t4 = 0u, t5;
+                    for (std::size_t i = 0; i < kLimbCount; ++i)
+                    {
+                        const std::uint64_t bi = b.mLimb[i];
+                        Wide sum = (Wide)a.mLimb[0] * bi + t0;
+                        t0 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)a.mLimb[1] * bi + t1 + static_cast<std::uint64_t>(sum >> 64);
+                        t1 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)a.mLimb[2] * bi + t2 + static_cast<std::uint64_t>(sum >> 64);
+                        t2 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)a.mLimb[3] * bi + t3 + static_cast<std::uint64_t>(sum >> 64);
+                        t3 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)t4 + static_cast<std::uint64_t>(sum >> 64);
+                        t4 = static_cast<std::uint64_t>(sum);
+                        t5 = static_cast<std::uint64_t>(sum >> 64);
+
+                        const std::uint64_t u = t0 * mInverse;
+                        sum = (Wide)u * m[0] + t0;
+                        sum = (Wide)u * m[1] + t1 + static_cast<std::uint64_t>(sum >> 64);
+                        t0 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)u * m[2] + t2 + static_cast<std::uint64_t>(sum >> 64);
+                        t1 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)u * m[3] + t3 + static_cast<std::uint64_t>(sum >> 64);
+                        t2 = static_cast<std::uint64_t>(sum);
+                        sum = (Wide)t4 + static_cast<std::uint64_t>(sum >> 64);
+                        t3 = static_cast<std::uint64_t>(sum);
+                        t4 = t5 + static_cast<std::uint64_t>(sum >> 64);
+                    }
+                    const std::uint64_t t[kLimbCount] = {t0, t1, t2, t3};
+                    ReduceOnce(r, t, t4);
+                }
+
+                void ScalarModulus::Add (Element &r, const Element &a, const Element &b) const noexcept
+                {
+                    std::uint64_t t[kLimbCount];
+                    Wide sum = 0u;
+                    for (std::size_t i = 0; i < kLimbCount; ++i)
+                    {
+                        sum = (Wide)a.mLimb[i] + b.mLimb[i] + static_cast<std::uint64_t>(sum >> 64);
+                        t[i] = static_cast<std::uint64_t>(sum);
+                    }
+                    ReduceOnce(r, t, static_cast<std::uint64_t>(sum >> 64));
+                }
+
+                void ScalarModulus::Invert (Element &r, const Element &a) const noexcept
+                {
+                    // r = a^(m - 2) by a fixed window of 4 bits over the public exponent.
+                    Element exponent = mModulus;
+                    exponent.mLimb[0] -= 2u;    // m is odd and greater than 2, no borrow
+
+                    Element powers[16];
+                    powers[0] = mR;             // one in the Montgomery form
+                    for (std::size_t i = 1; i < 16u; ++i)
+                    {
+                        Multiply(powers[i], powers[i - 1u], a);
+                    }
+
+                    Element result = mR;
+                    for (std::size_t window = 64u; window > 0u; --window)
+                    {
+                        for (std::size_t i = 0; i < 4u; ++i)
+                        {
+                            Multiply(result, result, result);
+                        }
+                        const std::size_t position = 4u * (window - 1u);
+                        const std::size_t digit = static_cast<std::size_t>(exponent.mLimb[position / 64u] >> (position % 64u)) & 15u;
+                        if (digit != 0u)
+                        {
+                            Multiply(result, result, powers[digit]);
+                        }
+                    }
+                    r = result;
+                }
+
+                bool ScalarModulus::IsZero (const Element &a) noexcept
+                {
+                    const std::uint64_t bits = a.mLimb[0] | a.mLimb[1] | a.mLimb[2] | a.mLimb[3];
+                    return ((bits | (0u - bits)) >> 63) == 0u;
+                }
+
+                void ScalarModulus::ReduceOnce (Element &r, const std::uint64_t t[4], std::uint64_t carry) const noexcept
+                {
+                    // r = (carry : t) - m if it does not borrow, else t; the choice is made by a mask.
+                    std::uint64_t d[kLimbCount];
+                    std::uint64_t borrow = 0u;
+                    for (std::size_t i = 0; i < kLimbCount; ++i)
+                    {
+                        const Wide difference = (Wide)t[i] - mModulus.mLimb[i] - borrow;
+                        d[i] = static_cast<std::uint64_t>(difference);
+                        borrow = static_cast<std::uint64_t>(difference >> 64) & 1u;
+                    }
+                    // keep t if the subtraction borrowed beyond the carry word
+                    const std::uint64_t keep = 0u - (borrow & (carry ^ 1u));
+                    for (std::size_t i = 0; i < kLimbCount; ++i)
+                    {
+                        r.mLimb[i] = (t[i] & keep) | (d[i] & ~keep);
+                    }
+                }
+            }
+        }
+    }
+}
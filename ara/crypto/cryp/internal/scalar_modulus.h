@@ -0,0 +1,110 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_SCALAR_MODULUS_H
+#define ARA_CRYPTO_CRYP_INTERNAL_SCALAR_MODULUS_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Constant-time arithmetic modulo an odd modulus of at most 256 bits, e.g. the order of an
+                 * elliptic curve group for the scalar operations of signature schemes. The products are computed
+                 * in the Montgomery form (R = 2^256); the Montgomery constants are derived by the constructor, so
+                 * an object should be constructed once (e.g. as a function-local static) and shared.
+                 */
+                class ScalarModulus
+                {
+                public:
+
+                    /**
+                     * @brief Size of an encoded element in bytes.
+                     */
+                    static const std::size_t kSize = 32u;
+
+                    /**
+                     * @brief Residue in four little-endian 64-bit limbs, always fully reduced.
+                     */
+                    struct Element
+                    {
+                        std::uint64_t mLimb[4];
+                    };
+
+                    /**
+                     * @brief Construct a new Scalar Modulus object.
+                     * @param[in] modulus the odd modulus in little-endian 64-bit limbs
+                     */
+                    explicit ScalarModulus (const std::uint64_t modulus[4]) noexcept;
+
+                    /**
+                     * @brief Reduce an unsigned integer of up to 2 * kSize bytes modulo the modulus.
+                     * @param[out] r the residue in the ordinary (not Montgomery) form
+                     * @param[in] bytes the integer
+                     * @param[in] size size of the integer in bytes
+                     * @param[in] bigEndian true if the integer is big-endian, false if little-endian
+                     */
+                    void Reduce (Element &r, const std::uint8_t *bytes, std::size_t size, bool bigEndian) const noexcept;
+
+                    /**
+                     * @brief Encode a residue to kSize bytes.
+                     * @param[out] bytes the encoding
+                     * @param[in] a the residue
+                     * @param[in] bigEndian true for the big-endian encoding, false for the little-endian one
+                     */
+                    static void ToBytes (std::uint8_t *bytes, const Element &a, bool bigEndian) noexcept;
+
+                    /**
+                     * @brief Convert a residue to the Montgomery form (a * R mod m).
+                     */
+                    void ToMontgomery (Element &r, const Element &a) const noexcept;
+
+                    /**
+                     * @brief Convert a residue from the Montgomery form (a / R mod m).
+                     */
+                    void FromMontgomery (Element &r, const Element &a) const noexcept;
+
+                    /**
+                     * @brief Montgomery product r = a * b / R mod m. The argument b must be reduced, a may be any
+                     * value below 2^256.
+                     */
+                    void Multiply (Element &r, const Element &a, const Element &b) const noexcept;
+
+                    /**
+                     * @brief Modular sum r = a + b mod m of reduced arguments (in any, but the same, form).
+                     */
+                    void Add (Element &r, const Element &a, const Element &b) const noexcept;
+
+                    /**
+                     * @brief Modular inverse of an element in the Montgomery form by the Fermat's little theorem (the
+                     * modulus must be a prime). The exponent is public, so the time does not depend on the argument.
+                     * @param[out] r the inverse in the Montgomery form (zero for the zero argument)
+                     * @param[in] a the element in the Montgomery form
+                     */
+                    void Invert (Element &r, const Element &a) const noexcept;
+
+                    /**
+                     * @brief Check (in constant time) if an element is zero.
+                     * @return true if all limbs are zero
+                     */
+                    static bool IsZero (const Element &a) noexcept;
+
+                private:
+
+                    void ReduceOnce (Element &r, const std::uint64_t t[4], std::uint64_t carry) const noexcept;
+
+                    Element mModulus;
+                    Element mR;             // R mod m
+                    Element mR2;            // R^2 mod m
+                    std::uint64_t mInverse; // -m^-1 mod 2^64
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_SCALAR_MODULUS_H
@@ -0,0 +1,260 @@
+#include "ara/crypto/cryp/internal/sha1.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARA_CRYPTO_SHA_NI 1
+#include <immintrin.h>
+#define ARA_CRYPTO_SHA_NI_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    const std::uint32_t kInitialState[5] =
+                    {
+                        0x67452301u, 0xefcdab89u, 0x98badcfeu, 0x10325476u, 0xc3d2e1f0u
+                    };
+
+                    inline std::uint32_t RotateLeft (std::uint32_t value, unsigned bits) noexcept
+                    {
+                        return (value << bits) | (value >> (32u - bits));
+                    }
+
+                    inline std::uint32_t LoadBe32 (const std::uint8_t *bytes) noexcept
+                    {
+                        return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+                               (static_cast<std::uint32_t>(bytes[2]) << 8) | static_cast<std::uint32_t>(bytes[3]);
+                    }
+
+                    inline void StoreBe32 (std::uint32_t value, std::uint8_t *bytes) noexcept
+                    {
+                        bytes[0] = static_cast<std::uint8_t>(value >> 24);
+                        bytes[1] = static_cast<std::uint8_t>(value >> 16);
+                        bytes[2] = static_cast<std::uint8_t>(value >> 8);
+                        bytes[3] = static_cast<std::uint8_t>(value);
+                    }
+
+#ifdef ARA_CRYPTO_SHA_NI
+                    bool IsShaNiSupported () noexcept
+                    {
+                        static const bool cSupported = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+                        return cSupported;
+                    }
+
+                    // The round function selector of SHA1RNDS4 must be an immediate.
+                    ARA_CRYPTO_SHA_NI_TARGET
+                    inline __m128i Rounds4Ni (__m128i abcd, __m128i e, std::size_t group) noexcept
+                    {
+                        switch (group / 5u)
+                        {
+                        case 0u:
+                            return _mm_sha1rnds4_epu32(abcd, e, 0);
+                        case 1u:
+                            return _mm_sha1rnds4_epu32(abcd, e, 1);
+                        case 2u:
+                            return _mm_sha1rnds4_epu32(abcd, e, 2);
+                        default:
+                            return _mm_sha1rnds4_epu32(abcd, e, 3);
+                        }
+                    }
+
+                    // 20 groups of 4 rounds, the message schedule of the later groups is computed in 4 registers
+                    // alongside the rounds.
+                    ARA_CRYPTO_SHA_NI_TARGET
+                    void CompressNi (std::uint32_t *state, const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                    {
+                        const __m128i byteOrder = _mm_set_epi64x(0x0001020304050607ll, 0x08090a0b0c0d0e0fll);
+                        __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+                        __m128i e = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+                        for (; blockCount > 0u; --blockCount, blocks += Sha1::kBlockSize)
+                        {
+                            const __m128i abcdSaved = abcd;
+                            const __m128i eSaved = e;
+                            __m128i previous = abcd;
+                            __m128i message[4];
+                            for (std::size_t i = 0; i < 20u; ++i)
+                            {
+                                __m128i &current = message[i % 4u];
+                                if (i < 4u)
+                                {
+                                    current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16u * i)), byteOrder);
+                                }
+                                e = (i == 0u) ? _mm_add_epi32(e, current) : _mm_sha1nexte_epu32(previous, current);
+                                if ((i >= 3u) && (i <= 18u))
+                                {
+                                    message[(i + 1u) % 4u] = _mm_sha1msg2_epu32(message[(i + 1u) % 4u], current);
+                                }
+                                previous = abcd;
+                                abcd = Rounds4Ni(abcd, e, i);
+                                if ((i >= 1u) && (i <= 16u))
+                                {
+                                    message[(i + 3u) % 4u] = _mm_sha1msg1_epu32(message[(i + 3u) % 4u], current);
+                                }
+                                if ((i >= 2u) && (i <= 17u))
+                                {
+                                    message[(i + 2u) % 4u] = _mm_xor_si128(message[(i + 2u) % 4u], current);
+                                }
+                            }
+                            e = _mm_sha1nexte_epu32(previous, eSaved);
+                            abcd = _mm_add_epi32(abcd, abcdSaved);
+                        }
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+                        state[4] = static_cast<std::uint32_t>(_mm_extract_epi32(e, 3));
+                    }
+#endif
+                }
+
+                Sha1::Sha1 () noexcept
+                {
+                    Reset();
+                }
+
+                void Sha1::Reset () noexcept
+                {
+                    std::memcpy(mState, kInitialState, sizeof(mState));
+                    std::memset(mBuffer, 0, sizeof(mBuffer));
+                    mLength = 0u;
+                    mBuffered = 0u;
+                }
+
+                void Sha1::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    mLength += size;
+                    if (mBuffered != 0u)
+                    {
+                        const std::size_t taken = (size < (kBlockSize - mBuffered)) ? size : (kBlockSize - mBuffered);
+                        std::memcpy(mBuffer + mBuffered, data, taken);
+                        mBuffered += taken;
+                        data += taken;
+                        size -= taken;
+                        if (mBuffered < kBlockSize)
+                        {
+                            return;
+                        }
+                        Compress(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+
+                    const std::size_t blockCount = size / kBlockSize;
+                    if (blockCount != 0u)
+                    {
+                        Compress(data, blockCount);
+                        data += blockCount * kBlockSize;
+                        size -= blockCount * kBlockSize;
+                    }
+                    if (size != 0u)
+                    {
+                        std::memcpy(mBuffer, data, size);
+                        mBuffered = size;
+                    }
+                }
+
+                void Sha1::Finish (std::uint8_t *digest) noexcept
+                {
+                    const std::uint64_t bitLength = mLength * 8u;
+                    mBuffer[mBuffered++] = 0x80u;
+                    if (mBuffered > (kBlockSize - 8u))
+                    {
+                        std::memset(mBuffer + mBuffered, 0, kBlockSize - mBuffered);
+                        Compress(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+                    std::memset(mBuffer + mBuffered, 0, kBlockSize - 8u - mBuffered);
+                    for (std::size_t i = 0; i < 8u; ++i)
+                    {
+                        mBuffer[kBlockSize - 1u - i] = static_cast<std::uint8_t>(bitLength >> (8u * i));
+                    }
+                    Compress(mBuffer, 1u);
+
+                    for (std::size_t i = 0; i < 5u; ++i)
+                    {
+                        StoreBe32(mState[i], digest + 4u * i);
+                    }
+                    Reset();
+                }
+
+                void Sha1::Compute (const std::uint8_t *data, std::size_t size, std::uint8_t *digest) noexcept
+                {
+                    Sha1 hash;
+                    hash.Update(data, size);
+                    hash.Finish(digest);
+                }
+
+                void Sha1::Compress (const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                {
+#ifdef ARA_CRYPTO_SHA_NI
+                    if (IsShaNiSupported())
+                    {
+                        CompressNi(mState, blocks, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, blocks += kBlockSize)
+                    {
+                        std::uint32_t w[80];
+                        for (std::size_t i = 0; i < 16u; ++i)
+                        {
+                            w[i] = LoadBe32(blocks + 4u * i);
+                        }
+                        for (std::size_t i = 16; i < 80u; ++i)
+                        {
+                            w[i] = RotateLeft(w[i - 3u] ^ w[i - 8u] ^ w[i - 14u] ^ w[i - 16u], 1u);
+                        }
+
+                        std::uint32_t a = mState[0];
+                        std::uint32_t b = mState[1];
+                        std::uint32_t c = mState[2];
+                        std::uint32_t d = mState[3];
+                        std::uint32_t e = mState[4];
+                        for (std::size_t i = 0; i < 80u; ++i)
+                        {
+                            std::uint32_t f;
+                            std::uint32_t k;
+                            if (i < 20u)
+                            {
+                                f = (b & c) | (~b & d);
+                                k = 0x5a827999u;
+                            }
+                            else if (i < 40u)
+                            {
+                                f = b ^ c ^ d;
+                                k = 0x6ed9eba1u;
+                            }
+                            else if (i < 60u)
+                            {
+                                f = (b & c) | (b & d) | (c & d);
+                                k = 0x8f1bbcdcu;
+                            }
+                            else
+                            {
+                                f = b ^ c ^ d;
+                                k = 0xca62c1d6u;
+                            }
+                            const std::uint32_t temp = RotateLeft(a, 5u) + f + e + k + w[i];
+                            e = d;
+                            d = c;
+                            c = RotateLeft(b, 30u);
+                            b = a;
+                            a = temp;
+                        }
+                        mState[0] += a;
+                        mState[1] += b;
+                        mState[2] += c;
+                        mState[3] += d;
+                        mState[4] += e;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,251 @@
+#include "ara/crypto/cryp/internal/sha256.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARA_CRYPTO_SHA_NI 1
+#include <immintrin.h>
+#define ARA_CRYPTO_SHA_NI_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    const std::uint32_t kRoundConstants[64] =
+                    {
+                        0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+                        0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+                        0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+                        0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+                        0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+                        0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+                        0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+                        0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u
+                    };
+
+                    const std::uint32_t kInitialState[8] =
+                    {
+                        0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au, 0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u
+                    };
+
+                    inline std::uint32_t RotateRight (std::uint32_t value, unsigned bits) noexcept
+                    {
+                        return (value >> bits) | (value << (32u - bits));
+                    }
+
+                    inline std::uint32_t LoadBe32 (const std::uint8_t *bytes) noexcept
+                    {
+                        return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+                               (static_cast<std::uint32_t>(bytes[2]) << 8) | static_cast<std::uint32_t>(bytes[3]);
+                    }
+
+                    inline void StoreBe32 (std::uint32_t value, std::uint8_t *bytes) noexcept
+                    {
+                        bytes[0] = static_cast<std::uint8_t>(value >> 24);
+                        bytes[1] = static_cast<std::uint8_t>(value >> 16);
+                        bytes[2] = static_cast<std::uint8_t>(value >> 8);
+                        bytes[3] = static_cast<std::uint8_t>(value);
+                    }
+
+#ifdef ARA_CRYPTO_SHA_NI
+                    bool IsShaNiSupported () noexcept
+                    {
+                        static const bool cSupported = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+                        return cSupported;
+                    }
+
+                    // 16 groups of 4 rounds on the state split into ABEF and CDGH, the message schedule of the later
+                    // groups is computed in 4 registers alongside the rounds.
+                    ARA_CRYPTO_SHA_NI_TARGET
+                    void CompressNi (std::uint32_t *state, const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                    {
+                        const __m128i byteOrder = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+                        const __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xb1);
+                        const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1b);
+                        __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+                        __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+                        for (; blockCount > 0u; --blockCount, blocks += Sha256::kBlockSize)
+                        {
+                            const __m128i abefSaved = abef;
+                            const __m128i cdghSaved = cdgh;
+                            __m128i message[4];
+                            for (std::size_t i = 0; i < 16u; ++i)
+                            {
+                                __m128i &current = message[i % 4u];
+                                if (i < 4u)
+                                {
+                                    current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16u * i)), byteOrder);
+                                }
+                                __m128i words = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kRoundConstants + 4u * i)));
+                                cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+                                if ((i >= 3u) && (i <= 14u))
+                                {
+                                    __m128i &next = message[(i + 1u) % 4u];
+                                    next = _mm_add_epi32(next, _mm_alignr_epi8(current, message[(i + 3u) % 4u], 4));
+                                    next = _mm_sha256msg2_epu32(next, current);
+                                }
+                                words = _mm_shuffle_epi32(words, 0x0e);
+                                abef = _mm_sha256rnds2_epu32(abef, cdgh, words);
+                                if ((i >= 1u) && (i <= 12u))
+                                {
+                                    message[(i + 3u) % 4u] = _mm_sha256msg1_epu32(message[(i + 3u) % 4u], current);
+                                }
+                            }
+                            abef = _mm_add_epi32(abef, abefSaved);
+                            cdgh = _mm_add_epi32(cdgh, cdghSaved);
+                        }
+
+                        const __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+                        const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+                    }
+#endif
+                }
+
+                Sha256::Sha256 () noexcept
+                {
+                    Reset();
+                }
+
+                void Sha256::Reset () noexcept
+                {
+                    std::memcpy(mState, kInitialState, sizeof(mState));
+                    std::memset(mBuffer, 0, sizeof(mBuffer));
+                    mLength = 0u;
+                    mBuffered = 0u;
+                }
+
+                void Sha256::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    mLength += size;
+                    if (mBuffered != 0u)
+                    {
+                        const std::size_t taken = (size < (kBlockSize - mBuffered)) ? size : (kBlockSize - mBuffered);
+                        std::memcpy(mBuffer + mBuffered, data, taken);
+                        mBuffered += taken;
+                        data += taken;
+                        size -= taken;
+                        if (mBuffered < kBlockSize)
+                        {
+                            return;
+                        }
+                        Compress(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+
+                    const std::size_t blockCount = size / kBlockSize;
+                    if (blockCount != 0u)
+                    {
+                        Compress(data, blockCount);
+                        data += blockCount * kBlockSize;
+                        size -= blockCount * kBlockSize;
+                    }
+                    if (size != 0u)
+                    {
+                        std::memcpy(mBuffer, data, size);
+                        mBuffered = size;
+                    }
+                }
+
+                void Sha256::Finish (std::uint8_t *digest) noexcept
+                {
+                    const std::uint64_t bitLength = mLength * 8u;
+                    mBuffer[mBuffered++] = 0x80u;
+                    if (mBuffered > (kBlockSize - 8u))
+                    {
+                        std::memset(mBuffer + mBuffered, 0, kBlockSize - mBuffered);
+                        Compress(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+                    std::memset(mBuffer + mBuffered, 0, kBlockSize - 8u - mBuffered);
+                    for (std::size_t i = 0; i < 8u; ++i)
+                    {
+                        mBuffer[kBlockSize - 1u - i] = static_cast<std::uint8_t>(bitLength >> (8u * i));
+                    }
+                    Compress(mBuffer, 1u);
+
+                    for (std::size_t i = 0; i < 8u; ++i)
+                    {
+                        StoreBe32(mState[i], digest + 4u * i);
+                    }
+                    Reset();
+                }
+
+                void Sha256::Compute (const std::uint8_t *data, std::size_t size, std::uint8_t *digest) noexcept
+                {
+                    Sha256 hash;
+                    hash.Update(data, size);
+                    hash.Finish(digest);
+                }
+
+                void Sha256::Compress (const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                {
+#ifdef ARA_CRYPTO_SHA_NI
+                    if (IsShaNiSupported())
+                    {
+                        CompressNi(mState, blocks, blockCount);
+                        return;
+                    }
+#endif
+                    for (; blockCount > 0u; --blockCount, blocks += kBlockSize)
+                    {
+                        std::uint32_t w[64];
+                        for (std::size_t i = 0; i < 16u; ++i)
+                        {
+                            w[i] = LoadBe32(blocks + 4u * i);
+                        }
+                        for (std::size_t i = 16; i < 64u; ++i)
+                        {
+                            const std::uint32_t s0 = RotateRight(w[i - 15u], 7u) ^ RotateRight(w[i - 15u], 18u) ^ (w[i - 15u] >> 3);
+                            const std::uint32_t s1 = RotateRight(w[i - 2u], 17u) ^ RotateRight(w[i - 2u], 19u) ^ (w[i - 2u] >> 10);
+                            w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+                        }
+
+                        std::uint32_t a = mState[0];
+                        std::uint32_t b = mState[1];
+                        std::uint32_t c = mState[2];
+                        std::uint32_t d = mState[3];
+                        std::uint32_t e = mState[4];
+                        std::uint32_t f = mState[5];
+                        std::uint32_t g = mState[6];
+                        std::uint32_t h = mState[7];
+                        for (std::size_t i = 0; i < 64u; ++i)
+                        {
+                            const std::uint32_t s1 = RotateRight(e, 6u) ^ RotateRight(e, 11u) ^ RotateRight(e, 25u);
+                            const std::uint32_t choice = (e & f) ^ (~e & g);
+                            const std::uint32_t temp1 = h + s1 + choice + kRoundConstants[i] + w[i];
+                            const std::uint32_t s0 = RotateRight(a, 2u) ^ RotateRight(a, 13u) ^ RotateRight(a, 22u);
+                            const std::uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+                            const std::uint32_t temp2 = s0 + majority;
+                            h = g;
+                            g = f;
+                            f = e;
+                            e = d + temp1;
+                            d = c;
+                            c = b;
+                            b = a;
+                            a = temp1 + temp2;
+                        }
+                        mState[0] += a;
+                        mState[1] += b;
+                        mState[2] += c;
+                        mState[3] += d;
+                        mState[4] += e;
+                        mState[5] += f;
+                        mState[6] += g;
+                        mState[7] += h;
+                    }
+                }
+            }
+        }
+    }
+}
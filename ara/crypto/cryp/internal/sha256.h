@@ -0,0 +1,75 @@
+#ifndef ARA_CRYPTO_CRYP_INTERNAL_SHA256_H
+#define ARA_CRYPTO_CRYP_INTERNAL_SHA256_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                /**
+                 * @brief SHA2-256 hash function (FIPS 180-4). The object is copyable, so an intermediate state
+                 * (e.g. after hashing a key-dependent prefix) can be saved and restored cheaply.
+                 */
+                class Sha256
+                {
+                public:
+
+                    /**
+                     * @brief Size of the input block in bytes.
+                     */
+                    static const std::size_t kBlockSize = 64u;
+
+                    /**
+                     * @brief Size of the digest in bytes.
+                     */
+                    static const std::size_t kDigestSize = 32u;
+
+                    Sha256 () noexcept;
+
+                    /**
+                     * @brief Restore the initial state.
+                     */
+                    void Reset () noexcept;
+
+                    /**
+                     * @brief Hash a portion of the message.
+                     * @param[in] data the message portion
+                     * @param[in] size size of the portion in bytes
+                     */
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept;
+
+                    /**
+                     * @brief Finish the hashing and restore the initial state.
+                     * @param[out] digest the message digest of kDigestSize bytes
+                     */
+                    void Finish (std::uint8_t *digest) noexcept;
+
+                    /**
+                     * @brief Compute the digest of a message at once.
+                     * @param[in] data the message
+                     * @param[in] size size of the message in bytes
+                     * @param[out] digest the message digest of kDigestSize bytes
+                     */
+                    static void Compute (const std::uint8_t *data, std::size_t size, std::uint8_t *digest) noexcept;
+
+                private:
+
+                    void Compress (const std::uint8_t *blocks, std::size_t blockCount) noexcept;
+
+                    std::uint32_t mState[8];
+                    std::uint64_t mLength;
+                    std::uint8_t mBuffer[kBlockSize];
+                    std::size_t mBuffered;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_INTERNAL_SHA256_H
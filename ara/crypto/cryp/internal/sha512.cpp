@@ -0,0 +1,197 @@
+#include "ara/crypto/cryp/internal/sha512.h"
+
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    const std::uint64_t kRoundConstants[80] =
+                    {
+                        0x428a2f98d728ae22u, 0x7137449123ef65cdu, 0xb5c0fbcfec4d3b2fu, 0xe9b5dba58189dbbcu,
+                        0x3956c25bf348b538u, 0x59f111f1b605d019u, 0x923f82a4af194f9bu, 0xab1c5ed5da6d8118u,
+                        0xd807aa98a3030242u, 0x12835b0145706fbeu, 0x243185be4ee4b28cu, 0x550c7dc3d5ffb4e2u,
+                        0x72be5d74f27b896fu, 0x80deb1fe3b1696b1u, 0x9bdc06a725c71235u, 0xc19bf174cf692694u,
+                        0xe49b69c19ef14ad2u, 0xefbe4786384f25e3u, 0x0fc19dc68b8cd5b5u, 0x240ca1cc77ac9c65u,
+                        0x2de92c6f592b0275u, 0x4a7484aa6ea6e483u, 0x5cb0a9dcbd41fbd4u, 0x76f988da831153b5u,
+                        0x983e5152ee66dfabu, 0xa831c66d2db43210u, 0xb00327c898fb213fu, 0xbf597fc7beef0ee4u,
+                        0xc6e00bf33da88fc2u, 0xd5a79147930aa725u, 0x06ca6351e003826fu, 0x142929670a0e6e70u,
+                        0x27b70a8546d22ffcu, 0x2e1b21385c26c926u, 0x4d2c6dfc5ac42aedu, 0x53380d139d95b3dfu,
+                        0x650a73548baf63deu, 0x766a0abb3c77b2a8u, 0x81c2c92e47edaee6u, 0x92722c851482353bu,
+                        0xa2bfe8a14cf10364u, 0xa81a664bbc423001u, 0xc24b8b70d0f89791u, 0xc76c51a30654be30u,
+                        0xd192e819d6ef5218u, 0xd69906245565a910u, 0xf40e35855771202au, 0x106aa07032bbd1b8u,
+                        0x19a4c116b8d2d0c8u, 0x1e376c085141ab53u, 0x2748774cdf8eeb99u, 0x34b0bcb5e19b48a8u,
+                        0x391c0cb3c5c95a63u, 0x4ed8aa4ae3418acbu, 0x5b9cca4f7763e373u, 0x682e6ff3d6b2b8a3u,
+                        0x748f82ee5defb2fcu, 0x78a5636f43172f60u, 0x84c87814a1f0ab72u, 0x8cc702081a6439ecu,
+                        0x90befffa23631e28u, 0xa4506cebde82bde9u, 0xbef9a3f7b2c67915u, 0xc67178f2e372532bu,
+                        0xca273eceea26619cu, 0xd186b8c721c0c207u, 0xeada7dd6cde0eb1eu, 0xf57d4f7fee6ed178u,
+                        0x06f067aa72176fbau, 0x0a637dc5a2c898a6u, 0x113f9804bef90daeu, 0x1b710b35131c471bu,
+                        0x28db77f523047d84u, 0x32caab7b40c72493u, 0x3c9ebe0a15c9bebcu, 0x431d67c49c100d4cu,
+                        0x4cc5d4becb3e42b6u, 0x597f299cfc657e2au, 0x5fcb6fab3ad6faecu, 0x6c44198c4a475817u
+                    };
+
+                    const std::uint64_t kInitialState[8] =
+                    {
+                        0x6a09e667f3bcc908u, 0xbb67ae8584caa73bu, 0x3c6ef372fe94f82bu, 0xa54ff53a5f1d36f1u,
+                        0x510e527fade682d1u, 0x9b05688c2b3e6c1fu, 0x1f83d9abfb41bd6bu, 0x5be0cd19137e2179u
+                    };
+
+                    inline std::uint64_t RotateRight (std::uint64_t value, unsigned bits) noexcept
+                    {
+                        return (value >> bits) | (value << (64u - bits));
+                    }
+
+                    inline std::uint64_t LoadBe64 (const std::uint8_t *bytes) noexcept
+                    {
+                        std::uint64_t value = 0u;
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            value = (value << 8) | bytes[i];
+                        }
+                        return value;
+                    }
+
+                    inline void StoreBe64 (std::uint64_t value, std::uint8_t *bytes) noexcept
+                    {
+                        for (std::size_t i = 0; i < 8u; ++i)
+                        {
+                            bytes[7u - i] = static_cast<std::uint8_t>(value >> (8u * i));
+                        }
+                    }
+                }
+
+                Sha512::Sha512 () noexcept
+                {
+                    Reset();
+                }
+
+                void Sha512::Reset () noexcept
+                {
+                    std::memcpy(mState, kInitialState, sizeof(mState));
+                    std::memset(mBuffer, 0, sizeof(mBuffer));
+                    mLength = 0u;
+                    mBuffered = 0u;
+                }
+
+                void Sha512::Update (const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    mLength += size;
+                    if (mBuffered != 0u)
+                    {
+                        const std::size_t taken = (size < (kBlockSize - mBuffered)) ? size : (kBlockSize - mBuffered);
+                        std::memcpy(mBuffer + mBuffered, data, taken);
+                        mBuffered += taken;
+                        data += taken;
+                        size -= taken;
+                        if (mBuffered < kBlockSize)
+                        {
+                            return;
+                        }
+                        Compress(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+
+                    const std::size_t blockCount = size / kBlockSize;
+                    if (blockCount != 0u)
+                    {
+                        Compress(data, blockCount);
+                        data += blockCount * kBlockSize;
+                        size -= blockCount * kBlockSize;
+                    }
+                    if (size != 0u)
+                    {
+                        std::memcpy(mBuffer, data, size);
+                        mBuffered = size;
+                    }
+                }
+
+                void Sha512::Finish (std::uint8_t *digest) noexcept
+                {
+                    // The length field has 128 bits, the byte counter gives its low 67 bits.
+                    mBuffer[mBuffered++] = 0x80u;
+                    if (mBuffered > (kBlockSize - 16u))
+                    {
+                        std::memset(mBuffer + mBuffered, 0, kBlockSize - mBuffered);
+                        Compress(mBuffer, 1u);
+                        mBuffered = 0u;
+                    }
+                    std::memset(mBuffer + mBuffered, 0, kBlockSize - 16u - mBuffered);
+                    StoreBe64(mLength >> 61, mBuffer + kBlockSize - 16u);
+                    StoreBe64(mLength << 3, mBuffer + kBlockSize - 8u);
+                    Compress(mBuffer, 1u);
+
+                    for (std::size_t i = 0; i < 8u; ++i)
+                    {
+                        StoreBe64(mState[i], digest + 8u * i);
+                    }
+                    Reset();
+                }
+
+                void Sha512::Compute (const std::uint8_t *data, std::size_t size, std::uint8_t *digest) noexcept
+                {
+                    Sha512 hash;
+                    hash.Update(data, size);
+                    hash.Finish(digest);
+                }
+
+                void Sha512::Compress (const std::uint8_t *blocks, std::size_t blockCount) noexcept
+                {
+                    for (; blockCount > 0u; --blockCount, blocks += kBlockSize)
+                    {
+                        std::uint64_t w[80];
+                        for (std::size_t i = 0; i < 16u; ++i)
+                        {
+                            w[i] = LoadBe64(blocks + 8u * i);
+                        }
+                        for (std::size_t i = 16; i < 80u; ++i)
+                        {
+                            const std::uint64_t s0 = RotateRight(w[i - 15u], 1u) ^ RotateRight(w[i - 15u], 8u) ^ (w[i - 15u] >> 7);
+                            const std::uint64_t s1 = RotateRight(w[i - 2u], 19u) ^ RotateRight(w[i - 2u], 61u) ^ (w[i - 2u] >> 6);
+                            w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+                        }
+
+                        std::uint64_t a = mState[0];
+                        std::uint64_t b = mState[1];
+                        std::uint64_t c = mState[2];
+                        std::uint64_t d = mState[3];
+                        std::uint64_t e = mState[4];
+                        std::uint64_t f = mState[5];
+                        std::uint64_t g = mState[6];
+                        std::uint64_t h = mState[7];
+                        for (std::size_t i = 0; i < 80u; ++i)
+                        {
+                            const std::uint64_t s1 = RotateRight(e, 14u) ^ RotateRight(e, 18u) ^ RotateRight(e, 41u);
+                            const std::uint64_t choice = (e & f) ^ (~e & g);
+                            const std::uint64_t temp1 = h + s1 + choice + kRoundConstants[i] + w[i];
+                            const std::uint64_t s0 = RotateRight(a, 28u) ^ RotateRight(a, 34u) ^ RotateRight(a, 39u);
+                            const std::uint64_t majority = (a & b) ^ (a & c) ^ (b & c);
+                            const std::uint64_t temp2 = s0 + majority;
+                            h = g;
+                            g = f;
+                            f = e;
+                            e = d + temp1;
+                            d = c;
+                            c = b;
+                            b = a;
+                            a = temp1 + temp2;
+                        }
+                        mState[0] += a;
+                        mState[1] += b;
+                        mState[2] += c;
+                        mState[3] += d;
+                        mState[4] += e;
+                        mState[5] += f;
+                        mState[6] += g;
+                        mState[7] += h;
+                    }
+                }
+            }
+        }
+    }
+}
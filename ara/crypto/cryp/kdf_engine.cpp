@@ -0,0 +1,96 @@
+#include "ara/crypto/cryp/kdf_engine.h"
+
+#include <algorithm>
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // Labels passed to HmacKdf::DeriveBatch() at once, collected on the stack.
+                const std::size_t kBatchSize = 16u;
+            }
+
+            KdfEngine::KdfEngine (CryptoAlgId algId) noexcept : mKdf(algId)
+            {
+            }
+
+            KdfEngine::~KdfEngine () noexcept
+            {
+                mKdf.Clear();
+            }
+
+            ara::core::Result<void> KdfEngine::SetSourceKeyMaterial (ReadOnlyMemRegion keyMaterial, ReadOnlyMemRegion salt) noexcept
+            {
+                if (!mKdf.IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if ((salt.size() != 0u) && (mKdf.GetAlgId() != kAlgIdHkdfSha2_256))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                mKdf.SetSourceKeyMaterial(keyMaterial.data(), keyMaterial.size(), salt.data(), salt.size());
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> KdfEngine::DeriveKey (ReadOnlyMemRegion targetKeyId, ReadOnlyMemRegion ctxLabel, ReadWriteMemRegion key) const noexcept
+            {
+                if (!mKdf.IsKeySet())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if ((key.size() == 0u) || !mKdf.Derive(ctxLabel.data(), ctxLabel.size(), targetKeyId.data(), targetKeyId.size(), key.data(), key.size()))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> KdfEngine::DeriveKeys (ReadOnlyMemRegion targetKeyId, ara::core::Span<const ReadOnlyMemRegion> ctxLabels, ReadWriteMemRegion keys, std::size_t keySize) const noexcept
+            {
+                if (!mKdf.IsKeySet())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (keySize == 0u)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                if (keys.size() / keySize < ctxLabels.size())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                internal::HmacKdf::Label labels[kBatchSize];
+                std::uint8_t *out = keys.data();
+                for (std::size_t first = 0; first < ctxLabels.size(); first += kBatchSize)
+                {
+                    const std::size_t count = std::min(kBatchSize, ctxLabels.size() - first);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        labels[i].mData = ctxLabels[first + i].data();
+                        labels[i].mSize = ctxLabels[first + i].size();
+                    }
+                    if (!mKdf.DeriveBatch(labels, count, targetKeyId.data(), targetKeyId.size(), out, keySize))
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    out += count * keySize;
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void KdfEngine::Reset () noexcept
+            {
+                mKdf.Clear();
+            }
+        }
+    }
+}
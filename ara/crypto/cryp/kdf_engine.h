@@ -0,0 +1,139 @@
+#ifndef ARA_CRYPTO_CRYP_KDF_ENGINE_H
+#define ARA_CRYPTO_CRYP_KDF_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/hmac_kdf.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Key derivation engine with the operations of KeyDerivationFunctionCtx over raw key-material:
+             * HKDF (RFC 5869), the KDF in counter mode (NIST SP 800-108) and PBKDF2 (RFC 8018), all over
+             * HMAC/SHA2-256 (see internal::HmacKdf). SetSourceKeyMaterial() keys the HMAC once, so each
+             * derived key costs only the compressions of its own label and target key ID, and DeriveKeys()
+             * derives a whole batch of session keys without an allocation. The context label is the label of
+             * the derivation and the target key ID its context. A KeyDerivationFunctionCtx would take the
+             * key-material from a RestrictedUseObject and return key objects, neither of which this tree
+             * implements, so the engine is used on raw buffers. Derivations do not modify the engine and may
+             * run concurrently.
+             */
+            class KdfEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Kdf Engine object.
+                 * @param[in] algId kAlgIdHkdfSha2_256, kAlgIdKdfCtrHmacSha2_256 or kAlgIdPbkdf2HmacSha2_256
+                 */
+                explicit KdfEngine (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Destroy the Kdf Engine object wiping the keyed state.
+                 */
+                ~KdfEngine () noexcept;
+
+                KdfEngine (const KdfEngine &) = delete;
+                KdfEngine& operator= (const KdfEngine &) = delete;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept
+                {
+                    return mKdf.IsSupported();
+                }
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mKdf.GetAlgId();
+                }
+
+                /**
+                 * @brief Configure the number of iterations (as KeyDerivationFunctionCtx::ConfigIterations()).
+                 * Only PBKDF2 is iterated, the other functions always use 1.
+                 * @param[in] iterations the required number of iterations (0 means the default of 10000)
+                 * @return std::uint32_t the configured number of iterations
+                 */
+                std::uint32_t ConfigIterations (std::uint32_t iterations=0) noexcept
+                {
+                    return mKdf.ConfigIterations(iterations);
+                }
+
+                /**
+                 * @brief Deploy the source key-material and compute the keyed HMAC state.
+                 * @param[in] keyMaterial the HKDF input keying material, the SP 800-108 key derivation key or the
+                 * PBKDF2 password
+                 * @param[in] salt an optional HKDF extraction salt (must be empty for the other functions)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidArgument if a salt is passed to another function than HKDF
+                 */
+                ara::core::Result<void> SetSourceKeyMaterial (ReadOnlyMemRegion keyMaterial, ReadOnlyMemRegion salt=ReadOnlyMemRegion()) noexcept;
+
+                /**
+                 * @brief Check if the source key-material is deployed.
+                 * @return true if SetSourceKeyMaterial() succeeded and Reset() was not called since
+                 */
+                bool IsKeySet () const noexcept
+                {
+                    return mKdf.IsKeySet();
+                }
+
+                /**
+                 * @brief Derive one key into a caller provided buffer.
+                 * @param[in] targetKeyId ID of the target key
+                 * @param[in] ctxLabel the context label of the derivation
+                 * @param[out] key the derived key, its size is the size of the key
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key-material is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the key is empty or longer than the function
+                 * can derive (8160 bytes for HKDF)
+                 */
+                ara::core::Result<void> DeriveKey (ReadOnlyMemRegion targetKeyId, ReadOnlyMemRegion ctxLabel, ReadWriteMemRegion key) const noexcept;
+
+                /**
+                 * @brief Derive a batch of keys of the same size and target key ID, one per context label (as
+                 * KeyDerivationFunctionCtx::DeriveKeys()).
+                 * @param[in] targetKeyId ID of the target keys
+                 * @param[in] ctxLabels the context labels (one per derived key)
+                 * @param[out] keys the derived keys, stored one after another in the order of the labels
+                 * @param[in] keySize size of every derived key in bytes
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key-material is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the key size is zero or longer than the
+                 * function can derive
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the keys buffer is smaller than
+                 * ctxLabels.size() * keySize bytes
+                 */
+                ara::core::Result<void> DeriveKeys (ReadOnlyMemRegion targetKeyId, ara::core::Span<const ReadOnlyMemRegion> ctxLabels, ReadWriteMemRegion keys, std::size_t keySize) const noexcept;
+
+                /**
+                 * @brief Wipe the keyed state (as KeyDerivationFunctionCtx::Reset()), the configured iterations
+                 * are kept.
+                 */
+                void Reset () noexcept;
+
+            private:
+                internal::HmacKdf mKdf;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_KDF_ENGINE_H
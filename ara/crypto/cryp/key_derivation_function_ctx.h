@@ -1,6 +1,14 @@
 #ifndef ARA_CRYPTO_CRYP_KEY_DERIVATION_FUNCTION_CTX_H
 #define ARA_CRYPTO_CRYP_KEY_DERIVATION_FUNCTION_CTX_H
 
+#include <new>
+
+#include "ara/core/span.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
 
 namespace ara
@@ -131,6 +139,53 @@ namespace ara
                  * @exception CryptoErrorDomain::kBruteForceRisk if key length of the sourceKm is below of an internally defined limitation
                  */
                 virtual ara::core::Result<void> SetSourceKeyMaterial (const RestrictedUseObject &sourceKM) noexcept=0;
+
+                /**
+                 * @brief Derive a batch of symmetric keys from the deployed key-material, one per context label,
+                 * sharing the target key ID and the target configuration (e.g. the encryption, MAC and IV keys of
+                 * both directions of a session). The default implementation calls Init() and DeriveKey() for every
+                 * label; an implementation caching the keyed state of the source key-material (like KdfEngine) may
+                 * override it to skip the reconfiguration. After the call the context is initialized with the last label.
+                 * @param[in] targetKeyId ID of the target keys
+                 * @param[in] ctxLabels the context labels (one per derived key)
+                 * @param[in] targetAlgId the identifier of the target symmetric crypto algorithm
+                 * @param[in] allowedUsage bit-flags that define a list of allowed transformations' types in which the target keys may be used
+                 * @param[in] isSession the "session" (or "temporary") attribute for the target keys (if true)
+                 * @param[in] isExportable the exportability attribute for the target keys (if true)
+                 * @return ara::core::Result<ara::core::Vector<SymmetricKey::Uptrc> > the derived keys in the order of the labels
+                 * @exception CryptoErrorDomain::kUninitializedContext if the key-material was not deployed
+                 * @exception CryptoErrorDomain::kIncompatibleArguments if targetAlgId specifies a cryptographic algorithm different from a symmetric one with key length equal to GetTargetKeyBitLength()
+                 * @exception CryptoErrorDomain::kUsageViolation if allowedUsage specifies more usages than the source key-material allows
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result cannot be allocated
+                 */
+                virtual ara::core::Result<ara::core::Vector<SymmetricKey::Uptrc> > DeriveKeys (ReadOnlyMemRegion targetKeyId, ara::core::Span<const ReadOnlyMemRegion> ctxLabels, AlgId targetAlgId=kAlgIdAny, AllowedUsageFlags allowedUsage=kAllowKdfMaterialAnyUsage, bool isSession=true, bool isExportable=false) noexcept
+                {
+                    ara::core::Vector<SymmetricKey::Uptrc> keys;
+                    try
+                    {
+                        // The keys are appended within the reserved capacity, so push_back() below cannot throw.
+                        keys.reserve(ctxLabels.size());
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return ara::core::Result<ara::core::Vector<SymmetricKey::Uptrc> >::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                    }
+                    for (const ReadOnlyMemRegion &ctxLabel : ctxLabels)
+                    {
+                        ara::core::Result<void> initialized = Init(targetKeyId, targetAlgId, allowedUsage, ctxLabel);
+                        if (!initialized.HasValue())
+                        {
+                            return ara::core::Result<ara::core::Vector<SymmetricKey::Uptrc> >::FromError(initialized.Error());
+                        }
+                        ara::core::Result<SymmetricKey::Uptrc> key = DeriveKey(isSession, isExportable);
+                        if (!key.HasValue())
+                        {
+                            return ara::core::Result<ara::core::Vector<SymmetricKey::Uptrc> >::FromError(key.Error());
+                        }
+                        keys.push_back(std::move(key).Value());
+                    }
+                    return ara::core::Result<ara::core::Vector<SymmetricKey::Uptrc> >::FromValue(std::move(keys));
+                }
             };
         }
     }
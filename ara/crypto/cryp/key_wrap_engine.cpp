@@ -0,0 +1,204 @@
+#include "ara/crypto/cryp/key_wrap_engine.h"
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // The KWP message length indicator has 32 bits, KW keys are limited the same way.
+                const std::size_t kMaxKeySize = 0xffffffffu;
+
+                bool IsPaddedAlgorithm (CryptoAlgId algId) noexcept
+                {
+                    return (algId == kAlgIdAes128Kwp) || (algId == kAlgIdAes256Kwp);
+                }
+            }
+
+            KeyWrapEngine::KeyWrapEngine (CryptoAlgId algId) noexcept :
+                mAlgId(algId),
+                mKeyWrap(IsPaddedAlgorithm(algId))
+            {
+            }
+
+            bool KeyWrapEngine::IsSupported () const noexcept
+            {
+                return GetKekSize() != 0u;
+            }
+
+            std::size_t KeyWrapEngine::CalculateWrappedKeySize (std::size_t keyLength) const noexcept
+            {
+                if (((keyLength % 8u) != 0u) || (keyLength / 8u > kMaxKeySize))
+                {
+                    return 0u;
+                }
+                return mKeyWrap.GetWrappedSize(keyLength / 8u);
+            }
+
+            std::size_t KeyWrapEngine::GetMaxTargetKeyLength () const noexcept
+            {
+                const std::size_t granularity = GetTargetKeyGranularity();
+                return (kMaxKeySize / granularity) * granularity * 8u;
+            }
+
+            ara::core::Result<void> KeyWrapEngine::SetKey (ReadOnlyMemRegion kek) noexcept
+            {
+                const std::size_t kekSize = GetKekSize();
+                if (kekSize == 0u)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if ((kek.size() != kekSize) || !mKeyWrap.SetKey(kek.data(), kek.size()))
+                {
+                    mKeyWrap.Clear();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<std::size_t> KeyWrapEngine::Wrap (ReadOnlyMemRegion key, ReadWriteMemRegion wrappedKey) const noexcept
+            {
+                if (!mKeyWrap.IsKeySet())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                const std::size_t wrappedSize = mKeyWrap.GetWrappedSize(key.size());
+                if (wrappedSize == 0u)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                if (wrappedKey.size() < wrappedSize)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                mKeyWrap.Wrap(key.data(), key.size(), wrappedKey.data());
+                return ara::core::Result<std::size_t>::FromValue(wrappedSize);
+            }
+
+            ara::core::Result<std::size_t> KeyWrapEngine::Unwrap (ReadOnlyMemRegion wrappedKey, ReadWriteMemRegion key) const noexcept
+            {
+                std::size_t keySize = 0u;
+                ara::core::Result<void> result = UnwrapBatch(
+                    ara::core::Span<const ReadOnlyMemRegion>(&wrappedKey, 1u),
+                    ara::core::Span<const ReadWriteMemRegion>(&key, 1u),
+                    ara::core::Span<std::size_t>(&keySize, 1u));
+                if (!result.HasValue())
+                {
+                    return ara::core::Result<std::size_t>::FromError(result.Error());
+                }
+                return ara::core::Result<std::size_t>::FromValue(keySize);
+            }
+
+            ara::core::Result<void> KeyWrapEngine::WrapBatch (ara::core::Span<const ReadOnlyMemRegion> keys, ara::core::Span<const ReadWriteMemRegion> wrappedKeys) const noexcept
+            {
+                if (!mKeyWrap.IsKeySet())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (keys.size() != wrappedKeys.size())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                {
+                    const std::size_t wrappedSize = mKeyWrap.GetWrappedSize(keys[i].size());
+                    if (wrappedSize == 0u)
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    if (wrappedKeys[i].size() < wrappedSize)
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                    }
+                }
+
+                internal::KeyWrap::Item items[internal::KeyWrap::kLanes];
+                for (std::size_t first = 0; first < keys.size(); first += internal::KeyWrap::kLanes)
+                {
+                    const std::size_t remaining = keys.size() - first;
+                    const std::size_t count = (remaining < internal::KeyWrap::kLanes) ? remaining : internal::KeyWrap::kLanes;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        items[i] = {keys[first + i].data(), keys[first + i].size(), wrappedKeys[first + i].data(), 0u};
+                    }
+                    mKeyWrap.WrapBatch(items, count);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> KeyWrapEngine::UnwrapBatch (ara::core::Span<const ReadOnlyMemRegion> wrappedKeys, ara::core::Span<const ReadWriteMemRegion> keys, ara::core::Span<std::size_t> keySizes) const noexcept
+            {
+                if (!mKeyWrap.IsKeySet())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if ((wrappedKeys.size() != keys.size()) || (wrappedKeys.size() != keySizes.size()))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                const std::size_t minSize = (mKeyWrap.IsPadded() ? 2u : 3u) * internal::KeyWrap::kSemiblockSize;
+                for (std::size_t i = 0; i < wrappedKeys.size(); ++i)
+                {
+                    const std::size_t size = wrappedKeys[i].size();
+                    if ((size < minSize) || ((size % internal::KeyWrap::kSemiblockSize) != 0u))
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    if (keys[i].size() < size - internal::KeyWrap::kSemiblockSize)
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                    }
+                }
+
+                bool authentic = true;
+                internal::KeyWrap::Item items[internal::KeyWrap::kLanes];
+                for (std::size_t first = 0; first < wrappedKeys.size(); first += internal::KeyWrap::kLanes)
+                {
+                    const std::size_t remaining = wrappedKeys.size() - first;
+                    const std::size_t count = (remaining < internal::KeyWrap::kLanes) ? remaining : internal::KeyWrap::kLanes;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        items[i] = {wrappedKeys[first + i].data(), wrappedKeys[first + i].size(), keys[first + i].data(), 0u};
+                    }
+                    authentic = mKeyWrap.UnwrapBatch(items, count) && authentic;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        keySizes[first + i] = items[i].mOutSize;
+                    }
+                }
+
+                if (!authentic)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAuthTagNotValid);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void KeyWrapEngine::Clear () noexcept
+            {
+                mKeyWrap.Clear();
+            }
+
+            std::size_t KeyWrapEngine::GetKekSize () const noexcept
+            {
+                switch (mAlgId)
+                {
+                case kAlgIdAes128Kw:
+                case kAlgIdAes128Kwp:
+                    return 16u;
+                case kAlgIdAes256Kw:
+                case kAlgIdAes256Kwp:
+                    return 32u;
+                default:
+                    return 0u;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef ARA_CRYPTO_CRYP_KEY_WRAP_ENGINE_H
+#define ARA_CRYPTO_CRYP_KEY_WRAP_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/key_wrap.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Key wrap engine for the symmetric key wrapper contexts: AES-KW (RFC 3394) and AES-KWP
+             * (RFC 5649) over the accelerated AES core. The key encryption key is scheduled once by SetKey(); the
+             * batch methods wrap or unwrap many keys under it in lockstep (see internal::KeyWrap), which is the
+             * shape of a key provisioning step exporting hundreds of keys. A keyed engine is not modified by the
+             * wrap and unwrap methods, so it may be used concurrently. With no SymmetricKeyWrapperCtx implementation
+             * to override WrapKeyMaterials() and UnwrapKeys() by it, the engine works on raw key bytes.
+             */
+            class KeyWrapEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Key Wrap Engine object.
+                 * @param[in] algId kAlgIdAes128Kw, kAlgIdAes256Kw, kAlgIdAes128Kwp or kAlgIdAes256Kwp
+                 */
+                explicit KeyWrapEngine (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept;
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Check if the key encryption key is deployed.
+                 * @return true if SetKey() succeeded and Clear() was not called since
+                 */
+                bool IsKeySet () const noexcept
+                {
+                    return mKeyWrap.IsKeySet();
+                }
+
+                /**
+                 * @brief Calculate size of the wrapped key in bytes from original key length in bits.
+                 * @param[in] keyLength original key length in bits
+                 * @return std::size_t size of the wrapped key in bytes, 0 if the length is not supported
+                 */
+                std::size_t CalculateWrappedKeySize (std::size_t keyLength) const noexcept;
+
+                /**
+                 * @brief Get maximum length of the target key.
+                 * @return std::size_t maximum length of the target key in bits
+                 */
+                std::size_t GetMaxTargetKeyLength () const noexcept;
+
+                /**
+                 * @brief Get expected granularity of the target key: 8 for KW, 1 for KWP.
+                 * @return std::size_t size of the block in bytes
+                 */
+                std::size_t GetTargetKeyGranularity () const noexcept
+                {
+                    return mKeyWrap.IsPadded() ? 1u : internal::KeyWrap::kSemiblockSize;
+                }
+
+                /**
+                 * @brief Deploy the key encryption key.
+                 * @param[in] kek the key encryption key (16 or 32 bytes according to the algorithm)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the key size does not match the algorithm
+                 */
+                ara::core::Result<void> SetKey (ReadOnlyMemRegion kek) noexcept;
+
+                /**
+                 * @brief Wrap a key.
+                 * @param[in] key the key material
+                 * @param[out] wrappedKey the buffer for the wrapped key of CalculateWrappedKeySize() bytes
+                 * @return ara::core::Result<std::size_t> size of the wrapped key
+                 * @exception CryptoErrorDomain::kUninitializedContext if the key encryption key is not deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the key size is not supported
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the buffer is too small
+                 */
+                ara::core::Result<std::size_t> Wrap (ReadOnlyMemRegion key, ReadWriteMemRegion wrappedKey) const noexcept;
+
+                /**
+                 * @brief Unwrap and authenticate a key.
+                 * @param[in] wrappedKey the wrapped key
+                 * @param[out] key the buffer for the key of (wrappedKey.size() - 8) bytes
+                 * @return ara::core::Result<std::size_t> size of the key
+                 * @exception CryptoErrorDomain::kUninitializedContext if the key encryption key is not deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the size of the wrapped key is invalid
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the buffer is too small
+                 * @exception CryptoErrorDomain::kAuthTagNotValid if the integrity check failed
+                 */
+                ara::core::Result<std::size_t> Unwrap (ReadOnlyMemRegion wrappedKey, ReadWriteMemRegion key) const noexcept;
+
+                /**
+                 * @brief Wrap a batch of keys under the deployed key encryption key.
+                 * @param[in] keys the key materials
+                 * @param[out] wrappedKeys the buffers for the wrapped keys (one per key)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if the key encryption key is not deployed
+                 * @exception CryptoErrorDomain::kInvalidArgument if the numbers of keys and buffers differ
+                 * @exception CryptoErrorDomain::kInvalidInputSize if a key size is not supported
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if a buffer is too small
+                 */
+                ara::core::Result<void> WrapBatch (ara::core::Span<const ReadOnlyMemRegion> keys, ara::core::Span<const ReadWriteMemRegion> wrappedKeys) const noexcept;
+
+                /**
+                 * @brief Unwrap and authenticate a batch of keys. All keys are processed even if some of them fail
+                 * the integrity check; the buffer of a failed key is wiped and its size is set to 0.
+                 * @param[in] wrappedKeys the wrapped keys
+                 * @param[out] keys the buffers for the keys (one per wrapped key)
+                 * @param[out] keySizes the sizes of the unwrapped keys (one per wrapped key)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if the key encryption key is not deployed
+                 * @exception CryptoErrorDomain::kInvalidArgument if the numbers of wrapped keys, buffers and sizes differ
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the size of a wrapped key is invalid
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if a buffer is too small
+                 * @exception CryptoErrorDomain::kAuthTagNotValid if the integrity check of a key failed
+                 */
+                ara::core::Result<void> UnwrapBatch (ara::core::Span<const ReadOnlyMemRegion> wrappedKeys, ara::core::Span<const ReadWriteMemRegion> keys, ara::core::Span<std::size_t> keySizes) const noexcept;
+
+                /**
+                 * @brief Wipe the key encryption key.
+                 */
+                void Clear () noexcept;
+
+            private:
+                std::size_t GetKekSize () const noexcept;
+
+                CryptoAlgId mAlgId;
+                internal::KeyWrap mKeyWrap;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_KEY_WRAP_ENGINE_H
@@ -0,0 +1,341 @@
+#include "ara/crypto/cryp/mac_engine.h"
+
+#include <new>
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/cmac.h"
+#include "ara/crypto/cryp/internal/constant_time.h"
+#include "ara/crypto/cryp/internal/gmac.h"
+#include "ara/crypto/cryp/internal/hmac.h"
+#include "ara/crypto/cryp/internal/poly1305.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+#include "ara/crypto/cryp/internal/sha512.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            class MacEngine::Kernel
+            {
+            public:
+                virtual ~Kernel () noexcept=default;
+
+                virtual bool SetKey (const std::uint8_t *key, std::size_t keySize) noexcept=0;
+
+                virtual bool Start (const std::uint8_t *iv, std::size_t ivSize) noexcept=0;
+
+                virtual void Update (const std::uint8_t *data, std::size_t size) noexcept=0;
+
+                virtual void Finish (std::uint8_t *mac) noexcept=0;
+
+                virtual void Clear () noexcept=0;
+
+                virtual std::unique_ptr<Kernel> Clone () const noexcept=0;
+            };
+
+            namespace
+            {
+                const std::size_t kMaxDigestSize = internal::Sha512::kDigestSize;
+
+                void Wipe (void *data, std::size_t size) noexcept
+                {
+                    volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        bytes[i] = 0u;
+                    }
+                }
+
+                // Key deployment and restart of the particular MAC functions.
+                template <class Hash>
+                bool Deploy (internal::Hmac<Hash> &mac, const std::uint8_t *key, std::size_t keySize, std::size_t) noexcept
+                {
+                    mac.SetKey(key, keySize);
+                    return true;
+                }
+
+                bool Deploy (internal::Cmac &mac, const std::uint8_t *key, std::size_t keySize, std::size_t requiredSize) noexcept
+                {
+                    return (keySize == requiredSize) && mac.SetKey(key, keySize);
+                }
+
+                bool Deploy (internal::Gmac &mac, const std::uint8_t *key, std::size_t keySize, std::size_t requiredSize) noexcept
+                {
+                    return (keySize == requiredSize) && mac.SetKey(key, keySize);
+                }
+
+                bool Deploy (internal::Poly1305 &mac, const std::uint8_t *key, std::size_t keySize, std::size_t) noexcept
+                {
+                    if (keySize != internal::Poly1305::kKeySize)
+                    {
+                        return false;
+                    }
+                    mac.SetKey(key);
+                    return true;
+                }
+
+                template <class Mac>
+                bool Restart (Mac &mac, const std::uint8_t *, std::size_t ivSize) noexcept
+                {
+                    if (ivSize != 0u)
+                    {
+                        return false;
+                    }
+                    mac.Start();
+                    return true;
+                }
+
+                bool Restart (internal::Gmac &mac, const std::uint8_t *iv, std::size_t ivSize) noexcept
+                {
+                    return mac.Start(iv, ivSize);
+                }
+
+                template <class Mac>
+                class KernelOf final : public MacEngine::Kernel
+                {
+                public:
+                    explicit KernelOf (std::size_t keySize=0u) noexcept : mKeySize(keySize)
+                    {
+                    }
+
+                    bool SetKey (const std::uint8_t *key, std::size_t keySize) noexcept override
+                    {
+                        return Deploy(mMac, key, keySize, mKeySize);
+                    }
+
+                    bool Start (const std::uint8_t *iv, std::size_t ivSize) noexcept override
+                    {
+                        return Restart(mMac, iv, ivSize);
+                    }
+
+                    void Update (const std::uint8_t *data, std::size_t size) noexcept override
+                    {
+                        mMac.Update(data, size);
+                    }
+
+                    void Finish (std::uint8_t *mac) noexcept override
+                    {
+                        mMac.Finish(mac);
+                    }
+
+                    void Clear () noexcept override
+                    {
+                        mMac.Clear();
+                    }
+
+                    std::unique_ptr<MacEngine::Kernel> Clone () const noexcept override
+                    {
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<Mac>(*this));
+                    }
+
+                private:
+                    Mac mMac;
+                    std::size_t mKeySize;   // the required key size of the AES based functions
+                };
+
+                // A Poly1305 key must not authenticate two messages, so it is neither restarted nor copied.
+                bool IsOneTimeKey (CryptoAlgId algId) noexcept
+                {
+                    return algId == kAlgIdPoly1305;
+                }
+
+                std::unique_ptr<MacEngine::Kernel> MakeKernel (CryptoAlgId algId) noexcept
+                {
+                    switch (algId)
+                    {
+                    case kAlgIdHmacSha2_256:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Hmac<internal::Sha256> >());
+                    case kAlgIdHmacSha2_512:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Hmac<internal::Sha512> >());
+                    case kAlgIdCmacAes128:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Cmac>(16u));
+                    case kAlgIdCmacAes256:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Cmac>(32u));
+                    case kAlgIdGmacAes128:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Gmac>(16u));
+                    case kAlgIdGmacAes256:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Gmac>(32u));
+                    case kAlgIdPoly1305:
+                        return std::unique_ptr<MacEngine::Kernel>(new (std::nothrow) KernelOf<internal::Poly1305>());
+                    default:
+                        return nullptr;
+                    }
+                }
+            }
+
+            MacEngine::MacEngine (CryptoAlgId algId) noexcept :
+                mAlgId(algId),
+                mKernel(MakeKernel(algId)),
+                mKeySet(false),
+                mStarted(false),
+                mKeyUsed(false)
+            {
+            }
+
+            MacEngine::~MacEngine () noexcept
+            {
+                Clear();
+            }
+
+            MacEngine::MacEngine (const MacEngine &other) noexcept :
+                mAlgId(other.mAlgId),
+                mKernel(IsOneTimeKey(other.mAlgId) ? MakeKernel(other.mAlgId) : (other.mKernel ? other.mKernel->Clone() : nullptr)),
+                mKeySet(other.mKeySet && mKernel && !IsOneTimeKey(other.mAlgId)),
+                mStarted(other.mStarted && mKeySet),
+                mKeyUsed(false)
+            {
+            }
+
+            MacEngine& MacEngine::operator= (const MacEngine &other) noexcept
+            {
+                if (this != &other)
+                {
+                    Clear();
+                    mAlgId = other.mAlgId;
+                    mKernel = IsOneTimeKey(mAlgId) ? MakeKernel(mAlgId) : (other.mKernel ? other.mKernel->Clone() : nullptr);
+                    mKeySet = other.mKeySet && mKernel && !IsOneTimeKey(mAlgId);
+                    mStarted = other.mStarted && mKeySet;
+                    mKeyUsed = false;
+                }
+                return *this;
+            }
+
+            bool MacEngine::IsSupported () const noexcept
+            {
+                return static_cast<bool>(mKernel);
+            }
+
+            std::size_t MacEngine::GetDigestSize () const noexcept
+            {
+                switch (mAlgId)
+                {
+                case kAlgIdHmacSha2_256:
+                    return internal::Sha256::kDigestSize;
+                case kAlgIdHmacSha2_512:
+                    return internal::Sha512::kDigestSize;
+                case kAlgIdCmacAes128:
+                case kAlgIdCmacAes256:
+                    return internal::Cmac::kDigestSize;
+                case kAlgIdGmacAes128:
+                case kAlgIdGmacAes256:
+                    return internal::Gmac::kDigestSize;
+                case kAlgIdPoly1305:
+                    return internal::Poly1305::kDigestSize;
+                default:
+                    return 0u;
+                }
+            }
+
+            ara::core::Result<void> MacEngine::SetKey (ReadOnlyMemRegion key) noexcept
+            {
+                if (!mKernel)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                mKeySet = false;
+                mStarted = false;
+                mKeyUsed = false;
+                if (!mKernel->SetKey(key.data(), key.size()))
+                {
+                    mKernel->Clear();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                mKeySet = true;
+                mStarted = (mAlgId != kAlgIdGmacAes128) && (mAlgId != kAlgIdGmacAes256);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> MacEngine::Start (ReadOnlyMemRegion iv) noexcept
+            {
+                if (!mKeySet)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (mKeyUsed)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUsageViolation);
+                }
+                if (!mKernel->Start(iv.data(), iv.size()))
+                {
+                    mStarted = false;
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                mStarted = true;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> MacEngine::Update (ReadOnlyMemRegion in) noexcept
+            {
+                if (!mStarted)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kProcessingNotStarted);
+                }
+                mKernel->Update(in.data(), in.size());
+                mKeyUsed = IsOneTimeKey(mAlgId);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<std::size_t> MacEngine::Finish (ReadWriteMemRegion mac) noexcept
+            {
+                if (!mStarted)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kProcessingNotStarted);
+                }
+                const std::size_t digestSize = GetDigestSize();
+                if (mac.size() < digestSize)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                std::uint8_t digest[kMaxDigestSize];
+                mKernel->Finish(digest);
+                for (std::size_t i = 0; i < digestSize; ++i)
+                {
+                    mac[i] = digest[i];
+                }
+                Wipe(digest, sizeof(digest));
+                mStarted = false;
+                if (IsOneTimeKey(mAlgId))
+                {
+                    Clear();
+                }
+                return ara::core::Result<std::size_t>::FromValue(digestSize);
+            }
+
+            ara::core::Result<bool> MacEngine::FinishAndCheck (ReadOnlyMemRegion expectedTag) noexcept
+            {
+                if (!mStarted)
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kProcessingNotStarted);
+                }
+
+                std::uint8_t digest[kMaxDigestSize];
+                mKernel->Finish(digest);
+                mStarted = false;
+                const std::size_t digestSize = GetDigestSize();
+                const bool valid = (expectedTag.size() == digestSize) &&
+                    internal::ConstantTimeEqual(digest, expectedTag.data(), digestSize);
+                Wipe(digest, sizeof(digest));
+                if (IsOneTimeKey(mAlgId))
+                {
+                    Clear();
+                }
+                return ara::core::Result<bool>::FromValue(valid);
+            }
+
+            void MacEngine::Clear () noexcept
+            {
+                if (mKernel)
+                {
+                    mKernel->Clear();
+                }
+                mKeySet = false;
+                mStarted = false;
+                mKeyUsed = false;
+            }
+        }
+    }
+}
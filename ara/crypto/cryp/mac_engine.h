@@ -0,0 +1,173 @@
+#ifndef ARA_CRYPTO_CRYP_MAC_ENGINE_H
+#define ARA_CRYPTO_CRYP_MAC_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Streaming MAC engine for the message authentication code contexts: HMAC/SHA2-256,
+             * HMAC/SHA2-512, CMAC/AES, GMAC/AES and Poly1305. SetKey() computes the keyed state once (the
+             * HMAC inner and outer pad states, the AES key schedule and the CMAC subkeys, the GHASH key powers,
+             * the clamped Poly1305 key) and Start() restarts a computation from it, so a keyed engine is
+             * restarted for every message without processing the key again. Copying an engine takes a
+             * snapshot of its keyed and running state. A Poly1305 key authenticates one message only: it is
+             * wiped when its MAC is finished, the computation cannot be restarted once it has processed data,
+             * and a copy does not take the key. The MAC context interface has no implementation here that could
+             * hold the engine, its users call it directly.
+             */
+            class MacEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Mac Engine object.
+                 * @param[in] algId kAlgIdHmacSha2_256, kAlgIdHmacSha2_512, kAlgIdCmacAes128, kAlgIdCmacAes256,
+                 * kAlgIdGmacAes128, kAlgIdGmacAes256 or kAlgIdPoly1305
+                 */
+                explicit MacEngine (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Destroy the Mac Engine object wiping the keyed state.
+                 */
+                ~MacEngine () noexcept;
+
+                /**
+                 * @brief Construct a snapshot of another engine. The snapshot of a Poly1305 engine has no key. If
+                 * the memory for the snapshot cannot be allocated, the engine is not supported (see IsSupported()).
+                 * @param[in] other the engine to copy
+                 */
+                MacEngine (const MacEngine &other) noexcept;
+
+                /**
+                 * @brief Replace the state by a snapshot of another engine. The snapshot of a Poly1305 engine has no
+                 * key. If the memory for the snapshot cannot be allocated, the engine is not supported (see
+                 * IsSupported()).
+                 * @param[in] other the engine to copy
+                 * @return MacEngine& this engine
+                 */
+                MacEngine& operator= (const MacEngine &other) noexcept;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported (and the memory for its
+                 * state was allocated).
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept;
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Get the size of the MAC in bytes.
+                 * @return std::size_t
+                 */
+                std::size_t GetDigestSize () const noexcept;
+
+                /**
+                 * @brief Check if a key is deployed.
+                 * @return true if SetKey() succeeded and Clear() was not called since
+                 */
+                bool IsKeySet () const noexcept
+                {
+                    return mKeySet;
+                }
+
+                /**
+                 * @brief Check if a computation is started.
+                 * @return true if Start() succeeded and Finish() was not called since
+                 */
+                bool IsStarted () const noexcept
+                {
+                    return mStarted;
+                }
+
+                /**
+                 * @brief Deploy a key. The HMAC, CMAC and Poly1305 computations are started implicitly, GMAC needs
+                 * an IV passed to Start().
+                 * @param[in] key the key value
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the key size is invalid for the algorithm
+                 */
+                ara::core::Result<void> SetKey (ReadOnlyMemRegion key) noexcept;
+
+                /**
+                 * @brief Start a new computation from the keyed state. A Poly1305 computation can only be started
+                 * again before it has processed any data, a new message needs a new key.
+                 * @param[in] iv the IV of GMAC (must be empty for the other algorithms)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is deployed (also after a Poly1305
+                 * MAC is finished)
+                 * @exception CryptoErrorDomain::kUsageViolation if the Poly1305 key has already processed data
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the IV size is invalid for the algorithm
+                 */
+                ara::core::Result<void> Start (ReadOnlyMemRegion iv=ReadOnlyMemRegion()) noexcept;
+
+                /**
+                 * @brief Authenticate a portion of the message.
+                 * @param[in] in the message portion
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kProcessingNotStarted if no computation is started
+                 */
+                ara::core::Result<void> Update (ReadOnlyMemRegion in) noexcept;
+
+                /**
+                 * @brief Finish the computation and write the MAC into a caller provided buffer. A Poly1305 key is
+                 * wiped.
+                 * @param[out] mac the buffer for the MAC of at least GetDigestSize() bytes
+                 * @return ara::core::Result<std::size_t> size of the MAC stored to the buffer
+                 * @exception CryptoErrorDomain::kProcessingNotStarted if no computation is started
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the buffer is too small
+                 */
+                ara::core::Result<std::size_t> Finish (ReadWriteMemRegion mac) noexcept;
+
+                /**
+                 * @brief Finish the computation and compare the MAC against an expected tag in constant time. The
+                 * calculated MAC never leaves the engine. A Poly1305 key is wiped.
+                 * @param[in] expectedTag the expected MAC of GetDigestSize() bytes
+                 * @return ara::core::Result<bool> true if the expected tag is identical to the calculated MAC, but
+                 * false otherwise (also if the sizes differ)
+                 * @exception CryptoErrorDomain::kProcessingNotStarted if no computation is started
+                 */
+                ara::core::Result<bool> FinishAndCheck (ReadOnlyMemRegion expectedTag) noexcept;
+
+                /**
+                 * @brief Wipe the keyed and the running state.
+                 */
+                void Clear () noexcept;
+
+                /**
+                 * @brief Keyed MAC function of one algorithm.
+                 */
+                class Kernel;
+
+            private:
+                CryptoAlgId mAlgId;
+                std::unique_ptr<Kernel> mKernel;
+                bool mKeySet;
+                bool mStarted;
+                bool mKeyUsed;      // the one-time Poly1305 key has processed data
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_MAC_ENGINE_H
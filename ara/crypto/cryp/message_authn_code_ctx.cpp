@@ -0,0 +1,35 @@
+#include "ara/crypto/cryp/message_authn_code_ctx.h"
+
+#include <algorithm>
+
+#include "ara/crypto/cryp/internal/digest_check.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            ara::core::Result<bool> MessageAuthnCodeCtx::Check (ReadOnlyMemRegion expectedTag) const noexcept
+            {
+                return internal::CheckDigest(*this, expectedTag);
+            }
+
+            ara::core::Result<std::size_t> MessageAuthnCodeCtx::GetDigest (ReadWriteMemRegion output, std::size_t offset) const noexcept
+            {
+                ara::core::Result<ara::core::Vector<ara::core::Byte> > digest = GetDigest(offset);
+                if (!digest.HasValue())
+                {
+                    return ara::core::Result<std::size_t>::FromError(digest.Error());
+                }
+                const ara::core::Vector<ara::core::Byte> &value = digest.Value();
+                const std::size_t size = std::min(output.size(), value.size());
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    output[i] = static_cast<std::uint8_t>(value[i]);
+                }
+                return ara::core::Result<std::size_t>::FromValue(size);
+            }
+        }
+    }
+}
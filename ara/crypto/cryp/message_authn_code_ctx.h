@@ -1,6 +1,12 @@
 #ifndef ARA_CRYPTO_CRYP_MESSAGE_AUTHN_CODE_CTX_H
 #define ARA_CRYPTO_CRYP_MESSAGE_AUTHN_CODE_CTX_H
 
+#include "ara/core/utility.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
 
 namespace ara
@@ -37,6 +43,37 @@ namespace ara
                  */
                 virtual ara::core::Result<bool> Check (const Signature &expected) const noexcept=0;
 
+                /**
+                 * @brief Check the calculated digest against an expected tag value in constant time, without
+                 * materializing a "signature" object. Entire digest value is kept in the context up to next call
+                 * Start(), therefore it can be verified again. The default implementation copies the digest by
+                 * GetDigest(ReadWriteMemRegion, std::size_t) into a stack buffer piece by piece.
+                 * @param[in] expectedTag the expected digest value
+                 * @return ara::core::Result<bool> true if the expected tag is identical to the calculated digest,
+                 * but false otherwise (also if the sizes differ)
+                 * @exception CryptoErrorDomain::kProcessingNotFinished if the digest calculation was not finished by a call of the Finish() method
+                 */
+                virtual ara::core::Result<bool> Check (ReadOnlyMemRegion expectedTag) const noexcept;
+
+                /**
+                 * @brief Finish the digest calculation and check it against an expected tag value in constant time
+                 * by a single call. This is the receive path of an authenticated message: no "signature" object is
+                 * produced. The default implementation calls Finish() and Check().
+                 * @param[in] expectedTag the expected digest value
+                 * @return ara::core::Result<bool> true if the expected tag is identical to the calculated digest,
+                 * but false otherwise (also if the sizes differ)
+                 * @exception CryptoErrorDomain::kProcessingNotStarted if the digest calculation was not initiated by a call of the Start() method
+                 */
+                virtual ara::core::Result<bool> FinishAndCheck (ReadOnlyMemRegion expectedTag) noexcept
+                {
+                    ara::core::Result<Signature::Uptrc> finished = Finish(false);
+                    if (!finished.HasValue())
+                    {
+                        return ara::core::Result<bool>::FromError(finished.Error());
+                    }
+                    return Check(expectedTag);
+                }
+
                 /**
                  * @brief [SWS_CRYPT_22115]
                  * Finish the digest calculation and optionally produce the "signature" object. Only after call of this
@@ -72,6 +109,20 @@ namespace ara
                  */
                 virtual ara::core::Result<ara::core::Vector<ara::core::Byte> > GetDigest (std::size_t offset=0) const noexcept=0;
 
+                /**
+                 * @brief Copy requested part of calculated digest to a caller provided buffer. If
+                 * (full_digest_size <= offset) then return_size = 0 bytes; else return_size = min(output.size(),
+                 * (full_digest_size - offset)) bytes. The default implementation copies the result of
+                 * GetDigest(offset); an implementation keeping the digest in the context may override it to
+                 * avoid the allocation of a container.
+                 * @param[out] output the output buffer
+                 * @param[in] offset position of the first byte of digest that should be placed to the output buffer
+                 * @return ara::core::Result<std::size_t> number of digest bytes really stored to the output buffer
+                 * @exception CryptoErrorDomain::kProcessingNotFinished if the digest calculation was not finished by a call of the Finish() method
+                 * @exception CryptoErrorDomain::kUsageViolation if the buffered digest belongs to a MAC/HMAC/AE/AEAD context initialized by a key without kAllowSignature permission
+                 */
+                virtual ara::core::Result<std::size_t> GetDigest (ReadWriteMemRegion output, std::size_t offset=0) const noexcept;
+
                 /**
                  * @brief [SWS_CRYPT_22117]
                  * Get requested part of calculated digest to pre-reserved managed container. This method sets
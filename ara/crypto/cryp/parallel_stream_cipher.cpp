@@ -0,0 +1,313 @@
+#include "ara/crypto/cryp/parallel_stream_cipher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <thread>
+
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/crypto_provider.h"
+#include "ara/crypto/cryp/internal/aes_xts.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // Run work(worker) on the caller thread (worker 0) and on workerCount - 1 additional threads.
+                template <typename Work>
+                void RunWorkers (std::size_t workerCount, Work &work) noexcept
+                {
+                    ara::core::Vector<std::thread> threads;
+                    try
+                    {
+                        threads.reserve(workerCount - 1);
+                        for (std::size_t t = 1; t < workerCount; ++t)
+                        {
+                            threads.emplace_back(work, t);
+                        }
+                    }
+                    catch (const std::exception &)
+                    {
+                        // Not started workers are not required: the remaining chunks are taken by the caller thread.
+                    }
+                    work(0u);
+                    for (std::thread &thread : threads)
+                    {
+                        thread.join();
+                    }
+                }
+            }
+
+            ParallelStreamCipher::ParallelStreamCipher (Factory factory, std::size_t chunkSize, std::size_t maxThreads, std::size_t dataUnitSize) noexcept
+            : mFactory(std::move(factory)),
+              mPool(nullptr),
+              mAlgId(kAlgIdUndefined),
+              mKey(nullptr),
+              mTransform(CryptoTransform::kEncrypt),
+              mChunkSize(chunkSize),
+              mMaxThreads(maxThreads),
+              mDataUnitSize(dataUnitSize)
+            {
+            }
+
+            ParallelStreamCipher::ParallelStreamCipher (Pool &pool, CryptoAlgId algId, const SymmetricKey &key, CryptoTransform transform, std::size_t chunkSize, std::size_t maxThreads, std::size_t dataUnitSize) noexcept
+            : mFactory(),
+              mPool(&pool),
+              mAlgId(algId),
+              mKey(&key),
+              mTransform(transform),
+              mChunkSize(chunkSize),
+              mMaxThreads(maxThreads),
+              mDataUnitSize(dataUnitSize)
+            {
+            }
+
+            ParallelStreamCipher::Factory ParallelStreamCipher::MakeFactory (CryptoProvider &provider, CryptoAlgId algId, const SymmetricKey &key, CryptoTransform transform) noexcept
+            {
+                return [&provider, algId, &key, transform] () -> ara::core::Result<StreamCipherCtx::Uptr>
+                {
+                    ara::core::Result<StreamCipherCtx::Uptr> created = provider.CreateStreamCipherCtx(algId);
+                    if (!created.HasValue())
+                    {
+                        return created;
+                    }
+                    StreamCipherCtx::Uptr ctx = std::move(created).Value();
+                    ara::core::Result<void> deployed = ctx->SetKey(key, transform);
+                    if (!deployed.HasValue())
+                    {
+                        return ara::core::Result<StreamCipherCtx::Uptr>::FromError(deployed.Error());
+                    }
+                    return ara::core::Result<StreamCipherCtx::Uptr>::FromValue(std::move(ctx));
+                };
+            }
+
+            ara::core::Result<void> ParallelStreamCipher::Process (ReadWriteMemRegion inOut, ReadOnlyMemRegion iv, std::uint64_t streamOffset) const noexcept
+            {
+                if (inOut.empty())
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                if ((mPool == nullptr) && !mFactory)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kMissingArgument);
+                }
+
+                ara::core::Result<Pool::Uptr> first = CreateContext();
+                if (!first.HasValue())
+                {
+                    return ara::core::Result<void>::FromError(first.Error());
+                }
+                ara::core::Vector<Pool::Uptr> contexts;
+                contexts.push_back(std::move(first).Value());
+                if (!contexts[0])
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                }
+
+                StreamCipherCtx &prototype = *contexts[0];
+                if (!prototype.IsSeekableMode())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                BlockService::Uptr blockService = prototype.GetBlockService();
+                const std::size_t blockSize = (blockService && (blockService->GetBlockSize() != 0u)) ? blockService->GetBlockSize() : 1u;
+                if (!prototype.IsBytewiseMode() && ((streamOffset % blockSize) != 0u))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+
+                ara::core::Result<void> checked = CheckDataUnits(blockSize, inOut.size());
+                if (!checked.HasValue())
+                {
+                    return checked;
+                }
+                if ((mDataUnitSize != 0u) && ((streamOffset % mDataUnitSize) != 0u))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+
+                const std::size_t size = inOut.size();
+                const std::size_t chunkSize = (mDataUnitSize != 0u) ? mChunkSize : std::max(blockSize, mChunkSize - (mChunkSize % blockSize));
+                const std::size_t chunkCount = (size + chunkSize - 1u) / chunkSize;
+                const std::size_t threadCount = GetThreadCount(chunkCount);
+
+                // Each worker owns a context: a missing one only reduces the parallelism.
+                for (std::size_t t = 1; t < threadCount; ++t)
+                {
+                    ara::core::Result<Pool::Uptr> created = CreateContext();
+                    if (!created.HasValue() || !created.Value())
+                    {
+                        break;
+                    }
+                    contexts.push_back(std::move(created).Value());
+                }
+
+                std::atomic<std::size_t> nextChunk(0u);
+                std::atomic<bool> failed(false);
+                std::mutex failureMutex;
+                ara::core::Result<void> failure = ara::core::Result<void>::FromValue();
+
+                auto fail = [&] (const ara::core::Result<void> &result)
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failed.exchange(true))
+                    {
+                        failure = result;
+                    }
+                };
+
+                auto work = [&] (std::size_t worker)
+                {
+                    StreamCipherCtx &ctx = *contexts[worker];
+                    ara::core::Result<void> started = ctx.Start(iv);
+                    if (!started.HasValue())
+                    {
+                        fail(started);
+                        return;
+                    }
+
+                    for (std::size_t c = nextChunk++; (c < chunkCount) && !failed.load(); c = nextChunk++)
+                    {
+                        const std::size_t offset = c * chunkSize;
+                        const std::size_t length = std::min(chunkSize, size - offset);
+                        ara::core::Result<void> positioned = ctx.Seek(static_cast<std::int64_t>(streamOffset + offset), true);
+                        if (!positioned.HasValue())
+                        {
+                            fail(positioned);
+                            return;
+                        }
+
+                        if ((length % blockSize) == 0u)
+                        {
+                            ara::core::Result<void> processed = ctx.ProcessBlocks(ReadWriteMemRegion(inOut.data() + offset, length));
+                            if (!processed.HasValue())
+                            {
+                                fail(processed);
+                                return;
+                            }
+                            continue;
+                        }
+
+                        // Only the last chunk may be incomplete: it is finished as a whole, so the modes with
+                        // ciphertext stealing (e.g. XTS) can combine its last complete block with the partial one.
+                        ara::core::Result<ara::core::Vector<ara::core::Byte> > finished = ctx.FinishBytes(ReadOnlyMemRegion(inOut.data() + offset, length));
+                        if (!finished.HasValue())
+                        {
+                            fail(ara::core::Result<void>::FromError(finished.Error()));
+                            return;
+                        }
+                        const ara::core::Vector<ara::core::Byte> &out = finished.Value();
+                        if (out.size() != length)
+                        {
+                            fail(ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize));
+                            return;
+                        }
+                        for (std::size_t i = 0; i < length; ++i)
+                        {
+                            inOut[offset + i] = static_cast<std::uint8_t>(out[i]);
+                        }
+                    }
+                };
+
+                RunWorkers(contexts.size(), work);
+
+                for (Pool::Uptr &ctx : contexts)
+                {
+                    ctx->Reset();
+                }
+                return failure;
+            }
+
+            ara::core::Result<ParallelStreamCipher::Pool::Uptr> ParallelStreamCipher::CreateContext () const noexcept
+            {
+                if (mPool == nullptr)
+                {
+                    // A context of the factory is held with an empty recycler, which destroys it.
+                    ara::core::Result<StreamCipherCtx::Uptr> created = mFactory();
+                    if (!created.HasValue())
+                    {
+                        return ara::core::Result<Pool::Uptr>::FromError(created.Error());
+                    }
+                    return ara::core::Result<Pool::Uptr>::FromValue(Pool::Uptr(std::move(created).Value().release(), Pool::Recycler()));
+                }
+
+                ara::core::Result<Pool::Uptr> acquired = mPool->Acquire(mAlgId);
+                if (!acquired.HasValue())
+                {
+                    return acquired;
+                }
+                Pool::Uptr ctx = std::move(acquired).Value();
+                ara::core::Result<void> deployed = ctx->SetKey(*mKey, mTransform);
+                if (!deployed.HasValue())
+                {
+                    return ara::core::Result<Pool::Uptr>::FromError(deployed.Error());
+                }
+                return ara::core::Result<Pool::Uptr>::FromValue(std::move(ctx));
+            }
+
+            ara::core::Result<void> ParallelStreamCipher::Process (const internal::AesXts &cipher, bool encrypt, ReadWriteMemRegion inOut, std::uint64_t firstDataUnit) const noexcept
+            {
+                if (!cipher.IsKeySet())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (mDataUnitSize == 0u)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                ara::core::Result<void> checked = CheckDataUnits(internal::AesXts::kBlockSize, inOut.size());
+                if (!checked.HasValue() || inOut.empty())
+                {
+                    return checked;
+                }
+
+                const std::size_t size = inOut.size();
+                const std::size_t chunkCount = (size + mChunkSize - 1u) / mChunkSize;
+                const std::size_t unitsPerChunk = mChunkSize / mDataUnitSize;
+                std::atomic<std::size_t> nextChunk(0u);
+
+                // The sizes are checked above, so the kernel cannot fail.
+                auto work = [&] (std::size_t)
+                {
+                    for (std::size_t c = nextChunk++; c < chunkCount; c = nextChunk++)
+                    {
+                        std::uint8_t *chunk = inOut.data() + c * mChunkSize;
+                        cipher.ProcessDataUnits(encrypt, firstDataUnit + c * unitsPerChunk, mDataUnitSize, chunk, chunk, std::min(mChunkSize, size - c * mChunkSize));
+                    }
+                };
+                RunWorkers(GetThreadCount(chunkCount), work);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> ParallelStreamCipher::CheckDataUnits (std::size_t blockSize, std::size_t size) const noexcept
+            {
+                if (mDataUnitSize == 0u)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                // A chunk must consist of whole data units, and only the last data unit may be partial (but
+                // not shorter than a block).
+                const std::size_t tail = size % mDataUnitSize;
+                if ((mDataUnitSize < blockSize) || ((mDataUnitSize % blockSize) != 0u) || (mChunkSize < mDataUnitSize) ||
+                    ((mChunkSize % mDataUnitSize) != 0u) || ((tail != 0u) && (tail < blockSize)))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            std::size_t ParallelStreamCipher::GetThreadCount (std::size_t chunkCount) const noexcept
+            {
+                const std::size_t threadCount = (mMaxThreads != 0) ? mMaxThreads : static_cast<std::size_t>(std::thread::hardware_concurrency());
+                return std::min(std::max<std::size_t>(threadCount, 1u), chunkCount);
+            }
+        }
+    }
+}
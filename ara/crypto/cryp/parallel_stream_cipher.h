@@ -0,0 +1,141 @@
+#ifndef ARA_CRYPTO_CRYP_PARALLEL_STREAM_CIPHER_H
+#define ARA_CRYPTO_CRYP_PARALLEL_STREAM_CIPHER_H
+
+#include <cinttypes>
+#include <functional>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/context_pool.h"
+#include "ara/crypto/cryp/cryobj/symmetric_key.h"
+#include "ara/crypto/cryp/stream_cipher_ctx.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace internal
+            {
+                class AesXts;
+            }
+
+            /**
+             * @brief Driver encrypting (or decrypting) a large buffer in place by several threads. The buffer is
+             * partitioned into chunks, every worker owns a keyed stream cipher context, positions it to the
+             * beginning of a chunk by Seek() and transforms the chunk by the copy-optimized ProcessBlocks(). It
+             * requires a seekable mode (see StreamCipherCtx::IsSeekableMode()), e.g. CTR or XTS. A mode that
+             * processes the stream in independent data units (e.g. XTS) needs the data unit size: the chunk size
+             * must be a multiple of it, so that a chunk never splits a data unit. The XTS-AES kernel can also be
+             * driven directly, without contexts (see the Process() overload taking internal::AesXts). The contexts
+             * are created by a Factory for every Process() call, or taken from a ContextPool and returned to it
+             * afterwards, so repeated calls only deploy the key again.
+             */
+            class ParallelStreamCipher
+            {
+            public:
+
+                /**
+                 * @brief Callable object creating a stream cipher context with the key already deployed. It is
+                 * called once per worker thread, possibly concurrently.
+                 */
+                using Factory = std::function<ara::core::Result<StreamCipherCtx::Uptr> ()>;
+
+                /**
+                 * @brief Pool of the worker contexts.
+                 */
+                using Pool = ContextPool<StreamCipherCtx>;
+
+                /**
+                 * @brief Default size of a chunk in bytes.
+                 */
+                static const std::size_t kDefaultChunkSize = 1024u * 1024u;
+
+                /**
+                 * @brief Construct a new Parallel Stream Cipher object
+                 * @param[in] factory the callable object creating keyed contexts (may be empty if only the
+                 * internal::AesXts overload of Process() is used)
+                 * @param[in] chunkSize size of a chunk in bytes (rounded down to the block size of the mode, it
+                 * must be a multiple of a non-zero dataUnitSize)
+                 * @param[in] maxThreads maximal number of worker threads (0 means the hardware concurrency)
+                 * @param[in] dataUnitSize size of a data unit in bytes for the modes that process the stream in
+                 * independent data units (e.g. XTS), or 0 if the stream is not split into data units
+                 */
+                explicit ParallelStreamCipher (Factory factory, std::size_t chunkSize=kDefaultChunkSize, std::size_t maxThreads=0, std::size_t dataUnitSize=0) noexcept;
+
+                /**
+                 * @brief Construct a new Parallel Stream Cipher object taking the contexts from a pool. Each worker
+                 * acquires a context and deploys the key to it; the contexts are returned to the pool (and
+                 * cleared by it) at the end of Process(). The pool and the key must outlive this object.
+                 * @param[in] pool the pool of the stream cipher contexts
+                 * @param[in] algId identifier of the stream cipher algorithm
+                 * @param[in] key the symmetric key
+                 * @param[in] transform the "direction" indicator of the transformation
+                 * @param[in] chunkSize size of a chunk in bytes (as for the Factory constructor)
+                 * @param[in] maxThreads maximal number of worker threads (0 means the hardware concurrency)
+                 * @param[in] dataUnitSize size of a data unit in bytes (as for the Factory constructor)
+                 */
+                ParallelStreamCipher (Pool &pool, CryptoAlgId algId, const SymmetricKey &key, CryptoTransform transform=CryptoTransform::kEncrypt, std::size_t chunkSize=kDefaultChunkSize, std::size_t maxThreads=0, std::size_t dataUnitSize=0) noexcept;
+
+                /**
+                 * @brief Make a factory creating contexts by the Crypto Provider and deploying the key to them.
+                 * The provider and the key must outlive the factory.
+                 * @param[in] provider the Crypto Provider
+                 * @param[in] algId identifier of the stream cipher algorithm
+                 * @param[in] key the symmetric key
+                 * @param[in] transform the "direction" indicator of the transformation
+                 * @return Factory the callable object creating keyed contexts
+                 */
+                static Factory MakeFactory (CryptoProvider &provider, CryptoAlgId algId, const SymmetricKey &key, CryptoTransform transform=CryptoTransform::kEncrypt) noexcept;
+
+                /**
+                 * @brief Transform the buffer in place. The result is the same as transforming it by a single
+                 * context started by Start(iv) and positioned by Seek(streamOffset).
+                 * @param[in,out] inOut the input and output data buffer
+                 * @param[in] iv the Initialization Vector (IV), "nonce" or tweak value passed to Start()
+                 * @param[in] streamOffset the position of the buffer beginning in the key stream (in bytes)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the mode of the contexts is not seekable
+                 * @exception CryptoErrorDomain::kInvalidArgument if the streamOffset is not aligned to the block size of a not byte-wise mode, or to the data unit size
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the data unit size is not a multiple of the block size, the chunk size is not a multiple of the data unit size, or the last data unit is shorter than a block
+                 * @exception CryptoErrorDomain::kBusyResource if no context could be created
+                 * @exception any error returned by the factory, the pool or the context methods
+                 */
+                ara::core::Result<void> Process (ReadWriteMemRegion inOut, ReadOnlyMemRegion iv=ReadOnlyMemRegion(), std::uint64_t streamOffset=0u) const noexcept;
+
+                /**
+                 * @brief Encrypt or decrypt a run of consecutive XTS data units in place by the XTS-AES kernel.
+                 * The key-scheduled kernel is immutable, so all workers share it and no contexts are created.
+                 * The data unit size passed to the constructor is used, the last data unit may be shorter.
+                 * @param[in] cipher the XTS-AES kernel with the key already set
+                 * @param[in] encrypt the direction: encryption (if true) or decryption (if false)
+                 * @param[in,out] inOut the input and output data buffer
+                 * @param[in] firstDataUnit the sequence number of the first data unit in the buffer
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is set to the cipher
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the data unit size is not a multiple of the AES block size, the chunk size is not a multiple of the data unit size, or the last data unit is shorter than a block
+                 */
+                ara::core::Result<void> Process (const internal::AesXts &cipher, bool encrypt, ReadWriteMemRegion inOut, std::uint64_t firstDataUnit=0u) const noexcept;
+
+            private:
+                ara::core::Result<Pool::Uptr> CreateContext () const noexcept;
+                ara::core::Result<void> CheckDataUnits (std::size_t blockSize, std::size_t size) const noexcept;
+                std::size_t GetThreadCount (std::size_t chunkCount) const noexcept;
+
+                Factory mFactory;
+                Pool *mPool;                    // used instead of the factory if not nullptr
+                CryptoAlgId mAlgId;
+                const SymmetricKey *mKey;
+                CryptoTransform mTransform;
+                std::size_t mChunkSize;
+                std::size_t mMaxThreads;
+                std::size_t mDataUnitSize;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_PARALLEL_STREAM_CIPHER_H
@@ -0,0 +1,205 @@
+#include "ara/crypto/cryp/public_key_cache.h"
+
+#include <new>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            PublicKeyCache::PublicKeyCache (std::size_t capacity) noexcept
+            : mMutex(),
+              mCapacity(capacity),
+              mEntries(),
+              mIndex(),
+              mStatistics()
+            {
+            }
+
+            ara::core::Result<PublicKeyCache::KeyId> PublicKeyCache::MakeKeyId (const PublicKey &key, CryptoAlgId algId, HashFunctionCtx &hashFunc) noexcept
+            {
+                KeyId id;
+                id.mCouid = key.GetObjectId().mCouid;
+                id.mAlgId = algId;
+                if (!id.mCouid.IsNil())
+                {
+                    return ara::core::Result<KeyId>::FromValue(id);
+                }
+
+                ara::core::Result<ara::core::Vector<ara::core::Byte> > digest = key.HashPublicKey(hashFunc);
+                if (!digest.HasValue())
+                {
+                    return ara::core::Result<KeyId>::FromError(digest.Error());
+                }
+
+                const ara::core::Vector<ara::core::Byte> &value = digest.Value();
+                return ara::core::Result<KeyId>::FromValue(MakeKeyId(ReadOnlyMemRegion(reinterpret_cast<const std::uint8_t*>(value.data()), value.size()), algId));
+            }
+
+            PublicKeyCache::KeyId PublicKeyCache::MakeKeyId (ReadOnlyMemRegion keyHash, CryptoAlgId algId) noexcept
+            {
+                // The version stamp stays nil, so a value-derived identifier never matches an assigned COUID.
+                KeyId id;
+                id.mAlgId = algId;
+                for (std::size_t i = 0; (i < keyHash.size()) && (i < 16u); ++i)
+                {
+                    std::uint64_t &qword = (i < 8u) ? id.mCouid.mGeneratorUid.mQwordLs : id.mCouid.mGeneratorUid.mQwordMs;
+                    qword = (qword << 8) | static_cast<std::uint64_t>(keyHash[i]);
+                }
+                return id;
+            }
+
+            PreparedPublicKey::Sptrc PublicKeyCache::Find (const KeyId &id) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto found = mIndex.find(id);
+                if (found == mIndex.end())
+                {
+                    ++mStatistics.mMisses;
+                    return nullptr;
+                }
+                ++mStatistics.mHits;
+                mEntries.splice(mEntries.begin(), mEntries, found->second);
+                return found->second->second;
+            }
+
+            ara::core::Result<PreparedPublicKey::Sptrc> PublicKeyCache::FindOrPrepare (const KeyId &id, const Preparer &prepare) noexcept
+            {
+                PreparedPublicKey::Sptrc state = Find(id);
+                if (state)
+                {
+                    return ara::core::Result<PreparedPublicKey::Sptrc>::FromValue(std::move(state));
+                }
+
+                ara::core::Result<PreparedPublicKey::Sptrc> prepared = prepare();
+                if (!prepared.HasValue() || !prepared.Value())
+                {
+                    return prepared;
+                }
+
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto found = mIndex.find(id);
+                if (found != mIndex.end())
+                {
+                    // Another thread has prepared the same key meanwhile: keep the already shared instance.
+                    mEntries.splice(mEntries.begin(), mEntries, found->second);
+                    return ara::core::Result<PreparedPublicKey::Sptrc>::FromValue(found->second->second);
+                }
+                InsertLocked(id, prepared.Value());
+                return prepared;
+            }
+
+            void PublicKeyCache::Insert (const KeyId &id, PreparedPublicKey::Sptrc state) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto found = mIndex.find(id);
+                if (found != mIndex.end())
+                {
+                    found->second->second = std::move(state);
+                    mEntries.splice(mEntries.begin(), mEntries, found->second);
+                    return;
+                }
+                InsertLocked(id, std::move(state));
+            }
+
+            bool PublicKeyCache::Erase (const KeyId &id) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto found = mIndex.find(id);
+                if (found == mIndex.end())
+                {
+                    return false;
+                }
+                mEntries.erase(found->second);
+                mIndex.erase(found);
+                return true;
+            }
+
+            void PublicKeyCache::Clear () noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mIndex.clear();
+                mEntries.clear();
+            }
+
+            void PublicKeyCache::SetCapacity (std::size_t capacity) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mCapacity = capacity;
+                TrimLocked();
+            }
+
+            std::size_t PublicKeyCache::GetCapacity () const noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mCapacity;
+            }
+
+            std::size_t PublicKeyCache::GetSize () const noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mEntries.size();
+            }
+
+            PublicKeyCache::Statistics PublicKeyCache::GetStatistics () const noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mStatistics;
+            }
+
+            void PublicKeyCache::InsertLocked (const KeyId &id, PreparedPublicKey::Sptrc state) noexcept
+            {
+                if (mCapacity == 0u)
+                {
+                    return;
+                }
+                try
+                {
+                    mEntries.emplace_front(id, std::move(state));
+                }
+                catch (const std::bad_alloc &)
+                {
+                    // The state is just not cached, the caller keeps its own reference.
+                    return;
+                }
+                try
+                {
+                    mIndex[id] = mEntries.begin();
+                }
+                catch (const std::bad_alloc &)
+                {
+                    mEntries.pop_front();
+                    return;
+                }
+                TrimLocked();
+            }
+
+            void PublicKeyCache::TrimLocked () noexcept
+            {
+                while (mEntries.size() > mCapacity)
+                {
+                    mIndex.erase(mEntries.back().first);
+                    mEntries.pop_back();
+                    ++mStatistics.mEvictions;
+                }
+            }
+
+            std::size_t PublicKeyCache::KeyIdHash::operator() (const KeyId &id) const noexcept
+            {
+                // COUIDs are random 128-bit generator IDs plus sequential version stamps: mixing the words is enough.
+                std::uint64_t hash = id.mCouid.mGeneratorUid.mQwordLs ^ (id.mCouid.mGeneratorUid.mQwordMs * 0x9E3779B97F4A7C15ull);
+                hash ^= (id.mCouid.mVersionStamp + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2));
+                hash ^= (id.mAlgId + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2));
+                return static_cast<std::size_t>(hash);
+            }
+
+            bool PublicKeyCache::KeyIdEqual::operator() (const KeyId &lhs, const KeyId &rhs) const noexcept
+            {
+                return (lhs.mCouid == rhs.mCouid) && (lhs.mAlgId == rhs.mAlgId);
+            }
+        }
+    }
+}
@@ -0,0 +1,223 @@
+#ifndef ARA_CRYPTO_CRYP_PUBLIC_KEY_CACHE_H
+#define ARA_CRYPTO_CRYP_PUBLIC_KEY_CACHE_H
+
+#include <cinttypes>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/crypto_object_uid.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
+#include "ara/crypto/cryp/cryobj/public_key.h"
+#include "ara/crypto/cryp/hash_function_ctx.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Algorithm specific state prepared from a public key value: the decoded key (e.g. an
+             * elliptic curve point in the internal coordinates) and any precomputation built for it (e.g. window
+             * tables of the variable-base scalar multiplication). The state is immutable after creation, therefore
+             * a single instance can be shared by any number of contexts and threads.
+             */
+            class PreparedPublicKey
+            {
+            public:
+
+                /**
+                 * @brief Shared smart pointer of the constant interface.
+                 */
+                using Sptrc = std::shared_ptr<const PreparedPublicKey>;
+
+                /**
+                 * @brief Destroy the Prepared Public Key object
+                 *
+                 */
+                virtual ~PreparedPublicKey () noexcept=default;
+
+                /**
+                 * @brief Get the identifier of the crypto algorithm the state was prepared for.
+                 * @return CryptoAlgId the algorithm ID
+                 */
+                virtual CryptoAlgId GetAlgId () const noexcept=0;
+            };
+
+            /**
+             * @brief Thread-safe LRU cache of prepared public-key states owned by a Crypto Provider. A
+             * verifier (or any other public key) context implementation can look up the state of a key in
+             * SetKey() and prepare it only on a miss, so repeated operations with the same key skip the decoding
+             * and table building. ChainVerifier keeps the RSA keys of certificate issuers in one.
+             * Entries are identified by the COUID of the public key and the algorithm ID of the context.
+             */
+            class PublicKeyCache
+            {
+            public:
+
+                /**
+                 * @brief Identifier of a cache entry.
+                 */
+                struct KeyId
+                {
+                    /**
+                     * @brief COUID of the public key, or a COUID derived from the key value hash (with the nil
+                     * version stamp) for keys that have no own COUID (see MakeKeyId()).
+                     */
+                    CryptoObjectUid mCouid;
+
+                    /**
+                     * @brief Algorithm ID of the prepared state.
+                     */
+                    CryptoAlgId mAlgId = kAlgIdUndefined;
+                };
+
+                /**
+                 * @brief Counters of the cache efficiency.
+                 */
+                struct Statistics
+                {
+                    std::uint64_t mHits = 0u;       // number of lookups satisfied by the cache
+                    std::uint64_t mMisses = 0u;     // number of lookups that required a preparation
+                    std::uint64_t mEvictions = 0u;  // number of least recently used entries dropped due to the capacity limit
+                };
+
+                /**
+                 * @brief Callable object preparing a state of a not cached key.
+                 */
+                using Preparer = std::function<ara::core::Result<PreparedPublicKey::Sptrc> ()>;
+
+                /**
+                 * @brief Default maximal number of cached keys.
+                 */
+                static const std::size_t kDefaultCapacity = 256u;
+
+                /**
+                 * @brief Construct an empty cache.
+                 * @param[in] capacity maximal number of cached keys (0 disables the caching)
+                 */
+                explicit PublicKeyCache (std::size_t capacity=kDefaultCapacity) noexcept;
+
+                PublicKeyCache (const PublicKeyCache &other)=delete;
+                PublicKeyCache& operator= (const PublicKeyCache &other)=delete;
+
+                /**
+                 * @brief Build the identifier of a cache entry for the public key. The COUID of the key is used if
+                 * it is assigned, otherwise the leading 16 bytes of the key value hash are used as a generator UID
+                 * of a COUID with the nil version stamp.
+                 * @param[in] key the public key
+                 * @param[in] algId the algorithm ID of the context that is going to use the prepared state
+                 * @param[in] hashFunc an initialized hash-function context (used only if the key has no COUID)
+                 * @return ara::core::Result<KeyId> the entry identifier
+                 * @exception CryptoErrorDomain::kIncompleteArgState if the key has no COUID and the hashFunc context is not initialized
+                 */
+                static ara::core::Result<KeyId> MakeKeyId (const PublicKey &key, CryptoAlgId algId, HashFunctionCtx &hashFunc) noexcept;
+
+                /**
+                 * @brief Build the identifier of a cache entry for a key that is not a PublicKey object (e.g. the
+                 * subjectPublicKey of a certificate): the leading 16 bytes of the key value hash are used as a
+                 * generator UID of a COUID with the nil version stamp.
+                 * @param[in] keyHash a hash of the key value of at least 16 bytes
+                 * @param[in] algId the algorithm ID of the prepared state
+                 * @return KeyId the entry identifier
+                 */
+                static KeyId MakeKeyId (ReadOnlyMemRegion keyHash, CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Find a prepared state and mark it as the most recently used one.
+                 * @param[in] id the entry identifier
+                 * @return PreparedPublicKey::Sptrc the cached state or nullptr if it is absent
+                 */
+                PreparedPublicKey::Sptrc Find (const KeyId &id) noexcept;
+
+                /**
+                 * @brief Find a prepared state or prepare and insert it on a miss. The preparation is executed
+                 * outside of the cache lock, so concurrent lookups of other keys are not blocked by it.
+                 * @param[in] id the entry identifier
+                 * @param[in] prepare the callable object preparing the state
+                 * @return ara::core::Result<PreparedPublicKey::Sptrc> the cached or just prepared state
+                 * @exception any error returned by the prepare callable object
+                 */
+                ara::core::Result<PreparedPublicKey::Sptrc> FindOrPrepare (const KeyId &id, const Preparer &prepare) noexcept;
+
+                /**
+                 * @brief Insert (or replace) a prepared state as the most recently used one.
+                 * @param[in] id the entry identifier
+                 * @param[in] state the prepared state
+                 */
+                void Insert (const KeyId &id, PreparedPublicKey::Sptrc state) noexcept;
+
+                /**
+                 * @brief Remove the entry of a key (e.g. after its revocation).
+                 * @param[in] id the entry identifier
+                 * @return true if the entry was found and removed
+                 * @return false otherwise
+                 */
+                bool Erase (const KeyId &id) noexcept;
+
+                /**
+                 * @brief Remove all entries.
+                 */
+                void Clear () noexcept;
+
+                /**
+                 * @brief Change the maximal number of cached keys, evicting the least recently used entries if
+                 * required.
+                 * @param[in] capacity new capacity of the cache (0 disables the caching)
+                 */
+                void SetCapacity (std::size_t capacity) noexcept;
+
+                /**
+                 * @brief Get the maximal number of cached keys.
+                 * @return std::size_t capacity of the cache
+                 */
+                std::size_t GetCapacity () const noexcept;
+
+                /**
+                 * @brief Get the number of currently cached keys.
+                 * @return std::size_t number of entries
+                 */
+                std::size_t GetSize () const noexcept;
+
+                /**
+                 * @brief Get the efficiency counters accumulated since construction.
+                 * @return Statistics a snapshot of the counters
+                 */
+                Statistics GetStatistics () const noexcept;
+
+            private:
+
+                struct KeyIdHash
+                {
+                    std::size_t operator() (const KeyId &id) const noexcept;
+                };
+
+                struct KeyIdEqual
+                {
+                    bool operator() (const KeyId &lhs, const KeyId &rhs) const noexcept;
+                };
+
+                using Entry = std::pair<KeyId, PreparedPublicKey::Sptrc>;
+                using EntryList = std::list<Entry>;
+
+                void InsertLocked (const KeyId &id, PreparedPublicKey::Sptrc state) noexcept;
+                void TrimLocked () noexcept;
+
+                mutable std::mutex mMutex;
+                std::size_t mCapacity;
+                EntryList mEntries;     // ordered from the most to the least recently used
+                std::unordered_map<KeyId, EntryList::iterator, KeyIdHash, KeyIdEqual> mIndex;
+                Statistics mStatistics;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_PUBLIC_KEY_CACHE_H
@@ -1,7 +1,10 @@
 #ifndef ARA_CRYPTO_CRYP_RANDOM_GENERATOR_CTX_H
 #define ARA_CRYPTO_CRYP_RANDOM_GENERATOR_CTX_H
 
+#include <cstdint>
+
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
 
 namespace ara
 {
@@ -44,6 +47,40 @@ namespace ara
                  */
                 virtual ara::core::Result<ara::core::Vector<ara::core::Byte> > Generate (std::uint32_t count) noexcept=0;
 
+                /**
+                 * @brief Fill a caller provided buffer with a generated random sequence. It is a copy-optimized
+                 * counterpart of the Generate(std::uint32_t) method that allows IVs and nonces to be produced in place
+                 * without an allocation. The default implementation falls back to the allocating method.
+                 * @param[out] output the buffer to fill, i.e. the whole buffer should be updated
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUninitializedContext if this context implements a local RNG that has to be seeded by the application (see Generate(std::uint32_t))
+                 * @exception CryptoErrorDomain::kBusyResource if this context implements a global RNG that is currently out-of-entropy
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the output buffer is larger than a single request supported by the context
+                 */
+                virtual ara::core::Result<void> Generate (ReadWriteMemRegion output) noexcept
+                {
+                    if (output.size() > UINT32_MAX)
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    ara::core::Result<ara::core::Vector<ara::core::Byte> > generated = Generate(static_cast<std::uint32_t>(output.size()));
+                    if (!generated.HasValue())
+                    {
+                        return ara::core::Result<void>::FromError(generated.Error());
+                    }
+
+                    const ara::core::Vector<ara::core::Byte> &random = generated.Value();
+                    if (random.size() != output.size())
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    for (std::size_t i = 0; i < random.size(); ++i)
+                    {
+                        output[i] = static_cast<std::uint8_t>(random[i]);
+                    }
+                    return ara::core::Result<void>::FromValue();
+                }
+
                 /**
                  * @brief [SWS_CRYPT_22902]
                  * Get ExtensionService instance.
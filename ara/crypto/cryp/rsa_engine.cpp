@@ -0,0 +1,301 @@
+#include "ara/crypto/cryp/rsa_engine.h"
+
+#include <cstring>
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/system_random.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // Maximal number of attempts to draw a value below a full-size modulus (at least half of the
+                // values qualify) or an invertible blinding factor, the probability of a failure is below 2^-32.
+                const std::size_t kMaxAttempts = 32u;
+
+                // Extra random bytes of a blinding factor, so its residue modulo n is close to uniform.
+                const std::size_t kBlindingMargin = 8u;
+
+                void Wipe (void *data, std::size_t size) noexcept
+                {
+                    volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        bytes[i] = 0u;
+                    }
+                }
+
+                internal::Rsa::Integer ToInteger (ReadOnlyMemRegion value) noexcept
+                {
+                    return {value.data(), value.size()};
+                }
+            }
+
+            RsaEngine::RsaEngine (CryptoAlgId algId) noexcept : mAlgId(algId), mBlinding()
+            {
+            }
+
+            RsaEngine::~RsaEngine () noexcept
+            {
+                Clear();
+            }
+
+            bool RsaEngine::IsSupported () const noexcept
+            {
+                return GetModulusSize() != 0u;
+            }
+
+            std::size_t RsaEngine::GetModulusSize () const noexcept
+            {
+                switch (mAlgId)
+                {
+                case kAlgIdRsa2048OaepSha2_256:
+                case kAlgIdRsa2048Kem:
+                    return 256u;
+                case kAlgIdRsa3072OaepSha2_256:
+                case kAlgIdRsa3072Kem:
+                    return 384u;
+                default:
+                    return 0u;
+                }
+            }
+
+            std::size_t RsaEngine::GetMaxMessageSize () const noexcept
+            {
+                return (!IsSupported() || IsKem()) ? 0u : GetModulusSize() - 2u * internal::Rsa::kHashSize - 2u;
+            }
+
+            ara::core::Result<void> RsaEngine::SetPublicKey (ReadOnlyMemRegion modulus, ReadOnlyMemRegion publicExponent) noexcept
+            {
+                Clear();
+                if (!IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (!HasModulusSize(modulus))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                if (!mRsa.SetPublicKey(ToInteger(modulus), ToInteger(publicExponent)))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> RsaEngine::SetPrivateKey (const PrivateKey &key) noexcept
+            {
+                Clear();
+                if (!IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (!HasModulusSize(key.mModulus))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                const internal::Rsa::PrivateKey components = {
+                    ToInteger(key.mModulus), ToInteger(key.mPublicExponent), ToInteger(key.mPrime1), ToInteger(key.mPrime2),
+                    ToInteger(key.mExponent1), ToInteger(key.mExponent2), ToInteger(key.mCoefficient)};
+                if (!mRsa.SetPrivateKey(components))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+
+                std::uint8_t random[internal::Rsa::kMaxModulusSize + kBlindingMargin];
+                const ReadWriteMemRegion region(random, GetModulusSize() + kBlindingMargin);
+                for (std::size_t attempt = 0; attempt < kMaxAttempts; ++attempt)
+                {
+                    ara::core::Result<void> filled = SystemRandom::Fill(region);
+                    if (!filled.HasValue())
+                    {
+                        break;
+                    }
+                    if (mRsa.InitBlinding(mBlinding, region.data(), region.size()))
+                    {
+                        Wipe(random, sizeof(random));
+                        return ara::core::Result<void>::FromValue();
+                    }
+                }
+
+                Wipe(random, sizeof(random));
+                Clear();
+                return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+            }
+
+            ara::core::Result<std::size_t> RsaEngine::Encrypt (ReadOnlyMemRegion message, ReadWriteMemRegion ciphertext, ReadOnlyMemRegion label) const noexcept
+            {
+                if (!IsSupported() || IsKem())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (!IsKeySet())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (message.size() > GetMaxMessageSize())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                if (ciphertext.size() < GetModulusSize())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                std::uint8_t seed[internal::Rsa::kHashSize];
+                ara::core::Result<void> filled = SystemRandom::Fill(ReadWriteMemRegion(seed, sizeof(seed)));
+                if (!filled.HasValue())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                }
+                mRsa.EncryptOaep(message.data(), message.size(), label.data(), label.size(), seed, ciphertext.data());
+                Wipe(seed, sizeof(seed));
+                return ara::core::Result<std::size_t>::FromValue(GetModulusSize());
+            }
+
+            ara::core::Result<std::size_t> RsaEngine::Decrypt (ReadOnlyMemRegion ciphertext, ReadWriteMemRegion message, ReadOnlyMemRegion label) const noexcept
+            {
+                if (!IsSupported() || IsKem())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (!HasPrivateKey())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (ciphertext.size() != GetModulusSize())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                internal::Rsa::Blinding blinding;
+                TakeBlinding(blinding);
+                std::uint8_t decrypted[internal::Rsa::kMaxModulusSize];
+                std::size_t size = 0u;
+                const bool valid = mRsa.DecryptOaep(ciphertext.data(), label.data(), label.size(), blinding, decrypted, size);
+                Wipe(&blinding, sizeof(blinding));
+
+                ara::core::Result<std::size_t> result = ara::core::Result<std::size_t>::FromValue(size);
+                if (!valid)
+                {
+                    result = ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                else if (message.size() < size)
+                {
+                    result = ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+                else
+                {
+                    std::memcpy(message.data(), decrypted, size);
+                }
+                Wipe(decrypted, sizeof(decrypted));
+                return result;
+            }
+
+            ara::core::Result<std::size_t> RsaEngine::Encapsulate (ReadWriteMemRegion encapsulated, internal::HmacKdf &kdf, ReadOnlyMemRegion salt) const noexcept
+            {
+                if (!IsSupported() || !IsKem() || !kdf.IsSupported())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (!IsKeySet())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (encapsulated.size() < GetModulusSize())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                // z is drawn uniformly below n by rejection, c = z^e
+                std::uint8_t secret[internal::Rsa::kMaxModulusSize];
+                const ReadWriteMemRegion region(secret, GetModulusSize());
+                for (std::size_t attempt = 0; attempt < kMaxAttempts; ++attempt)
+                {
+                    ara::core::Result<void> filled = SystemRandom::Fill(region);
+                    if (!filled.HasValue())
+                    {
+                        break;
+                    }
+                    if (mRsa.PublicOperation(secret, encapsulated.data()))
+                    {
+                        kdf.SetSourceKeyMaterial(secret, GetModulusSize(), salt.data(), salt.size());
+                        Wipe(secret, sizeof(secret));
+                        return ara::core::Result<std::size_t>::FromValue(GetModulusSize());
+                    }
+                }
+
+                Wipe(secret, sizeof(secret));
+                return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+            }
+
+            ara::core::Result<void> RsaEngine::Decapsulate (ReadOnlyMemRegion encapsulated, internal::HmacKdf &kdf, ReadOnlyMemRegion salt) const noexcept
+            {
+                if (!IsSupported() || !IsKem() || !kdf.IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (!HasPrivateKey())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (encapsulated.size() != GetModulusSize())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                internal::Rsa::Blinding blinding;
+                TakeBlinding(blinding);
+                std::uint8_t secret[internal::Rsa::kMaxModulusSize];
+                const bool valid = mRsa.PrivateOperation(encapsulated.data(), secret, blinding);
+                Wipe(&blinding, sizeof(blinding));
+                if (valid)
+                {
+                    kdf.SetSourceKeyMaterial(secret, GetModulusSize(), salt.data(), salt.size());
+                }
+                Wipe(secret, sizeof(secret));
+
+                if (!valid)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void RsaEngine::Clear () noexcept
+            {
+                std::lock_guard<std::mutex> lock(mBlindingMutex);
+                mRsa.Clear();
+                Wipe(&mBlinding, sizeof(mBlinding));
+            }
+
+            bool RsaEngine::IsKem () const noexcept
+            {
+                return (mAlgId == kAlgIdRsa2048Kem) || (mAlgId == kAlgIdRsa3072Kem);
+            }
+
+            bool RsaEngine::HasModulusSize (ReadOnlyMemRegion modulus) const noexcept
+            {
+                std::size_t offset = 0u;
+                while ((offset < modulus.size()) && (modulus[offset] == 0u))
+                {
+                    ++offset;
+                }
+                return (modulus.size() - offset == GetModulusSize()) && ((modulus[offset] & 0x80u) != 0u);
+            }
+
+            void RsaEngine::TakeBlinding (internal::Rsa::Blinding &blinding) const noexcept
+            {
+                // Each operation gets its own pair, the stored one is refreshed for the next operation.
+                std::lock_guard<std::mutex> lock(mBlindingMutex);
+                blinding = mBlinding;
+                mRsa.AdvanceBlinding(mBlinding);
+            }
+        }
+    }
+}
@@ -0,0 +1,206 @@
+#ifndef ARA_CRYPTO_CRYP_RSA_ENGINE_H
+#define ARA_CRYPTO_CRYP_RSA_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <mutex>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/hmac_kdf.h"
+#include "ara/crypto/cryp/internal/rsa.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief RSA engine for the public key encryptor / private key decryptor contexts (RSAES-OAEP with
+             * SHA2-256, RFC 8017) and the key encapsulator / decapsulator contexts (RSA-KEM, RFC 5990: a random
+             * integer z below the modulus is encapsulated as z^e and keys the KDF). Those four contexts are
+             * interfaces only in this tree, so the engine takes the key components as big-endian integers.
+             * SetPrivateKey() precomputes the Montgomery constants of the modulus and both primes once per key, so
+             * a private operation costs two half-size exponentiations by the CRT. Every private operation is
+             * blinded by its own pair taken from the engine under a short lock, so Decrypt() and Decapsulate() may
+             * be called concurrently.
+             */
+            class RsaEngine
+            {
+            public:
+
+                /**
+                 * @brief Components of a private key in the CRT representation (big-endian integers).
+                 */
+                struct PrivateKey
+                {
+                    ReadOnlyMemRegion mModulus;         // n = p * q
+                    ReadOnlyMemRegion mPublicExponent;  // e
+                    ReadOnlyMemRegion mPrime1;          // p
+                    ReadOnlyMemRegion mPrime2;          // q
+                    ReadOnlyMemRegion mExponent1;       // d mod (p - 1)
+                    ReadOnlyMemRegion mExponent2;       // d mod (q - 1)
+                    ReadOnlyMemRegion mCoefficient;     // q^-1 mod p
+                };
+
+                /**
+                 * @brief Construct a new Rsa Engine object.
+                 * @param[in] algId kAlgIdRsa2048OaepSha2_256, kAlgIdRsa3072OaepSha2_256, kAlgIdRsa2048Kem or kAlgIdRsa3072Kem
+                 */
+                explicit RsaEngine (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Destroy the Rsa Engine object wiping the key.
+                 */
+                ~RsaEngine () noexcept;
+
+                RsaEngine (const RsaEngine &) = delete;
+                RsaEngine& operator= (const RsaEngine &) = delete;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept;
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Get the size of the modulus of the algorithm in bytes, i.e. the size of a ciphertext or
+                 * an encapsulated key.
+                 * @return std::size_t
+                 */
+                std::size_t GetModulusSize () const noexcept;
+
+                /**
+                 * @brief Get the maximal size of an OAEP message in bytes.
+                 * @return std::size_t 0 for the KEM algorithms
+                 */
+                std::size_t GetMaxMessageSize () const noexcept;
+
+                /**
+                 * @brief Deploy a public key.
+                 * @param[in] modulus the big-endian modulus of exactly the bit length of the algorithm
+                 * @param[in] publicExponent the big-endian public exponent
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the modulus has a wrong length
+                 * @exception CryptoErrorDomain::kInvalidArgument if the key is invalid
+                 */
+                ara::core::Result<void> SetPublicKey (ReadOnlyMemRegion modulus, ReadOnlyMemRegion publicExponent) noexcept;
+
+                /**
+                 * @brief Deploy a private key, precompute its CRT constants and prepare the blinding.
+                 * @param[in] key the key components
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the modulus has a wrong length
+                 * @exception CryptoErrorDomain::kInvalidArgument if the key is invalid
+                 * @exception CryptoErrorDomain::kBusyResource if the random generator failed
+                 */
+                ara::core::Result<void> SetPrivateKey (const PrivateKey &key) noexcept;
+
+                /**
+                 * @brief Check if a key is deployed.
+                 * @return true if SetPublicKey() or SetPrivateKey() succeeded and Clear() was not called since
+                 */
+                bool IsKeySet () const noexcept
+                {
+                    return mRsa.GetModulusSize() != 0u;
+                }
+
+                /**
+                 * @brief Check if a private key is deployed.
+                 * @return true if SetPrivateKey() succeeded and Clear() was not called since
+                 */
+                bool HasPrivateKey () const noexcept
+                {
+                    return mRsa.HasPrivateKey();
+                }
+
+                /**
+                 * @brief Encrypt a message by RSAES-OAEP with a fresh random seed.
+                 * @param[in] message the message of at most GetMaxMessageSize() bytes
+                 * @param[out] ciphertext the buffer for the ciphertext of GetModulusSize() bytes
+                 * @param[in] label the OAEP label
+                 * @return ara::core::Result<std::size_t> actual size of the ciphertext stored to the output buffer
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not an OAEP one
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the message is too long
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the ciphertext buffer is too small
+                 * @exception CryptoErrorDomain::kBusyResource if the random generator failed
+                 */
+                ara::core::Result<std::size_t> Encrypt (ReadOnlyMemRegion message, ReadWriteMemRegion ciphertext, ReadOnlyMemRegion label=ReadOnlyMemRegion()) const noexcept;
+
+                /**
+                 * @brief Decrypt an RSAES-OAEP ciphertext.
+                 * @param[in] ciphertext the ciphertext of GetModulusSize() bytes
+                 * @param[out] message the buffer for the message of at least GetMaxMessageSize() bytes
+                 * @param[in] label the OAEP label
+                 * @return ara::core::Result<std::size_t> actual size of the message stored to the output buffer
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not an OAEP one
+                 * @exception CryptoErrorDomain::kUninitializedContext if no private key is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the ciphertext has a wrong size
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the message buffer is too small
+                 * @exception CryptoErrorDomain::kInvalidArgument on a decryption error (the cause is not reported)
+                 */
+                ara::core::Result<std::size_t> Decrypt (ReadOnlyMemRegion ciphertext, ReadWriteMemRegion message, ReadOnlyMemRegion label=ReadOnlyMemRegion()) const noexcept;
+
+                /**
+                 * @brief Encapsulate a fresh random secret and use it as the source key material of a key
+                 * derivation function. The secret is wiped before the method returns and never leaves the engine.
+                 * @param[out] encapsulated the buffer for the encapsulated secret of GetModulusSize() bytes
+                 * @param[in,out] kdf the key derivation function to be keyed
+                 * @param[in] salt the optional salt of the KDF (used by HKDF)
+                 * @return ara::core::Result<std::size_t> actual size of the encapsulated secret stored to the output buffer
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not a KEM one or the KDF is not supported
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is deployed
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the encapsulated buffer is too small
+                 * @exception CryptoErrorDomain::kBusyResource if the random generator failed
+                 */
+                ara::core::Result<std::size_t> Encapsulate (ReadWriteMemRegion encapsulated, internal::HmacKdf &kdf, ReadOnlyMemRegion salt=ReadOnlyMemRegion()) const noexcept;
+
+                /**
+                 * @brief Decapsulate a secret and use it as the source key material of a key derivation function.
+                 * The secret is wiped before the method returns and never leaves the engine.
+                 * @param[in] encapsulated the encapsulated secret of GetModulusSize() bytes
+                 * @param[in,out] kdf the key derivation function to be keyed
+                 * @param[in] salt the optional salt of the KDF (used by HKDF)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not a KEM one or the KDF is not supported
+                 * @exception CryptoErrorDomain::kUninitializedContext if no private key is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the encapsulated secret has a wrong size
+                 * @exception CryptoErrorDomain::kInvalidArgument if the encapsulated secret is not below the modulus
+                 */
+                ara::core::Result<void> Decapsulate (ReadOnlyMemRegion encapsulated, internal::HmacKdf &kdf, ReadOnlyMemRegion salt=ReadOnlyMemRegion()) const noexcept;
+
+                /**
+                 * @brief Wipe the deployed key and the blinding.
+                 */
+                void Clear () noexcept;
+
+            private:
+                bool IsKem () const noexcept;
+                bool HasModulusSize (ReadOnlyMemRegion modulus) const noexcept;
+                void TakeBlinding (internal::Rsa::Blinding &blinding) const noexcept;
+
+                CryptoAlgId mAlgId;
+                internal::Rsa mRsa;
+                mutable std::mutex mBlindingMutex;
+                mutable internal::Rsa::Blinding mBlinding;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_RSA_ENGINE_H
@@ -0,0 +1,361 @@
+#include "ara/crypto/cryp/secure_counter.h"
+
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                const std::uint64_t kMagic = 0x4152414354523031ull;    // "ARACTR01"
+                const std::size_t kPageSize = 4096u;
+
+                /**
+                 * @brief Record of the persistent file. The check word detects a torn or foreign record, which
+                 * must not silently restart the counter.
+                 */
+                struct MarkRecord
+                {
+                    std::uint64_t mMsqw;
+                    std::uint64_t mMark;
+                    std::uint64_t mCheck;
+                };
+
+                std::uint64_t MakeCheck (std::uint64_t msqw, std::uint64_t mark) noexcept
+                {
+                    return kMagic ^ msqw ^ ((mark << 32) | (mark >> 32));
+                }
+
+                /**
+                 * @brief Create the missing directories of the path (up to the last '/'), e.g. the default
+                 * /var/lib/ara_crypto on the first run. The new directories are accessible by the owner only.
+                 */
+                bool CreateParentDirectories (const ara::core::String &path) noexcept
+                {
+                    char directory[PATH_MAX];
+                    const std::size_t end = path.rfind('/');
+                    if ((end == ara::core::String::npos) || (end == 0u))
+                    {
+                        return true;
+                    }
+                    if (end >= sizeof(directory))
+                    {
+                        return false;
+                    }
+                    path.copy(directory, end);
+                    directory[end] = '\0';
+
+                    for (std::size_t i = 1u; i <= end; ++i)
+                    {
+                        if ((directory[i] != '/') && (directory[i] != '\0'))
+                        {
+                            continue;
+                        }
+                        const char separator = directory[i];
+                        directory[i] = '\0';
+                        if ((::mkdir(directory, 0700) != 0) && (errno != EEXIST))
+                        {
+                            return false;
+                        }
+                        directory[i] = separator;
+                    }
+                    return true;
+                }
+
+                bool ReadMark (int fd, std::uint64_t &msqw, std::uint64_t &mark) noexcept
+                {
+                    MarkRecord record;
+                    ssize_t result;
+                    do
+                    {
+                        result = ::pread(fd, &record, sizeof(record), 0);
+                    } while ((result < 0) && (errno == EINTR));
+
+                    if (result == 0)
+                    {
+                        // A new file: the counter starts from zero.
+                        msqw = 0u;
+                        mark = 0u;
+                        return true;
+                    }
+                    if ((result != static_cast<ssize_t>(sizeof(record))) || (record.mCheck != MakeCheck(record.mMsqw, record.mMark)))
+                    {
+                        return false;
+                    }
+                    msqw = record.mMsqw;
+                    mark = record.mMark;
+                    return true;
+                }
+            }
+
+            /**
+             * @brief Layout of the shared page. The fields after mMagic are accessed by lock-free atomic operations
+             * from all processes. mMark is cleared before mMsqw is incremented and set after, so a value is
+             * accepted only if mMsqw is equal before its increment and after the load of mMark.
+             */
+            struct SecureCounterStore::SharedPage
+            {
+                std::uint64_t mMagic;                   // written under the file lock only
+                std::atomic<std::uint64_t> mMsqw;
+                std::atomic<std::uint64_t> mLsqw;       // the next value to take
+                std::atomic<std::uint64_t> mMark;       // the persisted high-water mark: values below it may be taken
+            };
+
+            static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The shared counter requires lock-free 64-bit atomics");
+
+            const char SecureCounterStore::kDefaultSharedPath[] = "/dev/shm/ara_crypto_secure_counter";
+            const char SecureCounterStore::kDefaultPersistentPath[] = "/var/lib/ara_crypto/secure_counter";
+
+            SecureCounterStore::SecureCounterStore (const ara::core::String &sharedPath, const ara::core::String &persistentPath, std::uint64_t batchSize) noexcept :
+                mSharedPath(sharedPath),
+                mPersistentPath(persistentPath),
+                mBatchSize((batchSize == 0u) ? 1u : batchSize),
+                mPage(nullptr),
+                mSharedFd(-1),
+                mPersistentFd(-1)
+            {
+            }
+
+            SecureCounterStore::~SecureCounterStore () noexcept
+            {
+                SharedPage *page = mPage.load();
+                if (page != nullptr)
+                {
+                    ::munmap(page, kPageSize);
+                }
+                if (mSharedFd >= 0)
+                {
+                    ::close(mSharedFd);
+                }
+                if (mPersistentFd >= 0)
+                {
+                    ::close(mPersistentFd);
+                }
+            }
+
+            SecureCounterStore& SecureCounterStore::GetDefault () noexcept
+            {
+                static SecureCounterStore store(kDefaultSharedPath, kDefaultPersistentPath);
+                return store;
+            }
+
+            ara::core::Result<SecureCounter> SecureCounterStore::Next () noexcept
+            {
+                return Reserve(1u);
+            }
+
+            ara::core::Result<SecureCounter> SecureCounterStore::Reserve (std::uint64_t count) noexcept
+            {
+                if ((count == 0u) || (count > mBatchSize))
+                {
+                    return ara::core::Result<SecureCounter>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+
+                ara::core::Result<void> opened = Open();
+                if (!opened.HasValue())
+                {
+                    return ara::core::Result<SecureCounter>::FromError(opened.Error());
+                }
+                SharedPage &page = *mPage.load(std::memory_order_acquire);
+
+                while (true)
+                {
+                    const std::uint64_t msqw = page.mMsqw.load();
+                    const std::uint64_t lsqw = page.mLsqw.fetch_add(count);
+                    if ((page.mMark.load() >= lsqw + count) && (page.mMsqw.load() == msqw))
+                    {
+                        return ara::core::Result<SecureCounter>::FromValue(SecureCounter{lsqw, msqw});
+                    }
+                    if (page.mMsqw.load() != msqw)
+                    {
+                        // The MSQW was incremented concurrently: the taken LSQW may belong to either of them.
+                        continue;
+                    }
+
+                    ara::core::Result<void> extended = Extend(msqw, lsqw, count);
+                    if (!extended.HasValue())
+                    {
+                        return ara::core::Result<SecureCounter>::FromError(extended.Error());
+                    }
+                    // The taken range stays valid if the mark now covers it.
+                    if ((page.mMark.load() >= lsqw + count) && (page.mMsqw.load() == msqw))
+                    {
+                        return ara::core::Result<SecureCounter>::FromValue(SecureCounter{lsqw, msqw});
+                    }
+                }
+            }
+
+            ara::core::Result<void> SecureCounterStore::Open () noexcept
+            {
+                static_assert(sizeof(SharedPage) <= kPageSize, "The shared counter must fit a page");
+
+                if (mPage.load(std::memory_order_acquire) != nullptr)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mPage.load() != nullptr)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                if ((mPersistentFd < 0) && CreateParentDirectories(mPersistentPath))
+                {
+                    mPersistentFd = ::open(mPersistentPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+                }
+                if ((mSharedFd < 0) && CreateParentDirectories(mSharedPath))
+                {
+                    mSharedFd = ::open(mSharedPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+                }
+                if ((mPersistentFd < 0) || (mSharedFd < 0))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+
+                if (!LockFile())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                }
+
+                struct stat status;
+                if ((::fstat(mSharedFd, &status) != 0) ||
+                    ((static_cast<std::size_t>(status.st_size) < kPageSize) && (::ftruncate(mSharedFd, kPageSize) != 0)))
+                {
+                    UnlockFile();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+
+                void *memory = ::mmap(nullptr, kPageSize, PROT_READ | PROT_WRITE, MAP_SHARED, mSharedFd, 0);
+                if (memory == MAP_FAILED)
+                {
+                    UnlockFile();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+
+                SharedPage *page = static_cast<SharedPage*>(memory);
+                if (page->mMagic != kMagic)
+                {
+                    // The shared page is new (e.g. after a power cycle): continue from the persisted mark. The first
+                    // Reserve() finds the mark reached and reserves the next block.
+                    std::uint64_t msqw;
+                    std::uint64_t mark;
+                    if (!ReadMark(mPersistentFd, msqw, mark))
+                    {
+                        ::munmap(memory, kPageSize);
+                        UnlockFile();
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                    }
+                    page = new (memory) SharedPage();
+                    page->mMsqw.store(msqw);
+                    page->mLsqw.store(mark);
+                    page->mMark.store(mark);
+                    page->mMagic = kMagic;
+                }
+                UnlockFile();
+
+                mPage.store(page, std::memory_order_release);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> SecureCounterStore::Extend (std::uint64_t msqw, std::uint64_t lsqw, std::uint64_t count) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!LockFile())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                }
+
+                SharedPage &page = *mPage.load();
+                ara::core::Result<void> result = ara::core::Result<void>::FromValue();
+                if (page.mMsqw.load() != msqw)
+                {
+                    // Another caller has already incremented the MSQW.
+                }
+                else if (lsqw + count > kLsqwLimit)
+                {
+                    // A stale range taken after the MSQW increment but before the LSQW restart is ignored.
+                    if (page.mLsqw.load() > kLsqwLimit)
+                    {
+                        if ((msqw == ~static_cast<std::uint64_t>(0u)) || !WriteMark(msqw + 1u, mBatchSize))
+                        {
+                            result = ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                        }
+                        else
+                        {
+                            page.mMark.store(0u);
+                            page.mMsqw.store(msqw + 1u);
+                            page.mLsqw.store(0u);
+                            page.mMark.store(mBatchSize);
+                        }
+                    }
+                }
+                else
+                {
+                    const std::uint64_t mark = page.mMark.load();
+                    if (mark < lsqw + count)
+                    {
+                        // Reserve the block following the requested range; a burst of callers is served by one write.
+                        const std::uint64_t headroom = kLsqwLimit - (lsqw + count);
+                        const std::uint64_t newMark = lsqw + count + ((headroom < mBatchSize) ? headroom : mBatchSize);
+                        if (WriteMark(msqw, newMark))
+                        {
+                            page.mMark.store(newMark);
+                        }
+                        else
+                        {
+                            result = ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                        }
+                    }
+                }
+
+                UnlockFile();
+                return result;
+            }
+
+            bool SecureCounterStore::LockFile () noexcept
+            {
+                // A process-associated record lock: unlike flock() it is not shared with a forked child.
+                struct flock request = {};
+                request.l_type = F_WRLCK;
+                request.l_whence = SEEK_SET;
+                int result;
+                do
+                {
+                    result = ::fcntl(mPersistentFd, F_SETLKW, &request);
+                } while ((result != 0) && (errno == EINTR));
+                return (result == 0);
+            }
+
+            void SecureCounterStore::UnlockFile () noexcept
+            {
+                struct flock request = {};
+                request.l_type = F_UNLCK;
+                request.l_whence = SEEK_SET;
+                ::fcntl(mPersistentFd, F_SETLK, &request);
+            }
+
+            bool SecureCounterStore::WriteMark (std::uint64_t msqw, std::uint64_t mark) noexcept
+            {
+                const MarkRecord record = {msqw, mark, MakeCheck(msqw, mark)};
+                ssize_t result;
+                do
+                {
+                    result = ::pwrite(mPersistentFd, &record, sizeof(record), 0);
+                } while ((result < 0) && (errno == EINTR));
+                return (result == static_cast<ssize_t>(sizeof(record))) && (::fdatasync(mPersistentFd) == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef ARA_CRYPTO_CRYP_SECURE_COUNTER_H
+#define ARA_CRYPTO_CRYP_SECURE_COUNTER_H
+
+#include <atomic>
+#include <cinttypes>
+#include <mutex>
+
+#include "ara/core/result.h"
+#include "ara/core/string.h"
+
+#include "ara/crypto/cryp/common/entry_point.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Monotonic 128-bit counter shared by all processes of the Crypto Stack. The current value lives
+             * in a memory-mapped page (normally on a tmpfs, i.e. the "low-power" domain) and is incremented by a
+             * lock-free atomic operation. Values are handed out only below a high-water mark that is persisted to
+             * the non-volatile storage before it is published: when the mark is reached, one caller reserves the
+             * next block of kDefaultBatchSize values by writing a new mark to the disk. If the shared page is lost
+             * (e.g. by a power cycle), the counter continues from the persisted mark, so no value is ever repeated.
+             * The MSQW is incremented when the LSQW reaches kLsqwLimit.
+             */
+            class SecureCounterStore
+            {
+            public:
+
+                /**
+                 * @brief Default number of values reserved by a single write to the persistent storage.
+                 */
+                static const std::uint64_t kDefaultBatchSize = 1ull << 16;
+
+                /**
+                 * @brief Bound of the LSQW: reaching it increments the MSQW and restarts the LSQW from zero. The
+                 * upper half of the LSQW range is a headroom for concurrent increments that overshoot the bound.
+                 */
+                static const std::uint64_t kLsqwLimit = 1ull << 63;
+
+                /**
+                 * @brief Default path of the shared page with the current value.
+                 */
+                static const char kDefaultSharedPath[];
+
+                /**
+                 * @brief Default path of the file with the persisted high-water mark.
+                 */
+                static const char kDefaultPersistentPath[];
+
+                /**
+                 * @brief Construct a new Secure Counter Store object. The files are opened on the first use.
+                 * @param[in] sharedPath path of the shared page (created with the missing parent directories if
+                 * it does not exist)
+                 * @param[in] persistentPath path of the high-water mark file (created with the missing parent
+                 * directories if it does not exist)
+                 * @param[in] batchSize number of values reserved by a single write to the persistent storage (at least 1)
+                 */
+                SecureCounterStore (const ara::core::String &sharedPath, const ara::core::String &persistentPath, std::uint64_t batchSize=kDefaultBatchSize) noexcept;
+
+                ~SecureCounterStore () noexcept;
+
+                SecureCounterStore (const SecureCounterStore&) = delete;
+                SecureCounterStore& operator= (const SecureCounterStore&) = delete;
+
+                /**
+                 * @brief Get the instance using the default paths, shared by GetSecureCounter().
+                 * @return SecureCounterStore& the default store
+                 */
+                static SecureCounterStore& GetDefault () noexcept;
+
+                /**
+                 * @brief Take the next value of the counter.
+                 * @return ara::core::Result<SecureCounter> a value greater than all values taken before (by any process)
+                 * @exception CryptoErrorDomain::kAccessViolation if the shared page or the persistent file (or its directory) cannot be created or opened
+                 * @exception CryptoErrorDomain::kRuntimeFault if the persistent file is corrupted or cannot be written
+                 */
+                ara::core::Result<SecureCounter> Next () noexcept;
+
+                /**
+                 * @brief Take a contiguous range of values, e.g. for freshness values of a batch of messages. The
+                 * range never crosses an increment of the MSQW.
+                 * @param[in] count number of values to take (1 up to the batch size)
+                 * @return ara::core::Result<SecureCounter> the first value of the range; the following values have
+                 * the same MSQW and the LSQW incremented by 1 up to count - 1
+                 * @exception CryptoErrorDomain::kInvalidArgument if count is zero or exceeds the batch size
+                 * @exception CryptoErrorDomain::kAccessViolation if the shared page or the persistent file (or its directory) cannot be created or opened
+                 * @exception CryptoErrorDomain::kRuntimeFault if the persistent file is corrupted or cannot be written
+                 */
+                ara::core::Result<SecureCounter> Reserve (std::uint64_t count) noexcept;
+
+            private:
+                struct SharedPage;
+
+                ara::core::Result<void> Open () noexcept;
+                ara::core::Result<void> Extend (std::uint64_t msqw, std::uint64_t lsqw, std::uint64_t count) noexcept;
+                bool LockFile () noexcept;
+                void UnlockFile () noexcept;
+                bool WriteMark (std::uint64_t msqw, std::uint64_t mark) noexcept;
+
+                ara::core::String mSharedPath;
+                ara::core::String mPersistentPath;
+                std::uint64_t mBatchSize;
+
+                std::mutex mMutex;  // serializes Open() and Extend() within the process, the file lock across processes
+                std::atomic<SharedPage*> mPage;
+                int mSharedFd;
+                int mPersistentFd;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_SECURE_COUNTER_H
@@ -0,0 +1,118 @@
+#include "ara/crypto/cryp/signer_engine.h"
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            SignerEngine::SignerEngine (CryptoAlgId algId) noexcept : mAlgId(algId), mKeySet(false)
+            {
+            }
+
+            SignerEngine::~SignerEngine () noexcept
+            {
+                Clear();
+            }
+
+            bool SignerEngine::IsSupported () const noexcept
+            {
+                return (mAlgId == kAlgIdEd25519) || (mAlgId == kAlgIdEcdsaP256Sha2_256);
+            }
+
+            std::size_t SignerEngine::GetPrivateKeySize () const noexcept
+            {
+                return (mAlgId == kAlgIdEd25519) ? internal::Ed25519::kSeedSize : internal::EcdsaP256::kPrivateKeySize;
+            }
+
+            std::size_t SignerEngine::GetSignatureSize () const noexcept
+            {
+                return (mAlgId == kAlgIdEd25519) ? internal::Ed25519::kSignatureSize : internal::EcdsaP256::kSignatureSize;
+            }
+
+            ara::core::Result<void> SignerEngine::SetKey (ReadOnlyMemRegion privateKey) noexcept
+            {
+                if (!IsSupported())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if (privateKey.size() != GetPrivateKeySize())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                Clear();
+                if (mAlgId == kAlgIdEd25519)
+                {
+                    internal::Ed25519::ExpandKey(privateKey.data(), mEd25519);
+                }
+                else if (!internal::EcdsaP256::ExpandKey(privateKey.data(), mEcdsa))
+                {
+                    internal::EcdsaP256::Clear(mEcdsa);
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                mKeySet = true;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ReadOnlyMemRegion SignerEngine::GetPublicKey () const noexcept
+            {
+                if (!mKeySet)
+                {
+                    return ReadOnlyMemRegion();
+                }
+                if (mAlgId == kAlgIdEd25519)
+                {
+                    return ReadOnlyMemRegion(mEd25519.mPublicKey, sizeof(mEd25519.mPublicKey));
+                }
+                return ReadOnlyMemRegion(mEcdsa.mPublicKey, sizeof(mEcdsa.mPublicKey));
+            }
+
+            ara::core::Result<std::size_t> SignerEngine::Sign (ReadOnlyMemRegion value, ReadWriteMemRegion signature, ReadOnlyMemRegion context) const noexcept
+            {
+                if (!mKeySet)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                }
+                if (signature.size() < GetSignatureSize())
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                }
+
+                if (mAlgId == kAlgIdEd25519)
+                {
+                    if (!internal::Ed25519::Sign(mEd25519, value.data(), value.size(), context.data(), context.size(), signature.data()))
+                    {
+                        return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                }
+                else
+                {
+                    if (value.empty() || !context.empty())
+                    {
+                        return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    internal::EcdsaP256::Sign(mEcdsa, value.data(), value.size(), signature.data());
+                }
+                return ara::core::Result<std::size_t>::FromValue(GetSignatureSize());
+            }
+
+            void SignerEngine::Clear () noexcept
+            {
+                // Both members of the union are plain data, wiping the larger one covers the other.
+                if (sizeof(mEd25519) > sizeof(mEcdsa))
+                {
+                    internal::Ed25519::Clear(mEd25519);
+                }
+                else
+                {
+                    internal::EcdsaP256::Clear(mEcdsa);
+                }
+                mKeySet = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef ARA_CRYPTO_CRYP_SIGNER_ENGINE_H
+#define ARA_CRYPTO_CRYP_SIGNER_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/ecdsa.h"
+#include "ara/crypto/cryp/internal/ed25519.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Signature engine for Ed25519 / Ed25519ctx (RFC 8032) and ECDSA over NIST P-256 with
+             * deterministic nonces (RFC 6979). It is not wired to a SignerPrivateCtx, the tree has no implementation
+             * of one; its Sign() is what an override of SignerPrivateCtx::SignInto() would call. SetKey() prepares everything derived from the
+             * private key once (the expanded Ed25519 key, the ECDSA scalar in the Montgomery form, the public
+             * key), so repeated signatures with the same key cost only the hashing, one fixed-base comb
+             * multiplication and a few scalar operations. Signatures are written into caller provided buffers.
+             * Sign() does not modify the object and may be called concurrently.
+             */
+            class SignerEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Signer Engine object.
+                 * @param[in] algId kAlgIdEd25519 or kAlgIdEcdsaP256Sha2_256
+                 */
+                explicit SignerEngine (CryptoAlgId algId) noexcept;
+
+                /**
+                 * @brief Destroy the Signer Engine object wiping the prepared key.
+                 */
+                ~SignerEngine () noexcept;
+
+                SignerEngine (const SignerEngine &) = delete;
+                SignerEngine& operator= (const SignerEngine &) = delete;
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept;
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Get the size of a private key in bytes.
+                 * @return std::size_t
+                 */
+                std::size_t GetPrivateKeySize () const noexcept;
+
+                /**
+                 * @brief Get the size of a signature in bytes (r || s for ECDSA).
+                 * @return std::size_t
+                 */
+                std::size_t GetSignatureSize () const noexcept;
+
+                /**
+                 * @brief Deploy a private key and prepare its signing state.
+                 * @param[in] privateKey the private key (the Ed25519 seed or the big-endian ECDSA scalar)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the private key has a wrong size
+                 * @exception CryptoErrorDomain::kInvalidArgument if the private key is out of range
+                 */
+                ara::core::Result<void> SetKey (ReadOnlyMemRegion privateKey) noexcept;
+
+                /**
+                 * @brief Check if a key is deployed.
+                 * @return true if SetKey() succeeded and Clear() was not called since
+                 */
+                bool IsKeySet () const noexcept
+                {
+                    return mKeySet;
+                }
+
+                /**
+                 * @brief Get the public key of the deployed private key (the uncompressed point for ECDSA).
+                 * @return ReadOnlyMemRegion the public key, empty if no key is deployed
+                 */
+                ReadOnlyMemRegion GetPublicKey () const noexcept;
+
+                /**
+                 * @brief Sign a value into a caller provided buffer.
+                 * @param[in] value the message for Ed25519, the message digest for ECDSA
+                 * @param[out] signature the buffer for the signature of at least GetSignatureSize() bytes
+                 * @param[in] context the Ed25519ctx context (must be empty for ECDSA)
+                 * @return ara::core::Result<std::size_t> actual size of the signature value stored to the output buffer
+                 * @exception CryptoErrorDomain::kUninitializedContext if no key is deployed
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the ECDSA digest is empty or the context is too long or unsupported
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if the signature buffer is too small
+                 */
+                ara::core::Result<std::size_t> Sign (ReadOnlyMemRegion value, ReadWriteMemRegion signature, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept;
+
+                /**
+                 * @brief Wipe the deployed key.
+                 */
+                void Clear () noexcept;
+
+            private:
+                CryptoAlgId mAlgId;
+                bool mKeySet;
+                union
+                {
+                    internal::Ed25519::SigningKey mEd25519;
+                    internal::EcdsaP256::SigningKey mEcdsa;
+                };
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_SIGNER_ENGINE_H
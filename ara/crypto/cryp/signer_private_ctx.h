@@ -1,6 +1,12 @@
 #ifndef ARA_CRYPTO_CRYP_SIGNER_PRIVATE_CTX_H
 #define ARA_CRYPTO_CRYP_SIGNER_PRIVATE_CTX_H
 
+#include "ara/core/utility.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
 
 namespace ara
@@ -80,6 +86,65 @@ namespace ara
                  */
                 virtual ara::core::Result<ara::core::Vector<ara::core::Byte> > Sign (ReadOnlyMemRegion value, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept=0;
 
+                /**
+                 * @brief Sign a directly provided hash or message value into a caller provided buffer, the
+                 * counterpart of Sign() for callers that keep the signature in their own memory. A context
+                 * over an engine writing into the buffer (like SignerEngine) overrides it to sign without an
+                 * allocation; the default calls Sign() and copies the returned vector, so it allocates.
+                 * @param[in] value the (pre-)hashed or direct message value that should be signed
+                 * @param[out] signature the buffer for the signature value
+                 * @param[in] context an optional user supplied "context" (its support depends from concrete algorithm)
+                 * @return ara::core::Result<std::size_t> actual size of the signature value stored to the output buffer
+                 * @exception CryptoErrorDomain::kInvalidInputSize if size of the input value or context arguments are incorrect / unsupported
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if capacity of the output signature buffer is not enough
+                 * @exception CryptoErrorDomain::kUninitializedContext this context was not initialized by a key value
+                 */
+                virtual ara::core::Result<std::size_t> SignInto (ReadOnlyMemRegion value, ReadWriteMemRegion signature, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept
+                {
+                    ara::core::Result<ara::core::Vector<ara::core::Byte> > produced = Sign(value, context);
+                    if (!produced.HasValue())
+                    {
+                        return ara::core::Result<std::size_t>::FromError(produced.Error());
+                    }
+
+                    const ara::core::Vector<ara::core::Byte> &result = produced.Value();
+                    if (result.size() > signature.size())
+                    {
+                        return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientCapacity);
+                    }
+                    for (std::size_t i = 0; i < result.size(); ++i)
+                    {
+                        signature[i] = static_cast<std::uint8_t>(result[i]);
+                    }
+                    return ara::core::Result<std::size_t>::FromValue(result.size());
+                }
+
+                /**
+                 * @brief Sign a directly provided digest value into a caller provided buffer, the counterpart of
+                 * SignPreHashed() without a Signature object. The buffer gets the bare signature value, without
+                 * the hash-function algorithm ID and the COUID a Signature object carries. The Signature object
+                 * does not expose its value, so there is no fallback on SignPreHashed(): a context supports it
+                 * only by overriding it.
+                 * @param[in] hashAlgId hash function algorithm ID
+                 * @param[in] hashValue hash function value (resulting digest without any truncations)
+                 * @param[out] signature the buffer for the signature value
+                 * @param[in] context an optional user supplied "context" (its support depends from concrete algorithm)
+                 * @return ara::core::Result<std::size_t> actual size of the signature value stored to the output buffer
+                 * @exception CryptoErrorDomain::kInvalidArgument if hash-function algorithm does not comply with the signature algorithm specification of this context
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the user supplied context has incorrect (or unsupported) size
+                 * @exception CryptoErrorDomain::kInsufficientCapacity if capacity of the output signature buffer is not enough
+                 * @exception CryptoErrorDomain::kUninitializedContext this context was not initialized by a key value
+                 * @exception CryptoErrorDomain::kUnsupported if the context does not override this method
+                 */
+                virtual ara::core::Result<std::size_t> SignPreHashedInto (AlgId hashAlgId, ReadOnlyMemRegion hashValue, ReadWriteMemRegion signature, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept
+                {
+                    static_cast<void>(hashAlgId);
+                    static_cast<void>(hashValue);
+                    static_cast<void>(signature);
+                    static_cast<void>(context);
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+
                 /**
                  * @brief [SWS_CRYPT_23513]
                  * Sign a directly provided digest value and create the Signature object. This method must put the
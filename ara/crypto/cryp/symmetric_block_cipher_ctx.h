@@ -2,6 +2,7 @@
 #define ARA_CRYPTO_CRYP_SYMMETRIC_BLOCK_CIPHER_CTX_H
 
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
 
 namespace ara
 {
@@ -75,6 +76,37 @@ namespace ara
                  */
                 virtual ara::core::Result<ara::core::Vector<ara::core::Byte> > ProcessBlocks (ReadOnlyMemRegion in) const noexcept=0;
 
+                /**
+                 * @brief Process (encrypt / decrypt) blocks of data in place according to the configuration. It is a
+                 * copy-optimized counterpart of the ProcessBlocks(ReadOnlyMemRegion) method: the result overwrites the
+                 * input, so no output buffer is allocated. The inOut must have a size that is divisible by the block size
+                 * (see GetBlockSize()). The default implementation falls back to the copying method. A context can
+                 * override it to process the buffer in place (as BlockCipherEngine::ProcessBlocks() does for AES/ECB).
+                 * @param[in,out] inOut an input and output data buffer, i.e. the whole buffer should be updated
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kInvalidInputSize if size of the inOut buffer is not divisible by the block size (see GetBlockSize())
+                 * @exception CryptoErrorDomain::kUninitializedContext if the context was not initialized by calling SetKey()
+                 */
+                virtual ara::core::Result<void> ProcessBlocks (ReadWriteMemRegion inOut) const noexcept
+                {
+                    ara::core::Result<ara::core::Vector<ara::core::Byte> > processed = ProcessBlocks(ReadOnlyMemRegion(inOut));
+                    if (!processed.HasValue())
+                    {
+                        return ara::core::Result<void>::FromError(processed.Error());
+                    }
+
+                    const ara::core::Vector<ara::core::Byte> &out = processed.Value();
+                    if (out.size() != inOut.size())
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                    }
+                    for (std::size_t i = 0; i < out.size(); ++i)
+                    {
+                        inOut[i] = static_cast<std::uint8_t>(out[i]);
+                    }
+                    return ara::core::Result<void>::FromValue();
+                }
+
                 /**
                  * @brief [SWS_CRYPT_23712]
                  * Indicate that the currently configured transformation accepts only complete blocks of input data.
@@ -1,6 +1,15 @@
 #ifndef ARA_CRYPTO_CRYP_SYMMETRIC_KEY_WRAPPER_CTX_H
 #define ARA_CRYPTO_CRYP_SYMMETRIC_KEY_WRAPPER_CTX_H
 
+#include <new>
+
+#include "ara/core/span.h"
+#include "ara/core/utility.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
 #include "ara/crypto/cryp/cryobj/symmetric_key.h"
 
@@ -144,6 +153,84 @@ namespace ara
                  * @exception CryptoErrorDomain::kUninitializedContext if the context was not initialized by a key value
                  */
                 virtual ara::core::Result<ara::core::Vector<ara::core::Byte> > WrapKeyMaterial (const RestrictedUseObject &key) const noexcept=0;
+
+                /**
+                 * @brief Execute the "key wrap" operation for a batch of key materials under the deployed key (e.g.
+                 * all keys of an ECU exported by a key provisioning step). The default implementation calls
+                 * WrapKeyMaterial() for every key; an implementation may override it to share the key schedule
+                 * and to pipeline the block cipher calls of independent keys (see KeyWrapEngine::WrapBatch()).
+                 * @param[in] keys the keys that should be wrapped
+                 * @return ara::core::Result<ara::core::Vector<ara::core::Vector<ara::core::Byte> > > the wrapped keys in the order of the input
+                 * @exception CryptoErrorDomain::kInvalidArgument if a key pointer is null
+                 * @exception CryptoErrorDomain::kInvalidInputSize if a key object has an unsupported length
+                 * @exception CryptoErrorDomain::kUninitializedContext if the context was not initialized by a key value
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result cannot be allocated
+                 */
+                virtual ara::core::Result<ara::core::Vector<ara::core::Vector<ara::core::Byte> > > WrapKeyMaterials (ara::core::Span<const RestrictedUseObject* const> keys) const noexcept
+                {
+                    ara::core::Vector<ara::core::Vector<ara::core::Byte> > wrapped;
+                    try
+                    {
+                        // The wrapped keys are moved in within the reserved capacity, so push_back() below cannot throw.
+                        wrapped.reserve(keys.size());
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return ara::core::Result<ara::core::Vector<ara::core::Vector<ara::core::Byte> > >::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                    }
+                    for (const RestrictedUseObject *key : keys)
+                    {
+                        if (key == nullptr)
+                        {
+                            return ara::core::Result<ara::core::Vector<ara::core::Vector<ara::core::Byte> > >::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                        }
+                        ara::core::Result<ara::core::Vector<ara::core::Byte> > result = WrapKeyMaterial(*key);
+                        if (!result.HasValue())
+                        {
+                            return ara::core::Result<ara::core::Vector<ara::core::Vector<ara::core::Byte> > >::FromError(result.Error());
+                        }
+                        wrapped.push_back(std::move(result).Value());
+                    }
+                    return ara::core::Result<ara::core::Vector<ara::core::Vector<ara::core::Byte> > >::FromValue(std::move(wrapped));
+                }
+
+                /**
+                 * @brief Execute the "key unwrap" operation for a batch of wrapped keys of the same target algorithm
+                 * and usage, the counterpart of WrapKeyMaterials() (e.g. all keys of an ECU imported by a key
+                 * provisioning step). The default implementation calls UnwrapKey() for every wrapped key; an
+                 * implementation may override it to unwrap the keys under one key schedule in lockstep (see
+                 * KeyWrapEngine::UnwrapBatch()). All the keys are unwrapped or none: the first failure is reported.
+                 * @param[in] wrappedKeys the memory regions that contain the wrapped keys
+                 * @param[in] algId an identifier of the target symmetric crypto algorithm
+                 * @param[in] allowedUsage bit-flags that define a list of allowed transformations’ types in which the target keys can be used
+                 * @return ara::core::Result<ara::core::Vector<RestrictedUseObject::Uptrc> > the unwrapped keys in the order of the input
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the size of a provided wrapped key is unsupported
+                 * @exception CryptoErrorDomain::kUninitializedContext if the context was not initialized by a key value
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result cannot be allocated
+                 */
+                virtual ara::core::Result<ara::core::Vector<RestrictedUseObject::Uptrc> > UnwrapKeys (ara::core::Span<const ReadOnlyMemRegion> wrappedKeys, AlgId algId, AllowedUsageFlags allowedUsage) const noexcept
+                {
+                    ara::core::Vector<RestrictedUseObject::Uptrc> unwrapped;
+                    try
+                    {
+                        // The keys are moved in within the reserved capacity, so push_back() below cannot throw.
+                        unwrapped.reserve(wrappedKeys.size());
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return ara::core::Result<ara::core::Vector<RestrictedUseObject::Uptrc> >::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                    }
+                    for (const ReadOnlyMemRegion &wrappedKey : wrappedKeys)
+                    {
+                        ara::core::Result<RestrictedUseObject::Uptrc> result = UnwrapKey(wrappedKey, algId, allowedUsage);
+                        if (!result.HasValue())
+                        {
+                            return ara::core::Result<ara::core::Vector<RestrictedUseObject::Uptrc> >::FromError(result.Error());
+                        }
+                        unwrapped.push_back(std::move(result).Value());
+                    }
+                    return ara::core::Result<ara::core::Vector<RestrictedUseObject::Uptrc> >::FromValue(std::move(unwrapped));
+                }
             };
         }
     }
@@ -0,0 +1,220 @@
+#include "ara/crypto/cryp/system_random.h"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/drbg.h"
+#include "ara/crypto/cryp/internal/entropy_source.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                const CryptoAlgId kGenerators[] = {kAlgIdChaCha20Rng, kAlgIdCtrDrbgAes256, kAlgIdHmacDrbgSha2_256};
+                const std::size_t kGeneratorCount = sizeof(kGenerators) / sizeof(kGenerators[0]);
+
+                // Maximal size of the additional input mixed by Reseed().
+                const std::size_t kMaxAdditionalSize = 32u;
+
+                void Wipe (void *data, std::size_t size) noexcept
+                {
+                    volatile std::uint8_t *bytes = static_cast<volatile std::uint8_t*>(data);
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        bytes[i] = 0u;
+                    }
+                }
+
+                /**
+                 * @brief Generator of a thread together with its pre-generated output.
+                 */
+                struct Instance
+                {
+                    std::unique_ptr<internal::Drbg> mDrbg;
+                    std::uint8_t mBuffer[SystemRandom::kBufferSize];
+                    std::size_t mAvailable = 0u;    // number of not consumed bytes at the end of mBuffer
+                    pid_t mPid = 0;                 // the process that has seeded the generator
+
+                    ~Instance () noexcept
+                    {
+                        Wipe(mBuffer, sizeof(mBuffer));
+                    }
+
+                    void Discard () noexcept
+                    {
+                        Wipe(mBuffer, sizeof(mBuffer));
+                        mAvailable = 0u;
+                    }
+                };
+
+                thread_local Instance tInstances[kGeneratorCount];
+
+                bool Seed (Instance &instance, CryptoAlgId algId, const std::uint8_t *additional, std::size_t additionalSize) noexcept
+                {
+                    if (!instance.mDrbg)
+                    {
+                        instance.mDrbg = internal::Drbg::Create(algId);
+                        if (!instance.mDrbg)
+                        {
+                            return false;
+                        }
+                        instance.mDrbg->SetReseedInterval(SystemRandom::kReseedInterval);
+                    }
+
+                    std::uint8_t entropy[48];
+                    const std::size_t seedSize = instance.mDrbg->GetSeedSize();
+                    if ((seedSize > sizeof(entropy)) || !internal::GetSystemEntropy(entropy, seedSize))
+                    {
+                        return false;
+                    }
+
+                    const pid_t pid = ::getpid();
+                    if (!instance.mDrbg->IsInstantiated())
+                    {
+                        // The personalization string separates instances of threads and processes.
+                        std::uint8_t personalization[16] = {};
+                        const std::uint64_t threadHash = static_cast<std::uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+                        const std::uint64_t processId = static_cast<std::uint64_t>(pid);
+                        std::memcpy(personalization, &threadHash, sizeof(threadHash));
+                        std::memcpy(personalization + 8u, &processId, sizeof(processId));
+                        instance.mDrbg->Instantiate(entropy, personalization, sizeof(personalization));
+                    }
+                    else
+                    {
+                        instance.mDrbg->Reseed(entropy, additional, additionalSize);
+                    }
+                    Wipe(entropy, sizeof(entropy));
+
+                    instance.mPid = pid;
+                    instance.Discard();
+                    return true;
+                }
+
+                ara::core::Result<Instance*> Acquire (CryptoAlgId algId) noexcept
+                {
+                    std::size_t index = 0;
+                    while ((index < kGeneratorCount) && (kGenerators[index] != algId))
+                    {
+                        ++index;
+                    }
+                    if (index == kGeneratorCount)
+                    {
+                        return ara::core::Result<Instance*>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                    }
+
+                    Instance &instance = tInstances[index];
+                    // A child process must not repeat the output of its parent.
+                    const bool ready = instance.mDrbg && instance.mDrbg->IsInstantiated() && (instance.mPid == ::getpid());
+                    if (!ready && !Seed(instance, algId, nullptr, 0u))
+                    {
+                        return ara::core::Result<Instance*>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                    }
+                    return ara::core::Result<Instance*>::FromValue(&instance);
+                }
+
+                bool Produce (Instance &instance, CryptoAlgId algId, std::uint8_t *out, std::size_t size) noexcept
+                {
+                    while (size != 0u)
+                    {
+                        const std::size_t length = (size < internal::Drbg::kMaxRequestSize) ? size : internal::Drbg::kMaxRequestSize;
+                        internal::Drbg::Status status = instance.mDrbg->Generate(out, length);
+                        if (status == internal::Drbg::Status::kReseedRequired)
+                        {
+                            if (!Seed(instance, algId, nullptr, 0u))
+                            {
+                                return false;
+                            }
+                            status = instance.mDrbg->Generate(out, length);
+                        }
+                        if (status != internal::Drbg::Status::kOk)
+                        {
+                            return false;
+                        }
+                        out += length;
+                        size -= length;
+                    }
+                    return true;
+                }
+
+                void Take (Instance &instance, std::uint8_t *out, std::size_t size) noexcept
+                {
+                    std::uint8_t *source = instance.mBuffer + (SystemRandom::kBufferSize - instance.mAvailable);
+                    std::memcpy(out, source, size);
+                    Wipe(source, size);
+                    instance.mAvailable -= size;
+                }
+            }
+
+            ara::core::Result<void> SystemRandom::Fill (ReadWriteMemRegion output, CryptoAlgId algId) noexcept
+            {
+                ara::core::Result<Instance*> acquired = Acquire(algId);
+                if (!acquired.HasValue())
+                {
+                    return ara::core::Result<void>::FromError(acquired.Error());
+                }
+                Instance &instance = *acquired.Value();
+
+                std::uint8_t *out = output.data();
+                std::size_t size = output.size();
+                if (size >= (kBufferSize / 2u))
+                {
+                    if (!Produce(instance, algId, out, size))
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                    }
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                if (instance.mAvailable < size)
+                {
+                    const std::size_t head = instance.mAvailable;
+                    Take(instance, out, head);
+                    out += head;
+                    size -= head;
+                    if (!Produce(instance, algId, instance.mBuffer, kBufferSize))
+                    {
+                        instance.Discard();
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                    }
+                    instance.mAvailable = kBufferSize;
+                }
+                Take(instance, out, size);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<ara::core::Vector<ara::core::Byte> > SystemRandom::Generate (std::uint32_t count, CryptoAlgId algId) noexcept
+            {
+                ara::core::Vector<ara::core::Byte> random(count);
+                ara::core::Result<void> filled = Fill(ReadWriteMemRegion(reinterpret_cast<std::uint8_t*>(random.data()), random.size()), algId);
+                if (!filled.HasValue())
+                {
+                    return ara::core::Result<ara::core::Vector<ara::core::Byte> >::FromError(filled.Error());
+                }
+                return ara::core::Result<ara::core::Vector<ara::core::Byte> >::FromValue(std::move(random));
+            }
+
+            ara::core::Result<void> SystemRandom::Reseed (ReadOnlyMemRegion additional, CryptoAlgId algId) noexcept
+            {
+                ara::core::Result<Instance*> acquired = Acquire(algId);
+                if (!acquired.HasValue())
+                {
+                    return ara::core::Result<void>::FromError(acquired.Error());
+                }
+                const std::size_t additionalSize = (additional.size() < kMaxAdditionalSize) ? additional.size() : kMaxAdditionalSize;
+                if (!Seed(*acquired.Value(), algId, additional.data(), additionalSize))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+        }
+    }
+}
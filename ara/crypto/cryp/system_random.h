@@ -0,0 +1,83 @@
+#ifndef ARA_CRYPTO_CRYP_SYSTEM_RANDOM_H
+#define ARA_CRYPTO_CRYP_SYSTEM_RANDOM_H
+
+#include <cinttypes>
+
+#include "ara/core/result.h"
+#include "ara/core/utility.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Global random number generator of the Crypto Stack. Every thread owns its own DRBG instance
+             * (per algorithm), seeded from the operating system entropy source on first use, so concurrent callers
+             * never contend on a lock. Small requests (e.g. IVs and nonces) are served from a per-thread buffer of
+             * pre-generated output that is wiped as it is consumed; large requests are generated directly into the
+             * caller's buffer. An instance is reseeded from the system entropy after kReseedInterval requests and
+             * after a fork() of the process.
+             */
+            class SystemRandom
+            {
+            public:
+
+                /**
+                 * @brief Algorithm of the generator used by default.
+                 */
+                static const CryptoAlgId kDefaultAlgId = kAlgIdChaCha20Rng;
+
+                /**
+                 * @brief Size of the per-thread buffer of pre-generated output in bytes. Requests of at least a
+                 * half of this size bypass the buffer.
+                 */
+                static const std::size_t kBufferSize = 512u;
+
+                /**
+                 * @brief Number of DRBG requests between two reseeds from the system entropy source.
+                 */
+                static const std::uint64_t kReseedInterval = 1ull << 20;
+
+                /**
+                 * @brief Fill a buffer with random bytes.
+                 * @param[out] output the buffer to fill
+                 * @param[in] algId the generator algorithm: kAlgIdChaCha20Rng, kAlgIdCtrDrbgAes256 or kAlgIdHmacDrbgSha2_256
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if algId is not a supported generator
+                 * @exception CryptoErrorDomain::kBusyResource if the system entropy source cannot provide a seed
+                 */
+                static ara::core::Result<void> Fill (ReadWriteMemRegion output, CryptoAlgId algId=kDefaultAlgId) noexcept;
+
+                /**
+                 * @brief Return an allocated buffer with random bytes.
+                 * @param[in] count number of random bytes to generate
+                 * @param[in] algId the generator algorithm (see Fill())
+                 * @return ara::core::Result<ara::core::Vector<ara::core::Byte> > a buffer filled with the random bytes
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if algId is not a supported generator
+                 * @exception CryptoErrorDomain::kBusyResource if the system entropy source cannot provide a seed
+                 */
+                static ara::core::Result<ara::core::Vector<ara::core::Byte> > Generate (std::uint32_t count, CryptoAlgId algId=kDefaultAlgId) noexcept;
+
+                /**
+                 * @brief Reseed the calling thread's generator from the system entropy source, mixing an optional
+                 * additional input, and discard its pre-generated output.
+                 * @param[in] additional an optional additional input (up to 32 bytes are used)
+                 * @param[in] algId the generator algorithm (see Fill())
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if algId is not a supported generator
+                 * @exception CryptoErrorDomain::kBusyResource if the system entropy source cannot provide a seed
+                 */
+                static ara::core::Result<void> Reseed (ReadOnlyMemRegion additional=ReadOnlyMemRegion(), CryptoAlgId algId=kDefaultAlgId) noexcept;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_SYSTEM_RANDOM_H
@@ -0,0 +1,94 @@
+#include "ara/crypto/cryp/verifier_engine.h"
+
+#include <algorithm>
+#include <new>
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/ed25519.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // Items passed to Ed25519::VerifyBatch() at once (one entropy request each), collected on the stack.
+                const std::size_t kChunkSize = 8u * internal::Ed25519::kMaxBatchSize;
+            }
+
+            bool VerifierEngine::IsSupported () const noexcept
+            {
+                return (mAlgId == kAlgIdEd25519);
+            }
+
+            ara::core::Result<bool> VerifierEngine::Verify (ReadOnlyMemRegion publicKey, ReadOnlyMemRegion value, ReadOnlyMemRegion signature, ReadOnlyMemRegion context) const noexcept
+            {
+                if (!IsSupported())
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                if ((publicKey.size() != internal::Ed25519::kPublicKeySize) || (signature.size() != internal::Ed25519::kSignatureSize) ||
+                    (context.size() > internal::Ed25519::kMaxContextSize))
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+                return ara::core::Result<bool>::FromValue(internal::Ed25519::Verify(publicKey.data(), value.data(), value.size(), context.data(), context.size(), signature.data()));
+            }
+
+            ara::core::Result<ara::core::Vector<bool> > VerifierEngine::VerifyBatch (ara::core::Span<const ReadOnlyMemRegion> publicKeys, ara::core::Span<const ReadOnlyMemRegion> values, ara::core::Span<const ReadOnlyMemRegion> signatures, ReadOnlyMemRegion context) const noexcept
+            {
+                using BatchResult = ara::core::Result<ara::core::Vector<bool> >;
+
+                if (!IsSupported())
+                {
+                    return BatchResult::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+                const std::size_t count = values.size();
+                if ((publicKeys.size() != count) || (signatures.size() != count))
+                {
+                    return BatchResult::FromError(CryptoErrorDomain::Errc::kIncompatibleArguments);
+                }
+                if (context.size() > internal::Ed25519::kMaxContextSize)
+                {
+                    return BatchResult::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                ara::core::Vector<bool> verified;
+                try
+                {
+                    verified.assign(count, false);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return BatchResult::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+
+                internal::Ed25519::BatchItem items[kChunkSize];
+                std::size_t indices[kChunkSize];
+                bool results[kChunkSize];
+                for (std::size_t first = 0; first < count; first += kChunkSize)
+                {
+                    const std::size_t end = std::min(count, first + kChunkSize);
+                    std::size_t itemCount = 0;
+                    for (std::size_t i = first; i < end; ++i)
+                    {
+                        if ((publicKeys[i].size() == internal::Ed25519::kPublicKeySize) && (signatures[i].size() == internal::Ed25519::kSignatureSize))
+                        {
+                            items[itemCount] = internal::Ed25519::BatchItem{publicKeys[i].data(), values[i].data(), values[i].size(), signatures[i].data()};
+                            indices[itemCount++] = i;
+                        }
+                    }
+                    internal::Ed25519::VerifyBatch(items, itemCount, context.data(), context.size(), results);
+                    for (std::size_t j = 0; j < itemCount; ++j)
+                    {
+                        verified[indices[j]] = results[j];
+                    }
+                }
+                return BatchResult::FromValue(std::move(verified));
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef ARA_CRYPTO_CRYP_VERIFIER_ENGINE_H
+#define ARA_CRYPTO_CRYP_VERIFIER_ENGINE_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/base_id_types.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            /**
+             * @brief Ed25519 / Ed25519ctx (RFC 8032) signature verification over raw public keys, the counterpart
+             * of SignerEngine. VerifyBatch() checks the signatures by random linear combinations (see
+             * internal::Ed25519::VerifyBatch()), which is what an Ed25519 verifier context would override
+             * VerifierPublicCtx::VerifyBatch() with; this tree has no such context or PublicKey object, so the
+             * keys are passed as their 32-byte encodings. The engine has no state besides its algorithm and may
+             * be used concurrently.
+             */
+            class VerifierEngine
+            {
+            public:
+
+                /**
+                 * @brief Construct a new Verifier Engine object.
+                 * @param[in] algId kAlgIdEd25519
+                 */
+                explicit VerifierEngine (CryptoAlgId algId) noexcept : mAlgId(algId)
+                {
+                }
+
+                /**
+                 * @brief Check if the algorithm ID passed to the constructor is supported.
+                 * @return true if the algorithm is supported
+                 */
+                bool IsSupported () const noexcept;
+
+                /**
+                 * @brief Get the algorithm ID of the engine.
+                 * @return CryptoAlgId
+                 */
+                CryptoAlgId GetAlgId () const noexcept
+                {
+                    return mAlgId;
+                }
+
+                /**
+                 * @brief Verify one signature.
+                 * @param[in] publicKey the encoded public key
+                 * @param[in] value the message
+                 * @param[in] signature the signature (R || S)
+                 * @param[in] context the Ed25519ctx context
+                 * @return ara::core::Result<bool> true if the signature is valid, false otherwise
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the public key or the signature has a wrong
+                 * size or the context is too long
+                 */
+                ara::core::Result<bool> Verify (ReadOnlyMemRegion publicKey, ReadOnlyMemRegion value, ReadOnlyMemRegion signature, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept;
+
+                /**
+                 * @brief Verify a batch of signatures (as VerifierPublicCtx::VerifyBatch()): the i-th signature of
+                 * the i-th value by the i-th public key. A signature or public key of a wrong size only marks its
+                 * item as not verified.
+                 * @param[in] publicKeys the encoded public keys (one per value)
+                 * @param[in] values the messages
+                 * @param[in] signatures the signatures (one per value)
+                 * @param[in] context the Ed25519ctx context common for all items
+                 * @return ara::core::Result<ara::core::Vector<bool> > per-item result bitmap
+                 * @exception CryptoErrorDomain::kUnsupported if the algorithm is not supported
+                 * @exception CryptoErrorDomain::kIncompatibleArguments if the sizes of the spans are different
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the context is too long
+                 * @exception CryptoErrorDomain::kInsufficientResource if the result cannot be allocated
+                 */
+                ara::core::Result<ara::core::Vector<bool> > VerifyBatch (ara::core::Span<const ReadOnlyMemRegion> publicKeys, ara::core::Span<const ReadOnlyMemRegion> values, ara::core::Span<const ReadOnlyMemRegion> signatures, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept;
+
+            private:
+                CryptoAlgId mAlgId;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_CRYP_VERIFIER_ENGINE_H
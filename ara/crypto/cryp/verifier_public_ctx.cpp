@@ -0,0 +1,148 @@
+#include "ara/crypto/cryp/verifier_public_ctx.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <system_error>
+#include <thread>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/crypto_provider.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace cryp
+        {
+            namespace
+            {
+                // Minimal number of batch items that justifies an additional worker thread.
+                const std::size_t kMinItemsPerThread = 32u;
+            }
+
+            ara::core::Result<ara::core::Vector<bool> > VerifierPublicCtx::VerifyBatch (ara::core::Span<const ReadOnlyMemRegion> values, ara::core::Span<const ReadOnlyMemRegion> signatures, ara::core::Span<const PublicKey* const> keys, ReadOnlyMemRegion context, std::size_t maxThreads) const noexcept
+            {
+                using BatchResult = ara::core::Result<ara::core::Vector<bool> >;
+
+                const std::size_t count = values.size();
+                if ((signatures.size() != count) || (!keys.empty() && (keys.size() != count)))
+                {
+                    return BatchResult::FromError(CryptoErrorDomain::Errc::kIncompatibleArguments);
+                }
+
+                ara::core::Vector<bool> verified(count, false);
+
+                if (keys.empty())
+                {
+                    // The deployed key cannot be shared with other contexts, so the batch is processed in place.
+                    if (!IsInitialized())
+                    {
+                        return BatchResult::FromError(CryptoErrorDomain::Errc::kUninitializedContext);
+                    }
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        ara::core::Result<bool> result = Verify(values[i], signatures[i], context);
+                        verified[i] = result.HasValue() && result.Value();
+                    }
+                    return BatchResult::FromValue(std::move(verified));
+                }
+
+                // Group the items by their public keys: order[] lists item indices sorted by key and groups[]
+                // keeps the start position of each group inside order[] (plus the terminating position).
+                ara::core::Vector<std::size_t> order(count);
+                std::iota(order.begin(), order.end(), 0u);
+                std::stable_sort(order.begin(), order.end(), [&keys] (std::size_t lhs, std::size_t rhs)
+                {
+                    return std::less<const PublicKey*>()(keys[lhs], keys[rhs]);
+                });
+
+                ara::core::Vector<std::size_t> groups;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if ((i == 0) || (keys[order[i]] != keys[order[i - 1]]))
+                    {
+                        groups.push_back(i);
+                    }
+                }
+                groups.push_back(count);
+                const std::size_t groupCount = groups.size() - 1;
+
+                if (groupCount == 0)
+                {
+                    return BatchResult::FromValue(std::move(verified));
+                }
+
+                std::size_t threadCount = (maxThreads != 0) ? maxThreads : static_cast<std::size_t>(std::thread::hardware_concurrency());
+                threadCount = std::min({std::max<std::size_t>(threadCount, 1u), groupCount, std::max<std::size_t>(count / kMinItemsPerThread, 1u)});
+
+                // Each worker owns a verifier context, because the key deployed to this one must stay untouched.
+                const AlgId algId = GetCryptoPrimitiveId()->GetPrimitiveId();
+                ara::core::Vector<VerifierPublicCtx::Uptr> verifiers;
+                for (std::size_t t = 0; t < threadCount; ++t)
+                {
+                    ara::core::Result<VerifierPublicCtx::Uptr> verifier = MyProvider().CreateVerifierPublicCtx(algId);
+                    if (!verifier.HasValue())
+                    {
+                        break;
+                    }
+                    verifiers.push_back(std::move(verifier).Value());
+                }
+                if (verifiers.empty())
+                {
+                    return BatchResult::FromError(CryptoErrorDomain::Errc::kBusyResource);
+                }
+
+                // One byte per item: bits of the vector<bool> must not be written by concurrent threads.
+                ara::core::Vector<std::uint8_t> flags(count, 0u);
+                std::atomic<std::size_t> nextGroup(0u);
+
+                auto work = [&] (VerifierPublicCtx &verifier)
+                {
+                    for (std::size_t g = nextGroup++; g < groupCount; g = nextGroup++)
+                    {
+                        const PublicKey *key = keys[order[groups[g]]];
+                        if ((key == nullptr) || !verifier.SetKey(*key).HasValue())
+                        {
+                            continue;
+                        }
+                        for (std::size_t i = groups[g]; i < groups[g + 1]; ++i)
+                        {
+                            const std::size_t item = order[i];
+                            ara::core::Result<bool> result = verifier.Verify(values[item], signatures[item], context);
+                            flags[item] = (result.HasValue() && result.Value()) ? 1u : 0u;
+                        }
+                    }
+                    verifier.Reset();
+                };
+
+                ara::core::Vector<std::thread> threads;
+                threads.reserve(verifiers.size() - 1);
+                for (std::size_t t = 1; t < verifiers.size(); ++t)
+                {
+                    try
+                    {
+                        threads.emplace_back(work, std::ref(*verifiers[t]));
+                    }
+                    catch (const std::system_error &)
+                    {
+                        // Not started workers are not required: the remaining groups are taken by the caller thread.
+                        break;
+                    }
+                }
+                work(*verifiers[0]);
+                for (std::thread &thread : threads)
+                {
+                    thread.join();
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    verified[i] = (flags[i] != 0u);
+                }
+                return BatchResult::FromValue(std::move(verified));
+            }
+        }
+    }
+}
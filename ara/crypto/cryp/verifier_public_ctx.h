@@ -1,10 +1,14 @@
 #ifndef ARA_CRYPTO_CRYP_VERIFIER_PUBLIC_CTX_H
 #define ARA_CRYPTO_CRYP_VERIFIER_PUBLIC_CTX_H
 
+#include "ara/core/span.h"
+#include "ara/core/vector.h"
+
 #include "ara/crypto/cryp/common/mem_region.h"
 
 #include "ara/crypto/cryp/cryobj/crypto_context.h"
 #include "ara/crypto/cryp/cryobj/signature.h"
+#include "ara/crypto/cryp/cryobj/public_key.h"
 
 #include "ara/crypto/cryp/signature_service.h"
 #include "ara/crypto/cryp/hash_function_ctx.h"
@@ -121,6 +125,29 @@ namespace ara
                  * @exception CryptoErrc::kInvalidInputSize if the size of the supplied context or signature is incompatible with the configured signature algorithm.
                 */
                 virtual ara::core::Result<bool> VerifyPrehashed (CryptoAlgId hashAlgId, ReadOnlyMemRegion hashValue, const Signature &signature, ReadOnlyMemRegion context=ReadOnlyMemRegion()) const noexcept=0;
+
+                /**
+                 * @brief Verify a batch of signature BLOBs by directly provided (pre-)hashed or message values.
+                 * The i-th signature is verified against the i-th value. If the keys span is empty then all items
+                 * are verified by the key already deployed to this context, otherwise keys[i] is the public key of
+                 * the i-th item. The default implementation does no algorithm-level batching: every item is still
+                 * verified by an own Verify() call; the batch equation of Ed25519 is VerifierEngine::VerifyBatch(),
+                 * which an Ed25519 context should override this method with. The default only groups the items
+                 * that share a public key, so SetKey() is called once per distinct key, and distributes the groups
+                 * across up to maxThreads worker threads started by the call, each of them using an own verifier
+                 * context of the same algorithm created by MyProvider(). A malformed signature or a key that cannot be deployed doesn't fail the
+                 * whole batch, but only marks the correspondent items as not verified.
+                 * @param[in] values the (pre-)hashed or direct message values that should be verified
+                 * @param[in] signatures the signature BLOBs for the verification (one per value, see SWS_CRYPT_24112 for the BLOB format)
+                 * @param[in] keys the public keys of the items (one per value), or an empty span for verification by the key deployed to this context
+                 * @param[in] context an optional user supplied "context" common for all items (its support depends from concrete algorithm)
+                 * @param[in] maxThreads the maximal number of worker threads; 0 means the number of hardware threads
+                 * @return ara::core::Result<ara::core::Vector<bool> > per-item result bitmap: true if the signature of correspondent item was verified successfully and false otherwise
+                 * @exception CryptoErrorDomain::kIncompatibleArguments if the sizes of values and signatures (or non-empty keys) spans are different
+                 * @exception CryptoErrorDomain::kUninitializedContext if the keys span is empty, but no key was deployed to this context by SetKey()
+                 * @exception CryptoErrorDomain::kBusyResource if a verifier context for a worker thread cannot be created
+                 */
+                virtual ara::core::Result<ara::core::Vector<bool> > VerifyBatch (ara::core::Span<const ReadOnlyMemRegion> values, ara::core::Span<const ReadOnlyMemRegion> signatures, ara::core::Span<const PublicKey* const> keys=ara::core::Span<const PublicKey* const>(), ReadOnlyMemRegion context=ReadOnlyMemRegion(), std::size_t maxThreads=0) const noexcept;
             };
         }
     }
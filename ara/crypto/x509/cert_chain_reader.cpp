@@ -0,0 +1,403 @@
+#include "ara/crypto/x509/cert_chain_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/x509/internal/der.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                // A typical certificate takes 1 to 1.5 KB in DER and a third more in PEM.
+                const std::size_t kExpectedCertificateSize = 1024u;
+
+                // Tag and at most 4 length octets, larger certificates are not accepted.
+                const std::size_t kMaxHeaderSize = 6u;
+
+                // Longest accepted PEM line: RFC 7468 lines take 64 characters, a certificate written as a single
+                // base64 line of this size takes 48 KB.
+                const std::size_t kMaxLineSize = 64u * 1024u;
+
+                const char cBeginCertificate[] = "-----BEGIN CERTIFICATE-----";
+                const char cEndCertificate[] = "-----END CERTIFICATE-----";
+                const char cBegin[] = "-----BEGIN ";
+                const char cEnd[] = "-----END ";
+                const char cBoundary[] = "-----";
+
+                enum class Header : std::uint8_t
+                {
+                    kComplete,
+                    kIncomplete,
+                    kMalformed
+                };
+
+                // Get the size of a certificate from the header of its outer SEQUENCE.
+                Header ReadHeader (const std::uint8_t *data, std::size_t size, std::size_t &elementSize) noexcept
+                {
+                    if (size == 0u)
+                    {
+                        return Header::kIncomplete;
+                    }
+                    if (data[0] != internal::DerReader::kTagSequence)
+                    {
+                        return Header::kMalformed;
+                    }
+                    if (size < 2u)
+                    {
+                        return Header::kIncomplete;
+                    }
+                    if (data[1] < 0x80u)
+                    {
+                        elementSize = 2u + data[1];
+                        return Header::kComplete;
+                    }
+                    const std::size_t lengthSize = data[1] & 0x7fu;
+                    if ((lengthSize == 0u) || (2u + lengthSize > kMaxHeaderSize))
+                    {
+                        return Header::kMalformed;
+                    }
+                    if (size < 2u + lengthSize)
+                    {
+                        return Header::kIncomplete;
+                    }
+                    std::size_t length = 0u;
+                    for (std::size_t i = 0; i < lengthSize; ++i)
+                    {
+                        length = (length << 8) | data[2u + i];
+                    }
+                    elementSize = 2u + lengthSize + length;
+                    return Header::kComplete;
+                }
+
+                template<std::size_t N>
+                bool StartsWith (const std::uint8_t *line, std::size_t size, const char (&prefix)[N]) noexcept
+                {
+                    return (size >= N - 1u) && (std::memcmp(line, prefix, N - 1u) == 0);
+                }
+
+                template<std::size_t N>
+                bool Equals (const std::uint8_t *line, std::size_t size, const char (&text)[N]) noexcept
+                {
+                    return (size == N - 1u) && (std::memcmp(line, text, N - 1u) == 0);
+                }
+
+                bool IsBlank (std::uint8_t c) noexcept
+                {
+                    return (c == ' ') || (c == '\t') || (c == '\r');
+                }
+            }
+
+            CertChainReader::CertChainReader (Serializable::FormatId formatId) noexcept : CertChainReader(formatId, false)
+            {
+            }
+
+            CertChainReader::CertChainReader (Serializable::FormatId formatId, bool countOnly) noexcept : mFormatId(formatId),
+                mFormat(Format::kUnknown),
+                mPemState(PemState::kOutside),
+                mCountOnly(countOnly),
+                mFailed(false),
+                mError(CryptoErrorDomain::Errc::kInvalidArgument),
+                mCount(0u)
+            {
+                if (formatId == Serializable::kFormatDerEncoded)
+                {
+                    mFormat = Format::kDer;
+                }
+                else if (formatId == Serializable::kFormatPemEncoded)
+                {
+                    mFormat = Format::kPem;
+                }
+            }
+
+            void CertChainReader::Reserve (std::size_t chainSize) noexcept
+            {
+                if (!mCountOnly)
+                {
+                    // Only a hint, without the memory the vector grows certificate by certificate.
+                    try
+                    {
+                        mCertificates.reserve(mCertificates.size() + chainSize / kExpectedCertificateSize + 1u);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                    }
+                }
+            }
+
+            ara::core::Result<void> CertChainReader::Update (ReadOnlyMemRegion chunk) noexcept
+            {
+                if ((mFormatId != Serializable::kFormatDefault) && (mFormat == Format::kUnknown))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                if (!mFailed && (chunk.size() != 0u))
+                {
+                    if (mFormat == Format::kUnknown)
+                    {
+                        // A DER chain starts with the SEQUENCE of a certificate, PEM text never does.
+                        mFormat = (chunk[0] == internal::DerReader::kTagSequence) ? Format::kDer : Format::kPem;
+                    }
+                    try
+                    {
+                        mFailed = (mFormat == Format::kDer) ? !UpdateDer(chunk.data(), chunk.size()) : !UpdatePem(chunk.data(), chunk.size());
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        mFailed = true;
+                        mError = CryptoErrorDomain::Errc::kInsufficientResource;
+                    }
+                }
+                if (mFailed)
+                {
+                    return ara::core::Result<void>::FromError(mError);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> CertChainReader::Finish () noexcept
+            {
+                if ((mFormatId != Serializable::kFormatDefault) && (mFormat == Format::kUnknown))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                if (!mFailed && (mFormat == Format::kPem) && !mPending.empty())
+                {
+                    // The last line has no line feed.
+                    try
+                    {
+                        mFailed = !ReadLine(mPending.data(), mPending.size());
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        mFailed = true;
+                        mError = CryptoErrorDomain::Errc::kInsufficientResource;
+                    }
+                    mPending.clear();
+                }
+                if (mFailed)
+                {
+                    return ara::core::Result<void>::FromError(mError);
+                }
+                if ((mCount == 0u) || !mPending.empty() || (mPemState != PemState::kOutside))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Vector<CertChainReader::CertPtr> CertChainReader::TakeCertificates () noexcept
+            {
+                ara::core::Vector<CertPtr> certificates;
+                certificates.swap(mCertificates);
+                return certificates;
+            }
+
+            ara::core::Result<std::size_t> CertChainReader::Count (ReadOnlyMemRegion certChain, Serializable::FormatId formatId) noexcept
+            {
+                CertChainReader reader(formatId, true);
+                ara::core::Result<void> result = reader.Update(certChain);
+                if (result.HasValue())
+                {
+                    result = reader.Finish();
+                }
+                if (!result.HasValue())
+                {
+                    return ara::core::Result<std::size_t>::FromError(result.Error());
+                }
+                return ara::core::Result<std::size_t>::FromValue(reader.GetCount());
+            }
+
+            ara::core::Result<void> CertChainReader::Parse (ara::core::Vector<CertPtr> &outcome, ReadOnlyMemRegion certChain, Serializable::FormatId formatId) noexcept
+            {
+                CertChainReader reader(formatId);
+                reader.mCertificates.swap(outcome);
+                const std::size_t size = reader.mCertificates.size();
+                reader.Reserve(certChain.size());
+                ara::core::Result<void> result = reader.Update(certChain);
+                if (result.HasValue())
+                {
+                    result = reader.Finish();
+                }
+                if (!result.HasValue())
+                {
+                    reader.mCertificates.resize(size);
+                }
+                outcome.swap(reader.mCertificates);
+                return result;
+            }
+
+            bool CertChainReader::UpdateDer (const std::uint8_t *data, std::size_t size)
+            {
+                while (size != 0u)
+                {
+                    std::size_t elementSize = 0u;
+                    if (mPending.empty())
+                    {
+                        const Header header = ReadHeader(data, size, elementSize);
+                        if (header == Header::kMalformed)
+                        {
+                            return false;
+                        }
+                        if ((header == Header::kIncomplete) || (elementSize > size))
+                        {
+                            mPending.assign(data, data + size);
+                            return true;
+                        }
+                        if (!AddCertificate(data, elementSize))
+                        {
+                            return false;
+                        }
+                        data += elementSize;
+                        size -= elementSize;
+                        continue;
+                    }
+
+                    // Complete the header first, then the certificate split between the chunks.
+                    Header header = ReadHeader(mPending.data(), mPending.size(), elementSize);
+                    while ((header == Header::kIncomplete) && (size != 0u))
+                    {
+                        mPending.push_back(*data++);
+                        --size;
+                        header = ReadHeader(mPending.data(), mPending.size(), elementSize);
+                    }
+                    if (header != Header::kComplete)
+                    {
+                        return header == Header::kIncomplete;
+                    }
+                    const std::size_t take = std::min(elementSize - mPending.size(), size);
+                    mPending.insert(mPending.end(), data, data + take);
+                    data += take;
+                    size -= take;
+                    if (mPending.size() == elementSize)
+                    {
+                        if (!AddCertificate(mPending.data(), mPending.size()))
+                        {
+                            return false;
+                        }
+                        mPending.clear();
+                    }
+                }
+                return true;
+            }
+
+            bool CertChainReader::UpdatePem (const std::uint8_t *data, std::size_t size)
+            {
+                const std::uint8_t *end = data + size;
+                while (data != end)
+                {
+                    const std::uint8_t *lineFeed = static_cast<const std::uint8_t*>(std::memchr(data, '\n', static_cast<std::size_t>(end - data)));
+                    const std::uint8_t *lineEnd = (lineFeed != nullptr) ? lineFeed : end;
+                    if (mPending.size() + static_cast<std::size_t>(lineEnd - data) > kMaxLineSize)
+                    {
+                        return false;
+                    }
+                    if (lineFeed == nullptr)
+                    {
+                        mPending.insert(mPending.end(), data, end);
+                        break;
+                    }
+                    bool read;
+                    if (mPending.empty())
+                    {
+                        read = ReadLine(data, static_cast<std::size_t>(lineFeed - data));
+                    }
+                    else
+                    {
+                        mPending.insert(mPending.end(), data, lineFeed);
+                        read = ReadLine(mPending.data(), mPending.size());
+                        mPending.clear();
+                    }
+                    if (!read)
+                    {
+                        return false;
+                    }
+                    data = lineFeed + 1;
+                }
+                return true;
+            }
+
+            bool CertChainReader::ReadLine (const std::uint8_t *line, std::size_t size)
+            {
+                while ((size != 0u) && IsBlank(line[size - 1u]))
+                {
+                    --size;
+                }
+                while ((size != 0u) && IsBlank(line[0]))
+                {
+                    ++line;
+                    --size;
+                }
+
+                switch (mPemState)
+                {
+                case PemState::kOutside:
+                    if (Equals(line, size, cBeginCertificate))
+                    {
+                        mPemState = PemState::kCertificate;
+                        mDecoder.Reset();
+                        mDecoded.clear();
+                    }
+                    else if (StartsWith(line, size, cBegin))
+                    {
+                        mPemState = PemState::kOther;
+                    }
+                    return true;
+
+                case PemState::kCertificate:
+                    if (Equals(line, size, cEndCertificate))
+                    {
+                        mPemState = PemState::kOutside;
+                        return mDecoder.Finish() && AddCertificate(mDecoded.data(), mDecoded.size());
+                    }
+                    if (StartsWith(line, size, cBoundary))
+                    {
+                        return false;
+                    }
+                    if (mCountOnly)
+                    {
+                        // The base64 is checked as well, but only the current line is kept.
+                        mDecoded.clear();
+                    }
+                    return mDecoder.Update(line, size, mDecoded);
+
+                case PemState::kOther:
+                    if (StartsWith(line, size, cEnd))
+                    {
+                        mPemState = PemState::kOutside;
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            bool CertChainReader::AddCertificate (const std::uint8_t *der, std::size_t size)
+            {
+                ++mCount;
+                if (mCountOnly)
+                {
+                    return true;
+                }
+                std::shared_ptr<DerCertificate> certificate = std::make_shared<DerCertificate>();
+                const ara::core::Result<void> parsed = certificate->Parse(ReadOnlyMemRegion(der, size));
+                if (!parsed.HasValue())
+                {
+                    if (parsed.CheckError(CryptoErrorDomain::Errc::kInsufficientResource))
+                    {
+                        mError = CryptoErrorDomain::Errc::kInsufficientResource;
+                    }
+                    return false;
+                }
+                mCertificates.push_back(std::move(certificate));
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef ARA_CRYPTO_X509_CERT_CHAIN_READER_H
+#define ARA_CRYPTO_X509_CERT_CHAIN_READER_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/result.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/common/serializable.h"
+#include "ara/crypto/x509/certificate_store.h"
+#include "ara/crypto/x509/internal/base64.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief Single-pass reader of a serialized certificate chain that parses and counts as ParseCertChain()
+             * and CountCertsInChain() specify, for an X.509 Provider implementation this tree does not contain
+             * yet. A DER chain is a concatenation of DER encoded certificates, a PEM chain is a sequence of
+             * "CERTIFICATE" blocks (RFC 7468) where the text around them and the blocks of other labels are
+             * skipped. The chain may be passed in chunks of any size: only a certificate or a line split between
+             * two chunks is buffered, and a PEM line longer than 64 KB fails the chain. The certificates are kept
+             * in the order of the chain.
+             */
+            class CertChainReader
+            {
+            public:
+
+                using CertPtr = CertificateStore::CertPtr;
+
+                /**
+                 * @brief Construct a new Cert Chain Reader object.
+                 * @param[in] formatId input format identifier (kFormatDefault means auto-detect by the first byte)
+                 */
+                explicit CertChainReader (Serializable::FormatId formatId=Serializable::kFormatDefault) noexcept;
+
+                CertChainReader (const CertChainReader &) = delete;
+                CertChainReader& operator= (const CertChainReader &) = delete;
+
+                /**
+                 * @brief Reserve the capacity for the certificates of a chain.
+                 * @param[in] chainSize the expected size of the serialized chain in bytes
+                 */
+                void Reserve (std::size_t chainSize) noexcept;
+
+                /**
+                 * @brief Read the next part of the chain.
+                 * @param[in] chunk the part
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kInvalidArgument if the chain cannot be parsed (the reader stays
+                 * failed then)
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for a certificate is insufficient
+                 * (the reader stays failed then)
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the formatId argument has unknown value
+                 */
+                ara::core::Result<void> Update (ReadOnlyMemRegion chunk) noexcept;
+
+                /**
+                 * @brief Check the end of the chain.
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kInvalidArgument if the chain is empty, ends inside a certificate
+                 * or cannot be parsed
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for a certificate is insufficient
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the formatId argument has unknown value
+                 */
+                ara::core::Result<void> Finish () noexcept;
+
+                /**
+                 * @brief Get the number of certificates read so far.
+                 * @return std::size_t
+                 */
+                std::size_t GetCount () const noexcept
+                {
+                    return mCount;
+                }
+
+                /**
+                 * @brief Get the certificates read so far.
+                 * @return const ara::core::Vector<CertPtr>&
+                 */
+                const ara::core::Vector<CertPtr>& GetCertificates () const noexcept
+                {
+                    return mCertificates;
+                }
+
+                /**
+                 * @brief Move the certificates read so far out of the reader.
+                 * @return ara::core::Vector<CertPtr>
+                 */
+                ara::core::Vector<CertPtr> TakeCertificates () noexcept;
+
+                /**
+                 * @brief Count the certificates in a chain as CountCertsInChain(). Only the framing is checked: the
+                 * sizes in the DER headers, or the PEM blocks and their base64, which is decoded line by line and
+                 * dropped. The certificates themselves are not parsed, so a chain counted here may fail Parse().
+                 * @param[in] certChain the serialized chain
+                 * @param[in] formatId input format identifier (kFormatDefault means auto-detect)
+                 * @return ara::core::Result<std::size_t> number of certificates
+                 * @exception CryptoErrorDomain::kInvalidArgument if the chain cannot be parsed
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for a line is insufficient
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the formatId argument has unknown value
+                 */
+                static ara::core::Result<std::size_t> Count (ReadOnlyMemRegion certChain, Serializable::FormatId formatId=Serializable::kFormatDefault) noexcept;
+
+                /**
+                 * @brief Parse a chain and append its certificates as ParseCertChain().
+                 * @param[in,out] outcome the vector the certificates are appended to, it is left unchanged on an
+                 * error
+                 * @param[in] certChain the serialized chain
+                 * @param[in] formatId input format identifier (kFormatDefault means auto-detect)
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kInvalidArgument if the chain cannot be parsed
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for a certificate is insufficient
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the formatId argument has unknown value
+                 */
+                static ara::core::Result<void> Parse (ara::core::Vector<CertPtr> &outcome, ReadOnlyMemRegion certChain, Serializable::FormatId formatId=Serializable::kFormatDefault) noexcept;
+
+            private:
+                enum class Format : std::uint8_t
+                {
+                    kUnknown,
+                    kDer,
+                    kPem
+                };
+
+                enum class PemState : std::uint8_t
+                {
+                    kOutside,       // text between the blocks
+                    kCertificate,   // the base64 lines of a certificate
+                    kOther          // a block of another label
+                };
+
+                CertChainReader (Serializable::FormatId formatId, bool countOnly) noexcept;
+
+                // These throw std::bad_alloc, Update() and Finish() report it.
+                bool UpdateDer (const std::uint8_t *data, std::size_t size);
+                bool UpdatePem (const std::uint8_t *data, std::size_t size);
+                bool ReadLine (const std::uint8_t *line, std::size_t size);
+                bool AddCertificate (const std::uint8_t *der, std::size_t size);
+
+                Serializable::FormatId mFormatId;
+                Format mFormat;
+                PemState mPemState;
+                bool mCountOnly;                                // certificates are counted but not decoded
+                bool mFailed;
+                CryptoErrorDomain::Errc mError;                 // the error of a failed reader
+                std::size_t mCount;
+                ara::core::Vector<CertPtr> mCertificates;
+                ara::core::Vector<std::uint8_t> mPending;       // DER certificate or PEM line split between chunks
+                ara::core::Vector<std::uint8_t> mDecoded;       // DER encoding of the current PEM certificate (of its
+                                                                // current line when counting)
+                internal::Base64Decoder mDecoder;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_CERT_CHAIN_READER_H
@@ -0,0 +1,483 @@
+#include "ara/crypto/x509/certificate_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/x509/internal/byte_hash.h"
+#include "ara/crypto/x509/internal/canonical_dn.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                // Entries of the validity index summarized by one latest end time.
+                const std::size_t kValidityBlockSize = 64u;
+
+                bool IsEqual (ReadOnlyMemRegion left, ReadOnlyMemRegion right) noexcept
+                {
+                    return (left.size() == right.size()) && ((left.size() == 0u) || (std::memcmp(left.data(), right.data(), left.size()) == 0));
+                }
+            }
+
+            ara::core::Result<CertificateStore::Id> CertificateStore::Add (ReadOnlyMemRegion der) noexcept
+            {
+                std::shared_ptr<DerCertificate> certificate;
+                try
+                {
+                    certificate = std::make_shared<DerCertificate>();
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                ara::core::Result<void> parsed = certificate->Parse(der);
+                if (!parsed.HasValue())
+                {
+                    return ara::core::Result<Id>::FromError(parsed.Error());
+                }
+                return Add(std::move(certificate));
+            }
+
+            ara::core::Result<CertificateStore::Id> CertificateStore::Add (CertPtr certificate) noexcept
+            {
+                if ((certificate == nullptr) || !certificate->IsParsed())
+                {
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kEmptyContainer);
+                }
+                const std::uint64_t sha256Key = FingerprintKey(certificate->Sha256Fingerprint());
+
+                std::unique_lock<std::shared_mutex> lock(mMutex);
+                auto range = mBySha256.equal_range(sha256Key);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (IsEqual(mCertificates[it->second]->GetEncoding(), certificate->GetEncoding()))
+                    {
+                        return ara::core::Result<Id>::FromValue(it->second);
+                    }
+                }
+
+                // A reused identifier is taken off the free list only once the certificate is indexed, an
+                // allocation failure unlinks what has been indexed already.
+                const bool reused = !mFreeIds.empty();
+                const Id id = reused ? mFreeIds.back() : static_cast<Id>(mCertificates.size());
+                try
+                {
+                    if (reused)
+                    {
+                        mCertificates[id] = certificate;
+                    }
+                    else
+                    {
+                        // Room on the free list for the new identifier, so that Remove() does not allocate
+                        mFreeIds.reserve(mCertificates.size() + 1u);
+                        mCertificates.push_back(certificate);
+                    }
+
+                    mBySubject.emplace(certificate->SubjectDnHash(), id);
+                    mBySerial.emplace(SerialKey(certificate->SerialNumber(), certificate->IssuerDnHash()), id);
+                    mBySha1.emplace(FingerprintKey(certificate->Sha1Fingerprint()), id);
+                    mBySha256.emplace(sha256Key, id);
+                    if (certificate->SubjectKeyId().size() != 0u)
+                    {
+                        mBySubjectKeyId.emplace(KeyIdKey(certificate->SubjectKeyId()), id);
+                    }
+                    if (certificate->AuthorityKeyId().size() != 0u)
+                    {
+                        mByAuthorityKeyId.emplace(KeyIdKey(certificate->AuthorityKeyId()), id);
+                    }
+
+                    InsertValidity(id, *certificate);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    Unlink(id, *certificate);
+                    if (reused)
+                    {
+                        mCertificates[id] = nullptr;
+                    }
+                    else if (mCertificates.size() > id)
+                    {
+                        mCertificates.pop_back();
+                    }
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                if (reused)
+                {
+                    mFreeIds.pop_back();
+                }
+                ++mCount;
+                return ara::core::Result<Id>::FromValue(id);
+            }
+
+            bool CertificateStore::Remove (Id id) noexcept
+            {
+                std::unique_lock<std::shared_mutex> lock(mMutex);
+                if ((id >= mCertificates.size()) || (mCertificates[id] == nullptr))
+                {
+                    return false;
+                }
+
+                // Add() has reserved room on the free list for every identifier.
+                const CertPtr certificate = std::move(mCertificates[id]);
+                mCertificates[id] = nullptr;
+                mFreeIds.push_back(id);
+                --mCount;
+
+                Unlink(id, *certificate);
+                return true;
+            }
+
+            CertificateStore::CertPtr CertificateStore::Get (Id id) const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return (id < mCertificates.size()) ? mCertificates[id] : nullptr;
+            }
+
+            std::size_t CertificateStore::Size () const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return mCount;
+            }
+
+            ara::core::Result<ara::core::Vector<CertificateStore::Id> > CertificateStore::FindByDn (ReadOnlyMemRegion subjectDn, ReadOnlyMemRegion issuerDn, time_t validityTimePoint) const noexcept
+            {
+                // The DNs are matched by their canonical forms (RFC 5280 7.1).
+                ara::core::Vector<std::uint8_t> subject;
+                ara::core::Vector<std::uint8_t> issuer;
+                try
+                {
+                    if (((subjectDn.size() != 0u) && !internal::CanonicalizeDn(subjectDn.data(), subjectDn.size(), subject)) ||
+                        ((issuerDn.size() != 0u) && !internal::CanonicalizeDn(issuerDn.data(), issuerDn.size(), issuer)))
+                    {
+                        return ara::core::Result<ara::core::Vector<Id> >::FromValue(ara::core::Vector<Id>());
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<ara::core::Vector<Id> >::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                const ReadOnlyMemRegion canonicalIssuer(issuer.data(), issuer.size());
+
+                if (subjectDn.size() == 0u)
+                {
+                    ara::core::Result<ara::core::Vector<Id> > found = FindValidAt(validityTimePoint);
+                    if (found.HasValue() && (issuerDn.size() != 0u))
+                    {
+                        std::shared_lock<std::shared_mutex> lock(mMutex);
+                        ara::core::Vector<Id> &ids = found.Value();
+                        ids.erase(std::remove_if(ids.begin(), ids.end(), [this, canonicalIssuer] (Id id)
+                            {
+                                return (mCertificates[id] == nullptr) || !IsEqual(mCertificates[id]->CanonicalIssuerDn(), canonicalIssuer);
+                            }), ids.end());
+                    }
+                    return found;
+                }
+
+                const ReadOnlyMemRegion canonicalSubject(subject.data(), subject.size());
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return Find(mBySubject, DnKey(canonicalSubject), [canonicalSubject, canonicalIssuer, &issuerDn, validityTimePoint] (const DerCertificate &certificate)
+                    {
+                        return IsEqual(certificate.CanonicalSubjectDn(), canonicalSubject) &&
+                            ((issuerDn.size() == 0u) || IsEqual(certificate.CanonicalIssuerDn(), canonicalIssuer)) && IsValidAt(certificate, validityTimePoint);
+                    });
+            }
+
+            ara::core::Result<ara::core::Vector<CertificateStore::Id> > CertificateStore::FindByCanonicalDn (ReadOnlyMemRegion canonicalSubjectDn, time_t validityTimePoint) const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return Find(mBySubject, DnKey(canonicalSubjectDn), [canonicalSubjectDn, validityTimePoint] (const DerCertificate &certificate)
+                    {
+                        return IsEqual(certificate.CanonicalSubjectDn(), canonicalSubjectDn) && IsValidAt(certificate, validityTimePoint);
+                    });
+            }
+
+            ara::core::Result<ara::core::Vector<CertificateStore::Id> > CertificateStore::FindByKeyIds (ReadOnlyMemRegion subjectKeyId, ara::core::Optional<ReadOnlyMemRegion> authorityKeyId) const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return Find(mBySubjectKeyId, KeyIdKey(subjectKeyId), [subjectKeyId, &authorityKeyId] (const DerCertificate &certificate)
+                    {
+                        return IsEqual(certificate.SubjectKeyId(), subjectKeyId) &&
+                            (!authorityKeyId.has_value() || IsEqual(certificate.AuthorityKeyId(), *authorityKeyId));
+                    });
+            }
+
+            ara::core::Result<ara::core::Vector<CertificateStore::Id> > CertificateStore::FindByAuthorityKeyId (ReadOnlyMemRegion authorityKeyId) const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return Find(mByAuthorityKeyId, KeyIdKey(authorityKeyId), [authorityKeyId] (const DerCertificate &certificate)
+                    {
+                        return IsEqual(certificate.AuthorityKeyId(), authorityKeyId);
+                    });
+            }
+
+            ara::core::Result<CertificateStore::Id> CertificateStore::FindBySn (ReadOnlyMemRegion sn, ReadOnlyMemRegion issuerDn) const noexcept
+            {
+                ara::core::Vector<std::uint8_t> issuer;
+                try
+                {
+                    if (!internal::CanonicalizeDn(issuerDn.data(), issuerDn.size(), issuer))
+                    {
+                        return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                const ReadOnlyMemRegion canonicalIssuer(issuer.data(), issuer.size());
+
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                const ara::core::Result<ara::core::Vector<Id> > found = Find(mBySerial, SerialKey(sn, DnKey(canonicalIssuer)), [sn, canonicalIssuer] (const DerCertificate &certificate)
+                    {
+                        return IsEqual(certificate.SerialNumber(), sn) && IsEqual(certificate.CanonicalIssuerDn(), canonicalIssuer);
+                    });
+                if (!found.HasValue())
+                {
+                    return ara::core::Result<Id>::FromError(found.Error());
+                }
+                if (found.Value().empty())
+                {
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                return ara::core::Result<Id>::FromValue(found.Value().front());
+            }
+
+            ara::core::Result<CertificateStore::Id> CertificateStore::FindByFingerprint (ReadOnlyMemRegion fingerprint) const noexcept
+            {
+                const bool sha1 = (fingerprint.size() == cryp::internal::Sha1::kDigestSize);
+                if (!sha1 && (fingerprint.size() != cryp::internal::Sha256::kDigestSize))
+                {
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kInvalidInputSize);
+                }
+
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                const ara::core::Result<ara::core::Vector<Id> > found = Find(sha1 ? mBySha1 : mBySha256, FingerprintKey(fingerprint), [fingerprint, sha1] (const DerCertificate &certificate)
+                    {
+                        return IsEqual(sha1 ? certificate.Sha1Fingerprint() : certificate.Sha256Fingerprint(), fingerprint);
+                    });
+                if (!found.HasValue())
+                {
+                    return ara::core::Result<Id>::FromError(found.Error());
+                }
+                if (found.Value().empty())
+                {
+                    return ara::core::Result<Id>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                return ara::core::Result<Id>::FromValue(found.Value().front());
+            }
+
+            ara::core::Result<ara::core::Vector<CertificateStore::Id> > CertificateStore::FindValidAt (time_t validityTimePoint) const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+
+                // Only the blocks started before the time point whose latest end is not before it are visited.
+                const std::int64_t time = static_cast<std::int64_t>(validityTimePoint);
+                const std::size_t started = static_cast<std::size_t>(std::upper_bound(mValidity.begin(), mValidity.end(), time,
+                    [] (std::int64_t point, const Validity &validity)
+                    {
+                        return point < validity.mNotBefore;
+                    }) - mValidity.begin());
+                ara::core::Vector<Id> found;
+                try
+                {
+                    for (std::size_t block = 0; block * kValidityBlockSize < started; ++block)
+                    {
+                        if (mBlockEnds[block] < time)
+                        {
+                            continue;
+                        }
+                        const std::size_t end = std::min(started, (block + 1u) * kValidityBlockSize);
+                        for (std::size_t i = block * kValidityBlockSize; i < end; ++i)
+                        {
+                            if (mValidity[i].mNotAfter >= time)
+                            {
+                                found.push_back(mValidity[i].mId);
+                            }
+                        }
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<ara::core::Vector<Id> >::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                std::sort(found.begin(), found.end());
+                return ara::core::Result<ara::core::Vector<Id> >::FromValue(std::move(found));
+            }
+
+            std::uint64_t CertificateStore::DnKey (ReadOnlyMemRegion canonicalDn) noexcept
+            {
+                // As DerCertificate::SubjectDnHash() and IssuerDnHash()
+                return internal::HashBytes(canonicalDn.data(), canonicalDn.size());
+            }
+
+            std::uint64_t CertificateStore::SerialKey (ReadOnlyMemRegion sn, std::uint64_t issuerDnKey) noexcept
+            {
+                return internal::HashBytes(sn.data(), sn.size(), issuerDnKey);
+            }
+
+            std::uint64_t CertificateStore::KeyIdKey (ReadOnlyMemRegion keyId) noexcept
+            {
+                return internal::HashBytes(keyId.data(), keyId.size());
+            }
+
+            std::uint64_t CertificateStore::FingerprintKey (ReadOnlyMemRegion fingerprint) noexcept
+            {
+                // A digest is uniformly distributed already, its first bytes serve as the hash.
+                std::uint64_t key = 0u;
+                std::memcpy(&key, fingerprint.data(), std::min(sizeof(key), fingerprint.size()));
+                return key;
+            }
+
+            void CertificateStore::Erase (Index &index, std::uint64_t key, Id id) noexcept
+            {
+                auto range = index.equal_range(key);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (it->second == id)
+                    {
+                        index.erase(it);
+                        return;
+                    }
+                }
+            }
+
+            void CertificateStore::Unlink (Id id, const DerCertificate &certificate) noexcept
+            {
+                Erase(mBySubject, certificate.SubjectDnHash(), id);
+                Erase(mBySerial, SerialKey(certificate.SerialNumber(), certificate.IssuerDnHash()), id);
+                Erase(mBySha1, FingerprintKey(certificate.Sha1Fingerprint()), id);
+                Erase(mBySha256, FingerprintKey(certificate.Sha256Fingerprint()), id);
+                if (certificate.SubjectKeyId().size() != 0u)
+                {
+                    Erase(mBySubjectKeyId, KeyIdKey(certificate.SubjectKeyId()), id);
+                }
+                if (certificate.AuthorityKeyId().size() != 0u)
+                {
+                    Erase(mByAuthorityKeyId, KeyIdKey(certificate.AuthorityKeyId()), id);
+                }
+                EraseValidity(id, certificate);
+            }
+
+            bool CertificateStore::IsValidAt (const DerCertificate &certificate, time_t validityTimePoint) noexcept
+            {
+                return (certificate.StartTime() <= validityTimePoint) && (validityTimePoint <= certificate.EndTime());
+            }
+
+            template <typename Predicate>
+            ara::core::Result<ara::core::Vector<CertificateStore::Id> > CertificateStore::Find (const Index &index, std::uint64_t key, Predicate predicate) const noexcept
+            {
+                ara::core::Vector<Id> found;
+                auto range = index.equal_range(key);
+                try
+                {
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        if (predicate(*mCertificates[it->second]))
+                        {
+                            found.push_back(it->second);
+                        }
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<ara::core::Vector<Id> >::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                // Ascending identifiers, independent of the hash table
+                std::sort(found.begin(), found.end());
+                return ara::core::Result<ara::core::Vector<Id> >::FromValue(std::move(found));
+            }
+
+            bool CertificateStore::IsEarlier (const Validity &left, const Validity &right) noexcept
+            {
+                return (left.mNotBefore < right.mNotBefore) || ((left.mNotBefore == right.mNotBefore) && (left.mId < right.mId));
+            }
+
+            void CertificateStore::InsertValidity (Id id, const DerCertificate &certificate)
+            {
+                if (!certificate.IsWellFormed())
+                {
+                    return;
+                }
+                // Both vectors grow before either changes, an allocation failure leaves the index as it was.
+                mValidity.reserve(mValidity.size() + 1u);
+                mBlockEnds.reserve(mValidity.size() / kValidityBlockSize + 1u);
+                const Validity added = {certificate.StartTime(), certificate.EndTime(), id};
+                const std::size_t position = static_cast<std::size_t>(std::lower_bound(mValidity.begin(), mValidity.end(), added, &IsEarlier) - mValidity.begin());
+                mValidity.insert(mValidity.begin() + static_cast<std::ptrdiff_t>(position), added);
+                mBlockEnds.resize((mValidity.size() + kValidityBlockSize - 1u) / kValidityBlockSize, std::numeric_limits<std::int64_t>::min());
+
+                // The blocks from the one of the new entry on gain their preceding entry and pass their last one on
+                // to the next block. Only a block whose latest end is passed on is scanned again.
+                const std::size_t first = position / kValidityBlockSize;
+                for (std::size_t block = first; block < mBlockEnds.size(); ++block)
+                {
+                    const std::size_t begin = block * kValidityBlockSize;
+                    const std::size_t next = begin + kValidityBlockSize;
+                    const std::int64_t gained = (block == first) ? added.mNotAfter : mValidity[begin].mNotAfter;
+                    if ((next < mValidity.size()) && (mValidity[next].mNotAfter >= mBlockEnds[block]))
+                    {
+                        mBlockEnds[block] = GetBlockEnd(block);
+                    }
+                    else
+                    {
+                        mBlockEnds[block] = std::max(mBlockEnds[block], gained);
+                    }
+                }
+            }
+
+            void CertificateStore::EraseValidity (Id id, const DerCertificate &certificate) noexcept
+            {
+                if (!certificate.IsWellFormed())
+                {
+                    return;
+                }
+                const Validity removed = {certificate.StartTime(), certificate.EndTime(), id};
+                auto found = std::lower_bound(mValidity.begin(), mValidity.end(), removed, &IsEarlier);
+                if ((found == mValidity.end()) || (found->mId != id))
+                {
+                    return;
+                }
+                const std::size_t position = static_cast<std::size_t>(found - mValidity.begin());
+                mValidity.erase(found);
+                mBlockEnds.resize((mValidity.size() + kValidityBlockSize - 1u) / kValidityBlockSize);
+
+                // The blocks from the one of the removed entry on lose their first entry (the removed one) to the
+                // preceding block and take the first one of the next block.
+                const std::size_t first = position / kValidityBlockSize;
+                for (std::size_t block = first; block < mBlockEnds.size(); ++block)
+                {
+                    const std::size_t begin = block * kValidityBlockSize;
+                    const std::size_t next = begin + kValidityBlockSize;
+                    const std::int64_t lost = (block == first) ? removed.mNotAfter : mValidity[begin - 1u].mNotAfter;
+                    if (lost >= mBlockEnds[block])
+                    {
+                        mBlockEnds[block] = GetBlockEnd(block);
+                    }
+                    else if (next <= mValidity.size())
+                    {
+                        mBlockEnds[block] = std::max(mBlockEnds[block], mValidity[next - 1u].mNotAfter);
+                    }
+                }
+            }
+
+            std::int64_t CertificateStore::GetBlockEnd (std::size_t block) const noexcept
+            {
+                const std::size_t end = std::min(mValidity.size(), (block + 1u) * kValidityBlockSize);
+                std::int64_t latest = std::numeric_limits<std::int64_t>::min();
+                for (std::size_t i = block * kValidityBlockSize; i < end; ++i)
+                {
+                    latest = std::max(latest, mValidity[i].mNotAfter);
+                }
+                return latest;
+            }
+        }
+    }
+}
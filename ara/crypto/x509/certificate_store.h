@@ -0,0 +1,198 @@
+#ifndef ARA_CRYPTO_X509_CERTIFICATE_STORE_H
+#define ARA_CRYPTO_X509_CERTIFICATE_STORE_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "ara/core/optional.h"
+#include "ara/core/result.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/x509/der_certificate.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief In-memory certificate storage with the lookups of FindCertByDn(), FindCertByKeyIds() and
+             * FindCertBySn(). This tree has no X.509 Provider implementation calling it, ChainVerifier searches it for
+             * the candidate issuers. Hash indexes on the subject DN, the issuer DN with the serial number, the subject
+             * key ID, the authority key ID and the SHA-1 and SHA-256 fingerprints turn each lookup into a hash
+             * probe confirmed by comparing bytes. The DNs are matched by their canonical forms (RFC 5280 7.1). An
+             * index of the validity intervals, updated in place by each change, answers a time point query
+             * without visiting the certificates that are not valid then. Lookups may run concurrently, changes take an
+             * exclusive lock.
+             */
+            class CertificateStore
+            {
+            public:
+
+                /**
+                 * @brief Identifier of a stored certificate.
+                 */
+                using Id = std::uint32_t;
+
+                /**
+                 * @brief Shared pointer to a stored certificate, it stays valid after the certificate is removed.
+                 */
+                using CertPtr = std::shared_ptr<const DerCertificate>;
+
+                CertificateStore () = default;
+
+                CertificateStore (const CertificateStore &) = delete;
+                CertificateStore& operator= (const CertificateStore &) = delete;
+
+                /**
+                 * @brief Parse a DER encoded certificate and add it to the store.
+                 * @param[in] der the encoding of the certificate (copied)
+                 * @return ara::core::Result<Id> the identifier of the certificate, or of the stored identical one
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the encoding is not a well-formed certificate
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the certificate is insufficient
+                 */
+                ara::core::Result<Id> Add (ReadOnlyMemRegion der) noexcept;
+
+                /**
+                 * @brief Add a parsed certificate to the store.
+                 * @param[in] certificate the certificate
+                 * @return ara::core::Result<Id> the identifier of the certificate, or of the stored identical one
+                 * @exception CryptoErrorDomain::kEmptyContainer if the certificate is not parsed
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the indexes is insufficient
+                 */
+                ara::core::Result<Id> Add (CertPtr certificate) noexcept;
+
+                /**
+                 * @brief Remove a certificate from the store.
+                 * @param[in] id the identifier of the certificate
+                 * @return true if the certificate has been removed
+                 */
+                bool Remove (Id id) noexcept;
+
+                /**
+                 * @brief Get a stored certificate.
+                 * @param[in] id the identifier of the certificate
+                 * @return CertPtr nullptr if there is no such certificate
+                 */
+                CertPtr Get (Id id) const noexcept;
+
+                /**
+                 * @brief Get the number of stored certificates.
+                 * @return std::size_t
+                 */
+                std::size_t Size () const noexcept;
+
+                /**
+                 * @brief Find the certificates by their subject and issuer DNs that are valid at a time point.
+                 * @param[in] subjectDn the DER encoded subject DN, or an empty region for any subject
+                 * @param[in] issuerDn the DER encoded issuer DN, or an empty region for any issuer
+                 * @param[in] validityTimePoint the time point
+                 * @return ara::core::Result<ara::core::Vector<Id> > the found certificates, empty if nothing is found
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the canonical DNs or the result is insufficient
+                 */
+                ara::core::Result<ara::core::Vector<Id> > FindByDn (ReadOnlyMemRegion subjectDn, ReadOnlyMemRegion issuerDn, time_t validityTimePoint) const noexcept;
+
+                /**
+                 * @brief Find the certificates by their canonical subject DN that are valid at a time point, e.g.
+                 * the candidate issuers of a certificate without converting its issuer DN again.
+                 * @param[in] canonicalSubjectDn the canonical subject DN (DerCertificate::CanonicalIssuerDn())
+                 * @param[in] validityTimePoint the time point
+                 * @return ara::core::Result<ara::core::Vector<Id> > the found certificates, empty if nothing is found
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result is insufficient
+                 */
+                ara::core::Result<ara::core::Vector<Id> > FindByCanonicalDn (ReadOnlyMemRegion canonicalSubjectDn, time_t validityTimePoint) const noexcept;
+
+                /**
+                 * @brief Find the certificates by their key identifiers.
+                 * @param[in] subjectKeyId the subject key identifier (SKID)
+                 * @param[in] authorityKeyId the optional authority key identifier (AKID)
+                 * @return ara::core::Result<ara::core::Vector<Id> > the found certificates, empty if nothing is found
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result is insufficient
+                 */
+                ara::core::Result<ara::core::Vector<Id> > FindByKeyIds (ReadOnlyMemRegion subjectKeyId, ara::core::Optional<ReadOnlyMemRegion> authorityKeyId) const noexcept;
+
+                /**
+                 * @brief Find the certificates issued by the key with the given identifier.
+                 * @param[in] authorityKeyId the authority key identifier (AKID)
+                 * @return ara::core::Result<ara::core::Vector<Id> > the found certificates, empty if nothing is found
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result is insufficient
+                 */
+                ara::core::Result<ara::core::Vector<Id> > FindByAuthorityKeyId (ReadOnlyMemRegion authorityKeyId) const noexcept;
+
+                /**
+                 * @brief Find a certificate by its serial number and issuer DN.
+                 * @param[in] sn the serial number (the content octets of the INTEGER)
+                 * @param[in] issuerDn the DER encoded issuer DN
+                 * @return ara::core::Result<Id> the certificate
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the certificate could not be found
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the canonical DN is insufficient
+                 */
+                ara::core::Result<Id> FindBySn (ReadOnlyMemRegion sn, ReadOnlyMemRegion issuerDn) const noexcept;
+
+                /**
+                 * @brief Find a certificate by its fingerprint, e.g. for pinning or de-duplication.
+                 * @param[in] fingerprint the SHA-1 or the SHA-256 fingerprint (told apart by the size)
+                 * @return ara::core::Result<Id> the certificate
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the certificate could not be found
+                 * @exception CryptoErrorDomain::kInvalidInputSize if the size is not of a SHA-1 or SHA-256 digest
+                 */
+                ara::core::Result<Id> FindByFingerprint (ReadOnlyMemRegion fingerprint) const noexcept;
+
+                /**
+                 * @brief Find the certificates valid at a time point.
+                 * @param[in] validityTimePoint the time point
+                 * @return ara::core::Result<ara::core::Vector<Id> > the found certificates, empty if nothing is found
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the result is insufficient
+                 */
+                ara::core::Result<ara::core::Vector<Id> > FindValidAt (time_t validityTimePoint) const noexcept;
+
+            private:
+                using Index = std::unordered_multimap<std::uint64_t, Id>;
+
+                struct Validity
+                {
+                    std::int64_t mNotBefore;
+                    std::int64_t mNotAfter;
+                    Id mId;
+                };
+
+                static std::uint64_t DnKey (ReadOnlyMemRegion canonicalDn) noexcept;
+                static std::uint64_t SerialKey (ReadOnlyMemRegion sn, std::uint64_t issuerDnKey) noexcept;
+                static std::uint64_t KeyIdKey (ReadOnlyMemRegion keyId) noexcept;
+                static std::uint64_t FingerprintKey (ReadOnlyMemRegion fingerprint) noexcept;
+                static void Erase (Index &index, std::uint64_t key, Id id) noexcept;
+                void Unlink (Id id, const DerCertificate &certificate) noexcept;
+                static bool IsValidAt (const DerCertificate &certificate, time_t validityTimePoint) noexcept;
+
+                template <typename Predicate>
+                ara::core::Result<ara::core::Vector<Id> > Find (const Index &index, std::uint64_t key, Predicate predicate) const noexcept;
+                static bool IsEarlier (const Validity &left, const Validity &right) noexcept;
+                void InsertValidity (Id id, const DerCertificate &certificate);
+                void EraseValidity (Id id, const DerCertificate &certificate) noexcept;
+                std::int64_t GetBlockEnd (std::size_t block) const noexcept;
+
+                mutable std::shared_mutex mMutex;
+                ara::core::Vector<CertPtr> mCertificates;     // indexed by Id, removed ones are null
+                ara::core::Vector<Id> mFreeIds;
+                std::size_t mCount = 0u;
+                Index mBySubject;
+                Index mBySerial;
+                Index mBySubjectKeyId;
+                Index mByAuthorityKeyId;
+                Index mBySha1;
+                Index mBySha256;
+
+                ara::core::Vector<Validity> mValidity;          // sorted by the start time
+                ara::core::Vector<std::int64_t> mBlockEnds;     // latest end time in each block of mValidity
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_CERTIFICATE_STORE_H
@@ -0,0 +1,675 @@
+#include "ara/crypto/x509/chain_verifier.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "ara/crypto/cryp/algorithm_registry.h"
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/rsa.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+#include "ara/crypto/cryp/public_key_cache.h"
+#include "ara/crypto/x509/internal/der.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                using internal::DerElement;
+                using internal::DerReader;
+
+                // Fewer items are not worth starting a thread for.
+                const std::size_t kMinItemsPerThread = 4u;
+
+                // Issuer keys kept prepared: a few CAs sign most of the certificates, CRLs and OCSP responses.
+                const std::size_t kIssuerKeyCapacity = 64u;
+
+                // BasicCertInfo::kConstrKeyCertSign
+                const std::uint32_t kConstrKeyCertSign = 0x0400u;
+
+                // AlgorithmIdentifier of sha256WithRSAEncryption with the NULL parameters (RFC 4055).
+                const std::uint8_t kSha256WithRsa[] = {
+                    0x30u, 0x0du, 0x06u, 0x09u, 0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x0bu, 0x05u, 0x00u};
+
+                // AlgorithmIdentifier of rsaEncryption with the NULL parameters (RFC 3279).
+                const std::uint8_t kRsaEncryption[] = {
+                    0x30u, 0x0du, 0x06u, 0x09u, 0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x01u, 0x01u, 0x05u, 0x00u};
+
+                bool IsEqual (ReadOnlyMemRegion left, ReadOnlyMemRegion right) noexcept
+                {
+                    return (left.size() == right.size()) && ((left.size() == 0u) || (std::memcmp(left.data(), right.data(), left.size()) == 0));
+                }
+
+                bool IsEqual (ReadOnlyMemRegion left, const std::uint8_t *right, std::size_t size) noexcept
+                {
+                    return (left.size() == size) && (std::memcmp(left.data(), right, size) == 0);
+                }
+
+                ChainVerifier::Status CheckTime (const DerCertificate &certificate, time_t now) noexcept
+                {
+                    if (!certificate.IsWellFormed())
+                    {
+                        return ChainVerifier::Status::kInvalid;
+                    }
+                    if (now < certificate.StartTime())
+                    {
+                        return ChainVerifier::Status::kFuture;
+                    }
+                    if (now > certificate.EndTime())
+                    {
+                        return ChainVerifier::Status::kExpired;
+                    }
+                    return ChainVerifier::Status::kValid;
+                }
+
+                /**
+                 * @brief RSA issuer key with the Montgomery constants of its modulus, shared by all threads.
+                 */
+                class PreparedRsaKey final : public cryp::PreparedPublicKey
+                {
+                public:
+                    CryptoAlgId GetAlgId () const noexcept override
+                    {
+                        return cryp::kAlgIdRsaPkcs1Sha2_256;
+                    }
+
+                    cryp::internal::Rsa mRsa;
+                };
+
+                // Holds PreparedRsaKey objects only, keyed by the SHA2-256 hash of the subjectPublicKey.
+                cryp::PublicKeyCache& GetIssuerKeys () noexcept
+                {
+                    static cryp::PublicKeyCache cIssuerKeys(kIssuerKeyCapacity);
+                    return cIssuerKeys;
+                }
+
+                // RSAPublicKey ::= SEQUENCE { modulus INTEGER, publicExponent INTEGER }
+                bool ParseRsaKey (ReadOnlyMemRegion subjectPublicKey, cryp::internal::Rsa &rsa) noexcept
+                {
+                    DerReader key(subjectPublicKey.data(), subjectPublicKey.size());
+                    DerElement sequence = {};
+                    DerElement modulus = {};
+                    DerElement exponent = {};
+                    if (!key.Read(DerReader::kTagSequence, sequence) || !key.IsEmpty())
+                    {
+                        return false;
+                    }
+                    DerReader integers(sequence);
+                    if (!integers.Read(DerReader::kTagInteger, modulus) || !integers.Read(DerReader::kTagInteger, exponent) || !integers.IsEmpty())
+                    {
+                        return false;
+                    }
+                    return rsa.SetPublicKey({modulus.mData, modulus.mSize}, {exponent.mData, exponent.mSize});
+                }
+
+                void Fingerprint (const DerCertificate &certificate, std::uint8_t fingerprint[32]) noexcept
+                {
+                    std::memcpy(fingerprint, certificate.Sha256Fingerprint().data(), cryp::internal::Sha256::kDigestSize);
+                }
+
+                // Run work(i) for i in [0, count) on up to maxThreads threads including the calling one.
+                template <typename Work>
+                void RunParallel (std::size_t count, std::size_t maxThreads, Work work) noexcept
+                {
+                    std::size_t threadCount = (maxThreads != 0) ? maxThreads : static_cast<std::size_t>(std::thread::hardware_concurrency());
+                    threadCount = std::min(std::max<std::size_t>(threadCount, 1u), std::max<std::size_t>(count / kMinItemsPerThread, 1u));
+
+                    std::atomic<std::size_t> next(0u);
+                    auto run = [&] ()
+                    {
+                        for (std::size_t i = next++; i < count; i = next++)
+                        {
+                            work(i);
+                        }
+                    };
+
+                    ara::core::Vector<std::thread> threads;
+                    threads.reserve(threadCount - 1u);
+                    for (std::size_t t = 1; t < threadCount; ++t)
+                    {
+                        try
+                        {
+                            threads.emplace_back(run);
+                        }
+                        catch (const std::system_error &)
+                        {
+                            // The items of not started workers are taken by the caller thread.
+                            break;
+                        }
+                    }
+                    run();
+                    for (std::thread &thread : threads)
+                    {
+                        thread.join();
+                    }
+                }
+            }
+
+            ChainVerifier::ChainVerifier (const CertificateStore *store, std::size_t capacity) noexcept
+            : mStore(store),
+              mCapacity(capacity),
+              mSignatureCheck(&ChainVerifier::CheckRsaSha256Signature),
+              mRevocationCheck(),
+              mGeneration(0u)
+            {
+            }
+
+            void ChainVerifier::SetSignatureCheck (SignatureCheck check) noexcept
+            {
+                mSignatureCheck = std::move(check);
+                ClearCache();
+            }
+
+            void ChainVerifier::SetRevocationCheck (RevocationCheck check) noexcept
+            {
+                mRevocationCheck = std::move(check);
+                RevocationChanged();
+            }
+
+            bool ChainVerifier::CheckRsaSha256Signature (const DerCertificate &certificate, const DerCertificate &issuer) noexcept
+            {
+                return CheckRsaSha256SignedData(certificate.GetTbsCertificate(), certificate.SignatureAlgorithm(), certificate.SignatureValue(), issuer);
+            }
+
+            bool ChainVerifier::CheckRsaSha256SignedData (ReadOnlyMemRegion signedData, ReadOnlyMemRegion algorithm, ReadOnlyMemRegion signatureValue, const DerCertificate &issuer) noexcept
+            {
+                if (!IsEqual(algorithm, kSha256WithRsa, sizeof(kSha256WithRsa)) ||
+                    !IsEqual(issuer.SubjectPublicKeyAlgorithm(), kRsaEncryption, sizeof(kRsaEncryption)))
+                {
+                    return false;
+                }
+
+                std::uint8_t digest[cryp::internal::Sha256::kDigestSize];
+                cryp::internal::Sha256::Compute(signedData.data(), signedData.size(), digest);
+
+                // The key is parsed and its modulus prepared once, then taken from the cache.
+                const ReadOnlyMemRegion subjectPublicKey = issuer.SubjectPublicKey();
+                std::uint8_t keyHash[cryp::internal::Sha256::kDigestSize];
+                cryp::internal::Sha256::Compute(subjectPublicKey.data(), subjectPublicKey.size(), keyHash);
+                const cryp::PublicKeyCache::KeyId id = cryp::PublicKeyCache::MakeKeyId(ReadOnlyMemRegion(keyHash, sizeof(keyHash)), cryp::kAlgIdRsaPkcs1Sha2_256);
+                using Prepared = ara::core::Result<cryp::PreparedPublicKey::Sptrc>;
+                Prepared prepared = Prepared::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                try
+                {
+                    prepared = GetIssuerKeys().FindOrPrepare(id, [subjectPublicKey] () noexcept -> Prepared
+                    {
+                        std::shared_ptr<PreparedRsaKey> key;
+                        try
+                        {
+                            key = std::make_shared<PreparedRsaKey>();
+                        }
+                        catch (const std::bad_alloc &)
+                        {
+                            return Prepared::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                        }
+                        if (!ParseRsaKey(subjectPublicKey, key->mRsa))
+                        {
+                            return Prepared::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                        }
+                        return Prepared::FromValue(std::move(key));
+                    });
+                }
+                catch (const std::bad_alloc &)
+                {
+                    // The preparer could not be stored; the key is parsed on the stack below.
+                }
+                if (prepared.HasValue())
+                {
+                    return static_cast<const PreparedRsaKey&>(*prepared.Value()).mRsa.VerifyPkcs1Sha256(digest, signatureValue.data(), signatureValue.size());
+                }
+                if (prepared.CheckError(CryptoErrorDomain::Errc::kInvalidArgument))
+                {
+                    return false;
+                }
+
+                // Without memory for the cache entry the key is prepared for this check only.
+                cryp::internal::Rsa rsa;
+                return ParseRsaKey(subjectPublicKey, rsa) && rsa.VerifyPkcs1Sha256(digest, signatureValue.data(), signatureValue.size());
+            }
+
+            ara::core::Result<void> ChainVerifier::SetAsRootOfTrust (CertPtr caCert) noexcept
+            {
+                if ((caCert == nullptr) || !caCert->IsParsed() || !caCert->IsWellFormed() || !caCert->IsCa())
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                if (!IsRootOfTrust(*caCert))
+                {
+                    const std::uint64_t key = caCert->SubjectDnHash();
+                    std::unique_lock<std::shared_mutex> lock(mRootsMutex);
+                    mRoots.emplace(key, std::move(caCert));
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            bool ChainVerifier::IsRootOfTrust (const DerCertificate &certificate) const noexcept
+            {
+                const std::uint64_t key = certificate.SubjectDnHash();
+                std::shared_lock<std::shared_mutex> lock(mRootsMutex);
+                auto range = mRoots.equal_range(key);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (IsEqual(it->second->GetEncoding(), certificate.GetEncoding()))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void ChainVerifier::RevocationChanged () noexcept
+            {
+                mGeneration.fetch_add(1u, std::memory_order_acq_rel);
+            }
+
+            ChainVerifier::Status ChainVerifier::VerifyCertChain (ara::core::Span<const CertPtr> chain, const DerCertificate *myRoot, time_t now) const noexcept
+            {
+                Path path;
+                PrepareChain(chain, myRoot, now, path);
+                return VerifyPath(path, now);
+            }
+
+            ChainVerifier::Status ChainVerifier::VerifyCert (const DerCertificate &certificate, const DerCertificate *myRoot, time_t now) const noexcept
+            {
+                Path path;
+                BuildPath(certificate, myRoot, now, path);
+                return VerifyPath(path, now);
+            }
+
+            ara::core::Vector<ChainVerifier::Status> ChainVerifier::VerifyCertChains (ara::core::Span<const ara::core::Span<const CertPtr> > chains, const DerCertificate *myRoot, time_t now, std::size_t maxThreads) const noexcept
+            {
+                ara::core::Vector<Path> paths(chains.size());
+                RunParallel(chains.size(), maxThreads, [&] (std::size_t i)
+                    {
+                        PrepareChain(chains[i], myRoot, now, paths[i]);
+                    });
+                return VerifyPaths(paths, now, maxThreads);
+            }
+
+            ara::core::Vector<ChainVerifier::Status> ChainVerifier::VerifyCerts (ara::core::Span<const CertPtr> certificates, const DerCertificate *myRoot, time_t now, std::size_t maxThreads) const noexcept
+            {
+                ara::core::Vector<Path> paths(certificates.size());
+                RunParallel(certificates.size(), maxThreads, [&] (std::size_t i)
+                    {
+                        if (certificates[i] == nullptr)
+                        {
+                            paths[i].mDecided = true;
+                            paths[i].mStatus = Status::kInvalid;
+                            return;
+                        }
+                        BuildPath(*certificates[i], myRoot, now, paths[i]);
+                    });
+                return VerifyPaths(paths, now, maxThreads);
+            }
+
+            std::size_t ChainVerifier::GetCachedEdgeCount () const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+                return mEdges.size();
+            }
+
+            bool ChainVerifier::EdgeKey::operator== (const EdgeKey &other) const noexcept
+            {
+                return std::memcmp(this, &other, sizeof(EdgeKey)) == 0;
+            }
+
+            std::size_t ChainVerifier::EdgeKeyHash::operator() (const EdgeKey &key) const noexcept
+            {
+                // The fingerprints are uniformly distributed already.
+                std::uint64_t issuer;
+                std::uint64_t subject;
+                std::memcpy(&issuer, key.mIssuer, sizeof(issuer));
+                std::memcpy(&subject, key.mSubject, sizeof(subject));
+                return static_cast<std::size_t>(issuer ^ (subject * 0x9e3779b97f4a7c15ull));
+            }
+
+            void ChainVerifier::PrepareChain (ara::core::Span<const CertPtr> chain, const DerCertificate *myRoot, time_t now, Path &path) const noexcept
+            {
+                path.mCertificates.clear();
+                path.mAnchor = nullptr;
+                path.mHolders.clear();
+                path.mDecided = true;
+                path.mStatus = Status::kInvalid;
+                if (chain.size() == 0u)
+                {
+                    return;
+                }
+                path.mCertificates.reserve(chain.size());
+                for (const CertPtr &certificate : chain)
+                {
+                    if ((certificate == nullptr) || !certificate->IsParsed())
+                    {
+                        return;
+                    }
+                    path.mCertificates.push_back(certificate.get());
+                }
+
+                // The chain may start with the trust anchor itself or with a certificate issued by it.
+                const DerCertificate *first = path.mCertificates[0];
+                path.mDecided = false;
+                path.mAnchor = myRoot;
+                if ((myRoot != nullptr) ? IsEqual(first->GetEncoding(), myRoot->GetEncoding()) : IsRootOfTrust(*first))
+                {
+                    path.mAnchor = first;
+                    path.mCertificates.erase(path.mCertificates.begin());
+                    path.mStatus = CheckTime(*first, now);
+                    path.mDecided = (path.mStatus != Status::kValid);
+                }
+                else if (myRoot == nullptr)
+                {
+                    CertPtr holder;
+                    path.mAnchor = FindIssuer(*first, nullptr, holder, now);
+                    if ((path.mAnchor != nullptr) && !IsRootOfTrust(*path.mAnchor))
+                    {
+                        path.mAnchor = nullptr;
+                    }
+                    path.mHolders.push_back(std::move(holder));
+                }
+            }
+
+            void ChainVerifier::BuildPath (const DerCertificate &certificate, const DerCertificate *myRoot, time_t now, Path &path) const noexcept
+            {
+                path.mCertificates.assign(1u, &certificate);
+                path.mAnchor = nullptr;
+                path.mHolders.clear();
+                path.mDecided = true;
+                path.mStatus = Status::kInvalid;
+                if (!certificate.IsParsed())
+                {
+                    return;
+                }
+                if ((myRoot != nullptr) ? IsEqual(certificate.GetEncoding(), myRoot->GetEncoding()) : IsRootOfTrust(certificate))
+                {
+                    path.mStatus = CheckTime(certificate, now);
+                    return;
+                }
+
+                // The path is built upwards from the certificate.
+                path.mDecided = false;
+                while (path.mCertificates.size() <= kMaxDepth)
+                {
+                    CertPtr holder;
+                    const DerCertificate *issuer = FindIssuer(*path.mCertificates.back(), myRoot, holder, now);
+                    if ((issuer == nullptr) || (std::find(path.mCertificates.begin(), path.mCertificates.end(), issuer) != path.mCertificates.end()))
+                    {
+                        break;
+                    }
+                    path.mHolders.push_back(std::move(holder));
+                    if ((issuer == myRoot) || ((myRoot == nullptr) && IsRootOfTrust(*issuer)))
+                    {
+                        path.mAnchor = issuer;
+                        break;
+                    }
+                    path.mCertificates.push_back(issuer);
+                }
+                std::reverse(path.mCertificates.begin(), path.mCertificates.end());
+            }
+
+            ChainVerifier::Status ChainVerifier::VerifyPath (const Path &path, time_t now) const noexcept
+            {
+                if (path.mDecided)
+                {
+                    return path.mStatus;
+                }
+                const DerCertificate *const anchor = path.mAnchor;
+                const std::size_t size = path.mCertificates.size();
+
+                // The trust anchor must be valid at the time, also when it is found as an issuer instead of heading
+                // the chain.
+                if (anchor != nullptr)
+                {
+                    const Status status = CheckTime(*anchor, now);
+                    if (status != Status::kValid)
+                    {
+                        return status;
+                    }
+                }
+
+                // RFC 5280 6.1.2 (k)-(m): max_path_length counts the intermediate CAs that may follow.
+                std::size_t maxPathLength = size;
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    const DerCertificate &certificate = *path.mCertificates[i];
+                    const DerCertificate *issuer = (i == 0u) ? anchor : path.mCertificates[i - 1u];
+                    if (!certificate.IsWellFormed() || certificate.HasUnknownCriticalExtension())
+                    {
+                        return Status::kInvalid;
+                    }
+                    if (issuer != nullptr)
+                    {
+                        const std::uint32_t constraints = issuer->GetConstraints();
+                        bool revoked = false;
+                        if (!certificate.IssuerDnMatches(*issuer) || !issuer->IsCa() ||
+                            ((constraints != 0u) && ((constraints & kConstrKeyCertSign) == 0u)) || !CheckEdge(certificate, *issuer, revoked) || revoked)
+                        {
+                            return Status::kInvalid;
+                        }
+                    }
+                    if (i + 1u < size)
+                    {
+                        if (!certificate.IsSelfIssued())
+                        {
+                            if (maxPathLength == 0u)
+                            {
+                                return Status::kInvalid;
+                            }
+                            --maxPathLength;
+                        }
+                        maxPathLength = std::min<std::size_t>(maxPathLength, certificate.GetPathLimit());
+                    }
+                    const Status status = CheckTime(certificate, now);
+                    if (status != Status::kValid)
+                    {
+                        return status;
+                    }
+                }
+                return (anchor != nullptr) ? Status::kValid : Status::kNoTrust;
+            }
+
+            ara::core::Vector<ChainVerifier::Status> ChainVerifier::VerifyPaths (const ara::core::Vector<Path> &paths, time_t now, std::size_t maxThreads) const noexcept
+            {
+                // The distinct edges (by the fingerprints, as the cache keys them) are checked first, so an edge
+                // shared by many paths costs one signature check and the paths then meet cached edges only.
+                struct PathEdge
+                {
+                    EdgeKey mKey;
+                    const DerCertificate *mIssuer;
+                    const DerCertificate *mSubject;
+                };
+                ara::core::Vector<PathEdge> edges;
+                for (const Path &path : paths)
+                {
+                    for (std::size_t i = 0; !path.mDecided && (i < path.mCertificates.size()); ++i)
+                    {
+                        const DerCertificate *issuer = (i == 0u) ? path.mAnchor : path.mCertificates[i - 1u];
+                        if ((issuer != nullptr) && issuer->IsCa() && path.mCertificates[i]->IssuerDnMatches(*issuer))
+                        {
+                            PathEdge edge = {};
+                            Fingerprint(*issuer, edge.mKey.mIssuer);
+                            Fingerprint(*path.mCertificates[i], edge.mKey.mSubject);
+                            edge.mIssuer = issuer;
+                            edge.mSubject = path.mCertificates[i];
+                            edges.push_back(edge);
+                        }
+                    }
+                }
+                std::sort(edges.begin(), edges.end(), [] (const PathEdge &left, const PathEdge &right)
+                    {
+                        return std::memcmp(&left.mKey, &right.mKey, sizeof(EdgeKey)) < 0;
+                    });
+                edges.erase(std::unique(edges.begin(), edges.end(), [] (const PathEdge &left, const PathEdge &right)
+                    {
+                        return left.mKey == right.mKey;
+                    }), edges.end());
+                RunParallel(edges.size(), maxThreads, [&] (std::size_t i)
+                    {
+                        bool revoked = false;
+                        CheckEdge(*edges[i].mSubject, *edges[i].mIssuer, revoked);
+                    });
+
+                ara::core::Vector<Status> statuses(paths.size(), Status::kUnknown);
+                RunParallel(paths.size(), maxThreads, [&] (std::size_t i)
+                    {
+                        statuses[i] = VerifyPath(paths[i], now);
+                    });
+                return statuses;
+            }
+
+            bool ChainVerifier::CheckEdge (const DerCertificate &certificate, const DerCertificate &issuer, bool &revoked) const noexcept
+            {
+                EdgeKey key;
+                Fingerprint(issuer, key.mIssuer);
+                Fingerprint(certificate, key.mSubject);
+                const std::uint64_t generation = mGeneration.load(std::memory_order_acquire);
+                auto isCurrent = [generation] (const Edge &edge)
+                {
+                    return !edge.mPending && (!edge.mSignatureValid || (edge.mGeneration == generation));
+                };
+                {
+                    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+                    auto it = mEdges.find(key);
+                    if ((it != mEdges.end()) && isCurrent(it->second))
+                    {
+                        revoked = it->second.mRevoked;
+                        return it->second.mSignatureValid;
+                    }
+                }
+
+                // The edge is claimed by a pending entry, so a concurrent check of it waits for the result.
+                bool known = false;
+                Edge edge = {false, false, true, generation};
+                {
+                    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+                    auto it = mEdges.find(key);
+                    while ((it != mEdges.end()) && it->second.mPending)
+                    {
+                        mEdgeReady.wait(lock);
+                        it = mEdges.find(key);
+                    }
+                    if ((it != mEdges.end()) && isCurrent(it->second))
+                    {
+                        revoked = it->second.mRevoked;
+                        return it->second.mSignatureValid;
+                    }
+                    if (it != mEdges.end())
+                    {
+                        known = true;
+                        edge.mSignatureValid = it->second.mSignatureValid;
+                    }
+                    else if (mEdges.size() >= mCapacity)
+                    {
+                        // The pending entries are kept for the threads waiting for them.
+                        for (auto entry = mEdges.begin(); entry != mEdges.end(); )
+                        {
+                            entry = entry->second.mPending ? std::next(entry) : mEdges.erase(entry);
+                        }
+                    }
+                    mEdges[key] = edge;
+                }
+
+                // Only the revocation is checked again for a known signature.
+                if (!known)
+                {
+                    edge.mSignatureValid = mSignatureCheck(certificate, issuer);
+                }
+                edge.mRevoked = edge.mSignatureValid && mRevocationCheck && mRevocationCheck(certificate, issuer);
+                edge.mPending = false;
+                {
+                    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+                    mEdges[key] = edge;
+                }
+                mEdgeReady.notify_all();
+                revoked = edge.mRevoked;
+                return edge.mSignatureValid;
+            }
+
+            const DerCertificate* ChainVerifier::FindIssuer (const DerCertificate &certificate, const DerCertificate *myRoot, CertPtr &holder, time_t now) const noexcept
+            {
+                const ReadOnlyMemRegion keyId = certificate.AuthorityKeyId();
+                if (myRoot != nullptr)
+                {
+                    if (certificate.IssuerDnMatches(*myRoot))
+                    {
+                        return myRoot;
+                    }
+                }
+                else
+                {
+                    // Of several matching roots (e.g. during a rollover) one valid now is preferred.
+                    const std::uint64_t key = certificate.IssuerDnHash();
+                    std::shared_lock<std::shared_mutex> lock(mRootsMutex);
+                    auto range = mRoots.equal_range(key);
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        const DerCertificate &root = *it->second;
+                        if (certificate.IssuerDnMatches(root) && ((keyId.size() == 0u) || (root.SubjectKeyId().size() == 0u) || IsEqual(root.SubjectKeyId(), keyId)))
+                        {
+                            const bool valid = (CheckTime(root, now) == Status::kValid);
+                            if (valid || (holder == nullptr))
+                            {
+                                holder = it->second;
+                            }
+                            if (valid)
+                            {
+                                return holder.get();
+                            }
+                        }
+                    }
+                    if (holder != nullptr)
+                    {
+                        return holder.get();
+                    }
+                }
+                if (mStore == nullptr)
+                {
+                    return nullptr;
+                }
+
+                // Prefer an issuer with the authority key ID as its subject key ID that is valid now.
+                // Without the memory for the candidates no issuer is found, the chain fails to verify.
+                const ara::core::Result<ara::core::Vector<CertificateStore::Id> > candidates = (keyId.size() != 0u) ?
+                    mStore->FindByKeyIds(keyId, ara::core::Optional<ReadOnlyMemRegion>()) : mStore->FindByCanonicalDn(certificate.CanonicalIssuerDn(), now);
+                if (!candidates.HasValue())
+                {
+                    return nullptr;
+                }
+                CertPtr fallback;
+                for (CertificateStore::Id id : candidates.Value())
+                {
+                    CertPtr candidate = mStore->Get(id);
+                    if ((candidate == nullptr) || !certificate.IssuerDnMatches(*candidate))
+                    {
+                        continue;
+                    }
+                    if (CheckTime(*candidate, now) == Status::kValid)
+                    {
+                        holder = std::move(candidate);
+                        return holder.get();
+                    }
+                    if (fallback == nullptr)
+                    {
+                        fallback = std::move(candidate);
+                    }
+                }
+                holder = std::move(fallback);
+                return holder.get();
+            }
+
+            void ChainVerifier::ClearCache () noexcept
+            {
+                std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+                mEdges.clear();
+            }
+        }
+    }
+}
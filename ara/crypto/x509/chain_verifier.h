@@ -0,0 +1,251 @@
+#ifndef ARA_CRYPTO_X509_CHAIN_VERIFIER_H
+#define ARA_CRYPTO_X509_CHAIN_VERIFIER_H
+
+#include <atomic>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "ara/core/result.h"
+#include "ara/core/span.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/x509/certificate_store.h"
+#include "ara/crypto/x509/der_certificate.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief Certification path validation backing X509Provider::VerifyCertChain() and VerifyCert() (RFC 5280
+             * 6.1: name chaining, CA and key usage constraints, path length, validity, revocation). Each verified
+             * (issuer, subject) edge is cached by the SHA2-256 fingerprints of both certificates together with the
+             * revocation generation it was checked at, so re-verifying chains that share intermediates costs hash
+             * lookups. A signature never changes, so RevocationChanged() (called on ImportCrl() or a new OCSP
+             * status) only makes the cached revocation results stale, and the trust anchors are looked up on every
+             * call, so SetAsRootOfTrust() needs no invalidation at all. The verification methods may be called
+             * concurrently, an edge being checked by one thread is awaited by the others instead of checked again;
+             * the checks must be configured before.
+             */
+            class ChainVerifier
+            {
+            public:
+
+                /**
+                 * @brief Verification status, the values are those of Certificate::Status.
+                 */
+                enum class Status : std::uint32_t
+                {
+                    kValid= 0,      // The certificate is valid.
+                    kInvalid= 1,    // The certificate is invalid.
+                    kUnknown= 2,    // Status of the certificate is unknown yet.
+                    kNoTrust= 3,    // The certificate has correct signature, but there is no root of trust for it.
+                    kExpired= 4,    // The certificate has correct signature, but it is already expired.
+                    kFuture= 5      // The certificate has correct signature, but its validity period is not started yet.
+                };
+
+                using CertPtr = CertificateStore::CertPtr;
+
+                /**
+                 * @brief Check of the signature of a certificate by the public key of its issuer.
+                 */
+                using SignatureCheck = std::function<bool (const DerCertificate &certificate, const DerCertificate &issuer)>;
+
+                /**
+                 * @brief Check whether a certificate issued by the issuer is revoked.
+                 */
+                using RevocationCheck = std::function<bool (const DerCertificate &certificate, const DerCertificate &issuer)>;
+
+                /**
+                 * @brief Default maximal number of cached edges.
+                 */
+                static const std::size_t kDefaultCapacity = 65536u;
+
+                /**
+                 * @brief Maximal length of a certification path built by VerifyCert().
+                 */
+                static const std::size_t kMaxDepth = 16u;
+
+                /**
+                 * @brief Construct a new Chain Verifier object checking sha256WithRSAEncryption signatures.
+                 * @param[in] store the certificate storage VerifyCert() looks the issuers up in (may be nullptr)
+                 * @param[in] capacity maximal number of cached edges, the cache is emptied when it is full
+                 */
+                explicit ChainVerifier (const CertificateStore *store=nullptr, std::size_t capacity=kDefaultCapacity) noexcept;
+
+                ChainVerifier (const ChainVerifier &) = delete;
+                ChainVerifier& operator= (const ChainVerifier &) = delete;
+
+                /**
+                 * @brief Replace the signature check, e.g. by one supporting more algorithms. Empties the cache.
+                 * @param[in] check the signature check
+                 */
+                void SetSignatureCheck (SignatureCheck check) noexcept;
+
+                /**
+                 * @brief Set the revocation check (e.g. by CRLs or OCSP responses). Makes the cached revocation
+                 * results stale.
+                 * @param[in] check the revocation check, an empty function disables the revocation checking
+                 */
+                void SetRevocationCheck (RevocationCheck check) noexcept;
+
+                /**
+                 * @brief Check an RSASSA-PKCS1-v1_5 signature with SHA2-256 (sha256WithRSAEncryption) by an RSA
+                 * issuer key of up to 4096 bits. This is the default signature check.
+                 * @param[in] certificate the signed certificate
+                 * @param[in] issuer the issuer certificate
+                 * @return true if the signature is valid
+                 */
+                static bool CheckRsaSha256Signature (const DerCertificate &certificate, const DerCertificate &issuer) noexcept;
+
+                /**
+                 * @brief Check an RSASSA-PKCS1-v1_5 signature with SHA2-256 of any signed structure (e.g. a CRL) by an
+                 * RSA issuer key of up to 4096 bits. The issuer keys are parsed and their moduli prepared once and
+                 * kept in a PublicKeyCache of the 64 most recently used ones, keyed by the hash of the
+                 * subjectPublicKey.
+                 * @param[in] signedData the DER encoding of the signed part (e.g. the tbsCertList)
+                 * @param[in] algorithm the DER encoded signature AlgorithmIdentifier
+                 * @param[in] signatureValue the signature (the BIT STRING content without the unused bits octet)
+                 * @param[in] issuer the issuer certificate
+                 * @return true if the signature is valid
+                 */
+                static bool CheckRsaSha256SignedData (ReadOnlyMemRegion signedData, ReadOnlyMemRegion algorithm, ReadOnlyMemRegion signatureValue, const DerCertificate &issuer) noexcept;
+
+                /**
+                 * @brief Add a trust anchor.
+                 * @param[in] caCert the CA certificate
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kInvalidArgument if the certificate is not a well-formed CA certificate
+                 */
+                ara::core::Result<void> SetAsRootOfTrust (CertPtr caCert) noexcept;
+
+                /**
+                 * @brief Check if a certificate is a trust anchor.
+                 * @param[in] certificate the certificate
+                 * @return true if an identical certificate has been passed to SetAsRootOfTrust()
+                 */
+                bool IsRootOfTrust (const DerCertificate &certificate) const noexcept;
+
+                /**
+                 * @brief Notify that the revocation data have changed, so the revocation results cached with the
+                 * edges are checked again on their next use.
+                 */
+                void RevocationChanged () noexcept;
+
+                /**
+                 * @brief Verify a certification chain ordered from the root CA (zero index) to the end-entity.
+                 * @param[in] chain the certificates
+                 * @param[in] myRoot the trust anchor to be used, nullptr for the roots of trust
+                 * @param[in] now the verification time
+                 * @return Status the status of the first failed certificate, kValid if all are valid (the trust anchor
+                 * is checked first, also when it is not part of the chain)
+                 */
+                Status VerifyCertChain (ara::core::Span<const CertPtr> chain, const DerCertificate *myRoot, time_t now) const noexcept;
+
+                /**
+                 * @brief Verify a certificate by a path built from the certificate storage to a trust anchor.
+                 * @param[in] certificate the certificate
+                 * @param[in] myRoot the trust anchor to be used, nullptr for the roots of trust
+                 * @param[in] now the verification time
+                 * @return Status kNoTrust if no path to a trust anchor has been found, kExpired or kFuture also if the
+                 * trust anchor is not valid at the time
+                 */
+                Status VerifyCert (const DerCertificate &certificate, const DerCertificate *myRoot, time_t now) const noexcept;
+
+                /**
+                 * @brief Verify a batch of certification chains concurrently. The distinct (issuer, subject) edges
+                 * of all chains are collected first, so a signature shared by many chains (e.g. of an intermediate
+                 * CA) is checked once, then the signatures and the chains are spread over worker threads.
+                 * @param[in] chains the chains, each ordered from the root CA to the end-entity
+                 * @param[in] myRoot the trust anchor to be used, nullptr for the roots of trust
+                 * @param[in] now the verification time
+                 * @param[in] maxThreads maximal number of threads including the calling one (0 means the number of
+                 * hardware threads)
+                 * @return ara::core::Vector<Status> the status of each chain as returned by VerifyCertChain()
+                 */
+                ara::core::Vector<Status> VerifyCertChains (ara::core::Span<const ara::core::Span<const CertPtr> > chains, const DerCertificate *myRoot, time_t now, std::size_t maxThreads=0) const noexcept;
+
+                /**
+                 * @brief Verify a batch of certificates concurrently by paths built from the certificate storage (e.g.
+                 * to revalidate the whole storage against new CRLs). The shared edges are checked once as by
+                 * VerifyCertChains().
+                 * @param[in] certificates the certificates
+                 * @param[in] myRoot the trust anchor to be used, nullptr for the roots of trust
+                 * @param[in] now the verification time
+                 * @param[in] maxThreads maximal number of threads including the calling one (0 means the number of
+                 * hardware threads)
+                 * @return ara::core::Vector<Status> the status of each certificate as returned by VerifyCert()
+                 */
+                ara::core::Vector<Status> VerifyCerts (ara::core::Span<const CertPtr> certificates, const DerCertificate *myRoot, time_t now, std::size_t maxThreads=0) const noexcept;
+
+                /**
+                 * @brief Get the number of cached edges.
+                 * @return std::size_t
+                 */
+                std::size_t GetCachedEdgeCount () const noexcept;
+
+            private:
+                struct EdgeKey
+                {
+                    std::uint8_t mIssuer[32];
+                    std::uint8_t mSubject[32];
+
+                    bool operator== (const EdgeKey &other) const noexcept;
+                };
+
+                struct EdgeKeyHash
+                {
+                    std::size_t operator() (const EdgeKey &key) const noexcept;
+                };
+
+                struct Edge
+                {
+                    bool mSignatureValid;
+                    bool mRevoked;
+                    bool mPending;                  // being checked by a thread, the others wait for mEdgeReady
+                    std::uint64_t mGeneration;
+                };
+
+                // A certification path from a trust anchor (excluded) down to the verified certificate.
+                struct Path
+                {
+                    ara::core::Vector<const DerCertificate*> mCertificates;
+                    const DerCertificate *mAnchor;
+                    ara::core::Vector<CertPtr> mHolders;    // keep the found issuers alive
+                    bool mDecided;                          // the status is known before the path is verified
+                    Status mStatus;
+                };
+
+                void PrepareChain (ara::core::Span<const CertPtr> chain, const DerCertificate *myRoot, time_t now, Path &path) const noexcept;
+                void BuildPath (const DerCertificate &certificate, const DerCertificate *myRoot, time_t now, Path &path) const noexcept;
+                Status VerifyPath (const Path &path, time_t now) const noexcept;
+                ara::core::Vector<Status> VerifyPaths (const ara::core::Vector<Path> &paths, time_t now, std::size_t maxThreads) const noexcept;
+                bool CheckEdge (const DerCertificate &certificate, const DerCertificate &issuer, bool &revoked) const noexcept;
+                const DerCertificate* FindIssuer (const DerCertificate &certificate, const DerCertificate *myRoot, CertPtr &holder, time_t now) const noexcept;
+                void ClearCache () noexcept;
+
+                const CertificateStore *mStore;
+                std::size_t mCapacity;
+                SignatureCheck mSignatureCheck;
+                RevocationCheck mRevocationCheck;
+                std::atomic<std::uint64_t> mGeneration;
+
+                mutable std::shared_mutex mRootsMutex;
+                std::unordered_multimap<std::uint64_t, CertPtr> mRoots;     // by DerCertificate::SubjectDnHash()
+
+                mutable std::shared_mutex mCacheMutex;
+                mutable std::unordered_map<EdgeKey, Edge, EdgeKeyHash> mEdges;
+                mutable std::condition_variable_any mEdgeReady;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_CHAIN_VERIFIER_H
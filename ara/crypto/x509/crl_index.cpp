@@ -0,0 +1,717 @@
+#include "ara/crypto/x509/crl_index.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+#include "ara/crypto/x509/internal/canonical_dn.h"
+#include "ara/crypto/x509/internal/der.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                using internal::DerElement;
+                using internal::DerReader;
+
+                // Written in the native byte order, so a file of a foreign byte order is rejected. Version 2 keys the
+                // issuers by their canonical DNs, version 3 records the public key of each issuer, and version 4
+                // keys the issuers by both, so the CRLs of two keys of one issuer name are kept side by side.
+                const std::uint64_t kMagic = 0x41524143524c3034ull;    // "ARACRL04"
+
+                // The SHA2-256 of the canonical issuer DN followed by the SHA2-256 of the SubjectPublicKeyInfo of
+                // the issuer. The records of one issuer name are adjacent in the key order.
+                const std::size_t kDnKeySize = 32u;
+                const std::size_t kKeySize = 2u * kDnKeySize;
+
+                // BasicCertInfo::kConstrCrlSign
+                const std::uint32_t kConstrCrlSign = 0x0200u;
+
+                bool IsTime (const DerElement &element) noexcept
+                {
+                    return (element.mTag == DerReader::kTagUtcTime) || (element.mTag == DerReader::kTagGeneralizedTime);
+                }
+
+                // Extensions ::= SEQUENCE OF Extension. The critical ones (delta CRL indicator, issuing distribution
+                // point, certificate issuer) change the scope of the CRL, which the index does not model.
+                bool ReadExtensions (const DerElement &extensions, bool &supported) noexcept
+                {
+                    DerReader list(extensions);
+                    if (list.IsEmpty())
+                    {
+                        return false;
+                    }
+                    while (!list.IsEmpty())
+                    {
+                        DerElement extension = {};
+                        DerElement oid = {};
+                        DerElement flag = {};
+                        DerElement value = {};
+                        bool critical = false;
+                        if (!list.Read(DerReader::kTagSequence, extension))
+                        {
+                            return false;
+                        }
+                        DerReader fields(extension);
+                        if (!fields.Read(DerReader::kTagOid, oid) || !fields.ReadOptional(DerReader::kTagBoolean, flag) ||
+                            ((flag.mData != nullptr) && (!DerReader::DecodeBoolean(flag, critical) || !critical)) ||
+                            !fields.Read(DerReader::kTagOctetString, value) || !fields.IsEmpty())
+                        {
+                            return false;
+                        }
+                        supported = supported && !critical;
+                    }
+                    return true;
+                }
+
+                void MakeDnKey (ReadOnlyMemRegion canonicalIssuerDn, std::uint8_t key[kDnKeySize]) noexcept
+                {
+                    cryp::internal::Sha256::Compute(canonicalIssuerDn.data(), canonicalIssuerDn.size(), key);
+                }
+
+                // The key of the issuer is identified by the hash of its SubjectPublicKeyInfo, which unlike the
+                // SubjectKeyIdentifier extension every certificate has.
+                void MakeKey (ReadOnlyMemRegion canonicalIssuerDn, const DerCertificate &issuer, std::uint8_t key[kKeySize]) noexcept
+                {
+                    const ReadOnlyMemRegion publicKey = issuer.SubjectPublicKeyInfo();
+                    MakeDnKey(canonicalIssuerDn, key);
+                    cryp::internal::Sha256::Compute(publicKey.data(), publicKey.size(), key + kDnKeySize);
+                }
+
+                // The directory of a file, to make a rename within it durable.
+                ara::core::String GetDirectory (const ara::core::String &path)
+                {
+                    const std::size_t slash = path.find_last_of('/');
+                    if (slash == ara::core::String::npos)
+                    {
+                        return ".";
+                    }
+                    return (slash == 0u) ? ara::core::String("/") : path.substr(0u, slash);
+                }
+            }
+
+            /**
+             * @brief Layout of the index file: the header, the issuer records sorted by their keys and the serial
+             * records of each issuer sorted by their bytes.
+             */
+            struct CrlIndex::Header
+            {
+                std::uint64_t mMagic;
+                std::uint64_t mIssuerCount;
+                std::uint64_t mSerialCount;
+                std::uint64_t mReserved;
+            };
+
+            struct CrlIndex::IssuerRecord
+            {
+                std::uint8_t mKey[kKeySize];    // SHA2-256 of the canonical issuer DN and of the issuer's SubjectPublicKeyInfo
+                std::int64_t mThisUpdate;
+                std::int64_t mNextUpdate;       // 0 if absent
+                std::uint64_t mFirst;           // index of the first serial record
+                std::uint64_t mCount;
+            };
+
+            // The size first and the zero padded content octets: any two serial numbers compare by memcmp().
+            struct CrlIndex::SerialRecord
+            {
+                std::uint8_t mSize;
+                std::uint8_t mValue[kMaxSerialSize];
+            };
+
+            CrlIndex::Image::Image () noexcept : mMapping(nullptr), mMappingSize(0u), mBuffer(), mData(nullptr), mSize(0u)
+            {
+                static_assert((sizeof(Header) == 32u) && (sizeof(IssuerRecord) == 96u) && (sizeof(SerialRecord) == 24u),
+                    "The file layout must not depend on the compiler");
+            }
+
+            CrlIndex::Image::~Image () noexcept
+            {
+                if (mMapping != nullptr)
+                {
+                    ::munmap(mMapping, mMappingSize);
+                }
+            }
+
+            bool CrlIndex::Image::Map (int fd, std::size_t size) noexcept
+            {
+                if (size < sizeof(Header))
+                {
+                    return false;
+                }
+                void *memory = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+                if (memory == MAP_FAILED)
+                {
+                    return false;
+                }
+                mMapping = memory;
+                mMappingSize = size;
+                mData = static_cast<const std::uint8_t*>(memory);
+                mSize = size;
+                return true;
+            }
+
+            void CrlIndex::Image::Assign (ara::core::Vector<std::uint8_t> &&buffer) noexcept
+            {
+                mBuffer = std::move(buffer);
+                mData = mBuffer.data();
+                mSize = mBuffer.size();
+            }
+
+            bool CrlIndex::Image::IsWellFormed () const noexcept
+            {
+                if ((mSize < sizeof(Header)) || (GetHeader().mMagic != kMagic))
+                {
+                    return false;
+                }
+                const Header &header = GetHeader();
+                if ((header.mIssuerCount > mSize / sizeof(IssuerRecord)) || (header.mSerialCount > mSize / sizeof(SerialRecord)) ||
+                    (mSize != sizeof(Header) + header.mIssuerCount * sizeof(IssuerRecord) + header.mSerialCount * sizeof(SerialRecord)))
+                {
+                    return false;
+                }
+
+                // The lookups are binary searches, so both the issuers and the serial records of each issuer
+                // must be strictly ordered, and a serial record must be zero padded to compare by memcmp().
+                const IssuerRecord *issuers = GetIssuers();
+                const SerialRecord *serials = GetSerials();
+                for (std::uint64_t i = 0; i < header.mIssuerCount; ++i)
+                {
+                    if ((issuers[i].mFirst > header.mSerialCount) || (issuers[i].mCount > header.mSerialCount - issuers[i].mFirst) ||
+                        ((i != 0u) && (std::memcmp(issuers[i - 1u].mKey, issuers[i].mKey, kKeySize) >= 0)))
+                    {
+                        return false;
+                    }
+                    for (std::uint64_t j = issuers[i].mFirst; j < issuers[i].mFirst + issuers[i].mCount; ++j)
+                    {
+                        const SerialRecord &serial = serials[j];
+                        if ((serial.mSize == 0u) || (serial.mSize > kMaxSerialSize) ||
+                            (std::count(serial.mValue + serial.mSize, serial.mValue + kMaxSerialSize, 0u) != static_cast<std::ptrdiff_t>(kMaxSerialSize - serial.mSize)) ||
+                            ((j != issuers[i].mFirst) && (std::memcmp(&serials[j - 1u], &serial, sizeof(SerialRecord)) >= 0)))
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            const CrlIndex::Header& CrlIndex::Image::GetHeader () const noexcept
+            {
+                return *reinterpret_cast<const Header*>(mData);
+            }
+
+            const CrlIndex::IssuerRecord* CrlIndex::Image::GetIssuers () const noexcept
+            {
+                return reinterpret_cast<const IssuerRecord*>(mData + sizeof(Header));
+            }
+
+            const CrlIndex::SerialRecord* CrlIndex::Image::GetSerials () const noexcept
+            {
+                return reinterpret_cast<const SerialRecord*>(mData + sizeof(Header) + GetHeader().mIssuerCount * sizeof(IssuerRecord));
+            }
+
+            const CrlIndex::IssuerRecord* CrlIndex::Image::FindIssuer (const std::uint8_t key[kKeySize]) const noexcept
+            {
+                const IssuerRecord *begin = GetIssuers();
+                const IssuerRecord *end = begin + GetHeader().mIssuerCount;
+                const IssuerRecord *found = std::lower_bound(begin, end, key, [] (const IssuerRecord &record, const std::uint8_t *value)
+                    {
+                        return std::memcmp(record.mKey, value, kKeySize) < 0;
+                    });
+                return ((found != end) && (std::memcmp(found->mKey, key, kKeySize) == 0)) ? found : nullptr;
+            }
+
+            std::pair<const CrlIndex::IssuerRecord*, const CrlIndex::IssuerRecord*> CrlIndex::Image::FindIssuers (const std::uint8_t dnKey[kDnKeySize]) const noexcept
+            {
+                const IssuerRecord *begin = GetIssuers();
+                const IssuerRecord *end = begin + GetHeader().mIssuerCount;
+                const IssuerRecord *first = std::lower_bound(begin, end, dnKey, [] (const IssuerRecord &record, const std::uint8_t *value)
+                    {
+                        return std::memcmp(record.mKey, value, kDnKeySize) < 0;
+                    });
+                const IssuerRecord *last = std::upper_bound(first, end, dnKey, [] (const std::uint8_t *value, const IssuerRecord &record)
+                    {
+                        return std::memcmp(value, record.mKey, kDnKeySize) < 0;
+                    });
+                return std::make_pair(first, last);
+            }
+
+            CrlIndex::CrlIndex (const ara::core::String &path, ChainVerifier *verifier) noexcept
+            : mPath(path),
+              mVerifier(verifier),
+              mSignatureCheck(&ChainVerifier::CheckRsaSha256SignedData),
+              mImage()
+            {
+            }
+
+            void CrlIndex::SetSignatureCheck (SignatureCheck check) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mImportMutex);
+                mSignatureCheck = std::move(check);
+            }
+
+            ara::core::Result<void> CrlIndex::Open () noexcept
+            {
+                std::lock_guard<std::mutex> lock(mImportMutex);
+                ara::core::Result<ImagePtr> loaded = Load();
+                if (!loaded.HasValue())
+                {
+                    return ara::core::Result<void>::FromError(loaded.Error());
+                }
+                {
+                    std::unique_lock<std::shared_mutex> imageLock(mImageMutex);
+                    mImage = std::move(loaded).Value();
+                }
+                Notify();
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<bool> CrlIndex::ImportCrl (ReadOnlyMemRegion crl, const DerCertificate &issuer, time_t now) noexcept
+            {
+                // CertificateList ::= SEQUENCE { tbsCertList, signatureAlgorithm, signatureValue } (RFC 5280 5.1)
+                DerReader outer(crl.data(), crl.size());
+                DerElement list = {};
+                DerElement tbs = {};
+                DerElement algorithm = {};
+                DerElement signature = {};
+                bool valid = outer.Read(DerReader::kTagSequence, list) && outer.IsEmpty();
+                if (valid)
+                {
+                    DerReader parts(list);
+                    valid = parts.Read(DerReader::kTagSequence, tbs) && parts.Read(DerReader::kTagSequence, algorithm) &&
+                        parts.Read(DerReader::kTagBitString, signature) && (signature.mSize != 0u) && (signature.mData[0] == 0u) && parts.IsEmpty();
+                }
+
+                DerReader fields(tbs);
+                DerElement element = {};
+                DerElement issuerDn = {};
+                DerElement revoked = {};
+                std::int64_t thisUpdate = 0;
+                std::int64_t nextUpdate = 0;
+                std::uint32_t version = 0u;
+                bool supported = true;
+                if (valid)
+                {
+                    valid = fields.ReadOptional(DerReader::kTagInteger, element) &&
+                        ((element.mData == nullptr) || (DerReader::DecodeSmallInteger(element, version) && (version == 1u)));
+                }
+                if (valid)
+                {
+                    // The algorithm inside the signed part must repeat the outer one.
+                    valid = fields.Read(DerReader::kTagSequence, element) && (element.mEncodingSize == algorithm.mEncodingSize) &&
+                        DerReader::IsEqual(element, algorithm.mData, algorithm.mSize);
+                }
+                if (valid)
+                {
+                    valid = fields.Read(DerReader::kTagSequence, issuerDn) && fields.Read(element) && IsTime(element) &&
+                        DerReader::DecodeTime(element, thisUpdate);
+                }
+                if (valid && ((fields.PeekTag() == DerReader::kTagUtcTime) || (fields.PeekTag() == DerReader::kTagGeneralizedTime)))
+                {
+                    valid = fields.Read(element) && DerReader::DecodeTime(element, nextUpdate);
+                }
+                if (valid)
+                {
+                    valid = fields.ReadOptional(DerReader::kTagSequence, revoked) && fields.ReadOptional(DerReader::ContextTag(0u), element) &&
+                        fields.IsEmpty();
+                }
+                if (valid && (element.mData != nullptr))
+                {
+                    DerReader wrapper(element);
+                    DerElement extensions = {};
+                    valid = (version == 1u) && wrapper.Read(DerReader::kTagSequence, extensions) && wrapper.IsEmpty() &&
+                        ReadExtensions(extensions, supported);
+                }
+
+                // revokedCertificates ::= SEQUENCE OF SEQUENCE { userCertificate, revocationDate, crlEntryExtensions }
+                ara::core::Vector<SerialRecord> serials;
+                DerReader entries(revoked);
+                while (valid && !entries.IsEmpty())
+                {
+                    DerElement entry = {};
+                    DerElement serial = {};
+                    valid = entries.Read(DerReader::kTagSequence, entry);
+                    DerReader entryFields(entry);
+                    valid = valid && entryFields.Read(DerReader::kTagInteger, serial) && (serial.mSize != 0u) &&
+                        entryFields.Read(element) && IsTime(element) && entryFields.ReadOptional(DerReader::kTagSequence, element) &&
+                        entryFields.IsEmpty();
+                    if (valid && (element.mData != nullptr))
+                    {
+                        valid = (version == 1u) && ReadExtensions(element, supported);
+                    }
+                    if (valid && (serial.mSize > kMaxSerialSize))
+                    {
+                        supported = false;
+                    }
+                    else if (valid)
+                    {
+                        SerialRecord record = {};
+                        record.mSize = static_cast<std::uint8_t>(serial.mSize);
+                        std::memcpy(record.mValue, serial.mData, serial.mSize);
+                        try
+                        {
+                            serials.push_back(record);
+                        }
+                        catch (const std::bad_alloc &)
+                        {
+                            return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                        }
+                    }
+                }
+                if (!valid)
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+                if (!supported)
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kUnsupported);
+                }
+
+                ara::core::Vector<std::uint8_t> canonical;
+                try
+                {
+                    valid = internal::CanonicalizeDn(issuerDn.mEncoding, issuerDn.mEncodingSize, canonical);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                if (!valid)
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+                const ReadOnlyMemRegion dn(canonical.data(), canonical.size());
+                const std::uint32_t constraints = issuer.IsParsed() ? issuer.GetConstraints() : 0u;
+                if (!issuer.IsParsed() || !issuer.IsWellFormed() || (dn.size() != issuer.CanonicalSubjectDn().size()) ||
+                    ((dn.size() != 0u) && (std::memcmp(dn.data(), issuer.CanonicalSubjectDn().data(), dn.size()) != 0)) ||
+                    ((constraints != 0u) && ((constraints & kConstrCrlSign) == 0u)))
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                }
+
+                std::lock_guard<std::mutex> lock(mImportMutex);
+                if (!mSignatureCheck || !mSignatureCheck(ReadOnlyMemRegion(tbs.mEncoding, tbs.mEncodingSize),
+                    ReadOnlyMemRegion(algorithm.mEncoding, algorithm.mEncodingSize), ReadOnlyMemRegion(signature.mData + 1, signature.mSize - 1u), issuer))
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                }
+                const bool current = (nextUpdate == 0) || (static_cast<std::int64_t>(now) <= nextUpdate);
+
+                std::sort(serials.begin(), serials.end(), [] (const SerialRecord &left, const SerialRecord &right)
+                    {
+                        return std::memcmp(&left, &right, sizeof(SerialRecord)) < 0;
+                    });
+                serials.erase(std::unique(serials.begin(), serials.end(), [] (const SerialRecord &left, const SerialRecord &right)
+                    {
+                        return std::memcmp(&left, &right, sizeof(SerialRecord)) == 0;
+                    }), serials.end());
+
+                IssuerRecord added = {};
+                MakeKey(dn, issuer, added.mKey);
+                added.mThisUpdate = thisUpdate;
+                added.mNextUpdate = nextUpdate;
+                added.mCount = serials.size();
+
+                ImagePtr image = GetImage();
+                const IssuerRecord *replaced = image->FindIssuer(added.mKey);
+                if ((replaced != nullptr) && (replaced->mThisUpdate > thisUpdate))
+                {
+                    // An older CRL of the same key than the indexed one changes nothing.
+                    return ara::core::Result<bool>::FromValue(current);
+                }
+
+                // The new image copies the other issuers and the other keys of the issuer and inserts the CRL in the
+                // key order.
+                const Header &header = image->GetHeader();
+                const IssuerRecord *issuers = image->GetIssuers();
+                const SerialRecord *oldSerials = image->GetSerials();
+                const std::uint64_t issuerCount = header.mIssuerCount + ((replaced == nullptr) ? 1u : 0u);
+                const std::uint64_t serialCount = header.mSerialCount - ((replaced == nullptr) ? 0u : replaced->mCount) + serials.size();
+                ara::core::Vector<std::uint8_t> buffer;
+                try
+                {
+                    buffer.resize(sizeof(Header) + issuerCount * sizeof(IssuerRecord) + serialCount * sizeof(SerialRecord));
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                Header *newHeader = reinterpret_cast<Header*>(buffer.data());
+                IssuerRecord *newIssuers = reinterpret_cast<IssuerRecord*>(buffer.data() + sizeof(Header));
+                SerialRecord *newSerials = reinterpret_cast<SerialRecord*>(buffer.data() + sizeof(Header) + issuerCount * sizeof(IssuerRecord));
+                *newHeader = {kMagic, issuerCount, serialCount, 0u};
+
+                std::uint64_t next = 0u;
+                std::uint64_t source = 0u;
+                bool inserted = false;
+                for (std::uint64_t i = 0; i < issuerCount; ++i)
+                {
+                    if ((source < header.mIssuerCount) && (&issuers[source] == replaced))
+                    {
+                        ++source;
+                    }
+                    IssuerRecord &record = newIssuers[i];
+                    if (!inserted && ((source == header.mIssuerCount) || (std::memcmp(added.mKey, issuers[source].mKey, kKeySize) < 0)))
+                    {
+                        record = added;
+                        std::copy(serials.begin(), serials.end(), newSerials + next);
+                        inserted = true;
+                    }
+                    else
+                    {
+                        record = issuers[source];
+                        std::copy(oldSerials + record.mFirst, oldSerials + record.mFirst + record.mCount, newSerials + next);
+                        ++source;
+                    }
+                    record.mFirst = next;
+                    next += record.mCount;
+                }
+                image.reset();
+
+                ImagePtr updated;
+                if (mPath.empty())
+                {
+                    std::shared_ptr<Image> built;
+                    try
+                    {
+                        built = std::make_shared<Image>();
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return ara::core::Result<bool>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                    }
+                    built->Assign(std::move(buffer));
+                    updated = std::move(built);
+                }
+                else
+                {
+                    // The written file is mapped again, so the index is kept in the page cache only.
+                    ara::core::Result<void> stored = Store(buffer);
+                    if (!stored.HasValue())
+                    {
+                        return ara::core::Result<bool>::FromError(stored.Error());
+                    }
+                    ara::core::Result<ImagePtr> loaded = Load();
+                    if (!loaded.HasValue())
+                    {
+                        return ara::core::Result<bool>::FromError(loaded.Error());
+                    }
+                    updated = std::move(loaded).Value();
+                }
+                {
+                    std::unique_lock<std::shared_mutex> imageLock(mImageMutex);
+                    mImage = std::move(updated);
+                }
+                Notify();
+                return ara::core::Result<bool>::FromValue(current);
+            }
+
+            bool CrlIndex::IsRevoked (const DerCertificate &certificate, const DerCertificate &issuer) const noexcept
+            {
+                const ReadOnlyMemRegion serial = certificate.SerialNumber();
+                if ((serial.size() == 0u) || (serial.size() > kMaxSerialSize))
+                {
+                    return false;
+                }
+                SerialRecord key = {};
+                key.mSize = static_cast<std::uint8_t>(serial.size());
+                std::memcpy(key.mValue, serial.data(), serial.size());
+                // A CRL signed by another key of an issuer of the same name does not cover the certificate.
+                std::uint8_t issuerKey[kKeySize];
+                MakeKey(certificate.CanonicalIssuerDn(), issuer, issuerKey);
+
+                ImagePtr image = GetImage();
+                const IssuerRecord *record = image->FindIssuer(issuerKey);
+                if (record == nullptr)
+                {
+                    return false;
+                }
+                const SerialRecord *begin = image->GetSerials() + record->mFirst;
+                const SerialRecord *end = begin + record->mCount;
+                const SerialRecord *found = std::lower_bound(begin, end, key, [] (const SerialRecord &left, const SerialRecord &right)
+                    {
+                        return std::memcmp(&left, &right, sizeof(SerialRecord)) < 0;
+                    });
+                return (found != end) && (std::memcmp(found, &key, sizeof(SerialRecord)) == 0);
+            }
+
+            ara::core::Result<time_t> CrlIndex::GetNextUpdate (ReadOnlyMemRegion issuerDn) const noexcept
+            {
+                ara::core::Vector<std::uint8_t> canonical;
+                bool valid = false;
+                try
+                {
+                    valid = internal::CanonicalizeDn(issuerDn.data(), issuerDn.size(), canonical);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<time_t>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                if (!valid)
+                {
+                    return ara::core::Result<time_t>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                std::uint8_t key[kDnKeySize];
+                MakeDnKey(ReadOnlyMemRegion(canonical.data(), canonical.size()), key);
+                ImagePtr image = GetImage();
+                const std::pair<const IssuerRecord*, const IssuerRecord*> records = image->FindIssuers(key);
+                if (records.first == records.second)
+                {
+                    return ara::core::Result<time_t>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                std::int64_t nextUpdate = 0;
+                for (const IssuerRecord *record = records.first; record != records.second; ++record)
+                {
+                    if ((record->mNextUpdate != 0) && ((nextUpdate == 0) || (record->mNextUpdate < nextUpdate)))
+                    {
+                        nextUpdate = record->mNextUpdate;
+                    }
+                }
+                return ara::core::Result<time_t>::FromValue(static_cast<time_t>(nextUpdate));
+            }
+
+            std::size_t CrlIndex::GetRevokedCount () const noexcept
+            {
+                return static_cast<std::size_t>(GetImage()->GetHeader().mSerialCount);
+            }
+
+            CrlIndex::ImagePtr CrlIndex::GetImage () const noexcept
+            {
+                {
+                    std::shared_lock<std::shared_mutex> lock(mImageMutex);
+                    if (mImage != nullptr)
+                    {
+                        return mImage;
+                    }
+                }
+
+                // An index that has not been opened is empty.
+                static const ImagePtr cEmpty = [] ()
+                    {
+                        std::shared_ptr<Image> empty = std::make_shared<Image>();
+                        ara::core::Vector<std::uint8_t> buffer(sizeof(Header));
+                        *reinterpret_cast<Header*>(buffer.data()) = {kMagic, 0u, 0u, 0u};
+                        empty->Assign(std::move(buffer));
+                        return empty;
+                    }();
+                return cEmpty;
+            }
+
+            ara::core::Result<CrlIndex::ImagePtr> CrlIndex::Load () const noexcept
+            {
+                if (mPath.empty())
+                {
+                    return ara::core::Result<ImagePtr>::FromValue(GetImage());
+                }
+                const int fd = ::open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                {
+                    if (errno == ENOENT)
+                    {
+                        return ara::core::Result<ImagePtr>::FromValue(GetImage());
+                    }
+                    return ara::core::Result<ImagePtr>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+
+                // The mapping outlives the descriptor.
+                std::shared_ptr<Image> image;
+                try
+                {
+                    image = std::make_shared<Image>();
+                }
+                catch (const std::bad_alloc &)
+                {
+                    ::close(fd);
+                    return ara::core::Result<ImagePtr>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                struct stat status;
+                const bool statted = (::fstat(fd, &status) == 0);
+                const bool mapped = statted && image->Map(fd, static_cast<std::size_t>(status.st_size));
+                ::close(fd);
+                if (!statted)
+                {
+                    return ara::core::Result<ImagePtr>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+                if (!mapped || !image->IsWellFormed())
+                {
+                    return ara::core::Result<ImagePtr>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+                return ara::core::Result<ImagePtr>::FromValue(std::move(image));
+            }
+
+            ara::core::Result<void> CrlIndex::Store (const ara::core::Vector<std::uint8_t> &buffer) const noexcept
+            {
+                // A file per process, renamed over the index after it is durable.
+                ara::core::String temporary;
+                ara::core::String directory;
+                try
+                {
+                    temporary = mPath + ".tmp" + std::to_string(::getpid());
+                    directory = GetDirectory(mPath);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+                if (fd < 0)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+                std::size_t written = 0u;
+                while (written < buffer.size())
+                {
+                    const ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+                    if ((result < 0) && (errno == EINTR))
+                    {
+                        continue;
+                    }
+                    if (result <= 0)
+                    {
+                        break;
+                    }
+                    written += static_cast<std::size_t>(result);
+                }
+                const bool synced = (written == buffer.size()) && (::fsync(fd) == 0);
+                if ((::close(fd) != 0) || !synced || (::rename(temporary.c_str(), mPath.c_str()) != 0))
+                {
+                    ::unlink(temporary.c_str());
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+
+                // The rename is durable only when the directory entry is.
+                const int directoryFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                const bool renamed = (directoryFd >= 0) && (::fsync(directoryFd) == 0);
+                if (directoryFd >= 0)
+                {
+                    ::close(directoryFd);
+                }
+                if (!renamed)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void CrlIndex::Notify () const noexcept
+            {
+                if (mVerifier != nullptr)
+                {
+                    mVerifier->RevocationChanged();
+                }
+            }
+        }
+    }
+}
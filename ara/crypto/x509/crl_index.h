@@ -0,0 +1,171 @@
+#ifndef ARA_CRYPTO_X509_CRL_INDEX_H
+#define ARA_CRYPTO_X509_CRL_INDEX_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include "ara/core/result.h"
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/x509/chain_verifier.h"
+#include "ara/crypto/x509/der_certificate.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief Revocation storage backing X509Provider::ImportCrl(). Each imported CRL is compiled into a sorted
+             * array of the revoked serial numbers of its issuer, and all arrays are kept in one file that is mapped
+             * into memory as it is: a revocation check is a binary search over the issuers followed by one over the
+             * serial numbers, and a restart maps the file instead of parsing the CRLs again. An issuer is identified
+             * by its name together with its public key, so during a key rollover the CRLs of the old and the new
+             * key are both indexed. An import writes a new
+             * file and renames it over the old one, so readers never see a partial file, and then notifies the
+             * chain verifier. IsRevoked() fits ChainVerifier::RevocationCheck and may be called concurrently.
+             */
+            class CrlIndex
+            {
+            public:
+
+                /**
+                 * @brief Check of the signature of a CRL by the public key of its issuer.
+                 */
+                using SignatureCheck = std::function<bool (ReadOnlyMemRegion signedData, ReadOnlyMemRegion algorithm, ReadOnlyMemRegion signatureValue, const DerCertificate &issuer)>;
+
+                /**
+                 * @brief Maximal size of an indexed serial number (the content octets of the INTEGER). RFC 5280
+                 * limits serial numbers to 20 octets, and a sign octet may precede them.
+                 */
+                static const std::size_t kMaxSerialSize = 23u;
+
+                /**
+                 * @brief Construct a new CRL Index object, the file is not read before Open().
+                 * @param[in] path path of the index file, an empty path keeps the index in memory only
+                 * @param[in] verifier the chain verifier notified on changes (may be nullptr)
+                 */
+                explicit CrlIndex (const ara::core::String &path, ChainVerifier *verifier=nullptr) noexcept;
+
+                CrlIndex (const CrlIndex &) = delete;
+                CrlIndex& operator= (const CrlIndex &) = delete;
+
+                /**
+                 * @brief Replace the signature check, by default ChainVerifier::CheckRsaSha256SignedData().
+                 * @param[in] check the signature check
+                 */
+                void SetSignatureCheck (SignatureCheck check) noexcept;
+
+                /**
+                 * @brief Map the index file into memory. A missing file is an empty index.
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kAccessViolation if the file cannot be read or mapped
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the file is not a well-formed index
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the index cannot be allocated
+                 */
+                ara::core::Result<void> Open () noexcept;
+
+                /**
+                 * @brief Import a CRL signed by the issuer. It replaces the indexed CRL of the same issuer name and
+                 * public key unless that one is newer.
+                 * @param[in] crl the DER encoded CRL
+                 * @param[in] issuer the certificate of the CRL issuer
+                 * @param[in] now the current time
+                 * @return ara::core::Result<bool> true if the CRL is valid and false if it is already expired (its
+                 * revocations are indexed anyway)
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the provided BLOB is not a CRL
+                 * @exception CryptoErrorDomain::kUnsupported if the CRL is a delta, indirect or partitioned CRL, or
+                 * a serial number is longer than kMaxSerialSize
+                 * @exception CryptoErrorDomain::kRuntimeFault if the CRL validation has failed
+                 * @exception CryptoErrorDomain::kAccessViolation if the index file cannot be written
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the new index cannot be allocated
+                 */
+                ara::core::Result<bool> ImportCrl (ReadOnlyMemRegion crl, const DerCertificate &issuer, time_t now) noexcept;
+
+                /**
+                 * @brief Check if a certificate is listed in the indexed CRL of its issuer. The CRL applies only if it
+                 * has been imported with an issuer certificate of the same public key.
+                 * @param[in] certificate the certificate
+                 * @param[in] issuer the issuer certificate
+                 * @return true if the certificate is revoked
+                 */
+                bool IsRevoked (const DerCertificate &certificate, const DerCertificate &issuer) const noexcept;
+
+                /**
+                 * @brief Get the time of the next CRL update of an issuer, e.g. to schedule UpdateCrlOnline(). If CRLs
+                 * of several keys of the issuer are indexed, the earliest of their next updates is returned.
+                 * @param[in] issuerDn the DER encoded DN of the issuer
+                 * @return ara::core::Result<time_t> the next update, 0 if no CRL of the issuer tells it
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if no CRL of the issuer is indexed
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the canonical DN cannot be allocated
+                 */
+                ara::core::Result<time_t> GetNextUpdate (ReadOnlyMemRegion issuerDn) const noexcept;
+
+                /**
+                 * @brief Get the number of indexed revoked certificates of all issuers.
+                 * @return std::size_t
+                 */
+                std::size_t GetRevokedCount () const noexcept;
+
+            private:
+                struct Header;
+                struct IssuerRecord;
+                struct SerialRecord;
+
+                // A read-only index image, mapped from the file or built in memory.
+                class Image
+                {
+                public:
+                    Image () noexcept;
+                    ~Image () noexcept;
+
+                    Image (const Image &) = delete;
+                    Image& operator= (const Image &) = delete;
+
+                    bool Map (int fd, std::size_t size) noexcept;
+                    void Assign (ara::core::Vector<std::uint8_t> &&buffer) noexcept;
+                    bool IsWellFormed () const noexcept;
+
+                    const Header& GetHeader () const noexcept;
+                    const IssuerRecord* GetIssuers () const noexcept;
+                    const SerialRecord* GetSerials () const noexcept;
+                    const IssuerRecord* FindIssuer (const std::uint8_t key[64]) const noexcept;
+                    std::pair<const IssuerRecord*, const IssuerRecord*> FindIssuers (const std::uint8_t dnKey[32]) const noexcept;
+
+                private:
+                    void *mMapping;
+                    std::size_t mMappingSize;
+                    ara::core::Vector<std::uint8_t> mBuffer;
+                    const std::uint8_t *mData;
+                    std::size_t mSize;
+                };
+
+                using ImagePtr = std::shared_ptr<const Image>;
+
+                ImagePtr GetImage () const noexcept;
+                ara::core::Result<ImagePtr> Load () const noexcept;
+                ara::core::Result<void> Store (const ara::core::Vector<std::uint8_t> &buffer) const noexcept;
+                void Notify () const noexcept;
+
+                ara::core::String mPath;
+                ChainVerifier *mVerifier;
+                SignatureCheck mSignatureCheck;
+
+                std::mutex mImportMutex;                // serializes the writers
+                mutable std::shared_mutex mImageMutex;
+                ImagePtr mImage;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_CRL_INDEX_H
@@ -0,0 +1,390 @@
+#include "ara/crypto/x509/der_certificate.h"
+
+#include <cstring>
+#include <new>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/x509/internal/byte_hash.h"
+#include "ara/crypto/x509/internal/canonical_dn.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                using internal::DerElement;
+                using internal::DerReader;
+
+                // Content octets of the OIDs of the extensions decoded by the parser (id-ce, RFC 5280 4.2.1).
+                const std::uint8_t kOidSubjectKeyId[3] = {0x55u, 0x1du, 0x0eu};
+                const std::uint8_t kOidKeyUsage[3] = {0x55u, 0x1du, 0x0fu};
+                const std::uint8_t kOidBasicConstraints[3] = {0x55u, 0x1du, 0x13u};
+                const std::uint8_t kOidAuthorityKeyId[3] = {0x55u, 0x1du, 0x23u};
+
+                // BasicCertInfo::kConstrNone
+                const std::uint32_t kNoConstraints = 0u;
+
+                // Key Usage bits 0 (digitalSignature) to 8 (decipherOnly) as BasicCertInfo::KeyConstraints.
+                const std::uint32_t kKeyUsageMask = 0xff80u;
+
+                ReadOnlyMemRegion Content (const DerElement &element) noexcept
+                {
+                    return ReadOnlyMemRegion(element.mData, element.mSize);
+                }
+
+                ReadOnlyMemRegion Encoding (const DerElement &element) noexcept
+                {
+                    return ReadOnlyMemRegion(element.mEncoding, element.mEncodingSize);
+                }
+
+                bool IsTime (const DerElement &element) noexcept
+                {
+                    return (element.mTag == DerReader::kTagUtcTime) || (element.mTag == DerReader::kTagGeneralizedTime);
+                }
+
+                // A BIT STRING of whole octets (keys and signatures), the unused bits octet is skipped.
+                bool ReadOctetBits (DerReader &reader, ReadOnlyMemRegion &bits) noexcept
+                {
+                    DerElement element = {};
+                    if (!reader.Read(DerReader::kTagBitString, element) || (element.mSize == 0u) || (element.mData[0] != 0u))
+                    {
+                        return false;
+                    }
+                    bits = ReadOnlyMemRegion(element.mData + 1, element.mSize - 1u);
+                    return true;
+                }
+
+                // RFC 5280 4.2: a certificate must not include more than one instance of a particular extension, so
+                // the OID of the extension is compared with the OIDs of all extensions preceding it.
+                bool IsRepeatedExtension (ReadOnlyMemRegion extensions, const DerElement &extension) noexcept
+                {
+                    DerElement oid = {};
+                    DerReader fields(extension);
+                    if (!fields.Read(DerReader::kTagOid, oid))
+                    {
+                        return false;   // rejected by the decoding of the extension
+                    }
+
+                    DerReader previous(extensions.data(), extensions.size());
+                    DerElement other = {};
+                    while (previous.Read(DerReader::kTagSequence, other) && (other.mEncoding != extension.mEncoding))
+                    {
+                        DerElement otherOid = {};
+                        DerReader otherFields(other);
+                        if (otherFields.Read(DerReader::kTagOid, otherOid) && DerReader::IsEqual(otherOid, oid.mData, oid.mSize))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            }
+
+            DerCertificate::DerCertificate () noexcept : mCanonicalIssuerSize(0u), mIssuerDnHash(0u), mSubjectDnHash(0u), mVersion(0u), mDecoded(false), mDetails(), mFingerprinted(false), mFingerprints()
+            {
+                Reset();
+            }
+
+            ara::core::Result<void> DerCertificate::Parse (ReadOnlyMemRegion der, bool borrow) noexcept
+            {
+                // The copy is taken before the reset, which releases the old encoding der may point into.
+                ara::core::Vector<std::uint8_t> owned;
+                if (!borrow)
+                {
+                    try
+                    {
+                        owned.assign(der.begin(), der.end());
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        Reset();
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                    }
+                }
+                Reset();
+                const std::uint8_t *data = der.data();
+                if (!borrow)
+                {
+                    mOwned.swap(owned);
+                    data = mOwned.data();
+                }
+
+                DerReader outer(data, der.size());
+                DerElement certificate = {};
+                if (!outer.Read(DerReader::kTagSequence, certificate) || !outer.IsEmpty())
+                {
+                    Reset();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+
+                DerReader parts(certificate);
+                DerElement tbs = {};
+                DerElement signatureAlgorithm = {};
+                bool valid = parts.Read(DerReader::kTagSequence, tbs) && parts.Read(DerReader::kTagSequence, signatureAlgorithm) &&
+                    ReadOctetBits(parts, mSignature) && parts.IsEmpty();
+
+                DerReader fields(tbs);
+                DerElement element = {};
+                if (valid)
+                {
+                    valid = fields.ReadOptional(DerReader::ContextTag(0u), element);
+                }
+                if (valid)
+                {
+                    mVersion = 1u;
+                    if (element.mData != nullptr)
+                    {
+                        DerReader version(element);
+                        DerElement number = {};
+                        std::uint32_t value = 0u;
+                        valid = version.Read(number) && version.IsEmpty() && DerReader::DecodeSmallInteger(number, value) && (value <= 2u);
+                        mVersion = value + 1u;
+                    }
+                }
+                if (valid)
+                {
+                    valid = fields.Read(DerReader::kTagInteger, element) && (element.mSize != 0u);
+                    mSerialNumber = Content(element);
+                }
+                if (valid)
+                {
+                    // The algorithm inside the signed part must repeat the outer one (RFC 5280 4.1.1.2).
+                    valid = fields.Read(DerReader::kTagSequence, element) && (element.mEncodingSize == signatureAlgorithm.mEncodingSize) &&
+                        DerReader::IsEqual(element, signatureAlgorithm.mData, signatureAlgorithm.mSize);
+                }
+                if (valid)
+                {
+                    valid = fields.Read(DerReader::kTagSequence, element);
+                    mIssuer = Encoding(element);
+                }
+                if (valid)
+                {
+                    valid = fields.Read(DerReader::kTagSequence, element);
+                    DerReader validity(element);
+                    valid = valid && validity.Read(mNotBefore) && IsTime(mNotBefore) && validity.Read(mNotAfter) && IsTime(mNotAfter) &&
+                        validity.IsEmpty();
+                }
+                if (valid)
+                {
+                    valid = fields.Read(DerReader::kTagSequence, element);
+                    mSubject = Encoding(element);
+                }
+                if (valid)
+                {
+                    valid = fields.Read(DerReader::kTagSequence, element);
+                    mSubjectPublicKeyInfo = Encoding(element);
+                    DerReader keyInfo(element);
+                    DerElement algorithm = {};
+                    valid = valid && keyInfo.Read(DerReader::kTagSequence, algorithm) && ReadOctetBits(keyInfo, mPublicKey) && keyInfo.IsEmpty();
+                    mPublicKeyAlgorithm = Encoding(algorithm);
+                }
+                if (valid && (mVersion >= 2u))
+                {
+                    // The unique identifiers are skipped, RFC 5280 forbids them in conforming certificates.
+                    valid = fields.ReadOptional(DerReader::ContextPrimitiveTag(1u), element) &&
+                        fields.ReadOptional(DerReader::ContextPrimitiveTag(2u), element);
+                }
+                if (valid && (mVersion == 3u))
+                {
+                    valid = fields.ReadOptional(DerReader::ContextTag(3u), element);
+                    if (valid && (element.mData != nullptr))
+                    {
+                        DerReader wrapper(element);
+                        DerElement extensions = {};
+                        valid = wrapper.Read(DerReader::kTagSequence, extensions) && wrapper.IsEmpty() && (extensions.mSize != 0u);
+                        mExtensions = Content(extensions);
+                    }
+                }
+                if (valid && fields.IsEmpty())
+                {
+                    try
+                    {
+                        valid = internal::CanonicalizeDn(mIssuer.data(), mIssuer.size(), mCanonicalDns);
+                        mCanonicalIssuerSize = mCanonicalDns.size();
+                        valid = valid && internal::CanonicalizeDn(mSubject.data(), mSubject.size(), mCanonicalDns);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        Reset();
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                    }
+                }
+                if (!valid || !fields.IsEmpty())
+                {
+                    Reset();
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+
+                mIssuerDnHash = internal::HashBytes(CanonicalIssuerDn().data(), CanonicalIssuerDn().size());
+                mSubjectDnHash = internal::HashBytes(CanonicalSubjectDn().data(), CanonicalSubjectDn().size());
+                mEncoding = ReadOnlyMemRegion(data, der.size());
+                mTbsCertificate = Encoding(tbs);
+                mSignatureAlgorithm = Encoding(signatureAlgorithm);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            bool DerCertificate::IssuerDnMatches (const DerCertificate &issuer) const noexcept
+            {
+                const ReadOnlyMemRegion dn = CanonicalIssuerDn();
+                const ReadOnlyMemRegion issuerDn = issuer.CanonicalSubjectDn();
+                return (mIssuerDnHash == issuer.mSubjectDnHash) && (dn.size() == issuerDn.size()) &&
+                    ((dn.size() == 0u) || (std::memcmp(dn.data(), issuerDn.data(), dn.size()) == 0));
+            }
+
+            const DerCertificate::Details& DerCertificate::GetDetails () const noexcept
+            {
+                if (!mDecoded.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(mDetailsMutex);
+                    if (!mDecoded.load(std::memory_order_relaxed))
+                    {
+                        DecodeDetails();
+                        mDecoded.store(true, std::memory_order_release);
+                    }
+                }
+                return mDetails;
+            }
+
+            const DerCertificate::Fingerprints& DerCertificate::GetFingerprints () const noexcept
+            {
+                if (!mFingerprinted.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(mDetailsMutex);
+                    if (!mFingerprinted.load(std::memory_order_relaxed))
+                    {
+                        cryp::internal::Sha1::Compute(mEncoding.data(), mEncoding.size(), mFingerprints.mSha1);
+                        cryp::internal::Sha256::Compute(mEncoding.data(), mEncoding.size(), mFingerprints.mSha256);
+                        mFingerprinted.store(true, std::memory_order_release);
+                    }
+                }
+                return mFingerprints;
+            }
+
+            void DerCertificate::DecodeDetails () const noexcept
+            {
+                mDetails = {0, 0, ReadOnlyMemRegion(), ReadOnlyMemRegion(), kNoConstraints, kNoPathLimit, false, false, false};
+                if (!IsParsed())
+                {
+                    return;
+                }
+
+                bool valid = DerReader::DecodeTime(mNotBefore, mDetails.mNotBefore) && DerReader::DecodeTime(mNotAfter, mDetails.mNotAfter);
+                DerReader extensions(mExtensions.data(), mExtensions.size());
+                DerElement extension = {};
+                while (valid && !extensions.IsEmpty())
+                {
+                    valid = extensions.Read(DerReader::kTagSequence, extension) && !IsRepeatedExtension(mExtensions, extension) &&
+                        DecodeExtension(extension);
+                }
+                if (!valid)
+                {
+                    mDetails = {0, 0, ReadOnlyMemRegion(), ReadOnlyMemRegion(), kNoConstraints, kNoPathLimit, false, false, false};
+                    return;
+                }
+                mDetails.mWellFormed = true;
+            }
+
+            bool DerCertificate::DecodeExtension (const internal::DerElement &extension) const noexcept
+            {
+                DerReader fields(extension);
+                DerElement oid = {};
+                DerElement flag = {};
+                DerElement value = {};
+                bool critical = false;
+                if (!fields.Read(DerReader::kTagOid, oid) || !fields.ReadOptional(DerReader::kTagBoolean, flag) ||
+                    ((flag.mData != nullptr) && (!DerReader::DecodeBoolean(flag, critical) || !critical)) ||
+                    !fields.Read(DerReader::kTagOctetString, value) || !fields.IsEmpty())
+                {
+                    return false;   // DER does not encode the default "critical FALSE"
+                }
+
+                DerReader content(value);
+                DerElement element = {};
+                if (DerReader::IsEqual(oid, kOidSubjectKeyId, sizeof(kOidSubjectKeyId)))
+                {
+                    if (!content.Read(DerReader::kTagOctetString, element) || !content.IsEmpty())
+                    {
+                        return false;
+                    }
+                    mDetails.mSubjectKeyId = Content(element);
+                }
+                else if (DerReader::IsEqual(oid, kOidAuthorityKeyId, sizeof(kOidAuthorityKeyId)))
+                {
+                    DerElement fieldsOfKeyId = {};
+                    if (!content.Read(DerReader::kTagSequence, fieldsOfKeyId) || !content.IsEmpty())
+                    {
+                        return false;
+                    }
+                    // keyIdentifier [0], authorityCertIssuer [1] and authorityCertSerialNumber [2]
+                    DerReader keyId(fieldsOfKeyId);
+                    if (!keyId.ReadOptional(DerReader::ContextPrimitiveTag(0u), element) ||
+                        !keyId.ReadOptional(DerReader::ContextTag(1u), value) || !keyId.ReadOptional(DerReader::ContextPrimitiveTag(2u), value) ||
+                        !keyId.IsEmpty())
+                    {
+                        return false;
+                    }
+                    // An empty region with a non-null pointer marks a present extension without a keyIdentifier.
+                    mDetails.mAuthorityKeyId = (element.mData != nullptr) ? Content(element) : ReadOnlyMemRegion(fieldsOfKeyId.mData, 0u);
+                }
+                else if (DerReader::IsEqual(oid, kOidKeyUsage, sizeof(kOidKeyUsage)))
+                {
+                    if (!content.Read(DerReader::kTagBitString, element) || !content.IsEmpty() || (element.mSize < 2u) ||
+                        (element.mSize > 3u) || (element.mData[0] > 7u))
+                    {
+                        return false;
+                    }
+                    std::uint32_t bits = static_cast<std::uint32_t>(element.mData[1]) << 8;
+                    if (element.mSize == 3u)
+                    {
+                        bits |= element.mData[2];
+                    }
+                    mDetails.mConstraints = bits & kKeyUsageMask;
+                }
+                else if (DerReader::IsEqual(oid, kOidBasicConstraints, sizeof(kOidBasicConstraints)))
+                {
+                    DerElement constraints = {};
+                    if (!content.Read(DerReader::kTagSequence, constraints) || !content.IsEmpty())
+                    {
+                        return false;
+                    }
+                    DerReader basic(constraints);
+                    bool ca = false;
+                    if (!basic.ReadOptional(DerReader::kTagBoolean, flag) ||
+                        ((flag.mData != nullptr) && (!DerReader::DecodeBoolean(flag, ca) || !ca)) ||
+                        !basic.ReadOptional(DerReader::kTagInteger, element) || !basic.IsEmpty())
+                    {
+                        return false;
+                    }
+                    mDetails.mCa = ca;
+                    if ((element.mData != nullptr) && (!ca || !DerReader::DecodeSmallInteger(element, mDetails.mPathLimit)))
+                    {
+                        return false;   // a path length is only meaningful for a CA
+                    }
+                }
+                else if (critical)
+                {
+                    mDetails.mUnknownCritical = true;
+                }
+                return true;
+            }
+
+            void DerCertificate::Reset () noexcept
+            {
+                std::vector<std::uint8_t>().swap(mOwned);
+                mEncoding = mTbsCertificate = mSerialNumber = mIssuer = mSubject = ReadOnlyMemRegion();
+                mSubjectPublicKeyInfo = mPublicKeyAlgorithm = mPublicKey = mExtensions = ReadOnlyMemRegion();
+                mSignatureAlgorithm = mSignature = ReadOnlyMemRegion();
+                mNotBefore = mNotAfter = {0u, nullptr, 0u, nullptr, 0u};
+                mCanonicalDns.clear();
+                mCanonicalIssuerSize = 0u;
+                mIssuerDnHash = mSubjectDnHash = 0u;
+                mVersion = 0u;
+                mDecoded.store(false, std::memory_order_release);
+                mFingerprinted.store(false, std::memory_order_release);
+            }
+        }
+    }
+}
@@ -0,0 +1,378 @@
+#ifndef ARA_CRYPTO_X509_DER_CERTIFICATE_H
+#define ARA_CRYPTO_X509_DER_CERTIFICATE_H
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <ctime>
+#include <mutex>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/cryp/internal/sha1.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+#include "ara/crypto/x509/internal/der.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief Parsed X.509 certificate (RFC 5280), the parsing a Certificate object of ParseCert() would
+             * rest on; the tree has no such Certificate implementation, CertificateStore, CertChainReader and
+             * ChainVerifier use it directly. The object keeps the original DER encoding, either borrowed or copied
+             * once, and the fields are slices of it: Parse() walks the top-level structure and allocates one
+             * buffer for the canonical issuer and subject DNs used in name matching, the validity, the extensions
+             * and the fingerprints are computed on the first access without allocating. The accessors may be
+             * called concurrently.
+             */
+            class DerCertificate
+            {
+            public:
+
+                /**
+                 * @brief Path length limit reported when the Basic Constraints have none.
+                 */
+                static const std::uint32_t kNoPathLimit = 0xffffffffu;
+
+                DerCertificate () noexcept;
+
+                DerCertificate (const DerCertificate &) = delete;
+                DerCertificate& operator= (const DerCertificate &) = delete;
+
+                /**
+                 * @brief Parse a DER encoded certificate.
+                 * @param[in] der the encoding of exactly one certificate
+                 * @param[in] borrow if true the encoding is referenced, so it must outlive the object, otherwise
+                 * it is copied into the object
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the encoding is not a well-formed certificate
+                 * (the object is empty then)
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the copy or the canonical
+                 * DNs cannot be allocated (the object is empty then)
+                 */
+                ara::core::Result<void> Parse (ReadOnlyMemRegion der, bool borrow=false) noexcept;
+
+                /**
+                 * @brief Check if a certificate has been parsed.
+                 * @return true if Parse() succeeded
+                 */
+                bool IsParsed () const noexcept
+                {
+                    return mEncoding.size() != 0u;
+                }
+
+                /**
+                 * @brief Get the whole DER encoding of the certificate.
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion GetEncoding () const noexcept
+                {
+                    return mEncoding;
+                }
+
+                /**
+                 * @brief Get the signed part (the DER encoded TBSCertificate).
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion GetTbsCertificate () const noexcept
+                {
+                    return mTbsCertificate;
+                }
+
+                /**
+                 * @brief Get the X.509 version of the certificate.
+                 * @return std::uint32_t 1, 2 or 3
+                 */
+                std::uint32_t X509Version () const noexcept
+                {
+                    return mVersion;
+                }
+
+                /**
+                 * @brief Get the serial number (the content octets of the INTEGER).
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SerialNumber () const noexcept
+                {
+                    return mSerialNumber;
+                }
+
+                /**
+                 * @brief Get the DER encoded issuer Name.
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion IssuerDn () const noexcept
+                {
+                    return mIssuer;
+                }
+
+                /**
+                 * @brief Get the DER encoded subject Name.
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SubjectDn () const noexcept
+                {
+                    return mSubject;
+                }
+
+                /**
+                 * @brief Get the canonical form of the issuer DN (internal::CanonicalizeDn()).
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion CanonicalIssuerDn () const noexcept
+                {
+                    return ReadOnlyMemRegion(mCanonicalDns.data(), mCanonicalIssuerSize);
+                }
+
+                /**
+                 * @brief Get the canonical form of the subject DN (internal::CanonicalizeDn()).
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion CanonicalSubjectDn () const noexcept
+                {
+                    return ReadOnlyMemRegion(mCanonicalDns.data() + mCanonicalIssuerSize, mCanonicalDns.size() - mCanonicalIssuerSize);
+                }
+
+                /**
+                 * @brief Get the 64-bit hash of the canonical issuer DN (internal::HashBytes()).
+                 * @return std::uint64_t
+                 */
+                std::uint64_t IssuerDnHash () const noexcept
+                {
+                    return mIssuerDnHash;
+                }
+
+                /**
+                 * @brief Get the 64-bit hash of the canonical subject DN (internal::HashBytes()).
+                 * @return std::uint64_t
+                 */
+                std::uint64_t SubjectDnHash () const noexcept
+                {
+                    return mSubjectDnHash;
+                }
+
+                /**
+                 * @brief Check if the issuer DN matches the subject DN of another certificate (RFC 5280 7.1).
+                 * @param[in] issuer the candidate issuer
+                 * @return true if the canonical DNs are equal
+                 */
+                bool IssuerDnMatches (const DerCertificate &issuer) const noexcept;
+
+                /**
+                 * @brief Check if the certificate is self-issued (the issuer and subject DNs match).
+                 * @return true if the canonical DNs are equal
+                 */
+                bool IsSelfIssued () const noexcept
+                {
+                    return IssuerDnMatches(*this);
+                }
+
+                /**
+                 * @brief Get the DER encoded SubjectPublicKeyInfo.
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SubjectPublicKeyInfo () const noexcept
+                {
+                    return mSubjectPublicKeyInfo;
+                }
+
+                /**
+                 * @brief Get the DER encoded AlgorithmIdentifier of the subject public key.
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SubjectPublicKeyAlgorithm () const noexcept
+                {
+                    return mPublicKeyAlgorithm;
+                }
+
+                /**
+                 * @brief Get the subject public key (the content of the BIT STRING without the unused bits octet).
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SubjectPublicKey () const noexcept
+                {
+                    return mPublicKey;
+                }
+
+                /**
+                 * @brief Get the DER encoded AlgorithmIdentifier of the signature.
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SignatureAlgorithm () const noexcept
+                {
+                    return mSignatureAlgorithm;
+                }
+
+                /**
+                 * @brief Get the signature value (the content of the BIT STRING without the unused bits octet).
+                 * @return ReadOnlyMemRegion
+                 */
+                ReadOnlyMemRegion SignatureValue () const noexcept
+                {
+                    return mSignature;
+                }
+
+                /**
+                 * @brief Get the "Not Before" of the certificate.
+                 * @return time_t
+                 */
+                time_t StartTime () const noexcept
+                {
+                    return static_cast<time_t>(GetDetails().mNotBefore);
+                }
+
+                /**
+                 * @brief Get the "Not After" of the certificate.
+                 * @return time_t
+                 */
+                time_t EndTime () const noexcept
+                {
+                    return static_cast<time_t>(GetDetails().mNotAfter);
+                }
+
+                /**
+                 * @brief Get the key identifier of the SubjectKeyIdentifier extension.
+                 * @return ReadOnlyMemRegion empty if the extension is absent
+                 */
+                ReadOnlyMemRegion SubjectKeyId () const noexcept
+                {
+                    return GetDetails().mSubjectKeyId;
+                }
+
+                /**
+                 * @brief Get the keyIdentifier of the AuthorityKeyIdentifier extension.
+                 * @return ReadOnlyMemRegion empty if the extension or the field is absent
+                 */
+                ReadOnlyMemRegion AuthorityKeyId () const noexcept
+                {
+                    return GetDetails().mAuthorityKeyId;
+                }
+
+                /**
+                 * @brief Check whether the cA flag of the Basic Constraints is set.
+                 * @return true if it is a CA certificate
+                 */
+                bool IsCa () const noexcept
+                {
+                    return GetDetails().mCa;
+                }
+
+                /**
+                 * @brief Get the pathLenConstraint of the Basic Constraints.
+                 * @return std::uint32_t kNoPathLimit if there is none
+                 */
+                std::uint32_t GetPathLimit () const noexcept
+                {
+                    return GetDetails().mPathLimit;
+                }
+
+                /**
+                 * @brief Get the Key Usage as BasicCertInfo::KeyConstraints.
+                 * @return std::uint32_t BasicCertInfo::kConstrNone if the extension is absent
+                 */
+                std::uint32_t GetConstraints () const noexcept
+                {
+                    return GetDetails().mConstraints;
+                }
+
+                /**
+                 * @brief Check if the validity and the extensions are well-formed (an extension repeated in the
+                 * certificate is malformed, RFC 5280 4.2). The fields decoded from them have their default values
+                 * otherwise.
+                 * @return true if the lazily decoded part is well-formed
+                 */
+                bool IsWellFormed () const noexcept
+                {
+                    return GetDetails().mWellFormed;
+                }
+
+                /**
+                 * @brief Check if the certificate has a critical extension this parser does not process (a
+                 * certificate path must be rejected then, RFC 5280 4.2).
+                 * @return true if there is an unknown critical extension
+                 */
+                bool HasUnknownCriticalExtension () const noexcept
+                {
+                    return GetDetails().mUnknownCritical;
+                }
+
+                /**
+                 * @brief Get the SHA-1 fingerprint (the digest of the whole encoding).
+                 * @return ReadOnlyMemRegion cryp::internal::Sha1::kDigestSize bytes, empty if not parsed
+                 */
+                ReadOnlyMemRegion Sha1Fingerprint () const noexcept
+                {
+                    return IsParsed() ? ReadOnlyMemRegion(GetFingerprints().mSha1, sizeof(Fingerprints::mSha1)) : ReadOnlyMemRegion();
+                }
+
+                /**
+                 * @brief Get the SHA-256 fingerprint (the digest of the whole encoding).
+                 * @return ReadOnlyMemRegion cryp::internal::Sha256::kDigestSize bytes, empty if not parsed
+                 */
+                ReadOnlyMemRegion Sha256Fingerprint () const noexcept
+                {
+                    return IsParsed() ? ReadOnlyMemRegion(GetFingerprints().mSha256, sizeof(Fingerprints::mSha256)) : ReadOnlyMemRegion();
+                }
+
+            private:
+                struct Fingerprints
+                {
+                    std::uint8_t mSha1[cryp::internal::Sha1::kDigestSize];
+                    std::uint8_t mSha256[cryp::internal::Sha256::kDigestSize];
+                };
+
+                struct Details
+                {
+                    std::int64_t mNotBefore;
+                    std::int64_t mNotAfter;
+                    ReadOnlyMemRegion mSubjectKeyId;
+                    ReadOnlyMemRegion mAuthorityKeyId;
+                    std::uint32_t mConstraints;
+                    std::uint32_t mPathLimit;
+                    bool mCa;
+                    bool mUnknownCritical;
+                    bool mWellFormed;
+                };
+
+                const Details& GetDetails () const noexcept;
+                const Fingerprints& GetFingerprints () const noexcept;
+                void DecodeDetails () const noexcept;
+                void Reset () noexcept;
+                bool DecodeExtension (const internal::DerElement &extension) const noexcept;
+
+                std::vector<std::uint8_t> mOwned;
+                ReadOnlyMemRegion mEncoding;
+                ReadOnlyMemRegion mTbsCertificate;
+                ReadOnlyMemRegion mSerialNumber;
+                ReadOnlyMemRegion mIssuer;
+                ReadOnlyMemRegion mSubject;
+                ReadOnlyMemRegion mSubjectPublicKeyInfo;
+                ReadOnlyMemRegion mPublicKeyAlgorithm;
+                ReadOnlyMemRegion mPublicKey;
+                ReadOnlyMemRegion mExtensions;
+                ReadOnlyMemRegion mSignatureAlgorithm;
+                ReadOnlyMemRegion mSignature;
+                ara::core::Vector<std::uint8_t> mCanonicalDns;      // the canonical issuer DN, then the subject DN
+                std::size_t mCanonicalIssuerSize;
+                std::uint64_t mIssuerDnHash;
+                std::uint64_t mSubjectDnHash;
+                internal::DerElement mNotBefore;
+                internal::DerElement mNotAfter;
+                std::uint32_t mVersion;
+                mutable std::atomic<bool> mDecoded;
+                mutable std::mutex mDetailsMutex;
+                mutable Details mDetails;
+                mutable std::atomic<bool> mFingerprinted;
+                mutable Fingerprints mFingerprints;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_DER_CERTIFICATE_H
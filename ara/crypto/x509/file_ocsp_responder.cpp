@@ -0,0 +1,77 @@
+#include "ara/crypto/x509/file_ocsp_responder.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                // OCSP responses are a few kilobytes, anything much larger is not one.
+                const std::size_t kMaxResponseSize = 1u << 20;
+            }
+
+            FileOcspResponder::FileOcspResponder (const ara::core::String &directory) noexcept : mDirectory(directory)
+            {
+            }
+
+            ara::core::Result<ara::core::Vector<std::uint8_t> > FileOcspResponder::operator() (const DerCertificate &certificate, const DerCertificate &issuer) const noexcept
+            {
+                using Response = ara::core::Vector<std::uint8_t>;
+                static_cast<void>(issuer);
+
+                const char cDigits[] = "0123456789abcdef";
+                ara::core::String path = mDirectory;
+                path += '/';
+                for (std::uint8_t byte : certificate.SerialNumber())
+                {
+                    path += cDigits[byte >> 4];
+                    path += cDigits[byte & 0x0fu];
+                }
+                path += ".ocsp";
+
+                const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                {
+                    return ara::core::Result<Response>::FromError((errno == ENOENT) ? CryptoErrorDomain::Errc::kUnknownIdentifier : CryptoErrorDomain::Errc::kAccessViolation);
+                }
+                struct stat status;
+                if ((::fstat(fd, &status) != 0) || (static_cast<std::size_t>(status.st_size) > kMaxResponseSize))
+                {
+                    ::close(fd);
+                    return ara::core::Result<Response>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+
+                Response response(static_cast<std::size_t>(status.st_size));
+                std::size_t done = 0u;
+                while (done < response.size())
+                {
+                    const ssize_t result = ::read(fd, response.data() + done, response.size() - done);
+                    if ((result < 0) && (errno == EINTR))
+                    {
+                        continue;
+                    }
+                    if (result <= 0)
+                    {
+                        break;
+                    }
+                    done += static_cast<std::size_t>(result);
+                }
+                ::close(fd);
+                if (done != response.size())
+                {
+                    return ara::core::Result<Response>::FromError(CryptoErrorDomain::Errc::kAccessViolation);
+                }
+                return ara::core::Result<Response>::FromValue(std::move(response));
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef ARA_CRYPTO_X509_FILE_OCSP_RESPONDER_H
+#define ARA_CRYPTO_X509_FILE_OCSP_RESPONDER_H
+
+#include <cinttypes>
+
+#include "ara/core/result.h"
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/x509/der_certificate.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief Stand-in for an OCSP responder serving prepared DER encoded responses from a directory, one
+             * file per certificate named by the lowercase hexadecimal serial number with the ".ocsp" suffix (e.g.
+             * "04d2.ocsp"). It fits OcspCache::Responder where no network connection is available.
+             */
+            class FileOcspResponder
+            {
+            public:
+
+                /**
+                 * @brief Construct a new File OCSP Responder object.
+                 * @param[in] directory the directory of the response files
+                 */
+                explicit FileOcspResponder (const ara::core::String &directory) noexcept;
+
+                /**
+                 * @brief Read the response for a certificate.
+                 * @param[in] certificate the certificate
+                 * @param[in] issuer the issuer certificate (not used)
+                 * @return ara::core::Result<ara::core::Vector<std::uint8_t> > the response
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if there is no response for the certificate
+                 * @exception CryptoErrorDomain::kAccessViolation if the response file cannot be read
+                 */
+                ara::core::Result<ara::core::Vector<std::uint8_t> > operator() (const DerCertificate &certificate, const DerCertificate &issuer) const noexcept;
+
+            private:
+                ara::core::String mDirectory;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_FILE_OCSP_RESPONDER_H
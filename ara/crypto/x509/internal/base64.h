@@ -0,0 +1,59 @@
+#ifndef ARA_CRYPTO_X509_INTERNAL_BASE64_H
+#define ARA_CRYPTO_X509_INTERNAL_BASE64_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/vector.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Incremental decoder of the base64 alphabet (RFC 4648 4) as used by PEM (RFC 7468). The
+                 * characters may be passed in pieces of any size, e.g. line by line. Runs of 32 characters are
+                 * decoded by AVX2 if the CPU supports it.
+                 */
+                class Base64Decoder
+                {
+                public:
+                    Base64Decoder () noexcept;
+
+                    /**
+                     * @brief Start a new encoding.
+                     */
+                    void Reset () noexcept;
+
+                    /**
+                     * @brief Decode characters without whitespace.
+                     * @param[in] chars the characters
+                     * @param[in] size number of characters
+                     * @param[in,out] out the vector the decoded bytes are appended to
+                     * @return false if a character is not in the alphabet or follows the padding
+                     * @exception std::bad_alloc if out cannot grow (out and the decoder are unchanged then), the
+                     * noexcept callers report it as CryptoErrorDomain::kInsufficientResource
+                     */
+                    bool Update (const std::uint8_t *chars, std::size_t size, ara::core::Vector<std::uint8_t> &out);
+
+                    /**
+                     * @brief Check the end of the encoding.
+                     * @return true if the characters form whole quanta (with the padding)
+                     */
+                    bool Finish () const noexcept;
+
+                private:
+                    std::uint32_t mBits;        // the sextets of the incomplete quantum
+                    std::size_t mCount;         // number of sextets in mBits
+                    std::size_t mPadding;       // number of read '=' characters
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_INTERNAL_BASE64_H
@@ -0,0 +1,54 @@
+#ifndef ARA_CRYPTO_X509_INTERNAL_BYTE_HASH_H
+#define ARA_CRYPTO_X509_INTERNAL_BYTE_HASH_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Non-cryptographic 64-bit hash of a byte string for the in-memory indexes. A match must be
+                 * confirmed by comparing the bytes.
+                 * @param[in] data the bytes
+                 * @param[in] size number of bytes
+                 * @param[in] seed the seed, e.g. the hash of a preceding part of a composite key
+                 * @return std::uint64_t
+                 */
+                inline std::uint64_t HashBytes (const std::uint8_t *data, std::size_t size, std::uint64_t seed=0u) noexcept
+                {
+                    const std::uint64_t kMultiplier = 0x9e3779b97f4a7c15ull;
+                    std::uint64_t hash = seed ^ (size * kMultiplier);
+                    for (; size >= 8u; data += 8, size -= 8u)
+                    {
+                        std::uint64_t word;
+                        std::memcpy(&word, data, sizeof(word));
+                        hash = (hash ^ word) * kMultiplier;
+                        hash ^= hash >> 29;
+                    }
+                    if (size != 0u)
+                    {
+                        std::uint64_t word = 0u;
+                        std::memcpy(&word, data, size);
+                        hash = (hash ^ word) * kMultiplier;
+                    }
+                    // Finalizer of MurmurHash3
+                    hash ^= hash >> 33;
+                    hash *= 0xff51afd7ed558ccdull;
+                    hash ^= hash >> 33;
+                    hash *= 0xc4ceb9fe1a85ec53ull;
+                    hash ^= hash >> 33;
+                    return hash;
+                }
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_INTERNAL_BYTE_HASH_H
@@ -0,0 +1,280 @@
+#include "ara/crypto/x509/internal/canonical_dn.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    std::size_t Utf8Size (std::uint32_t code) noexcept
+                    {
+                        return (code < 0x80u) ? 1u : (code < 0x800u) ? 2u : (code < 0x10000u) ? 3u : 4u;
+                    }
+
+                    void AppendUtf8 (ara::core::String &text, std::uint32_t code)
+                    {
+                        const std::size_t size = Utf8Size(code);
+                        if (size == 1u)
+                        {
+                            text.push_back(static_cast<char>(code));
+                            return;
+                        }
+                        static const std::uint8_t cLead[5] = {0x00u, 0x00u, 0xc0u, 0xe0u, 0xf0u};
+                        text.push_back(static_cast<char>(cLead[size] | (code >> (6u * (size - 1u)))));
+                        for (std::size_t i = size - 1u; i > 0u; --i)
+                        {
+                            text.push_back(static_cast<char>(0x80u | ((code >> (6u * (i - 1u))) & 0x3fu)));
+                        }
+                    }
+
+                    // Sizes and counts in the canonical form take 7 bits per byte, the lowest bits first.
+                    void AppendSize (ara::core::Vector<std::uint8_t> &canonical, std::size_t size)
+                    {
+                        for (; size >= 0x80u; size >>= 7)
+                        {
+                            canonical.push_back(static_cast<std::uint8_t>(size | 0x80u));
+                        }
+                        canonical.push_back(static_cast<std::uint8_t>(size));
+                    }
+
+                    bool IsSpace (char c) noexcept
+                    {
+                        return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+                    }
+
+                    // Call emit(c) for each character of a value without the leading and trailing spaces, with the
+                    // inner runs of spaces replaced by one space and the ASCII letters in lowercase.
+                    template <typename Emit>
+                    void Normalize (const char *value, std::size_t size, Emit emit)
+                    {
+                        bool started = false;
+                        bool space = false;
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            const char c = value[i];
+                            if (IsSpace(c))
+                            {
+                                space = started;
+                                continue;
+                            }
+                            if (space)
+                            {
+                                emit(' ');
+                                space = false;
+                            }
+                            emit(((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c + ('a' - 'A')) : c);
+                            started = true;
+                        }
+                    }
+
+                    void AppendValue (const char *value, std::size_t size, ara::core::Vector<std::uint8_t> &canonical)
+                    {
+                        std::size_t normalized = 0u;
+                        Normalize(value, size, [&normalized] (char)
+                            {
+                                ++normalized;
+                            });
+                        canonical.push_back(static_cast<std::uint8_t>(DerReader::kTagUtf8String));
+                        AppendSize(canonical, normalized);
+                        Normalize(value, size, [&canonical] (char c)
+                            {
+                                canonical.push_back(static_cast<std::uint8_t>(c));
+                            });
+                    }
+
+                    bool AppendAttribute (const DerElement &attribute, ara::core::String &text, ara::core::Vector<std::uint8_t> &canonical)
+                    {
+                        DerReader pair(attribute);
+                        DerElement oid = {};
+                        DerElement value = {};
+                        if (!pair.Read(DerReader::kTagOid, oid) || !pair.Read(value) || !pair.IsEmpty())
+                        {
+                            return false;
+                        }
+                        AppendSize(canonical, oid.mSize);
+                        canonical.insert(canonical.end(), oid.mData, oid.mData + oid.mSize);
+
+                        std::size_t size = 0u;
+                        text.clear();
+                        if (ConvertDirectoryString(value, &text, size))
+                        {
+                            AppendValue(text.data(), text.size(), canonical);
+                        }
+                        else
+                        {
+                            canonical.push_back(value.mTag);
+                            AppendSize(canonical, value.mSize);
+                            canonical.insert(canonical.end(), value.mData, value.mData + value.mSize);
+                        }
+                        return true;
+                    }
+
+                    // Sort the canonical attributes of an RDN given as consecutive ranges of canonical.
+                    void SortAttributes (ara::core::Vector<std::uint8_t> &canonical, ara::core::Vector<std::pair<std::size_t, std::size_t> > &ranges)
+                    {
+                        const std::size_t first = ranges.front().first;
+                        const ara::core::Vector<std::uint8_t> attributes(canonical.begin() + static_cast<std::ptrdiff_t>(first), canonical.end());
+                        std::sort(ranges.begin(), ranges.end(), [&canonical] (const std::pair<std::size_t, std::size_t> &left, const std::pair<std::size_t, std::size_t> &right)
+                            {
+                                return std::lexicographical_compare(canonical.begin() + static_cast<std::ptrdiff_t>(left.first), canonical.begin() + static_cast<std::ptrdiff_t>(left.second),
+                                    canonical.begin() + static_cast<std::ptrdiff_t>(right.first), canonical.begin() + static_cast<std::ptrdiff_t>(right.second));
+                            });
+                        std::size_t next = first;
+                        for (const std::pair<std::size_t, std::size_t> &range : ranges)
+                        {
+                            const std::size_t size = range.second - range.first;
+                            std::memcpy(canonical.data() + next, attributes.data() + (range.first - first), size);
+                            next += size;
+                        }
+                    }
+                }
+
+                bool ConvertDirectoryString (const DerElement &value, ara::core::String *text, std::size_t &size)
+                {
+                    const std::uint8_t *data = value.mData;
+                    size = 0u;
+                    switch (value.mTag)
+                    {
+                    case DerReader::kTagUtf8String:
+                    case DerReader::kTagNumericString:
+                    case DerReader::kTagPrintableString:
+                    case DerReader::kTagIa5String:
+                    case DerReader::kTagVisibleString:
+                        size = value.mSize;
+                        if (text != nullptr)
+                        {
+                            text->append(reinterpret_cast<const char*>(data), value.mSize);
+                        }
+                        return true;
+                    case DerReader::kTagTeletexString:
+                        for (std::size_t i = 0; i < value.mSize; ++i)
+                        {
+                            size += Utf8Size(data[i]);
+                            if (text != nullptr)
+                            {
+                                AppendUtf8(*text, data[i]);
+                            }
+                        }
+                        return true;
+                    case DerReader::kTagBmpString:
+                        if ((value.mSize % 2u) != 0u)
+                        {
+                            return false;
+                        }
+                        for (std::size_t i = 0; i < value.mSize; i += 2u)
+                        {
+                            std::uint32_t code = (static_cast<std::uint32_t>(data[i]) << 8) | data[i + 1u];
+                            if ((code >= 0xd800u) && (code < 0xdc00u) && (i + 3u < value.mSize))
+                            {
+                                const std::uint32_t low = (static_cast<std::uint32_t>(data[i + 2u]) << 8) | data[i + 3u];
+                                if ((low >= 0xdc00u) && (low < 0xe000u))
+                                {
+                                    code = 0x10000u + ((code - 0xd800u) << 10) + (low - 0xdc00u);
+                                    i += 2u;
+                                }
+                            }
+                            if ((code >= 0xd800u) && (code < 0xe000u))
+                            {
+                                return false;   // unpaired surrogate
+                            }
+                            size += Utf8Size(code);
+                            if (text != nullptr)
+                            {
+                                AppendUtf8(*text, code);
+                            }
+                        }
+                        return true;
+                    case DerReader::kTagUniversalString:
+                        if ((value.mSize % 4u) != 0u)
+                        {
+                            return false;
+                        }
+                        for (std::size_t i = 0; i < value.mSize; i += 4u)
+                        {
+                            const std::uint32_t code = (static_cast<std::uint32_t>(data[i]) << 24) | (static_cast<std::uint32_t>(data[i + 1u]) << 16) |
+                                (static_cast<std::uint32_t>(data[i + 2u]) << 8) | data[i + 3u];
+                            if ((code > 0x10ffffu) || ((code >= 0xd800u) && (code < 0xe000u)))
+                            {
+                                return false;
+                            }
+                            size += Utf8Size(code);
+                            if (text != nullptr)
+                            {
+                                AppendUtf8(*text, code);
+                            }
+                        }
+                        return true;
+                    default:
+                        return false;
+                    }
+                }
+
+                bool CanonicalizeDn (const std::uint8_t *der, std::size_t size, ara::core::Vector<std::uint8_t> &canonical)
+                {
+                    const std::size_t start = canonical.size();
+                    DerReader outer(der, size);
+                    DerElement name = {};
+                    if (!outer.Read(DerReader::kTagSequence, name) || !outer.IsEmpty())
+                    {
+                        return false;
+                    }
+
+                    ara::core::String text;
+                    ara::core::Vector<std::pair<std::size_t, std::size_t> > ranges;
+                    DerReader names(name);
+                    bool valid = true;
+                    try
+                    {
+                        while (valid && !names.IsEmpty())
+                        {
+                            DerElement set = {};
+                            DerElement attribute = {};
+                            valid = names.Read(DerReader::kTagSet, set) && (set.mSize != 0u);
+                            std::size_t count = 0u;
+                            for (DerReader attributes(set); valid && !attributes.IsEmpty(); ++count)
+                            {
+                                valid = attributes.Read(DerReader::kTagSequence, attribute);
+                            }
+                            if (!valid)
+                            {
+                                break;
+                            }
+
+                            AppendSize(canonical, count);
+                            ranges.clear();
+                            for (DerReader attributes(set); valid && !attributes.IsEmpty(); )
+                            {
+                                const std::size_t first = canonical.size();
+                                valid = attributes.Read(DerReader::kTagSequence, attribute) && AppendAttribute(attribute, text, canonical);
+                                ranges.emplace_back(first, canonical.size());
+                            }
+                            if (valid && (count > 1u))
+                            {
+                                SortAttributes(canonical, ranges);
+                            }
+                        }
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        canonical.resize(start);
+                        throw;
+                    }
+                    if (!valid)
+                    {
+                        canonical.resize(start);
+                    }
+                    return valid;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef ARA_CRYPTO_X509_INTERNAL_CANONICAL_DN_H
+#define ARA_CRYPTO_X509_INTERNAL_CANONICAL_DN_H
+
+#include <cinttypes>
+#include <cstddef>
+
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/x509/internal/der.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace internal
+            {
+                /**
+                 * @brief Convert the value of a directory string (a DirectoryString of RFC 5280, IA5String or
+                 * VisibleString) to UTF-8. A TeletexString is treated as Latin-1, as most implementations do.
+                 * @param[in] value the element of the value
+                 * @param[in,out] text the string the result is appended to, or nullptr to compute its size only
+                 * @param[out] size size of the result in bytes
+                 * @return false if the value is not a directory string or is malformed
+                 */
+                bool ConvertDirectoryString (const DerElement &value, ara::core::String *text, std::size_t &size);
+
+                /**
+                 * @brief Append the canonical form of a DER encoded Name. Names that match by RFC 5280 7.1 have
+                 * equal canonical forms: the directory strings are converted to UTF-8, the insignificant spaces are
+                 * removed (RFC 4518 2.6.1) and the ASCII letters are folded to lowercase, other values are kept
+                 * as encoded, and the attributes of a multi-valued RDN are sorted. The form is a compact byte
+                 * string made for comparison and hashing only.
+                 * @param[in] der the DER encoded Name
+                 * @param[in] size size of the encoding in bytes
+                 * @param[in,out] canonical the vector the canonical form is appended to
+                 * @return false if the encoding is not a well-formed Name (canonical is unchanged then)
+                 * @exception std::bad_alloc if the memory for the canonical form cannot be allocated (canonical is
+                 * unchanged then), the noexcept callers report it as CryptoErrorDomain::kInsufficientResource
+                 */
+                bool CanonicalizeDn (const std::uint8_t *der, std::size_t size, ara::core::Vector<std::uint8_t> &canonical);
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_INTERNAL_CANONICAL_DN_H
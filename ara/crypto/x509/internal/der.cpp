@@ -0,0 +1,195 @@
+#include "ara/crypto/x509/internal/der.h"
+
+#include <cstring>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace internal
+            {
+                namespace
+                {
+                    // Longest accepted length field: 4 bytes cover any certificate or CRL.
+                    const std::size_t kMaxLengthBytes = 4u;
+
+                    bool ParseDigits (const std::uint8_t *text, std::size_t count, std::uint32_t &value) noexcept
+                    {
+                        value = 0u;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            if ((text[i] < '0') || (text[i] > '9'))
+                            {
+                                return false;
+                            }
+                            value = value * 10u + static_cast<std::uint32_t>(text[i] - '0');
+                        }
+                        return true;
+                    }
+
+                    // Days since 1970-01-01 of a proleptic Gregorian date.
+                    std::int64_t DaysFromCivil (std::int64_t year, std::uint32_t month, std::uint32_t day) noexcept
+                    {
+                        year -= (month <= 2u) ? 1 : 0;
+                        const std::int64_t era = ((year >= 0) ? year : year - 399) / 400;
+                        const std::int64_t yearOfEra = year - era * 400;
+                        const std::int64_t dayOfYear = (153 * ((month > 2u) ? month - 3 : month + 9) + 2) / 5 + day - 1;
+                        const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+                        return era * 146097 + dayOfEra - 719468;
+                    }
+
+                    std::uint32_t DaysInMonth (std::uint32_t year, std::uint32_t month) noexcept
+                    {
+                        static const std::uint8_t cDays[12] = {31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u};
+                        const bool leap = ((year % 4u) == 0u) && (((year % 100u) != 0u) || ((year % 400u) == 0u));
+                        return cDays[month - 1u] + (((month == 2u) && leap) ? 1u : 0u);
+                    }
+                }
+
+                bool DerReader::Read (DerElement &element) noexcept
+                {
+                    if (mSize < 2u)
+                    {
+                        return false;
+                    }
+                    const std::uint8_t tag = mData[0];
+                    if ((tag & 0x1fu) == 0x1fu)
+                    {
+                        return false;   // multi-byte tags are not used by X.509
+                    }
+
+                    std::size_t length = mData[1];
+                    std::size_t headerSize = 2u;
+                    if ((length & 0x80u) != 0u)
+                    {
+                        const std::size_t count = length & 0x7fu;
+                        if ((count == 0u) || (count > kMaxLengthBytes) || (mSize < 2u + count) || (mData[2] == 0u))
+                        {
+                            return false;   // indefinite, too long or not minimal
+                        }
+                        length = 0u;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            length = (length << 8) | mData[2u + i];
+                        }
+                        if (length < 0x80u)
+                        {
+                            return false;   // the short form is required
+                        }
+                        headerSize += count;
+                    }
+                    if (length > mSize - headerSize)
+                    {
+                        return false;
+                    }
+
+                    element.mTag = tag;
+                    element.mEncoding = mData;
+                    element.mEncodingSize = headerSize + length;
+                    element.mData = mData + headerSize;
+                    element.mSize = length;
+                    mData += element.mEncodingSize;
+                    mSize -= element.mEncodingSize;
+                    return true;
+                }
+
+                bool DerReader::Read (std::uint8_t tag, DerElement &element) noexcept
+                {
+                    return (PeekTag() == tag) && (mSize != 0u) && Read(element);
+                }
+
+                bool DerReader::ReadOptional (std::uint8_t tag, DerElement &element) noexcept
+                {
+                    if ((mSize == 0u) || (mData[0] != tag))
+                    {
+                        element = {tag, nullptr, 0u, nullptr, 0u};
+                        return true;
+                    }
+                    return Read(element);
+                }
+
+                bool DerReader::DecodeTime (const DerElement &element, std::int64_t &time) noexcept
+                {
+                    const std::uint8_t *text = element.mData;
+                    std::uint32_t year;
+                    if ((element.mTag == kTagUtcTime) && (element.mSize == 13u))
+                    {
+                        if (!ParseDigits(text, 2u, year))
+                        {
+                            return false;
+                        }
+                        year += (year >= 50u) ? 1900u : 2000u;
+                        text += 2;
+                    }
+                    else if ((element.mTag == kTagGeneralizedTime) && (element.mSize == 15u))
+                    {
+                        if (!ParseDigits(text, 4u, year))
+                        {
+                            return false;
+                        }
+                        text += 4;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+
+                    std::uint32_t month;
+                    std::uint32_t day;
+                    std::uint32_t hour;
+                    std::uint32_t minute;
+                    std::uint32_t second;
+                    if (!ParseDigits(text, 2u, month) || !ParseDigits(text + 2, 2u, day) || !ParseDigits(text + 4, 2u, hour) ||
+                        !ParseDigits(text + 6, 2u, minute) || !ParseDigits(text + 8, 2u, second) || (text[10] != 'Z'))
+                    {
+                        return false;
+                    }
+                    if ((month < 1u) || (month > 12u) || (day < 1u) || (day > DaysInMonth(year, month)) ||
+                        (hour > 23u) || (minute > 59u) || (second > 59u))
+                    {
+                        return false;
+                    }
+                    time = DaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+                    return true;
+                }
+
+                bool DerReader::DecodeBoolean (const DerElement &element, bool &value) noexcept
+                {
+                    if ((element.mTag != kTagBoolean) || (element.mSize != 1u) || ((element.mData[0] != 0x00u) && (element.mData[0] != 0xffu)))
+                    {
+                        return false;
+                    }
+                    value = (element.mData[0] != 0u);
+                    return true;
+                }
+
+                bool DerReader::DecodeSmallInteger (const DerElement &element, std::uint32_t &value) noexcept
+                {
+                    if ((element.mTag != kTagInteger) || (element.mSize == 0u) || ((element.mData[0] & 0x80u) != 0u) ||
+                        ((element.mSize > 1u) && (element.mData[0] == 0u) && ((element.mData[1] & 0x80u) == 0u)))
+                    {
+                        return false;
+                    }
+                    std::size_t offset = (element.mData[0] == 0u) ? 1u : 0u;
+                    if (element.mSize - offset > 4u)
+                    {
+                        return false;
+                    }
+                    value = 0u;
+                    for (; offset < element.mSize; ++offset)
+                    {
+                        value = (value << 8) | element.mData[offset];
+                    }
+                    return true;
+                }
+
+                bool DerReader::IsEqual (const DerElement &element, const std::uint8_t *data, std::size_t size) noexcept
+                {
+                    return (element.mSize == size) && (std::memcmp(element.mData, data, size) == 0);
+                }
+            }
+        }
+    }
+}
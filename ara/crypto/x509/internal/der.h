@@ -0,0 +1,175 @@
+#ifndef ARA_CRYPTO_X509_INTERNAL_DER_H
+#define ARA_CRYPTO_X509_INTERNAL_DER_H
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace internal
+            {
+                /**
+                 * @brief A DER encoded element (tag, length, value). The pointers refer into the parsed
+                 * encoding, nothing is copied.
+                 */
+                struct DerElement
+                {
+                    std::uint8_t mTag;
+                    const std::uint8_t *mEncoding;  // the whole element starting from the tag
+                    std::size_t mEncodingSize;
+                    const std::uint8_t *mData;      // the content octets
+                    std::size_t mSize;
+                };
+
+                /**
+                 * @brief Sequential reader of DER elements (X.690) in a buffer that is not copied. Only the
+                 * single-byte tags used by X.509 and the definite lengths in their minimal form are accepted, so
+                 * each value has exactly one accepted encoding.
+                 */
+                class DerReader
+                {
+                public:
+
+                    static const std::uint8_t kTagBoolean = 0x01u;
+                    static const std::uint8_t kTagInteger = 0x02u;
+                    static const std::uint8_t kTagBitString = 0x03u;
+                    static const std::uint8_t kTagOctetString = 0x04u;
+                    static const std::uint8_t kTagNull = 0x05u;
+                    static const std::uint8_t kTagOid = 0x06u;
+                    static const std::uint8_t kTagEnumerated = 0x0au;
+                    static const std::uint8_t kTagUtf8String = 0x0cu;
+                    static const std::uint8_t kTagNumericString = 0x12u;
+                    static const std::uint8_t kTagPrintableString = 0x13u;
+                    static const std::uint8_t kTagTeletexString = 0x14u;
+                    static const std::uint8_t kTagIa5String = 0x16u;
+                    static const std::uint8_t kTagUtcTime = 0x17u;
+                    static const std::uint8_t kTagGeneralizedTime = 0x18u;
+                    static const std::uint8_t kTagVisibleString = 0x1au;
+                    static const std::uint8_t kTagUniversalString = 0x1cu;
+                    static const std::uint8_t kTagBmpString = 0x1eu;
+                    static const std::uint8_t kTagSequence = 0x30u;
+                    static const std::uint8_t kTagSet = 0x31u;
+
+                    /**
+                     * @brief Get the tag of a constructed context-specific element [number].
+                     * @param[in] number the tag number (below 31)
+                     * @return std::uint8_t
+                     */
+                    static constexpr std::uint8_t ContextTag (std::uint8_t number) noexcept
+                    {
+                        return static_cast<std::uint8_t>(0xa0u | number);
+                    }
+
+                    /**
+                     * @brief Get the tag of a primitive context-specific element [number].
+                     * @param[in] number the tag number (below 31)
+                     * @return std::uint8_t
+                     */
+                    static constexpr std::uint8_t ContextPrimitiveTag (std::uint8_t number) noexcept
+                    {
+                        return static_cast<std::uint8_t>(0x80u | number);
+                    }
+
+                    /**
+                     * @brief Construct a reader of a sequence of elements.
+                     * @param[in] data the encoding
+                     * @param[in] size size of the encoding in bytes
+                     */
+                    DerReader (const std::uint8_t *data, std::size_t size) noexcept : mData(data), mSize(size)
+                    {
+                    }
+
+                    /**
+                     * @brief Construct a reader of the content of an element.
+                     * @param[in] element the constructed element
+                     */
+                    explicit DerReader (const DerElement &element) noexcept : mData(element.mData), mSize(element.mSize)
+                    {
+                    }
+
+                    /**
+                     * @brief Check if all elements have been read.
+                     * @return true if nothing is left
+                     */
+                    bool IsEmpty () const noexcept
+                    {
+                        return mSize == 0u;
+                    }
+
+                    /**
+                     * @brief Get the tag of the next element without reading it.
+                     * @return std::uint8_t the tag, 0 if nothing is left
+                     */
+                    std::uint8_t PeekTag () const noexcept
+                    {
+                        return (mSize == 0u) ? 0u : mData[0];
+                    }
+
+                    /**
+                     * @brief Read the next element.
+                     * @param[out] element the element
+                     * @return true if a well-formed element has been read
+                     */
+                    bool Read (DerElement &element) noexcept;
+
+                    /**
+                     * @brief Read the next element that must have the given tag.
+                     * @param[in] tag the expected tag
+                     * @param[out] element the element
+                     * @return true if a well-formed element with the tag has been read
+                     */
+                    bool Read (std::uint8_t tag, DerElement &element) noexcept;
+
+                    /**
+                     * @brief Read the next element if it has the given tag.
+                     * @param[in] tag the tag of the optional element
+                     * @param[out] element the element, empty if it is absent
+                     * @return false only if the element is present but malformed
+                     */
+                    bool ReadOptional (std::uint8_t tag, DerElement &element) noexcept;
+
+                    /**
+                     * @brief Decode an UTCTime or a GeneralizedTime in the form required by RFC 5280 ("Z" and
+                     * seconds, no fractions).
+                     * @param[in] element the time element
+                     * @param[out] time seconds since the Unix epoch
+                     * @return true if the time is well-formed
+                     */
+                    static bool DecodeTime (const DerElement &element, std::int64_t &time) noexcept;
+
+                    /**
+                     * @brief Decode a BOOLEAN.
+                     * @param[in] element the boolean element
+                     * @param[out] value the value
+                     * @return true if the boolean is well-formed (0x00 or 0xff)
+                     */
+                    static bool DecodeBoolean (const DerElement &element, bool &value) noexcept;
+
+                    /**
+                     * @brief Decode a non-negative INTEGER that fits into 32 bits.
+                     * @param[in] element the integer element
+                     * @param[out] value the value
+                     * @return true if the integer is minimally encoded, non-negative and fits
+                     */
+                    static bool DecodeSmallInteger (const DerElement &element, std::uint32_t &value) noexcept;
+
+                    /**
+                     * @brief Check if the content of an element equals the given bytes (e.g. an OID).
+                     * @return true if the content is equal
+                     */
+                    static bool IsEqual (const DerElement &element, const std::uint8_t *data, std::size_t size) noexcept;
+
+                private:
+                    const std::uint8_t *mData;
+                    std::size_t mSize;
+                };
+            }
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_INTERNAL_DER_H
@@ -0,0 +1,468 @@
+#include "ara/crypto/x509/ocsp_cache.h"
+
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/internal/sha1.h"
+#include "ara/crypto/cryp/internal/sha256.h"
+#include "ara/crypto/x509/internal/byte_hash.h"
+#include "ara/crypto/x509/internal/der.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            namespace
+            {
+                using internal::DerElement;
+                using internal::DerReader;
+
+                // id-pkix-ocsp-basic (RFC 6960 4.2.1)
+                const std::uint8_t kOidOcspBasic[] = {0x2bu, 0x06u, 0x01u, 0x05u, 0x05u, 0x07u, 0x30u, 0x01u, 0x01u};
+
+                // id-sha1 (RFC 3279), the hash of most responders and of the CertIDs of RFC 6960 4.1.1
+                const std::uint8_t kOidSha1[] = {0x2bu, 0x0eu, 0x03u, 0x02u, 0x1au};
+
+                // id-sha256 (RFC 5754)
+                const std::uint8_t kOidSha256[] = {0x60u, 0x86u, 0x48u, 0x01u, 0x65u, 0x03u, 0x04u, 0x02u, 0x01u};
+
+                // CertStatus ::= CHOICE { good [0] IMPLICIT NULL, revoked [1] IMPLICIT RevokedInfo, unknown [2] IMPLICIT NULL }
+                const std::uint8_t kTagGood = DerReader::ContextPrimitiveTag(0u);
+                const std::uint8_t kTagRevoked = DerReader::ContextTag(1u);
+                const std::uint8_t kTagUnknown = DerReader::ContextPrimitiveTag(2u);
+
+                // The issuerNameHash and issuerKeyHash of a CertID by one hash algorithm.
+                struct IssuerHashes
+                {
+                    std::uint8_t mName[cryp::internal::Sha256::kDigestSize];
+                    std::uint8_t mKey[cryp::internal::Sha256::kDigestSize];
+                    std::size_t mSize;
+
+                    bool Match (const DerElement &name, const DerElement &key) const noexcept
+                    {
+                        return DerReader::IsEqual(name, mName, mSize) && DerReader::IsEqual(key, mKey, mSize);
+                    }
+                };
+
+                bool ReadGeneralizedTime (DerReader &reader, std::int64_t &time) noexcept
+                {
+                    DerElement element = {};
+                    return reader.Read(DerReader::kTagGeneralizedTime, element) && DerReader::DecodeTime(element, time);
+                }
+            }
+
+            OcspCache::OcspCache (ChainVerifier *verifier, std::size_t capacity) noexcept
+            : mVerifier(verifier),
+              mCapacity(capacity),
+              mSignatureCheck(&ChainVerifier::CheckRsaSha256SignedData),
+              mResponder(),
+              mEntries(),
+              mEvictable()
+            {
+            }
+
+            void OcspCache::SetSignatureCheck (SignatureCheck check) noexcept
+            {
+                mSignatureCheck = std::move(check);
+            }
+
+            void OcspCache::SetResponder (Responder responder) noexcept
+            {
+                mResponder = std::move(responder);
+            }
+
+            ara::core::Result<std::size_t> OcspCache::ImportResponse (ReadOnlyMemRegion response, const DerCertificate &issuer, time_t now) noexcept
+            {
+                // OCSPResponse ::= SEQUENCE { responseStatus ENUMERATED, responseBytes [0] EXPLICIT ResponseBytes OPTIONAL }
+                DerReader outer(response.data(), response.size());
+                DerElement element = {};
+                DerElement status = {};
+                DerElement bytes = {};
+                bool valid = outer.Read(DerReader::kTagSequence, element) && outer.IsEmpty();
+                if (valid)
+                {
+                    DerReader parts(element);
+                    valid = parts.Read(DerReader::kTagEnumerated, status) && (status.mSize == 1u) &&
+                        parts.ReadOptional(DerReader::ContextTag(0u), bytes) && parts.IsEmpty();
+                }
+                if (valid && ((status.mData[0] != 0u) || (bytes.mData == nullptr)))
+                {
+                    // Only a successful response carries statuses.
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                }
+
+                // ResponseBytes ::= SEQUENCE { responseType OBJECT IDENTIFIER, response OCTET STRING }
+                DerElement basic = {};
+                if (valid)
+                {
+                    DerReader wrapper(bytes);
+                    DerElement responseBytes = {};
+                    DerElement type = {};
+                    valid = wrapper.Read(DerReader::kTagSequence, responseBytes) && wrapper.IsEmpty();
+                    DerReader fields(responseBytes);
+                    valid = valid && fields.Read(DerReader::kTagOid, type) && DerReader::IsEqual(type, kOidOcspBasic, sizeof(kOidOcspBasic)) &&
+                        fields.Read(DerReader::kTagOctetString, element) && fields.IsEmpty();
+                    DerReader content(element);
+                    valid = valid && content.Read(DerReader::kTagSequence, basic) && content.IsEmpty();
+                }
+
+                // BasicOCSPResponse ::= SEQUENCE { tbsResponseData, signatureAlgorithm, signature, certs [0] OPTIONAL }
+                DerElement tbs = {};
+                DerElement algorithm = {};
+                DerElement signature = {};
+                DerElement responses = {};
+                if (valid)
+                {
+                    DerReader fields(basic);
+                    valid = fields.Read(DerReader::kTagSequence, tbs) && fields.Read(DerReader::kTagSequence, algorithm) &&
+                        fields.Read(DerReader::kTagBitString, signature) && (signature.mSize != 0u) && (signature.mData[0] == 0u) &&
+                        fields.ReadOptional(DerReader::ContextTag(0u), element) && fields.IsEmpty();
+                }
+                if (valid)
+                {
+                    // ResponseData ::= SEQUENCE { version [0] DEFAULT v1, responderID, producedAt, responses, responseExtensions [1] }
+                    DerReader fields(tbs);
+                    std::int64_t producedAt = 0;
+                    valid = fields.ReadOptional(DerReader::ContextTag(0u), element) && (element.mData == nullptr) && fields.Read(element) &&
+                        ((element.mTag == DerReader::ContextTag(1u)) || (element.mTag == DerReader::ContextTag(2u))) &&
+                        ReadGeneralizedTime(fields, producedAt) && fields.Read(DerReader::kTagSequence, responses) &&
+                        fields.ReadOptional(DerReader::ContextTag(1u), element) && fields.IsEmpty();
+                }
+
+                // The statuses are cached by the SHA2-256 key hash whatever hash the responder has used.
+                const ReadOnlyMemRegion issuerName = issuer.SubjectDn();
+                const ReadOnlyMemRegion issuerKey = issuer.SubjectPublicKey();
+                IssuerHashes sha1 = {};
+                IssuerHashes sha256 = {};
+                Key key = {};
+                cryp::internal::Sha1::Compute(issuerName.data(), issuerName.size(), sha1.mName);
+                cryp::internal::Sha1::Compute(issuerKey.data(), issuerKey.size(), sha1.mKey);
+                sha1.mSize = cryp::internal::Sha1::kDigestSize;
+                cryp::internal::Sha256::Compute(issuerName.data(), issuerName.size(), sha256.mName);
+                cryp::internal::Sha256::Compute(issuerKey.data(), issuerKey.size(), sha256.mKey);
+                sha256.mSize = cryp::internal::Sha256::kDigestSize;
+                std::memcpy(key.mIssuerKeyHash, sha256.mKey, sizeof(key.mIssuerKeyHash));
+
+                // SingleResponse ::= SEQUENCE { certID, certStatus, thisUpdate, nextUpdate [0] OPTIONAL, singleExtensions [1] OPTIONAL }
+                ara::core::Vector<std::pair<Key, Entry> > found;
+                DerReader list(responses);
+                const std::int64_t time = static_cast<std::int64_t>(now);
+                while (valid && !list.IsEmpty())
+                {
+                    DerElement single = {};
+                    DerElement certId = {};
+                    DerElement certStatus = {};
+                    Entry entry = {CertStatus::kUnknown, 0, 0, {}};
+                    valid = list.Read(DerReader::kTagSequence, single);
+                    DerReader fields(single);
+                    valid = valid && fields.Read(DerReader::kTagSequence, certId) && fields.Read(certStatus) &&
+                        ReadGeneralizedTime(fields, entry.mThisUpdate) && fields.ReadOptional(DerReader::ContextTag(0u), element);
+                    if (valid && (element.mData != nullptr))
+                    {
+                        DerReader wrapper(element);
+                        valid = ReadGeneralizedTime(wrapper, entry.mNextUpdate) && wrapper.IsEmpty();
+                    }
+                    else
+                    {
+                        entry.mNextUpdate = entry.mThisUpdate + kDefaultLifetime;
+                    }
+                    valid = valid && fields.ReadOptional(DerReader::ContextTag(1u), element) && fields.IsEmpty();
+
+                    if (valid && (certStatus.mTag == kTagGood) && (certStatus.mSize == 0u))
+                    {
+                        entry.mStatus = CertStatus::kGood;
+                    }
+                    else if (valid && (certStatus.mTag == kTagRevoked))
+                    {
+                        entry.mStatus = CertStatus::kRevoked;
+                    }
+                    else
+                    {
+                        valid = valid && (certStatus.mTag == kTagUnknown) && (certStatus.mSize == 0u);
+                    }
+
+                    // CertID ::= SEQUENCE { hashAlgorithm, issuerNameHash, issuerKeyHash, serialNumber }
+                    DerElement hashAlgorithm = {};
+                    DerElement issuerNameHash = {};
+                    DerElement issuerKeyHash = {};
+                    DerElement serial = {};
+                    DerElement oid = {};
+                    DerReader id(certId);
+                    valid = valid && id.Read(DerReader::kTagSequence, hashAlgorithm) && id.Read(DerReader::kTagOctetString, issuerNameHash) &&
+                        id.Read(DerReader::kTagOctetString, issuerKeyHash) && id.Read(DerReader::kTagInteger, serial) && (serial.mSize != 0u) && id.IsEmpty();
+                    DerReader hash(hashAlgorithm);
+                    valid = valid && hash.Read(DerReader::kTagOid, oid) && hash.ReadOptional(DerReader::kTagNull, element) && hash.IsEmpty();
+
+                    // Statuses of other issuers, by other hashes, or not current are skipped.
+                    const bool issued = (DerReader::IsEqual(oid, kOidSha1, sizeof(kOidSha1)) && sha1.Match(issuerNameHash, issuerKeyHash)) ||
+                        (DerReader::IsEqual(oid, kOidSha256, sizeof(kOidSha256)) && sha256.Match(issuerNameHash, issuerKeyHash));
+                    if (valid && issued && (serial.mSize <= kMaxSerialSize) && (entry.mThisUpdate <= time) && (time <= entry.mNextUpdate))
+                    {
+                        key.mSerialSize = static_cast<std::uint8_t>(serial.mSize);
+                        std::memset(key.mSerial, 0, sizeof(key.mSerial));
+                        std::memcpy(key.mSerial, serial.mData, serial.mSize);
+                        try
+                        {
+                            found.emplace_back(key, entry);
+                        }
+                        catch (const std::bad_alloc &)
+                        {
+                            return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                        }
+                    }
+                }
+                if (!valid)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+
+                // Only responses signed by the issuer are accepted, not by a delegated responder.
+                if (!issuer.IsParsed() || !mSignatureCheck || !mSignatureCheck(ReadOnlyMemRegion(tbs.mEncoding, tbs.mEncodingSize),
+                    ReadOnlyMemRegion(algorithm.mEncoding, algorithm.mEncodingSize), ReadOnlyMemRegion(signature.mData + 1, signature.mSize - 1u), issuer))
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kRuntimeFault);
+                }
+
+                bool changed = false;
+                bool stored = true;
+                {
+                    std::unique_lock<std::shared_mutex> lock(mMutex);
+                    for (auto item = found.begin(); stored && (item != found.end()); ++item)
+                    {
+                        stored = Store(item->first, item->second, changed);
+                    }
+                }
+                if (changed)
+                {
+                    Notify();
+                }
+                if (!stored)
+                {
+                    return ara::core::Result<std::size_t>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                return ara::core::Result<std::size_t>::FromValue(found.size());
+            }
+
+            ara::core::Result<OcspCache::CertStatus> OcspCache::CheckStatus (const DerCertificate &certificate, const DerCertificate &issuer, time_t now) noexcept
+            {
+                Key key = {};
+                if (!MakeKey(certificate, issuer, key))
+                {
+                    return ara::core::Result<CertStatus>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                ara::core::Result<CertStatus> cached = Find(key, now);
+                if (cached.HasValue() || !mResponder)
+                {
+                    return cached;
+                }
+
+                ara::core::Result<ara::core::Vector<std::uint8_t> > fetched = mResponder(certificate, issuer);
+                if (!fetched.HasValue())
+                {
+                    return ara::core::Result<CertStatus>::FromError(fetched.Error());
+                }
+                ara::core::Result<std::size_t> imported = ImportResponse(ReadOnlyMemRegion(fetched.Value().data(), fetched.Value().size()), issuer, now);
+                if (!imported.HasValue())
+                {
+                    return ara::core::Result<CertStatus>::FromError(imported.Error());
+                }
+                return Find(key, now);
+            }
+
+            ara::core::Result<OcspCache::CertStatus> OcspCache::CheckStapled (const DerCertificate &certificate, const DerCertificate &issuer, ReadOnlyMemRegion stapled, time_t now) noexcept
+            {
+                Key key = {};
+                if (!MakeKey(certificate, issuer, key))
+                {
+                    return ara::core::Result<CertStatus>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                ara::core::Result<CertStatus> cached = Find(key, now);
+                if (cached.HasValue())
+                {
+                    return cached;
+                }
+                ara::core::Result<std::size_t> imported = ImportResponse(stapled, issuer, now);
+                if (!imported.HasValue())
+                {
+                    return ara::core::Result<CertStatus>::FromError(imported.Error());
+                }
+                return Find(key, now);
+            }
+
+            bool OcspCache::IsRevoked (const DerCertificate &certificate, const DerCertificate &issuer, time_t now) const noexcept
+            {
+                Key key = {};
+                if (!MakeKey(certificate, issuer, key))
+                {
+                    return false;
+                }
+                ara::core::Result<CertStatus> cached = Find(key, now);
+                return cached.HasValue() && (cached.Value() == CertStatus::kRevoked);
+            }
+
+            void OcspCache::Purge (time_t now) noexcept
+            {
+                const std::int64_t time = static_cast<std::int64_t>(now);
+                bool changed = false;
+                {
+                    std::unique_lock<std::shared_mutex> lock(mMutex);
+                    for (auto it = mEntries.begin(); it != mEntries.end();)
+                    {
+                        if (it->second.mNextUpdate < time)
+                        {
+                            changed = changed || (it->second.mStatus == CertStatus::kRevoked);
+                            Erase(it++);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+                if (changed)
+                {
+                    Notify();
+                }
+            }
+
+            std::size_t OcspCache::Size () const noexcept
+            {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                return mEntries.size();
+            }
+
+            bool OcspCache::Key::operator== (const Key &other) const noexcept
+            {
+                return std::memcmp(this, &other, sizeof(Key)) == 0;
+            }
+
+            std::size_t OcspCache::KeyHash::operator() (const Key &key) const noexcept
+            {
+                return static_cast<std::size_t>(internal::HashBytes(reinterpret_cast<const std::uint8_t*>(&key), sizeof(Key)));
+            }
+
+            bool OcspCache::MakeKey (const DerCertificate &certificate, const DerCertificate &issuer, Key &key) noexcept
+            {
+                const ReadOnlyMemRegion serial = certificate.SerialNumber();
+                if (!certificate.IsParsed() || !issuer.IsParsed() || (serial.size() > kMaxSerialSize))
+                {
+                    return false;
+                }
+                cryp::internal::Sha256::Compute(issuer.SubjectPublicKey().data(), issuer.SubjectPublicKey().size(), key.mIssuerKeyHash);
+                key.mSerialSize = static_cast<std::uint8_t>(serial.size());
+                std::memcpy(key.mSerial, serial.data(), serial.size());
+                return true;
+            }
+
+            bool OcspCache::Store (const Key &key, const Entry &entry, bool &changed) noexcept
+            {
+                const bool revoked = (entry.mStatus == CertStatus::kRevoked);
+                auto it = mEntries.find(key);
+                if (it != mEntries.end())
+                {
+                    // A status is replaced in place by a newer one, so a failed allocation keeps the old one.
+                    Entry &cached = it->second;
+                    if (cached.mThisUpdate > entry.mThisUpdate)
+                    {
+                        return true;
+                    }
+                    EvictionOrder::iterator order = cached.mOrder;
+                    if (revoked && (order != mEvictable.end()))
+                    {
+                        mEvictable.erase(order);
+                        order = mEvictable.end();
+                    }
+                    else if (!revoked && (order == mEvictable.end()))
+                    {
+                        try
+                        {
+                            order = mEvictable.emplace(entry.mNextUpdate, key);
+                        }
+                        catch (const std::bad_alloc &)
+                        {
+                            return false;
+                        }
+                    }
+                    else if (!revoked && (order->first != entry.mNextUpdate))
+                    {
+                        EvictionOrder::node_type node = mEvictable.extract(order);
+                        node.key() = entry.mNextUpdate;
+                        order = mEvictable.insert(std::move(node));
+                    }
+                    changed = changed || (cached.mStatus != entry.mStatus);
+                    cached = entry;
+                    cached.mOrder = order;
+                    return true;
+                }
+
+                // A full cache evicts the good or unknown status expiring first, a kRevoked one is never evicted
+                // as that would make IsRevoked() fail open.
+                if (!revoked && (mEvictable.size() >= mCapacity))
+                {
+                    if (mEvictable.empty())
+                    {
+                        return true;
+                    }
+                    Erase(mEntries.find(mEvictable.begin()->second));
+                    changed = true;
+                }
+                EvictionOrder::iterator order = mEvictable.end();
+                try
+                {
+                    if (!revoked)
+                    {
+                        order = mEvictable.emplace(entry.mNextUpdate, key);
+                    }
+                    Entry added = entry;
+                    added.mOrder = order;
+                    mEntries.emplace(key, added);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    if (order != mEvictable.end())
+                    {
+                        mEvictable.erase(order);
+                    }
+                    return false;
+                }
+                changed = changed || revoked;
+                return true;
+            }
+
+            void OcspCache::Erase (std::unordered_map<Key, Entry, KeyHash>::iterator it) noexcept
+            {
+                if (it->second.mOrder != mEvictable.end())
+                {
+                    mEvictable.erase(it->second.mOrder);
+                }
+                mEntries.erase(it);
+            }
+
+            ara::core::Result<OcspCache::CertStatus> OcspCache::Find (const Key &key, time_t now) const noexcept
+            {
+                const std::int64_t time = static_cast<std::int64_t>(now);
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                auto it = mEntries.find(key);
+                if ((it == mEntries.end()) || (time < it->second.mThisUpdate) || (it->second.mNextUpdate < time))
+                {
+                    return ara::core::Result<CertStatus>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                return ara::core::Result<CertStatus>::FromValue(it->second.mStatus);
+            }
+
+            void OcspCache::Notify () const noexcept
+            {
+                if (mVerifier != nullptr)
+                {
+                    mVerifier->RevocationChanged();
+                }
+            }
+        }
+    }
+}
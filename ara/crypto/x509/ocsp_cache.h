@@ -0,0 +1,203 @@
+#ifndef ARA_CRYPTO_X509_OCSP_CACHE_H
+#define ARA_CRYPTO_X509_OCSP_CACHE_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "ara/core/result.h"
+#include "ara/core/vector.h"
+
+#include "ara/crypto/cryp/common/mem_region.h"
+#include "ara/crypto/x509/chain_verifier.h"
+#include "ara/crypto/x509/der_certificate.h"
+
+namespace ara
+{
+    namespace crypto
+    {
+        namespace x509
+        {
+            /**
+             * @brief Cache of the certificate statuses of OCSP responses (RFC 6960) backing CheckCertStatus() and
+             * CheckCertStatusOnline(). A response is parsed and its signature is checked once, then each of its
+             * single responses is kept by (issuer key hash, serial number) until its nextUpdate, so the status
+             * checks within the validity window are hash lookups. A stapled response is only parsed if the cache
+             * has no current status, and a missing status may be fetched from a responder. IsRevoked() bound to a
+             * clock fits ChainVerifier::RevocationCheck, e.g. combined with CrlIndex::IsRevoked(). When the cache is
+             * full, the good and unknown statuses closest to their nextUpdate are evicted; a kRevoked status is only
+             * dropped when it expires. The methods may be called concurrently; the checks and the responder must be
+             * configured before.
+             */
+            class OcspCache
+            {
+            public:
+
+                /**
+                 * @brief Certificate status, the values are those of OcspResponse::OcspCertStatus.
+                 */
+                enum class CertStatus : std::uint32_t
+                {
+                    kGood= 0,       // The certificate is not revoked.
+                    kRevoked= 1,    // The certificate has been revoked (either permanantly or temporarily (on hold))
+                    kUnknown= 2     // The responder doesn’t know about the certificate being requested.
+                };
+
+                /**
+                 * @brief Check of the signature of a response by the public key of the certificate issuer.
+                 */
+                using SignatureCheck = std::function<bool (ReadOnlyMemRegion signedData, ReadOnlyMemRegion algorithm, ReadOnlyMemRegion signatureValue, const DerCertificate &issuer)>;
+
+                /**
+                 * @brief Source of the DER encoded OCSP response for a certificate, e.g. an OCSP responder.
+                 */
+                using Responder = std::function<ara::core::Result<ara::core::Vector<std::uint8_t> > (const DerCertificate &certificate, const DerCertificate &issuer)>;
+
+                /**
+                 * @brief Default maximal number of cached good and unknown statuses.
+                 */
+                static const std::size_t kDefaultCapacity = 65536u;
+
+                /**
+                 * @brief Time a status without nextUpdate is kept, in seconds.
+                 */
+                static const std::int64_t kDefaultLifetime = 3600;
+
+                /**
+                 * @brief Maximal size of a cached serial number (the content octets of the INTEGER).
+                 */
+                static const std::size_t kMaxSerialSize = 23u;
+
+                /**
+                 * @brief Construct a new OCSP Cache object checking sha256WithRSAEncryption signatures.
+                 * @param[in] verifier the chain verifier notified on changes of the revocation statuses (may be nullptr)
+                 * @param[in] capacity maximal number of cached good and unknown statuses, the kRevoked ones are not
+                 * limited
+                 */
+                explicit OcspCache (ChainVerifier *verifier=nullptr, std::size_t capacity=kDefaultCapacity) noexcept;
+
+                OcspCache (const OcspCache &) = delete;
+                OcspCache& operator= (const OcspCache &) = delete;
+
+                /**
+                 * @brief Replace the signature check, by default ChainVerifier::CheckRsaSha256SignedData().
+                 * @param[in] check the signature check
+                 */
+                void SetSignatureCheck (SignatureCheck check) noexcept;
+
+                /**
+                 * @brief Set the source of the responses for the statuses missing in the cache.
+                 * @param[in] responder the responder, an empty function disables the fetching
+                 */
+                void SetResponder (Responder responder) noexcept;
+
+                /**
+                 * @brief Parse a response signed by the certificate issuer and cache its current statuses. Only the
+                 * single responses identifying the certificates by SHA-1 or SHA2-256 hashes are taken.
+                 * @param[in] response the DER encoded OCSPResponse
+                 * @param[in] issuer the issuer of the certificates
+                 * @param[in] now the current time
+                 * @return ara::core::Result<std::size_t> the number of cached statuses
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the provided BLOB is not an OCSP response
+                 * @exception CryptoErrorDomain::kRuntimeFault if the response is not successful or its signature is
+                 * invalid
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the statuses cannot be allocated
+                 */
+                ara::core::Result<std::size_t> ImportResponse (ReadOnlyMemRegion response, const DerCertificate &issuer, time_t now) noexcept;
+
+                /**
+                 * @brief Get the status of a certificate, fetched from the responder if it is not cached.
+                 * @param[in] certificate the certificate
+                 * @param[in] issuer the issuer certificate
+                 * @param[in] now the current time
+                 * @return ara::core::Result<CertStatus>
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if no current status is known
+                 */
+                ara::core::Result<CertStatus> CheckStatus (const DerCertificate &certificate, const DerCertificate &issuer, time_t now) noexcept;
+
+                /**
+                 * @brief Get the status of a certificate from a stapled response (e.g. of a TLS handshake), which is
+                 * only parsed if no current status is cached.
+                 * @param[in] certificate the certificate
+                 * @param[in] issuer the issuer certificate
+                 * @param[in] stapled the DER encoded OCSPResponse
+                 * @param[in] now the current time
+                 * @return ara::core::Result<CertStatus>
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the stapled BLOB is not an OCSP response
+                 * @exception CryptoErrorDomain::kRuntimeFault if the stapled response is invalid
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the stapled response has no current status
+                 * of the certificate
+                 */
+                ara::core::Result<CertStatus> CheckStapled (const DerCertificate &certificate, const DerCertificate &issuer, ReadOnlyMemRegion stapled, time_t now) noexcept;
+
+                /**
+                 * @brief Check if a certificate has a current cached kRevoked status. Nothing is fetched.
+                 * @param[in] certificate the certificate
+                 * @param[in] issuer the issuer certificate
+                 * @param[in] now the current time
+                 * @return true if the certificate is revoked
+                 */
+                bool IsRevoked (const DerCertificate &certificate, const DerCertificate &issuer, time_t now) const noexcept;
+
+                /**
+                 * @brief Drop the expired statuses.
+                 * @param[in] now the current time
+                 */
+                void Purge (time_t now) noexcept;
+
+                /**
+                 * @brief Get the number of cached statuses.
+                 * @return std::size_t
+                 */
+                std::size_t Size () const noexcept;
+
+            private:
+                struct Key
+                {
+                    std::uint8_t mIssuerKeyHash[32];
+                    std::uint8_t mSerialSize;
+                    std::uint8_t mSerial[kMaxSerialSize];
+
+                    bool operator== (const Key &other) const noexcept;
+                };
+
+                struct KeyHash
+                {
+                    std::size_t operator() (const Key &key) const noexcept;
+                };
+
+                // The good and unknown statuses by their nextUpdate, the eviction order.
+                using EvictionOrder = std::multimap<std::int64_t, Key>;
+
+                struct Entry
+                {
+                    CertStatus mStatus;
+                    std::int64_t mThisUpdate;
+                    std::int64_t mNextUpdate;   // the status is dropped after it
+                    EvictionOrder::iterator mOrder;    // mEvictable.end() for kRevoked
+                };
+
+                static bool MakeKey (const DerCertificate &certificate, const DerCertificate &issuer, Key &key) noexcept;
+                bool Store (const Key &key, const Entry &entry, bool &changed) noexcept;
+                void Erase (std::unordered_map<Key, Entry, KeyHash>::iterator it) noexcept;
+                ara::core::Result<CertStatus> Find (const Key &key, time_t now) const noexcept;
+                void Notify () const noexcept;
+
+                ChainVerifier *mVerifier;
+                std::size_t mCapacity;
+                SignatureCheck mSignatureCheck;
+                Responder mResponder;
+
+                mutable std::shared_mutex mMutex;
+                std::unordered_map<Key, Entry, KeyHash> mEntries;
+                EvictionOrder mEvictable;
+            };
+        }
+    }
+}
+
+#endif // ARA_CRYPTO_X509_OCSP_CACHE_H
@@ -1,130 +1,657 @@
 #include "ara/crypto/x509/x509_dn.h"
 
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "ara/crypto/x509/internal/byte_hash.h"
+#include "ara/crypto/x509/internal/canonical_dn.h"
+#include "ara/crypto/x509/internal/der.h"
+
 namespace ara
 {
     namespace crypto
     {
         namespace x509
         {
-            ara::core::Result<ara::core::String> X509DN::GetAttribute (AttributeId id) const noexcept
+            namespace
             {
-                switch (id)
-                {
-                    case AttributeId::kCommonName:
-                        return ara::core::Result<ara::core::String>::FromValue(mCommonName);
-                        break;
-                    case AttributeId::kCountry:
-                        return ara::core::Result<ara::core::String>::FromValue(mCountry);
-                        break;
-                    case AttributeId::kState:
-                        return ara::core::Result<ara::core::String>::FromValue(mState);
-                        break;
-                    case AttributeId::kLocality:
-                        return ara::core::Result<ara::core::String>::FromValue(mLocality);
-                        break;
-                    case AttributeId::kOrganization:
-                        return ara::core::Result<ara::core::String>::FromValue(mOrganization);
-                        break;
-                    case AttributeId::kStreet:
-                        return ara::core::Result<ara::core::String>::FromValue(mStreet);
-                        break;
-                    case AttributeId::kPostalCode:
-                        return ara::core::Result<ara::core::String>::FromValue(mPostalCode);
-                        break;
-                    case AttributeId::kTitle:
-                        return ara::core::Result<ara::core::String>::FromValue(mTitle);
-                        break;
-                    case AttributeId::kSurname:
-                        return ara::core::Result<ara::core::String>::FromValue(mSurname);
-                        break;
-                    case AttributeId::kGivenName:
-                        return ara::core::Result<ara::core::String>::FromValue(mGivenName);
-                        break;
-                    case AttributeId::kInitials:
-                        return ara::core::Result<ara::core::String>::FromValue(mInitials);
-                        break;
-                    case AttributeId::kPseudonym:
-                        return ara::core::Result<ara::core::String>::FromValue(mPseudonym);
-                        break;
-                    case AttributeId::kGenerationQualifier:
-                        return ara::core::Result<ara::core::String>::FromValue(mGenerationQualifier);
-                        break;
-                    case AttributeId::kDnQualifier:
-                        return ara::core::Result<ara::core::String>::FromValue(mDnQualifier);
-                        break;
-                        case AttributeId::kEmail:
-                        return ara::core::Result<ara::core::String>::FromValue(mEmail);
-                        break;
-                        case AttributeId::kUri:
-                        return ara::core::Result<ara::core::String>::FromValue(mUri);
-                        break;
-                        case AttributeId::kDns:
-                        return ara::core::Result<ara::core::String>::FromValue(mDns);
-                        break;
-                        case AttributeId::kHostName:
-                        return ara::core::Result<ara::core::String>::FromValue(mHostName);
-                        break;
-                        case AttributeId::kIpAddress:
-                        return ara::core::Result<ara::core::String>::FromValue(mIpAddress);
-                        break;
-                        case AttributeId::kSerialNumbers:
-                        return ara::core::Result<ara::core::String>::FromValue(mSerialNumbers);
-                        break;
-                        case AttributeId::kUserId:
-                        return ara::core::Result<ara::core::String>::FromValue(mUserId);
-                        break;
+                using internal::DerElement;
+                using internal::DerReader;
+
+                // Longest accepted attribute value in bytes.
+                const std::size_t kMaxAttributeSize = 1024u;
+
+                // Most attribute values of a DN, the offset table indexes are 16-bit.
+                const std::size_t kMaxEntries = 0xffffu;
+
+                struct AttributeOid
+                {
+                    const std::uint8_t *mOid;
+                    std::size_t mSize;
+                };
+
+                const std::uint8_t kOidCommonName[] = {0x55u, 0x04u, 0x03u};
+                const std::uint8_t kOidCountry[] = {0x55u, 0x04u, 0x06u};
+                const std::uint8_t kOidState[] = {0x55u, 0x04u, 0x08u};
+                const std::uint8_t kOidLocality[] = {0x55u, 0x04u, 0x07u};
+                const std::uint8_t kOidOrganization[] = {0x55u, 0x04u, 0x0au};
+                const std::uint8_t kOidOrgUnit[] = {0x55u, 0x04u, 0x0bu};
+                const std::uint8_t kOidStreet[] = {0x55u, 0x04u, 0x09u};
+                const std::uint8_t kOidPostalCode[] = {0x55u, 0x04u, 0x11u};
+                const std::uint8_t kOidTitle[] = {0x55u, 0x04u, 0x0cu};
+                const std::uint8_t kOidSurname[] = {0x55u, 0x04u, 0x04u};
+                const std::uint8_t kOidGivenName[] = {0x55u, 0x04u, 0x2au};
+                const std::uint8_t kOidInitials[] = {0x55u, 0x04u, 0x2bu};
+                const std::uint8_t kOidPseudonym[] = {0x55u, 0x04u, 0x41u};
+                const std::uint8_t kOidGenerationQualifier[] = {0x55u, 0x04u, 0x2cu};
+                const std::uint8_t kOidDomainComponent[] = {0x09u, 0x92u, 0x26u, 0x89u, 0x93u, 0xf2u, 0x2cu, 0x64u, 0x01u, 0x19u};
+                const std::uint8_t kOidDnQualifier[] = {0x55u, 0x04u, 0x2eu};
+                const std::uint8_t kOidEmail[] = {0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x09u, 0x01u};
+                const std::uint8_t kOidHostName[] = {0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x09u, 0x02u};
+                const std::uint8_t kOidIpAddress[] = {0x2au, 0x86u, 0x48u, 0x86u, 0xf7u, 0x0du, 0x01u, 0x09u, 0x08u};
+                const std::uint8_t kOidSerialNumbers[] = {0x55u, 0x04u, 0x05u};
+                const std::uint8_t kOidUserId[] = {0x09u, 0x92u, 0x26u, 0x89u, 0x93u, 0xf2u, 0x2cu, 0x64u, 0x01u, 0x01u};
+
+                // OIDs in the order of X509DN::AttributeId, kUri and kDns have no attribute type in a Name.
+                const AttributeOid cAttributeOids[] = {
+                    {kOidCommonName, sizeof(kOidCommonName)}, {kOidCountry, sizeof(kOidCountry)},
+                    {kOidState, sizeof(kOidState)}, {kOidLocality, sizeof(kOidLocality)},
+                    {kOidOrganization, sizeof(kOidOrganization)}, {kOidOrgUnit, sizeof(kOidOrgUnit)},
+                    {kOidStreet, sizeof(kOidStreet)}, {kOidPostalCode, sizeof(kOidPostalCode)},
+                    {kOidTitle, sizeof(kOidTitle)}, {kOidSurname, sizeof(kOidSurname)},
+                    {kOidGivenName, sizeof(kOidGivenName)}, {kOidInitials, sizeof(kOidInitials)},
+                    {kOidPseudonym, sizeof(kOidPseudonym)}, {kOidGenerationQualifier, sizeof(kOidGenerationQualifier)},
+                    {kOidDomainComponent, sizeof(kOidDomainComponent)}, {kOidDnQualifier, sizeof(kOidDnQualifier)},
+                    {kOidEmail, sizeof(kOidEmail)}, {nullptr, 0u}, {nullptr, 0u},
+                    {kOidHostName, sizeof(kOidHostName)}, {kOidIpAddress, sizeof(kOidIpAddress)},
+                    {kOidSerialNumbers, sizeof(kOidSerialNumbers)}, {kOidUserId, sizeof(kOidUserId)}};
+
+                struct ShortName
+                {
+                    const std::uint8_t *mOid;
+                    std::size_t mSize;
+                    const char *mName;
+                };
+
+                // The attribute type names of RFC 4514 3, the other types are written as dotted-decimal OIDs.
+                const ShortName cShortNames[] = {
+                    {kOidCommonName, sizeof(kOidCommonName), "CN"}, {kOidLocality, sizeof(kOidLocality), "L"},
+                    {kOidState, sizeof(kOidState), "ST"}, {kOidOrganization, sizeof(kOidOrganization), "O"},
+                    {kOidOrgUnit, sizeof(kOidOrgUnit), "OU"}, {kOidCountry, sizeof(kOidCountry), "C"},
+                    {kOidStreet, sizeof(kOidStreet), "STREET"}, {kOidDomainComponent, sizeof(kOidDomainComponent), "DC"},
+                    {kOidUserId, sizeof(kOidUserId), "UID"}};
+
+                // Encoding of an empty Name (an empty SEQUENCE).
+                const std::uint8_t kEmptyName[] = {DerReader::kTagSequence, 0x00u};
+
+                // The string type of a new value: RFC 5280 requires PrintableString for the country, the DN qualifier
+                // and the serial number, IA5String for the e-mail address and the domain component.
+                std::uint8_t GetValueTag (X509DN::AttributeId id) noexcept
+                {
+                    switch (id)
+                    {
+                    case X509DN::AttributeId::kCountry:
+                    case X509DN::AttributeId::kDnQualifier:
+                    case X509DN::AttributeId::kSerialNumbers:
+                        return DerReader::kTagPrintableString;
+                    case X509DN::AttributeId::kEmail:
+                    case X509DN::AttributeId::kDomainComponent:
+                        return DerReader::kTagIa5String;
                     default:
-                        return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
-                        break;
+                        return DerReader::kTagUtf8String;
+                    }
                 }
-            }
 
-            ara::core::Result<ara::core::String> X509DN::GetAttribute (AttributeId id, unsigned index) const noexcept
-            {
-                switch (id)
+                bool IsValidValue (std::uint8_t tag, ara::core::StringView value) noexcept
                 {
-                    case AttributeId::kOrgUnit:
-                        if (mOrgUnit.size() > index)
+                    for (const char c : value)
+                    {
+                        const bool printable = ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) ||
+                            (std::strchr(" '()+,-./:=?", c) != nullptr);
+                        if ((c == '\0') || ((tag == DerReader::kTagPrintableString) && !printable) ||
+                            ((tag == DerReader::kTagIa5String) && (static_cast<unsigned char>(c) >= 0x80u)))
                         {
-                            return ara::core::Result<ara::core::String>::FromValue(mOrgUnit.at(index));
+                            return false;
                         }
-                        else
+                    }
+                    return true;
+                }
+
+                // Append a DER element with the definite length in its minimal form.
+                void AppendDer (ara::core::Vector<std::uint8_t> &der, std::uint8_t tag, const std::uint8_t *content, std::size_t size)
+                {
+                    der.push_back(tag);
+                    if (size < 0x80u)
+                    {
+                        der.push_back(static_cast<std::uint8_t>(size));
+                    }
+                    else
+                    {
+                        std::size_t octets = 0u;
+                        for (std::size_t rest = size; rest != 0u; rest >>= 8)
                         {
-                            return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kAboveBoundary);
+                            ++octets;
                         }
-                        break;
-                    case AttributeId::kDomainComponent:
-                            if (mDomainComponent.size() > index)
+                        der.push_back(static_cast<std::uint8_t>(0x80u | octets));
+                        for (std::size_t i = octets; i > 0u; --i)
                         {
-                            return ara::core::Result<ara::core::String>::FromValue(mDomainComponent.at(index));
+                            der.push_back(static_cast<std::uint8_t>(size >> (8u * (i - 1u))));
                         }
-                        else
+                    }
+                    der.insert(der.end(), content, content + size);
+                }
+
+                const char* FindShortName (const DerElement &oid) noexcept
+                {
+                    for (const ShortName &name : cShortNames)
+                    {
+                        if (DerReader::IsEqual(oid, name.mOid, name.mSize))
                         {
-                            return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kAboveBoundary);
+                            return name.mName;
                         }
-                        break;
-                    default:
-                        if (index == 0)
+                    }
+                    return nullptr;
+                }
+
+                // Append the dotted-decimal form of an OID, false if its content octets are malformed.
+                bool AppendOid (ara::core::String &text, const DerElement &oid)
+                {
+                    std::uint64_t arc = 0u;
+                    bool first = true;
+                    for (std::size_t i = 0; i < oid.mSize; ++i)
+                    {
+                        if ((arc >> 57) != 0u)
                         {
-                            return GetAttribute(id);
+                            return false;
                         }
-                        else
+                        arc = (arc << 7) | (oid.mData[i] & 0x7fu);
+                        if ((oid.mData[i] & 0x80u) != 0u)
+                        {
+                            continue;
+                        }
+                        if (first)
                         {
-                            return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                            // The first subidentifier combines the first two arcs (X.690 8.19.4).
+                            const std::uint64_t root = (arc < 80u) ? (arc / 40u) : 2u;
+                            text += std::to_string(root);
+                            arc -= root * 40u;
+                            first = false;
                         }
-                        break;
+                        text += '.';
+                        text += std::to_string(arc);
+                        arc = 0u;
+                    }
+                    return !first && ((oid.mData[oid.mSize - 1u] & 0x80u) == 0u);
+                }
+
+                // Append a string value with the escapes of RFC 4514 2.4.
+                void AppendEscaped (ara::core::String &text, const ara::core::String &value)
+                {
+                    for (std::size_t i = 0; i < value.size(); ++i)
+                    {
+                        const char c = value[i];
+                        if (c == '\0')
+                        {
+                            text += "\\00";
+                            continue;
+                        }
+                        if ((std::strchr("\"+,;<>\\", c) != nullptr) || ((i == 0u) && ((c == ' ') || (c == '#'))) ||
+                            ((i + 1u == value.size()) && (c == ' ')))
+                        {
+                            text += '\\';
+                        }
+                        text += c;
+                    }
+                }
+
+                // Append a value as '#' and the hexadecimal form of its DER encoding (RFC 4514 2.4).
+                void AppendHex (ara::core::String &text, const DerElement &value)
+                {
+                    const char cDigits[] = "0123456789abcdef";
+                    text += '#';
+                    for (std::size_t i = 0; i < value.mEncodingSize; ++i)
+                    {
+                        text += cDigits[value.mEncoding[i] >> 4];
+                        text += cDigits[value.mEncoding[i] & 0x0fu];
+                    }
+                }
+
+                bool IsMultiValued (X509DN::AttributeId id) noexcept
+                {
+                    return (id == X509DN::AttributeId::kOrgUnit) || (id == X509DN::AttributeId::kDomainComponent);
+                }
+
+                std::size_t FindAttribute (const DerElement &oid, std::size_t count) noexcept
+                {
+                    for (std::size_t id = 0; id < count; ++id)
+                    {
+                        if ((cAttributeOids[id].mOid != nullptr) && DerReader::IsEqual(oid, cAttributeOids[id].mOid, cAttributeOids[id].mSize))
+                        {
+                            return id;
+                        }
+                    }
+                    return count;
+                }
+
+                // Walk the attributes of a DER encoded Name (a SEQUENCE of SETs of type and value pairs) calling
+                // visit(id, value) for each attribute with an AttributeId.
+                template <typename Visitor>
+                bool ForEachAttribute (const std::uint8_t *der, std::size_t size, std::size_t count, Visitor visit)
+                {
+                    DerReader outer(der, size);
+                    DerElement name = {};
+                    if (!outer.Read(DerReader::kTagSequence, name) || !outer.IsEmpty())
+                    {
+                        return false;
+                    }
+                    DerReader names(name);
+                    while (!names.IsEmpty())
+                    {
+                        DerElement set = {};
+                        if (!names.Read(DerReader::kTagSet, set) || (set.mSize == 0u))
+                        {
+                            return false;
+                        }
+                        DerReader attributes(set);
+                        while (!attributes.IsEmpty())
+                        {
+                            DerElement attribute = {};
+                            DerElement oid = {};
+                            DerElement value = {};
+                            if (!attributes.Read(DerReader::kTagSequence, attribute))
+                            {
+                                return false;
+                            }
+                            DerReader pair(attribute);
+                            if (!pair.Read(DerReader::kTagOid, oid) || !pair.Read(value) || !pair.IsEmpty())
+                            {
+                                return false;
+                            }
+                            const std::size_t id = FindAttribute(oid, count);
+                            if ((id < count) && !visit(id, value))
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                }
+            }
+
+            X509DN::X509DN (X509Provider &provider, std::size_t capacity)
+            : X509Object(provider),
+              mValues(),
+              mEntries(),
+              mFirstEntry(),
+              mDer(kEmptyName, kEmptyName + sizeof(kEmptyName)),
+              mDecoded(true),
+              mDecodeMutex(),
+              mCanonical(),
+              mHash(0u)
+            {
+                mValues.reserve(capacity);
+                internal::CanonicalizeDn(mDer.data(), mDer.size(), mCanonical);
+                mHash = internal::HashBytes(mCanonical.data(), mCanonical.size());
+            }
+
+            ara::core::Result<ara::core::String> X509DN::GetAttribute (AttributeId id) const noexcept
+            {
+                if (IsMultiValued(id))
+                {
+                    return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                return GetAttribute(id, 0u);
+            }
+
+            ara::core::Result<ara::core::String> X509DN::GetAttribute (AttributeId id, unsigned index) const noexcept
+            {
+                ara::core::Result<ara::core::StringView> view = GetAttributeView(id, index);
+                if (!view.HasValue())
+                {
+                    return ara::core::Result<ara::core::String>::FromError(view.Error());
+                }
+                try
+                {
+                    return ara::core::Result<ara::core::String>::FromValue(ara::core::String(view.Value()));
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+            }
+
+            ara::core::Result<ara::core::StringView> X509DN::GetAttributeView (AttributeId id, unsigned index) const noexcept
+            {
+                const std::size_t attribute = static_cast<std::size_t>(id);
+                if (attribute >= kAttributeCount)
+                {
+                    return ara::core::Result<ara::core::StringView>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                if (!IsMultiValued(id) && (index > 0u))
+                {
+                    return ara::core::Result<ara::core::StringView>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+
+                Decode();
+                const std::size_t entry = mFirstEntry[attribute] + index;
+                if (entry >= mFirstEntry[attribute + 1u])
+                {
+                    if (IsMultiValued(id))
+                    {
+                        return ara::core::Result<ara::core::StringView>::FromError(CryptoErrorDomain::Errc::kAboveBoundary);
+                    }
+                    return ara::core::Result<ara::core::StringView>::FromValue(ara::core::StringView());
+                }
+                return ara::core::Result<ara::core::StringView>::FromValue(
+                    ara::core::StringView(mValues.data() + mEntries[entry].mOffset, mEntries[entry].mSize));
+            }
+
+            std::size_t X509DN::GetAttributeCount (AttributeId id) const noexcept
+            {
+                const std::size_t attribute = static_cast<std::size_t>(id);
+                if (attribute >= kAttributeCount)
+                {
+                    return 0u;
                 }
+                // The table is complete before the values are decoded.
+                return static_cast<std::size_t>(mFirstEntry[attribute + 1u] - mFirstEntry[attribute]);
             }
 
             ara::core::Result<ara::core::String> X509DN::GetDnString () const noexcept
             {
+                try
+                {
+                    return FormatDn();
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+            }
+
+            ara::core::Result<ara::core::String> X509DN::FormatDn () const
+            {
+                // The RDNs are written in the reverse order of the encoding (RFC 4514 2.1). SetDer() has validated
+                // the encoding.
+                ara::core::Vector<DerElement> rdns;
+                DerReader outer(mDer.data(), mDer.size());
+                DerElement name = {};
+                outer.Read(DerReader::kTagSequence, name);
+                for (DerReader sets(name); !sets.IsEmpty(); )
+                {
+                    DerElement set = {};
+                    sets.Read(DerReader::kTagSet, set);
+                    rdns.push_back(set);
+                }
+
                 ara::core::String result;
-                for (ara::core::String str : mDomainComponent)
+                ara::core::String text;
+                for (std::size_t rdn = rdns.size(); rdn > 0u; --rdn)
                 {
-                    result += str;
+                    if (rdn != rdns.size())
+                    {
+                        result += ',';
+                    }
+                    bool first = true;
+                    for (DerReader attributes(rdns[rdn - 1u]); !attributes.IsEmpty(); first = false)
+                    {
+                        DerElement pair = {};
+                        DerElement type = {};
+                        DerElement value = {};
+                        attributes.Read(DerReader::kTagSequence, pair);
+                        DerReader fields(pair);
+                        fields.Read(DerReader::kTagOid, type);
+                        fields.Read(value);
+                        if (!first)
+                        {
+                            result += '+';
+                        }
+
+                        const char *shortName = FindShortName(type);
+                        if (shortName != nullptr)
+                        {
+                            result += shortName;
+                        }
+                        else if (!AppendOid(result, type))
+                        {
+                            return ara::core::Result<ara::core::String>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                        }
+                        result += '=';
+
+                        std::size_t size = 0u;
+                        text.clear();
+                        if ((shortName != nullptr) && internal::ConvertDirectoryString(value, &text, size))
+                        {
+                            AppendEscaped(result, text);
+                        }
+                        else
+                        {
+                            AppendHex(result, value);
+                        }
+                    }
                 }
                 return ara::core::Result<ara::core::String>::FromValue(result);
             }
+
+            bool X509DN::operator== (const X509DN &other) const noexcept
+            {
+                return (mHash == other.mHash) && (mCanonical.size() == other.mCanonical.size()) &&
+                    ((mCanonical.size() == 0u) || (std::memcmp(mCanonical.data(), other.mCanonical.data(), mCanonical.size()) == 0));
+            }
+
+            bool X509DN::operator!= (const X509DN &other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+            ara::core::Result<void> X509DN::SetAttribute (AttributeId id, ara::core::StringView attribute) noexcept
+            {
+                if (IsMultiValued(id))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                return Replace(id, 0u, attribute);
+            }
+
+            ara::core::Result<void> X509DN::SetAttribute (AttributeId id, unsigned index, ara::core::StringView attribute) noexcept
+            {
+                if (!IsMultiValued(id) && (index > 0u))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInvalidArgument);
+                }
+                return Replace(id, index, attribute);
+            }
+
+            ara::core::Result<void> X509DN::SetDer (ReadOnlyMemRegion der) noexcept
+            {
+                std::size_t counts[kAttributeCount] = {};
+                std::size_t entries = 0u;
+                std::size_t total = 0u;
+                const bool valid = ForEachAttribute(der.data(), der.size(), kAttributeCount,
+                    [&counts, &entries, &total] (std::size_t id, const DerElement &value)
+                    {
+                        std::size_t size = 0u;
+                        if (!internal::ConvertDirectoryString(value, nullptr, size) || (entries == kMaxEntries))
+                        {
+                            return false;
+                        }
+                        ++counts[id];
+                        ++entries;
+                        total += size;
+                        return true;
+                    });
+                if (!valid)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+
+                // Everything is allocated before the DN changes, so a failure keeps the old DN. The copy also
+                // keeps der valid if it points into mDer, and Decode() fills the reserved storage only.
+                ara::core::Vector<std::uint8_t> canonical;
+                ara::core::Vector<std::uint8_t> copy;
+                ara::core::String values;
+                ara::core::Vector<Entry> table;
+                try
+                {
+                    if (!internal::CanonicalizeDn(der.data(), der.size(), canonical))
+                    {
+                        return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                    }
+                    copy.assign(der.begin(), der.end());
+                    values.reserve(total);
+                    table.reserve(entries);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+
+                std::lock_guard<std::mutex> lock(mDecodeMutex);
+                mCanonical.swap(canonical);
+                mHash = internal::HashBytes(mCanonical.data(), mCanonical.size());
+                mDer.swap(copy);
+                mValues.swap(values);
+                mEntries.swap(table);
+                mFirstEntry[0] = 0u;
+                for (std::size_t id = 0; id < kAttributeCount; ++id)
+                {
+                    mFirstEntry[id + 1u] = static_cast<std::uint16_t>(mFirstEntry[id] + counts[id]);
+                }
+                mDecoded.store(false, std::memory_order_release);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void X509DN::Decode () const noexcept
+            {
+                if (mDecoded.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(mDecodeMutex);
+                if (mDecoded.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                // SetDer() has validated the encoding, counted the entries of each attribute and reserved the
+                // storage, so nothing is allocated here.
+                std::uint16_t filled[kAttributeCount] = {};
+                mEntries.resize(mFirstEntry[kAttributeCount]);
+                ForEachAttribute(mDer.data(), mDer.size(), kAttributeCount,
+                    [this, &filled] (std::size_t id, const DerElement &value)
+                    {
+                        Entry &entry = mEntries[mFirstEntry[id] + filled[id]++];
+                        std::size_t size = 0u;
+                        entry.mOffset = static_cast<std::uint32_t>(mValues.size());
+                        internal::ConvertDirectoryString(value, &mValues, size);
+                        entry.mSize = static_cast<std::uint32_t>(size);
+                        return true;
+                    });
+                mDecoded.store(true, std::memory_order_release);
+            }
+
+            ara::core::Result<void> X509DN::Replace (AttributeId id, unsigned index, ara::core::StringView attribute) noexcept
+            {
+                const std::size_t target = static_cast<std::size_t>(id);
+                if ((target >= kAttributeCount) || (cAttributeOids[target].mOid == nullptr))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnknownIdentifier);
+                }
+                const std::uint8_t valueTag = GetValueTag(id);
+                if ((attribute.size() > kMaxAttributeSize) || !IsValidValue(valueTag, attribute))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kUnexpectedValue);
+                }
+                const std::size_t count = GetAttributeCount(id);
+                if ((index > count) || ((index == count) && (mFirstEntry[kAttributeCount] == kMaxEntries)))
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kAboveBoundary);
+                }
+
+                ara::core::Vector<std::uint8_t> der;
+                try
+                {
+                    der = Rewrite(target, index, attribute);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return ara::core::Result<void>::FromError(CryptoErrorDomain::Errc::kInsufficientResource);
+                }
+                return SetDer(ReadOnlyMemRegion(der.data(), der.size()));
+            }
+
+            ara::core::Vector<std::uint8_t> X509DN::Rewrite (std::size_t target, unsigned index, ara::core::StringView attribute) const
+            {
+                // The new AttributeTypeAndValue, an empty value removes the component.
+                const AttributeOid &oid = cAttributeOids[target];
+                const std::size_t count = GetAttributeCount(static_cast<AttributeId>(target));
+                ara::core::Vector<std::uint8_t> replacement;
+                if (!attribute.empty())
+                {
+                    ara::core::Vector<std::uint8_t> pair;
+                    AppendDer(pair, DerReader::kTagOid, oid.mOid, oid.mSize);
+                    AppendDer(pair, GetValueTag(static_cast<AttributeId>(target)), reinterpret_cast<const std::uint8_t*>(attribute.data()), attribute.size());
+                    AppendDer(replacement, DerReader::kTagSequence, pair.data(), pair.size());
+                }
+
+                // The encoding is rewritten RDN by RDN, so their order, the multi-valued RDNs and the attributes
+                // without an AttributeId are kept. SetDer() has validated the encoding.
+                ara::core::Vector<std::uint8_t> names;
+                ara::core::Vector<std::uint8_t> rdn;
+                std::size_t insertAt = 0u;
+                bool found = false;
+                std::size_t component = 0u;
+                DerReader outer(mDer.data(), mDer.size());
+                DerElement name = {};
+                outer.Read(DerReader::kTagSequence, name);
+                for (DerReader sets(name); !sets.IsEmpty(); )
+                {
+                    DerElement set = {};
+                    sets.Read(DerReader::kTagSet, set);
+                    rdn.clear();
+                    bool contains = false;
+                    for (DerReader attributes(set); !attributes.IsEmpty(); )
+                    {
+                        DerElement pair = {};
+                        DerElement type = {};
+                        attributes.Read(DerReader::kTagSequence, pair);
+                        DerReader fields(pair);
+                        fields.Read(DerReader::kTagOid, type);
+                        if (DerReader::IsEqual(type, oid.mOid, oid.mSize))
+                        {
+                            contains = true;
+                            if (component++ == index)
+                            {
+                                rdn.insert(rdn.end(), replacement.begin(), replacement.end());
+                                continue;
+                            }
+                        }
+                        rdn.insert(rdn.end(), pair.mEncoding, pair.mEncoding + pair.mEncodingSize);
+                    }
+                    if (!rdn.empty())
+                    {
+                        AppendDer(names, DerReader::kTagSet, rdn.data(), rdn.size());
+                    }
+                    if (contains)
+                    {
+                        insertAt = names.size();
+                        found = true;
+                    }
+                }
+
+                if ((index == count) && !replacement.empty())
+                {
+                    // A new component follows the last RDN of the attribute, a new attribute becomes the last RDN.
+                    rdn.clear();
+                    AppendDer(rdn, DerReader::kTagSet, replacement.data(), replacement.size());
+                    names.insert(names.begin() + static_cast<std::ptrdiff_t>(found ? insertAt : names.size()), rdn.begin(), rdn.end());
+                }
+
+                ara::core::Vector<std::uint8_t> der;
+                AppendDer(der, DerReader::kTagSequence, names.data(), names.size());
+                return der;
+            }
         }
     }
-}
\ No newline at end of file
+}
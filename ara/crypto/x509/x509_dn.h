@@ -1,13 +1,18 @@
 #ifndef ARA_CRYPTO_X509_X509DN_H
 #define ARA_CRYPTO_X509_X509DN_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <cinttypes>
 
 #include "ara/core/result.h"
 #include "ara/core/string.h"
+#include "ara/core/string_view.h"
+#include "ara/core/vector.h"
 
 #include "ara/crypto/cryp/common/crypto_error_domain.h"
+#include "ara/crypto/cryp/common/mem_region.h"
 
 #include "ara/crypto/x509/x509_object.h"
 #include "ara/crypto/x509/x509_provider.h"
@@ -21,63 +26,18 @@ namespace ara
             /**
              * @brief [SWS_CRYPT_40400]
              * Interface of X.509 Distinguished Name (DN).
+             * The DER encoding is the master copy of the DN: SetAttribute() rewrites the addressed attribute in
+             * it, so the order of the RDNs, the multi-valued RDNs and the attributes without an AttributeId are
+             * kept. The attribute values are decoded on the first access into one buffer with a table of their
+             * offsets indexed by AttributeId. The canonical form (RFC 5280 7.1) and its hash are computed
+             * whenever the DN is set, so a comparison is a hash compare confirmed by comparing the canonical
+             * forms.
              */
             class X509DN : public X509Object
             {
-            private:
-                ara::core::String mCommonName = nullptr;
-                ara::core::String mCountry;            // Country
-                ara::core::String mState;              // State
-                ara::core::String mLocality;           // Locality
-                ara::core::String mOrganization;       // Organization
-                ara::core::vector<ara::core::String> mOrgUnit;            // Organization Unit
-                ara::core::String mStreet;             // Street
-                ara::core::String mPostalCode;         // Postal Code
-                ara::core::String mTitle;              // Title
-                ara::core::String mSurname;            // Surname
-                ara::core::String mGivenName;         // Given Name
-                ara::core::String mInitials;          // Initials
-                ara::core::String mPseudonym;         // Pseudonym
-                ara::core::String mGenerationQualifier;   // Generation Qualifier
-                ara::core::vector<ara::core::String> mDomainComponent;   // Domain Component
-                ara::core::String mDnQualifier;       // Distinguished Name Qualifier
-                ara::core::String mEmail;             // E-mail
-                ara::core::String mUri;               // URI
-                ara::core::String mDns;               // DNS
-                ara::core::String mHostName;          // Host Name (UNSTRUCTUREDNAME)
-                ara::core::String mIpAddress;         // IP Address (UNSTRUCTUREDADDRESS)
-                ara::core::String mSerialNumbers;     // Serial Numbers
-                ara::core::String mUserId;             // User ID
-
             public:
 
-                X509DN (X509Provider &provider, std::size_t capacity=0)
-                : X509Object(provider),
-                  mCommonName(),
-                  mCountry(),
-                  mState(),
-                  mLocality(),
-                  mOrganization(),
-                  mOrgUnit(),
-                  mStreet(),
-                  mPostalCode(),
-                  mTitle(),
-                  mSurname(),
-                  mGivenName(),
-                  mInitials(),
-                  mPseudonym(),
-                  mGenerationQualifier(),
-                  mDomainComponent(),
-                  mDnQualifier(),
-                  mEmail(),
-                  mUri(),
-                  mDns(),
-                  mHostName(),
-                  mIpAddress(),
-                  mSerialNumbers(),
-                  mUserId()
-                {
-                }
+                X509DN (X509Provider &provider, std::size_t capacity=0);
 
                 ~X509DN ()
                 {
@@ -135,8 +95,9 @@ namespace ara
                  * @return ara::core::Result<ara::core::String> String of the attribute
                  * @exception CryptoErrorDomain::kUnknownIdentifier if the id argument has unsupported value
                  * @exception CryptoErrorDomain::kInsufficientCapacity if (attribute != nullptr), but attribute->capacity() is less than required for storing of the output
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the string cannot be allocated
                  */
-                virtual ara::core::Result<ara::core::String> GetAttribute (AttributeId id) const noexcept=0;
+                virtual ara::core::Result<ara::core::String> GetAttribute (AttributeId id) const noexcept;
 
                 /**
                  * @brief [SWS_CRYPT_40415]
@@ -151,27 +112,34 @@ namespace ara
                  * @exception CryptoErrorDomain::kInvalidArgument if (id != kOrgUnit) && (id != kDomainComponent) && (index > 0)
                  * @exception CryptoErrorDomain::kAboveBoundary if ((id == kOrgUnit) || (id == kDomainComponent)) and the index value is greater than or equal to the
                  * actual number of components in the specified attribute
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the string cannot be allocated
                  */
-                virtual ara::core::Result<ara::core::String> GetAttribute (AttributeId id, unsigned index) const noexcept=0;
+                virtual ara::core::Result<ara::core::String> GetAttribute (AttributeId id, unsigned index) const noexcept;
 
                 /**
                  * @brief [SWS_CRYPT_40411]
                  * Get the whole Distinguished Name (DN) as a single string. Capacity of the output string must
                  * be enough for storing the output value! If (dn == nullptr) then method only returns required
                  * buffer capacity.
+                 * The string is the RFC 4514 representation of the DER encoding: the RDNs in the reverse order
+                 * separated by ',', the attributes of a multi-valued RDN joined by '+'. The types of RFC 4514 3
+                 * are written by their names with the escaped string values, the other types as dotted-decimal
+                 * OIDs with '#' and the hexadecimal DER encoding of the value.
                  * @return ara::core::Result<ara::core::String> String of the whole DN string
                  * @exception CryptoErrorDomain::kInsufficientCapacity if (dn != nullptr), but dn->capacity() is less than required for the output value storing
+                 * @exception CryptoErrorDomain::kUnexpectedValue if an attribute type is not a valid OID
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the string cannot be allocated
                  */
-                virtual ara::core::Result<ara::core::String> GetDnString () const noexcept=0;
+                virtual ara::core::Result<ara::core::String> GetDnString () const noexcept;
 
                 /**
                  * @brief [SWS_CRYPT_40417]
                  * Check for equality of this and another Distinguished Name (DN) objects.
                  * @param other another instance of DN for comparison
-                 * @return true if the provided DN is identical to this one
+                 * @return true if the provided DN is identical to this one (the canonical forms are equal)
                  * @return false otherwise
                  */
-                virtual bool operator== (const X509DN &other) const noexcept=0;
+                virtual bool operator== (const X509DN &other) const noexcept;
  
                 /**
                  * @brief [SWS_CRYPT_40418]
@@ -191,16 +159,9 @@ namespace ara
                  * @return ara::core::Result<void> 
                  * @exception CryptoErrorDomain::kUnknownIdentifier if the id argument has unsupported value
                  * @exception CryptoErrorDomain::kUnexpectedValue if the attribute string contains incorrect characters or it has unsupported length
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the new DN cannot be allocated
                  */
-                virtual ara::core::Result<void> SetAttribute (AttributeId id, ara::core::StringView attribute) noexcept/*=0;*/
-                {
-                    switch(id)
-                    {
-                        case AttributeId::kCommonName:
-                            mCommonName = attribute;
-                            break;
-                    }
-                }
+                virtual ara::core::Result<void> SetAttribute (AttributeId id, ara::core::StringView attribute) noexcept;
 
                 /**
                  * @brief [SWS_CRYPT_40416]
@@ -215,8 +176,9 @@ namespace ara
                  * @exception CryptoErrorDomain::kInvalidArgument if (id != kOrgUnit) && (id != kDomainComponent) && (index > 0)
                  * @exception CryptoErrorDomain::kAboveBoundary if ((id == kOrgUnit) || (id == kDomainComponent))
                  * and the index value is greater than the current number of components in the specified attribute
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the new DN cannot be allocated
                  */
-                virtual ara::core::Result<void> SetAttribute (AttributeId id, unsigned index, ara::core::StringView attribute) noexcept=0;
+                virtual ara::core::Result<void> SetAttribute (AttributeId id, unsigned index, ara::core::StringView attribute) noexcept;
 
                 /**
                  * @brief [SWS_CRYPT_40412]
@@ -226,6 +188,99 @@ namespace ara
                  * @exception CryptoErrorDomain::kUnexpectedValue if the dn string has incorrect syntax.
                  */
                 virtual ara::core::Result<void> SetDn (ara::core::StringView dn) noexcept=0;
+
+                /**
+                 * @brief Get DN attribute by its ID and sequential index without copying it. The view refers
+                 * into the storage of this object and is valid until the DN is modified.
+                 * @param[in] id the identifier of required attribute
+                 * @param[in] index the zero-based index of required component (only kOrgUnit and kDomainComponent
+                 * may have more than one)
+                 * @return ara::core::Result<ara::core::StringView> UTF-8 value of the attribute, empty if it is absent
+                 * @exception CryptoErrorDomain::kUnknownIdentifier if the id argument has unsupported value
+                 * @exception CryptoErrorDomain::kInvalidArgument if (id != kOrgUnit) && (id != kDomainComponent) && (index > 0)
+                 * @exception CryptoErrorDomain::kAboveBoundary if ((id == kOrgUnit) || (id == kDomainComponent)) and the index value is greater than or equal to the
+                 * actual number of components in the specified attribute
+                 */
+                ara::core::Result<ara::core::StringView> GetAttributeView (AttributeId id, unsigned index=0) const noexcept;
+
+                /**
+                 * @brief Get the number of components of an attribute.
+                 * @param[in] id the identifier of the attribute
+                 * @return std::size_t 0 if the attribute is absent or the id is unknown
+                 */
+                std::size_t GetAttributeCount (AttributeId id) const noexcept;
+
+                /**
+                 * @brief Set the whole DN from its DER encoding (the Name of RFC 5280). The encoding is kept for
+                 * byte-exact comparison, the attribute values are decoded on the first access. Attributes
+                 * without an AttributeId are kept in the encoding only.
+                 * @param[in] der the DER encoded Name
+                 * @return ara::core::Result<void>
+                 * @exception CryptoErrorDomain::kUnexpectedValue if the encoding is malformed
+                 * @exception CryptoErrorDomain::kInsufficientResource if the memory for the DN cannot be allocated
+                 * (the DN is unchanged then)
+                 */
+                ara::core::Result<void> SetDer (ReadOnlyMemRegion der) noexcept;
+
+                /**
+                 * @brief Get the DER encoding of the DN: the one set by SetDer() with the changes made by
+                 * SetAttribute() since.
+                 * @return ReadOnlyMemRegion the DER encoded Name (an empty SEQUENCE for an empty DN)
+                 */
+                ReadOnlyMemRegion GetDer () const noexcept
+                {
+                    return ReadOnlyMemRegion(mDer.data(), mDer.size());
+                }
+
+                /**
+                 * @brief Get the canonical form of the DN, equal for the DNs that match by RFC 5280 7.1 (see
+                 * operator==()).
+                 * @return ReadOnlyMemRegion the compact canonical form, only meant for comparison and hashing
+                 */
+                ReadOnlyMemRegion GetCanonical () const noexcept
+                {
+                    return ReadOnlyMemRegion(mCanonical.data(), mCanonical.size());
+                }
+
+                /**
+                 * @brief Get the 64-bit hash of the canonical form, e.g. as a key of a hash index.
+                 * @return std::uint64_t
+                 */
+                std::uint64_t GetHash () const noexcept
+                {
+                    return mHash;
+                }
+
+            protected:
+                /**
+                 * @brief Number of AttributeId values.
+                 */
+                static const std::size_t kAttributeCount = 23u;
+
+            private:
+                // A value in mValues, the entries of an attribute are mEntries[mFirstEntry[id]] up to
+                // mEntries[mFirstEntry[id + 1]] in the order of their indexes.
+                struct Entry
+                {
+                    std::uint32_t mOffset;
+                    std::uint32_t mSize;
+                };
+
+                void Decode () const noexcept;
+                ara::core::Result<void> Replace (AttributeId id, unsigned index, ara::core::StringView attribute) noexcept;
+                // The RFC 4514 string of GetDnString(), throws std::bad_alloc.
+                ara::core::Result<ara::core::String> FormatDn () const;
+                // The encoding with a component replaced, throws std::bad_alloc.
+                ara::core::Vector<std::uint8_t> Rewrite (std::size_t target, unsigned index, ara::core::StringView attribute) const;
+
+                mutable ara::core::String mValues;               // UTF-8 attribute values one after another
+                mutable ara::core::Vector<Entry> mEntries;
+                mutable std::uint16_t mFirstEntry[kAttributeCount + 1u];
+                ara::core::Vector<std::uint8_t> mDer;
+                mutable std::atomic<bool> mDecoded;
+                mutable std::mutex mDecodeMutex;
+                ara::core::Vector<std::uint8_t> mCanonical;
+                std::uint64_t mHash;                            // of mCanonical
             };
         }
     }